@@ -1153,10 +1153,19 @@ namespace flopoco
 
 	void BitHeap::generateCompressorVHDL()
 	{
+		Profiler::Scope p("BitHeap::generateCompressorVHDL", op->getName());
 		op->vhdl << tab << endl << tab << "-- Beginning of code generated by BitHeap::generateCompressorVHDL" << endl;
 		REPORT(DEBUG, "begin generateCompressorVHDL");
 
 		generateSupertileVHDL();
+
+		// Cost estimate: one DSP per multiplier block, and, for the compression to two rows followed by an adder,
+		// about one LUT per bit in excess of two per column, plus one LUT per column
+		int nbBits = 0;
+		for (unsigned w=0; w<bits.size(); w++)
+			nbBits += bits[w].size();
+		op->addEstimatedCost(max(0, nbBits - (int)maxWeight), mulBlocks.size());
+
 		// add the constant bits to the actual bit heap
 
 		//empty bitheap
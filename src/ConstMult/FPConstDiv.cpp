@@ -104,6 +104,7 @@ namespace flopoco{
 		vhdl << tab << declare("x_exp", wEIn) << " <=  X("<<wEIn<<"+"<<wFIn<<"-1 downto "<<wFIn<<");"<<endl;
 		vhdl << tab << declare("x_sig", wFIn+1) << " <= '1' & X("<<wFIn-1 <<" downto 0);"<<endl;
 
+		addEstimatedAdderCost(gamma+1);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(gamma+1));
 		vhdl << tab << declare("Diffmd", gamma+1) << " <=  ('0' & x_sig" << range(wFIn, wFIn-gamma+1)<< ") - ('0' & CONV_STD_LOGIC_VECTOR(" << d << ", " << gamma <<")) ;" << endl;
 		vhdl << tab << declare("mltd") << " <=   Diffmd("<< gamma<<");" << endl;
@@ -114,6 +115,7 @@ namespace flopoco{
 		if(d*intpow2(dExp) >1.0) { // only underflow possible
 			vhdl <<endl << tab << "-- exponent processing. For this d we may only have underflow" << endl;
 			
+			addEstimatedAdderCost(wEOut+1);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEOut+1));
 			vhdl << tab << declare("r_exp0", wEOut+1) << " <=  ('0' & x_exp) - ( CONV_STD_LOGIC_VECTOR(" << s+1+dExp << ", " << wEOut+1 <<")) + (not mltd);" << endl;
 			
@@ -127,6 +129,7 @@ namespace flopoco{
 			{
 			vhdl <<endl << tab << "-- exponent processing. For this d we may only have overflow" << endl;
 			
+			addEstimatedAdderCost(wEOut+1);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEOut+1));
 			vhdl << tab << declare("r_exp0", wEOut+1) << " <=  ('0' & x_exp) + ( CONV_STD_LOGIC_VECTOR(" << -(s+1+dExp) << ", " << wEOut+1 <<")) + (not mltd);" << endl;
 			
@@ -585,6 +585,7 @@ namespace flopoco{
 		// Here if mantissa was 1 critical path is 0. Otherwise we want to reset critical path to the norm bit
 		setCycleFromSignal("norm", getSignalDelay("norm"));
 		
+		addEstimatedAdderCost(wE_sum+1);
 		manageCriticalPath(getTarget()->localWireDelay() + getTarget()->adderDelay(wE_sum+1));
 		vhdl <<endl << tab << "-- exponent processing"<<endl;
 		
@@ -603,6 +604,7 @@ namespace flopoco{
 			vhdl << tab << declare("expfrac_rnd",   wE_out+1+wF_out) << " <= r_exp_br & r_frac;"<<endl;
 		} 
 		else {
+			addEstimatedAdderCost(wE_out+1+wF_out+1);
 			manageCriticalPath(getTarget()->localWireDelay() + getTarget()->adderDelay(wE_out+1+wF_out+1));
 			vhdl << tab << declare("expfrac_br",   wE_out+1+wF_out+1) << " <= r_exp_br & shifted_frac;"<<endl;
 			// add the rounding bit //TODO: No  round to nearest here. OK for faithful. For CR, does this case ever appear?
@@ -102,6 +102,7 @@ namespace flopoco{
 			//normalize
 			vhdl << tab << declare("norm") << " <= fracMultRes"<<of(wF+1)<<";"<<endl;
 		
+			addEstimatedAdderCost(wE+2);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));
 			vhdl << tab << declare("nf",wF) << " <= fracMultRes"<<range(wF-1,0)<<" when norm='0' else fracMultRes"<<range(wF,1)<<";"<<endl;
 		}
@@ -133,6 +133,7 @@ namespace flopoco{
          else
          {
             vhdl << tab << declare("fA2",wFO) <<  "<= fA1" << range(wFO0+wFI+LSB, wFI+1+LSB)<< ";"<<endl;
+            addEstimatedAdderCost(wFO);
             manageCriticalPath(target->localWireDelay() + target->adderDelay(wFO));
             vhdl << tab << declare("fA4",wFO) <<  "<= fA2 when I" << of(wEI+wFI) <<" = '0' else -signed(fA2);" <<endl;
          }
@@ -170,6 +171,7 @@ namespace flopoco{
          }
          else
          {
+            addEstimatedAdderCost(wFO+1);
             manageCriticalPath(target->localWireDelay() + target->adderDelay(wFO+1));
             vhdl << tab << declare("fA3b",wFO+1) <<  "<= -signed(fA3);" <<endl;
             manageCriticalPath(target->localWireDelay() + target->lutDelay());
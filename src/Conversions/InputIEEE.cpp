@@ -115,6 +115,7 @@ namespace flopoco{
 				vhdl << tab << declare("round") << " <= roundBit and (sticky or resultLSB);"<<endl;
 
 				vhdl << tab << "-- The following addition will not overflow since FloPoCo format has one more exponent value" <<endl; 
+				addEstimatedAdderCost(wEO+wFO);
 				manageCriticalPath(target->localWireDelay() + target->adderDelay(wEO+wFO));
 				vhdl << tab << declare("expfracR0", wEO+wFO) << " <= (expX & sfracX" << range(wFI-1, wFI-wFO) << ")  +  (CONV_STD_LOGIC_VECTOR(0," << wEO+wFO-1 <<") & round);"<<endl;
 				vhdl << tab << declare("fracR",wFO) << " <= expfracR0" << range(wFO-1, 0) << ";" << endl;
@@ -143,6 +144,7 @@ namespace flopoco{
 			// We have to compute ER = E_X - bias(wE_in) + bias(wE_R)
 			// Let us pack all the constants together
 			mpz_class expAddend = -biasI + eMaxO-1;
+			addEstimatedAdderCost(wEO);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEO));
 			vhdl << tab << declare("expR",    wEO) << " <= "
 					 << "(" << rangeAssign(wEO-1, wEI, "'0'") << "  & expX) + "
@@ -179,10 +181,12 @@ namespace flopoco{
 			int32_t eMaxO = (1<<(wEO-1)); // that's our maximal exponent, one more than IEEE's
 			overflowThreshold = eMaxO+biasI;
 			vhdl << tab << "-- min exponent value without underflow, biased with input bias: " << underflowThreshold << endl ;
+			addEstimatedAdderCost(wEI+1);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEI+1));
 			vhdl << tab << declare("unSub",wEI+1) << " <= ('0' & expX) - CONV_STD_LOGIC_VECTOR(" << underflowThreshold << "," << wEI+1 <<");" << endl;
 			vhdl << tab << declare("underflow") << " <= unSub(" << wEI << ");" << endl;
 
+			addEstimatedAdderCost(wEI+1);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEI+1));
 			vhdl << tab << "-- max exponent value without overflow, biased with input bias: " << overflowThreshold << endl ;
 			vhdl << tab << declare("ovSub",wEI+1) << " <= CONV_STD_LOGIC_VECTOR(" << overflowThreshold << "," << wEI+1 <<")  -  ('0' & expX);" << endl;
@@ -222,6 +226,7 @@ namespace flopoco{
 				vhdl << tab << declare("round") << " <= roundBit and (sticky or resultLSB);"<<endl;
 
 				vhdl << tab << "-- The following addition may overflow" <<endl;
+				addEstimatedAdderCost(wEO+wFO+1);
 				manageCriticalPath(target->localWireDelay() + target->adderDelay(wEO+wFO+1));
 				vhdl << tab << declare("expfracR0", wEO+wFO+1) << " <= ('0' & expXO & fracX" << range(wFI-1, wFI-wFO) << ")  +  (CONV_STD_LOGIC_VECTOR(0," << wEO+wFO <<") & round);"<<endl;
 				vhdl << tab << declare("roundOverflow") << " <= expfracR0(" << wEO+wFO << ");" << endl;
@@ -99,6 +99,7 @@ namespace flopoco{
 				vhdl << tab << declare("round") << " <= roundBit and (sticky or resultLSB);"<<endl;
 
 				vhdl << tab << "-- The following addition will not overflow since FloPoCo format has one more exponent value" <<endl;
+				addEstimatedAdderCost(wEO+wFO);
 				manageCriticalPath(target->localWireDelay() + target->adderDelay(wEO+wFO));
 				vhdl << tab << declare("expfracR0", wEO+wFO) << " <= (expX & sfracX" << range(wFI-1, wFI-wFO) << ")  +  (CONV_STD_LOGIC_VECTOR(0," << wEO+wFO-1 <<") & round);"<<endl;
 
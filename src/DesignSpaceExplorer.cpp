@@ -0,0 +1,306 @@
+/*
+  The design-space exploration driver of FloPoCo
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  2008-2015.
+  All rights reserved.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "DesignSpaceExplorer.hpp"
+#include "UserInterface.hpp"
+
+namespace flopoco{
+
+	// The generic options whose values may be ranges
+	static const vector<string> numericalOptions = {"frequency", "hardMultThreshold", "latency"};
+
+
+	vector<string> DesignSpaceExplorer::expandValues(string value, bool numerical) {
+		vector<string> values;
+		istringstream list(value);
+		string item;
+		while(getline(list, item, ',')) {
+			size_t colon = item.find(':');
+			if(!numerical || colon==string::npos) {
+				values.push_back(item);
+				continue;
+			}
+			// a range min:max or min:max:step
+			string minS = item.substr(0, colon);
+			string maxS = item.substr(colon+1);
+			string stepS = "1";
+			colon = maxS.find(':');
+			if(colon!=string::npos) {
+				stepS = maxS.substr(colon+1);
+				maxS = maxS.substr(0, colon);
+			}
+			bool integer = (minS+maxS+stepS).find_first_of(".eE") == string::npos;
+			double min = stod(minS), max = stod(maxS), step = stod(stepS);
+			if(step <= 0)
+				throw(string("explore: the step of the range ") + item + " should be positive");
+			for (int i=0; min + i*step <= max*(1+1e-12); i++) {
+				ostringstream s;
+				if(integer)
+					s << (long)(min + i*step);
+				else
+					s << min + i*step;
+				values.push_back(s.str());
+			}
+		}
+		return values;
+	}
+
+
+
+	bool DesignSpaceExplorer::parseEstimate(string output, Variant& v) {
+		// The top-level operator is the last one in the global operator list
+		size_t pos = output.rfind("Estimate for ");
+		if(pos==string::npos)
+			return false;
+		string line = output.substr(pos);
+		line = line.substr(line.find(": ")+2);
+		return 6 == sscanf(line.c_str(), "latency %d cycles at %lf MHz, %d LUTs, %d FFs, %d DSPs, %d memory blocks",
+											 &v.latency, &v.frequency, &v.luts, &v.ffs, &v.dsps, &v.brams);
+	}
+
+
+
+	void DesignSpaceExplorer::runVariants(string flopoco, vector<Variant>& variants, int jobs) {
+		map<pid_t, size_t> running; // pid -> variant
+		map<size_t, string> logs;   // variant -> file of its output
+		size_t next = 0;
+		size_t done = 0;
+		while(done < variants.size()) {
+			// start new processes while there are free slots
+			while(running.size() < (size_t)jobs && next < variants.size()) {
+				char logName[] = "/tmp/flopoco_explore_XXXXXX";
+				int fd = mkstemp(logName);
+				if(fd<0)
+					throw(string("explore: cannot create a temporary file"));
+				vector<string> args = variants[next].args;
+				args.insert(args.begin(), "estimateOnly=1");
+				args.insert(args.begin(), flopoco);
+				pid_t pid = fork();
+				if(pid==0) { // child
+					dup2(fd, 1);
+					dup2(fd, 2);
+					vector<char*> argv;
+					for (auto& a: args)
+						argv.push_back((char*)a.c_str());
+					argv.push_back(NULL);
+					execv(flopoco.c_str(), argv.data());
+					_exit(127);
+				}
+				close(fd);
+				if(pid<0)
+					throw(string("explore: fork failed"));
+				running[pid] = next;
+				logs[next] = logName;
+				next++;
+			}
+
+			// wait for one of them
+			int status;
+			pid_t pid = wait(&status);
+			if(pid<0 || running.find(pid)==running.end())
+				continue;
+			size_t i = running[pid];
+			running.erase(pid);
+			ifstream log(logs[i].c_str());
+			stringstream output;
+			output << log.rdbuf();
+			log.close();
+			unlink(logs[i].c_str());
+			Variant& v = variants[i];
+			v.ok = WIFEXITED(status) && WEXITSTATUS(status)==0 && parseEstimate(output.str(), v);
+			done++;
+
+			cerr << "[" << done << "/" << variants.size() << "]";
+			for (auto a: v.args)
+				cerr << " " << a;
+			if(v.ok)
+				cerr << ": latency " << v.latency << " at " << v.frequency << " MHz, " << v.luts << " LUTs, " << v.ffs << " FFs, "
+						 << v.dsps << " DSPs, " << v.brams << " memory blocks" << endl;
+			else
+				cerr << ": FAILED" << endl;
+		}
+	}
+
+
+
+	bool DesignSpaceExplorer::dominates(Variant& a, Variant& b) {
+		bool notWorse = a.frequency >= b.frequency && a.latency <= b.latency && a.luts <= b.luts
+			&& a.ffs <= b.ffs && a.dsps <= b.dsps && a.brams <= b.brams;
+		bool better = a.frequency > b.frequency || a.latency < b.latency || a.luts < b.luts
+			|| a.ffs < b.ffs || a.dsps < b.dsps || a.brams < b.brams;
+		return notWorse && better;
+	}
+
+
+
+	void DesignSpaceExplorer::outputCSV(ostream& o, vector<Variant>& variants, vector<string>& keys) {
+		for (auto k: keys)
+			o << k << ",";
+		o << "frequencyMHz,latency,LUTs,FFs,DSPs,BRAMs" << endl;
+		for (auto& v: variants) {
+			if(!v.pareto)
+				continue;
+			for (auto k: keys) {
+				// a function such as f="sin(x)" keeps its quotes, doubled as CSV requires
+				string value = v.values[k];
+				for (size_t q=value.find('"'); q != string::npos; q=value.find('"', q+2))
+					value.insert(q, 1, '"');
+				o << "\"" << value << "\",";
+			}
+			o << v.frequency << "," << v.latency << "," << v.luts << "," << v.ffs << "," << v.dsps << "," << v.brams << endl;
+		}
+	}
+
+
+
+	void DesignSpaceExplorer::outputJSON(ostream& o, vector<Variant>& variants, vector<string>& keys) {
+		o << "[";
+		for (size_t i=0; i<variants.size(); i++) {
+			Variant& v = variants[i];
+			o << (i==0 ? "" : ",") << endl << "\t{";
+			for (auto k: keys) {
+				string value = v.values[k];
+				size_t q;
+				while((q=value.find('"')) != string::npos)
+					value.replace(q, 1, "'");
+				o << "\"" << k << "\": \"" << value << "\", ";
+			}
+			o << "\"ok\": " << (v.ok ? "true" : "false");
+			if(v.ok)
+				o << ", \"frequencyMHz\": " << v.frequency << ", \"latency\": " << v.latency << ", \"LUTs\": " << v.luts
+					<< ", \"FFs\": " << v.ffs << ", \"DSPs\": " << v.dsps << ", \"BRAMs\": " << v.brams;
+			o << ", \"pareto\": " << (v.pareto ? "true" : "false") << "}";
+		}
+		o << endl << "]" << endl;
+	}
+
+
+
+	void DesignSpaceExplorer::main(int argc, char* argv[]) {
+		int jobs = std::thread::hardware_concurrency();
+		if(jobs<1)
+			jobs=1;
+		string outputPrefix = "explore";
+
+		// Split the command line into the explored keys and their lists of values
+		vector<pair<string, vector<string>>> options, parameters;
+		string opName = "";
+		OperatorFactoryPtr factory = NULL;
+		for (int i=2; i<argc; i++) {
+			string arg = argv[i];
+			size_t eq = arg.find('=');
+			if(eq==string::npos) {
+				if(opName!="")
+					throw(string("explore: only one operator can be explored, got ") + opName + " and " + arg);
+				opName = arg;
+				factory = UserInterface::getFactoryByName(opName);
+				continue;
+			}
+			string key = arg.substr(0, eq);
+			string value = arg.substr(eq+1);
+			if(opName=="") { // an option
+				if(key=="jobs") {
+					jobs = stoi(value);
+					if(jobs<1)
+						throw(string("explore: jobs should be at least 1, got ") + value);
+				}
+				else if(key=="exploreOutput")
+					outputPrefix = value;
+				else {
+					bool numerical = find(numericalOptions.begin(), numericalOptions.end(), key) != numericalOptions.end();
+					bool boolean = key=="useHardMult" || key=="pipeline" || key=="plainVHDL";
+					options.push_back(make_pair(key, (numerical||boolean) ? expandValues(value, numerical) : vector<string>(1, value)));
+				}
+			}
+			else { // a parameter of the operator: the factory tells its type
+				string type = "";
+				for (auto p: factory->param_names()) {
+					string lp=p, lk=key;
+					std::transform(lp.begin(), lp.end(), lp.begin(), ::tolower);
+					std::transform(lk.begin(), lk.end(), lk.begin(), ::tolower);
+					if(lp==lk)
+						type = factory->getParamType(p);
+				}
+				if(type=="")
+					throw(string("explore: ") + opName + " has no parameter " + key);
+				bool numerical = (type=="int" || type=="real");
+				parameters.push_back(make_pair(key, (numerical || type=="bool") ? expandValues(value, numerical) : vector<string>(1, value)));
+			}
+		}
+		if(opName=="")
+			throw(string("Usage: flopoco explore [jobs=<n>] [exploreOutput=<prefix>] [options] OperatorName parameters\n")
+						+ "  where values may be lists (v1,v2,v3) or ranges (min:max or min:max:step)");
+
+		// Build the cartesian product
+		vector<pair<string, vector<string>>> all = options;
+		all.insert(all.end(), parameters.begin(), parameters.end());
+		vector<string> keys; // the keys that take more than one value
+		for (auto& kv: all)
+			if(kv.second.size()>1)
+				keys.push_back(kv.first);
+		vector<Variant> variants(1);
+		variants[0].ok = false;
+		variants[0].pareto = false;
+		for (size_t k=0; k<all.size(); k++) {
+			vector<Variant> extended;
+			for (auto& v: variants)
+				for (auto value: all[k].second) {
+					Variant w = v;
+					if(k==options.size())
+						w.args.push_back(opName);
+					w.args.push_back(all[k].first + "=" + value);
+					w.values[all[k].first] = value;
+					extended.push_back(w);
+				}
+			variants = extended;
+		}
+		if(parameters.empty())
+			for (auto& v: variants)
+				v.args.push_back(opName);
+		cerr << "Exploring " << variants.size() << " variants of " << opName << " with " << jobs << " processes" << endl;
+
+		// The flopoco executable itself
+		char exe[4096];
+		ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe)-1);
+		string flopoco = (len>0 ? string(exe, len) : string(argv[0]));
+		runVariants(flopoco, variants, jobs);
+
+		// Pareto front
+		for (auto& v: variants) {
+			v.pareto = v.ok;
+			for (auto& w: variants)
+				if(v.pareto && w.ok && dominates(w, v))
+					v.pareto = false;
+		}
+
+		ofstream csv((outputPrefix+".csv").c_str());
+		outputCSV(csv, variants, keys);
+		csv.close();
+		ofstream json((outputPrefix+".json").c_str());
+		outputJSON(json, variants, keys);
+		json.close();
+		int nbPareto = count_if(variants.begin(), variants.end(), [](Variant& v){return v.pareto;});
+		cerr << nbPareto << " Pareto-optimal variants written to " << outputPrefix << ".csv, all the variants to " << outputPrefix << ".json" << endl;
+	}
+
+}
@@ -0,0 +1,63 @@
+#ifndef DESIGNSPACEEXPLORER_HPP
+#define DESIGNSPACEEXPLORER_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+namespace flopoco{
+
+	/** The design-space exploration driver:
+	 *    flopoco explore [jobs=<n>] [exploreOutput=<prefix>] [options] OperatorName parameters
+	 * where each option or parameter value may be a comma-separated list of values (1,2,5),
+	 * and the value of a numerical option or parameter may be a range min:max or min:max:step.
+	 * All the combinations are generated, each by a separate flopoco process with estimateOnly=1
+	 * (processes rather than threads since the generator has global state), up to jobs at a time.
+	 * The latency and resource estimates of each variant are collected, and the variants that are
+	 * not dominated (higher frequency, lower latency, fewer LUTs, FFs, DSPs, memory blocks) form the Pareto front.
+	 * The Pareto front is written to <prefix>.csv, and all the variants to <prefix>.json.
+	 */
+	class DesignSpaceExplorer
+	{
+	public:
+		/** Runs the exploration. argv[1] is "explore" */
+		static void main(int argc, char* argv[]);
+
+	private:
+		/** A point of the design space, and its estimated metrics */
+		typedef struct {
+			vector<string> args;        /**< the flopoco arguments of this variant */
+			map<string,string> values;  /**< the value of each explored option or parameter */
+			bool ok;                    /**< true if the generation succeeded */
+			int latency;                /**< pipeline depth in cycles */
+			double frequency;           /**< in MHz */
+			int luts;
+			int ffs;
+			int dsps;
+			int brams;
+			bool pareto;                /**< true if no other variant dominates this one */
+		} Variant;
+
+		/** Expands a list or range of values
+		 * @param value the value, e.g. 1,2,5 or 8:16 or 100:400:50
+		 * @param numerical true if the value may be a range */
+		static vector<string> expandValues(string value, bool numerical);
+
+		/** Runs the variants, jobs processes at a time */
+		static void runVariants(string flopoco, vector<Variant>& variants, int jobs);
+
+		/** Parses the estimate line of the top-level operator in the output of flopoco estimateOnly=1 */
+		static bool parseEstimate(string output, Variant& v);
+
+		/** true if a dominates b */
+		static bool dominates(Variant& a, Variant& b);
+
+		static void outputCSV(ostream& o, vector<Variant>& variants, vector<string>& keys);
+		static void outputJSON(ostream& o, vector<Variant>& variants, vector<string>& keys);
+	};
+
+}
+#endif
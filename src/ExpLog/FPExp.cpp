@@ -126,6 +126,16 @@ namespace flopoco{
 	};
 
 	mpz_class FPExp::ExpYTable::function(int x){
+		mpz_class h = value(x, wIn, wOut);
+
+		// debug
+		if((h>=(mpz_class(1)<<wOut)) || h<0)
+			REPORT(0, "Ouch!!!!!" << h);
+
+		return h;
+	};
+
+	mpz_class FPExp::ExpYTable::value(int x, int wIn, int wOut){
 		mpz_class h;
 		mpfr_t a, y;
 
@@ -143,10 +153,6 @@ namespace flopoco{
 		mpfr_mul_2si(y, y, wOut-1, GMP_RNDN);
 		mpfr_get_z(h.get_mpz_t(), y,  GMP_RNDN);  // here the rounding takes place
 
-		// debug
-		if((h>=(mpz_class(1)<<wOut)) || h<0)
-			REPORT(0, "Ouch!!!!!" << h);
-
 		//cout << x << "\t" << h << "\t" << l <<endl;
 		mpfr_clears(y, a, NULL);
 				
@@ -155,6 +161,20 @@ namespace flopoco{
 
 
 
+	FPExp::ExpYDualTable::ExpYDualTable(Target* target, int wIn, int wOut) : 
+		DualTable(target, wIn, wOut) {
+		ostringstream name; 
+		srcFileName="FPExp::ExpYDualTable";
+		name <<"ExpYDualTable_" << wIn << "_" << wOut;
+		setName(name.str());
+	};
+
+	mpz_class FPExp::ExpYDualTable::function(int x){
+		return ExpYTable::value(x, wIn, wOut);
+	};
+
+
+
 
 
 	FPExp::FPExp(
@@ -165,18 +185,24 @@ namespace flopoco{
 			int d_,  
 			int guardBits, 
 			bool fullInput,   
-			map<string, double> inputDelays 
+			map<string, double> inputDelays,
+			int lanes_
 		): 	Operator(target), 
 			wE(wE_), 
 			wF(wF_), 
 			k(k_), 
 			d(d_), 
-			g(guardBits)
+			g(guardBits),
+			lanes(lanes_)
 	{
 		// Paperwork
+		if (lanes < 1)
+			THROWERROR("lanes should be at least 1, got " << lanes);
 
 		ostringstream name;
 		name << "FPExp_" << wE << "_" << wF ;
+		if (lanes > 1)
+			name << "_L" << lanes;
 		setNameWithFreq(name.str());
 
 		setCopyrightString("F. de Dinechin, Bogdan Pasca (2008-2013)");
@@ -209,7 +235,6 @@ namespace flopoco{
 		int sizeExpZmZm1;
 		int sizeExpZm1; // 
 		int sizeMultIn; // sacrificing accuracy where it costs
-		IntAdder* addexpZminus1;		
  		int blockRAMSize=target->sizeOfMemoryBlock();
 
 
@@ -314,8 +339,16 @@ namespace flopoco{
 		else 
 			wFIn=wF;
 
-		addFPInput("X", wE, wFIn);
-		addFPOutput("R", wE, wF, 2);  // 2 because faithfully rounded
+		if (lanes == 1) {
+			addFPInput("X", wE, wFIn);
+			addFPOutput("R", wE, wF, 2);  // 2 because faithfully rounded
+		}
+		else {
+			for (int l=0; l<lanes; l++)
+				addFPInput(join("X",l), wE, wFIn);
+			for (int l=0; l<lanes; l++)
+				addFPOutput(join("R",l), wE, wF, 2);
+		}
 
 
 
@@ -366,437 +399,479 @@ namespace flopoco{
 
 		//******** Input unpacking and shifting to fixed-point ********
 
-		setCriticalPath( getMaxInputDelays(inputDelays) + target->localWireDelay());
-		vhdl << tab  << declare("Xexn", 2) << " <= X(wE+wFIn+2 downto wE+wFIn+1);" << endl;
-		vhdl << tab  << declare("XSign") << " <= X(wE+wFIn);" << endl;
-		vhdl << tab  << declare("XexpField", wE) << " <= X(wE+wFIn-1 downto wFIn);" << endl;
-		vhdl << tab  << declare("Xfrac", wFIn) << " <= X(wFIn-1 downto 0);" << endl;
-
-		int e0 = bias - (wF+g);
-		vhdl << tab  << declare("e0", wE+2) << " <= conv_std_logic_vector(" << e0 << ", wE+2);  -- bias - (wF+g)" << endl;
-		manageCriticalPath( target->localWireDelay() + target->adderDelay(wE+2) ); 
-		vhdl << tab  << declare("shiftVal", wE+2) << " <= (\"00\" & XexpField) - e0; -- for a left shift" << endl;
+		vhdl << tab  << declare("e0", wE+2) << " <= conv_std_logic_vector(" << bias - (wF+g) << ", wE+2);  -- bias - (wF+g)" << endl;
+
+		/* The datapath is replicated for each lane. With a single lane,
+			 the signal names are those of the original single-input operator.
+			 It is built in three steps so that two lanes may share a dual-port table:
+			 range reduction of all the lanes, then the e^Y (or e^A) tables, then the rest of each lane */
+		Shifter* lshift = NULL;
+		FixRealKCM *mulInvLog2 = NULL;
+		FixRealKCM *mulLog2 = NULL;
+		IntAdder *yPaddedAdder = NULL;
+		int maxshift=wE-1+ wF+g; // maxX < 2^(wE-1);
+		for (int l=0; l<lanes; l++) {
+			string lane = (lanes == 1 ? "" : join("_",l));
+			string X    = (lanes == 1 ? "X" : join("X",l));
+			setCycle(0);
+
+			setCriticalPath( getMaxInputDelays(inputDelays) + target->localWireDelay());
+			vhdl << tab  << declare("Xexn"+lane, 2) << " <= " << X << "(wE+wFIn+2 downto wE+wFIn+1);" << endl;
+			vhdl << tab  << declare("XSign"+lane) << " <= " << X << "(wE+wFIn);" << endl;
+			vhdl << tab  << declare("XexpField"+lane, wE) << " <= " << X << "(wE+wFIn-1 downto wFIn);" << endl;
+			vhdl << tab  << declare("Xfrac"+lane, wFIn) << " <= " << X << "(wFIn-1 downto 0);" << endl;
+
+			addEstimatedAdderCost(wE+2);
+			manageCriticalPath( target->localWireDelay() + target->adderDelay(wE+2) );
+			vhdl << tab  << declare("shiftVal"+lane, wE+2) << " <= (\"00\" & XexpField" << lane << ") - e0; -- for a left shift" << endl;
+
+			vhdl << tab  << "-- underflow when input is shifted to zero (shiftval<0), in which case exp = 1" << endl;
+			vhdl << tab  << declare("resultWillBeOne"+lane) << " <= shiftVal" << lane << "(wE+1);" << endl;
+
+			// As we don't have a signed shifter, shift first, complement next. TODO? replace with a signed shifter
+			vhdl << tab << "--  mantissa with implicit bit" << endl;
+			vhdl << tab  << declare("mXu"+lane, wFIn+1) << " <= \"1\" & Xfrac" << lane << ";" << endl;
+
+			// left shift
+			double scp = getCriticalPath();
+			vhdl << tab  << "-- Partial overflow/underflow detection" << endl;
+			addEstimatedAdderCost(wE+1);
+			manageCriticalPath( target->adderDelay(wE+1) + target->localWireDelay() + target->lutDelay() + target->localWireDelay());
+			vhdl << tab  << declare("oufl0"+lane) << " <= not shiftVal" << lane << "(wE+1) when shiftVal" << lane << "(wE downto 0) >= conv_std_logic_vector(" << maxshift << ", wE+1) else '0';" << endl;
+
+			setCycleFromSignal("shiftVal"+lane, scp);
+
+			if (l==0) {
+				lshift = new Shifter(target, wFIn+1, maxshift , Shifter::Left, inDelayMap("S", target->localWireDelay(wFIn+1) + getCriticalPath())  );
+				addSubComponent(lshift);
+			}
+			int shiftInSize = lshift->getShiftInWidth();
+			vhdl << tab  << declare("shiftValIn"+lane, shiftInSize) << " <= shiftVal" << lane << range(shiftInSize-1, 0) << ";" << endl;
+
+			outPortMap(lshift, "R", "fixX0"+lane);
+			inPortMap(lshift, "S", "shiftValIn"+lane);
+			inPortMap(lshift, "X", "mXu"+lane);
+			vhdl << instance(lshift, "mantissa_shift"+lane);
+			syncCycleFromSignal("fixX0"+lane, lshift->getOutputDelay("R") );
+
+			int sizeXfix = wE+wF+g; // still unsigned; msb=wE-1; lsb = -wF-g
+			manageCriticalPath( target->localWireDelay(sizeXfix) + target->lutDelay());
+
+			vhdl << tab << declare("fixX"+lane, sizeXfix) << " <= " << " fixX0" << lane <<
+				range(wE-1 + wF+g + wFIn+1 -1, wFIn) <<
+				"when resultWillBeOne" << lane << "='0' else " << zg(sizeXfix) <<  ";" << endl;
+
+			int lsbXforFirstMult=-3;
+			int sizeXMulIn = wE-2 - lsbXforFirstMult +1; // msb=wE-2, lsb=-3
+			vhdl << tab <<	declare("xMulIn"+lane, sizeXMulIn) << " <=  fixX" << lane <<
+				range(sizeXfix-2, sizeXfix - sizeXMulIn-1  ) <<
+				"; -- truncation, error 2^-3" << endl;
+
+			//***************** Multiplication by 1/log2 to get approximate result ********
+			// FixRealKCM does the rounding to the proper place with the proper error
+			if (l==0) {
+				mulInvLog2 = new  FixRealKCM(target,
+				                             false,  // unsigned input,
+				                             wE-2 , // msbIn,
+				                             lsbXforFirstMult, // lsbIn
+				                             0,   // lsbOut,
+				                             "1/log(2)", //  constant
+				                             0.5 + 0.09, // error: we have 0.125 on X, and target is 0.5+0.22
+				                             inDelayMap( "X", target->localWireDelay(2) + getCriticalPath())
+				                             );
+				addSubComponent(mulInvLog2);
+			}
+			outPortMap(mulInvLog2, "R", "absK"+lane);
+			inPortMap(mulInvLog2, "X", "xMulIn"+lane);
+			vhdl << instance(mulInvLog2, "mulInvLog2"+lane);
+
+			syncCycleFromSignal("absK"+lane, mulInvLog2->getOutputDelay("R") );
+
+
+			// Now I have two things to do in parallel: compute K, and compute absKLog2
+			// First compute K
+			addEstimatedAdderCost(wE+1);
+			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
+			vhdl << tab << declare("minusAbsK"+lane,wE+1) << " <= " << rangeAssign(wE, 0, "'0'")<< " - ('0' & absK" << lane << ");"<<endl;
+			// The synthesizer should be able to merge the addition and this mux, so
+			// the next line is commented
+			// manageCriticalPath(target->localWireDelay() + target->lutDelay());
+			vhdl << tab << declare("K"+lane,wE+1) << " <= minusAbsK" << lane << " when  XSign" << lane << "='1'   else ('0' & absK" << lane << ");"<<endl;
+
+			// get back to the cycle+critical path at the output of the first multiplier
+			// We kind of forget the critical path at the end of the compute K
+			// block, because mulLog2 will be much larger.
+			setCycleFromSignal("absK"+lane, mulInvLog2->getOutputDelay("R") );
+
+			if (l==0) {
+				mulLog2 = new FixRealKCM(target,
+				                         false  /* unsigned input */,
+				                         wE-1, // msbIn
+				                         0,    // lsbIn
+				                         -wF-g, // lsbOut
+				                         "log(2)",
+				                         1.0,
+				                         inDelayMap( "X", target->localWireDelay(wF+g) + getCriticalPath()) );
+				addSubComponent(mulLog2);
+			}
+			outPortMap(mulLog2, "R", "absKLog2"+lane);
+			inPortMap(mulLog2, "X", "absK"+lane);
+			vhdl << instance(mulLog2, "mulLog2"+lane);
+			syncCycleFromSignal("absKLog2"+lane, mulLog2->getOutputDelay("R") );
 
-		vhdl << tab  << "-- underflow when input is shifted to zero (shiftval<0), in which case exp = 1" << endl;
-		vhdl << tab  << declare("resultWillBeOne") << " <= shiftVal(wE+1);" << endl;
- 
-		// As we don't have a signed shifter, shift first, complement next. TODO? replace with a signed shifter
-		vhdl << tab << "--  mantissa with implicit bit" << endl;
-		vhdl << tab  << declare("mXu", wFIn+1) << " <= \"1\" & Xfrac;" << endl;
 
-#if 0  //  FIXME maxshift is too large, but fixing it breaks alignment
-		// left shift
-		int maxshift=wE+g-1; // maxX < 2^(wE-1); 
-		Shifter* lshift = new Shifter(target, wFIn+1, maxshift , Shifter::Left);   
-		addSubComponent(lshift);
-		int shiftInSize = lshift->getShiftInWidth();
-		vhdl << tab  << declare("shiftValIn", shiftInSize) << " <= shiftVal" << range(shiftInSize-1, 0) << ";" << endl;
+			// absKLog2: msb wE-2, lsb -wF-g
 
-		outPortMap(lshift, "R", "fixX");
-		inPortMap(lshift, "S", "shiftValIn");
-		inPortMap(lshift, "X", "mXu");
-		vhdl << instance(lshift, "mantissa_shift");
-		syncCycleFromSignal("fixX0");
-		nextCycle();
+			sizeY=wF+g; // This is also the weight of Y's LSB
 
-		vhdl << tab  << "-- Partial overflow/underflow detection" << endl;
-		vhdl << tab  << declare("oufl0") << " <= not shiftVal(wE+1) when shiftVal(wE downto 0) >= conv_std_logic_vector(" << maxshift << ", wE+1) else '0';" << endl;
+			manageCriticalPath( target->localWireDelay() + target->lutDelay() );
 
+			vhdl << tab << declare("subOp1"+lane,sizeY) << " <= fixX" << lane << range(sizeY-1, 0) << " when XSign" << lane << "='0'"
+					 << " else not (fixX" << lane << range(sizeY-1, 0) << ");"<<endl;
+			vhdl << tab << declare("subOp2"+lane,sizeY) << " <= absKLog2" << lane << range(sizeY-1, 0) << " when XSign" << lane << "='1'"
+					 << " else not (absKLog2" << lane << range(sizeY-1, 0) << ");"<<endl;
 
-#else
+			if (l==0) {
+				double ctperiod = 1.0 / target->frequency();
+				target->setFrequency( 1.0 / (ctperiod - target->LogicToRAMWireDelay() ) ); // Bogdan, WTF is that?
+				yPaddedAdder = new IntAdder(target, sizeY, // we know the leading bits will cancel out
+				                            inDelayMap("X", target->localWireDelay() + getCriticalPath()) );
+				target->setFrequency( 1.0 / ctperiod );
+				addSubComponent(yPaddedAdder);
+			}
 
+			outPortMap( yPaddedAdder, "R", "Y"+lane);
+			inPortMapCst ( yPaddedAdder, "Cin", "'1'");
+			inPortMapCst ( yPaddedAdder, "Y", "subOp2"+lane);
+			inPortMap( yPaddedAdder, "X", "subOp1"+lane);
 
-		// left shift
-		double scp = getCriticalPath();
-		vhdl << tab  << "-- Partial overflow/underflow detection" << endl;
-		int maxshift=wE-1+ wF+g; // maxX < 2^(wE-1); 
-		manageCriticalPath( target->adderDelay(wE+1) + target->localWireDelay() + target->lutDelay() + target->localWireDelay());
-		vhdl << tab  << declare("oufl0") << " <= not shiftVal(wE+1) when shiftVal(wE downto 0) >= conv_std_logic_vector(" << maxshift << ", wE+1) else '0';" << endl;
+			vhdl << instance(yPaddedAdder, "theYAdder"+lane) << endl;
+			syncCycleFromSignal("Y"+lane, yPaddedAdder->getOutputDelay("R"));
+		}
 
-		setCycleFromSignal("shiftVal", scp);
+		vhdl << tab << "-- Now compute the exp of this fixed-point value" <<endl;
 
-		Shifter* lshift = new Shifter(target, wFIn+1, maxshift , Shifter::Left, inDelayMap("S", target->localWireDelay(wFIn+1) + getCriticalPath())  );   
-		addSubComponent(lshift);
-		int shiftInSize = lshift->getShiftInWidth();
-		vhdl << tab  << declare("shiftValIn", shiftInSize) << " <= shiftVal" << range(shiftInSize-1, 0) << ";" << endl;
+		/* The e^Y table (if expYTabulated) or the e^A table (generic case) is
+			 addressed by each lane. Two lanes share a dual-port table;
+			 with an odd number of lanes, the last one has its own single-port table.
+			 The magic table already uses both of its ports for one lane, so it is not shared. */
+		bool sharedTable = expYTabulated || !(useMagicTableExpZmZm1 || useMagicTableExpZm1);
+		double cpZhigh = 0;
+		if(sharedTable) {
+			string addr = (expYTabulated ? "Y" : "Addr1");
+			string data = (expYTabulated ? "expY" : "expA");
+			int wAddr   = (expYTabulated ? sizeY : k);
+			int wData   = (expYTabulated ? sizeExpY : sizeExpA); // e^A-1 has MSB weight 1
+
+			if(!expYTabulated) {
+				for (int l=0; l<lanes; l++) {
+					string lane = (lanes == 1 ? "" : join("_",l));
+					setCycleFromSignal("Y"+lane, yPaddedAdder->getOutputDelay("R"));
+					vhdl << tab << declare("Addr1"+lane, k) << " <= Y" << lane << range(sizeY-1, sizeY-k) << ";\n";
+					vhdl << tab << declare("Z"+lane, sizeZ) << " <= Y" << lane << range(sizeZ-1, 0) << ";\n";
+					vhdl << tab << declare("Zhigh"+lane, sizeZhigh) << " <= Z" << lane << range(sizeZ-1, sizeZ-sizeZhigh) << ";\n";
+					cpZhigh = getCriticalPath();
+				}
+			}
 
-		outPortMap(lshift, "R", "fixX0");
-		inPortMap(lshift, "S", "shiftValIn");
-		inPortMap(lshift, "X", "mXu");
-		vhdl << instance(lshift, "mantissa_shift");
-		syncCycleFromSignal("fixX0", lshift->getOutputDelay("R") );
+			Operator* singleTable = NULL;
+			Operator* dualTable = NULL;
+			for (int l=0; l<lanes; l+=2) {
+				string lane = (lanes == 1 ? "" : join("_",l));
+				setCycleFromSignal(addr+lane, (expYTabulated ? yPaddedAdder->getOutputDelay("R") : cpZhigh));
+				if(l+1 < lanes) {
+					string lane2 = join("_",l+1);
+					syncCycleFromSignal(addr+lane2);
+					if(dualTable==NULL) {
+						dualTable = new ExpYDualTable(target, wAddr, wData);
+						addSubComponent(dualTable);
+					}
+					inPortMap(dualTable, "X1", addr+lane);
+					inPortMap(dualTable, "X2", addr+lane2);
+					outPortMap(dualTable, "Y1", data+lane);
+					outPortMap(dualTable, "Y2", data+lane2);
+					vhdl << instance(dualTable, join("table_",l/2));
+					/* ExpYDualTable is combinatorial, as the magic table */
+					setSignalDelay(data+lane,  target->RAMDelay() );
+					setSignalDelay(data+lane2,  target->RAMDelay() );
+				}
+				else {
+					if(singleTable==NULL) {
+						singleTable = new ExpYTable(target, wAddr, wData);
+						addSubComponent(singleTable);
+					}
+					outPortMap(singleTable, "Y", data+lane);
+					inPortMap(singleTable, "X", addr+lane);
+					vhdl << instance(singleTable, "table"+lane);
+					setSignalDelay(data+lane,  singleTable->getOutputDelay("Y"));
+				}
+			}
+		}
 
-#endif	
-		
-		int sizeXfix = wE+wF+g; // still unsigned; msb=wE-1; lsb = -wF-g
-		manageCriticalPath( target->localWireDelay(sizeXfix) + target->lutDelay());
-
-		vhdl << tab << declare("fixX", sizeXfix) << " <= " << " fixX0" << 
-			range(wE-1 + wF+g + wFIn+1 -1, wFIn) << 
-			"when resultWillBeOne='0' else " << zg(sizeXfix) <<  ";" << endl;		
-
-		int lsbXforFirstMult=-3; 
-		int sizeXMulIn = wE-2 - lsbXforFirstMult +1; // msb=wE-2, lsb=-3
-		vhdl << tab <<	declare("xMulIn", sizeXMulIn) << " <=  fixX" << 
-			range(sizeXfix-2, sizeXfix - sizeXMulIn-1  ) << 
-			"; -- truncation, error 2^-3" << endl;
-
-		//***************** Multiplication by 1/log2 to get approximate result ******** 
-		// FixRealKCM does the rounding to the proper place with the proper error
-		FixRealKCM *mulInvLog2 = new  FixRealKCM(target,
-		                                         false,  // unsigned input,
-		                                         wE-2 , // msbIn,
-		                                         lsbXforFirstMult, // lsbIn 
-		                                         0,   // lsbOut,
-		                                         "1/log(2)", //  constant
-		                                         0.5 + 0.09, // error: we have 0.125 on X, and target is 0.5+0.22 
-		                                         inDelayMap( "X", target->localWireDelay(2) + getCriticalPath())
-		                                         );
-		addSubComponent(mulInvLog2);
-		outPortMap(mulInvLog2, "R", "absK");
-		inPortMap(mulInvLog2, "X", "xMulIn");
-		vhdl << instance(mulInvLog2, "mulInvLog2");
-
-		syncCycleFromSignal("absK", mulInvLog2->getOutputDelay("R") );
-
-
-		// Now I have two things to do in parallel: compute K, and compute absKLog2
-		// First compute K
-		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
-		vhdl << tab << declare("minusAbsK",wE+1) << " <= " << rangeAssign(wE, 0, "'0'")<< " - ('0' & absK);"<<endl;
-		// The synthesizer should be able to merge the addition and this mux, so
-		// the next line is commented
-		// manageCriticalPath(target->localWireDelay() + target->lutDelay());
-		vhdl << tab << declare("K",wE+1) << " <= minusAbsK when  XSign='1'   else ('0' & absK);"<<endl;
-
-		// get back to the cycle+critical path at the output of the first multiplier
-		// We kind of forget the critical path at the end of the compute K
-		// block, because mulLog2 will be much larger.
-		setCycleFromSignal("absK", mulInvLog2->getOutputDelay("R") );
-
-		FixRealKCM *mulLog2 = new FixRealKCM(target, 
-		                                     false  /* unsigned input */, 
-		                                     wE-1, // msbIn
-		                                     0,    // lsbIn
-		                                     -wF-g, // lsbOut
-		                                     "log(2)", 
-		                                     1.0, 
-		                                     inDelayMap( "X", target->localWireDelay(wF+g) + getCriticalPath()) );
-
-		addSubComponent(mulLog2);
-		outPortMap(mulLog2, "R", "absKLog2");
-		inPortMap(mulLog2, "X", "absK");
-		vhdl << instance(mulLog2, "mulLog2");
-		syncCycleFromSignal("absKLog2", mulLog2->getOutputDelay("R") );
-
-
-		// absKLog2: msb wE-2, lsb -wF-g
-
-		sizeY=wF+g; // This is also the weight of Y's LSB
-
-		manageCriticalPath( target->localWireDelay() + target->lutDelay() );
-
-		vhdl << tab << declare("subOp1",sizeY) << " <= fixX" << range(sizeY-1, 0) << " when XSign='0'"
-				 << " else not (fixX" << range(sizeY-1, 0) << ");"<<endl;
-		vhdl << tab << declare("subOp2",sizeY) << " <= absKLog2" << range(sizeY-1, 0) << " when XSign='1'"
-				 << " else not (absKLog2" << range(sizeY-1, 0) << ");"<<endl;
-
-		double ctperiod = 1.0 / target->frequency(); 
-		target->setFrequency( 1.0 / (ctperiod - target->LogicToRAMWireDelay() ) ); // Bogdan, WTF is that? 
-		IntAdder *yPaddedAdder = new IntAdder(target, sizeY, // we know the leading bits will cancel out
-																					inDelayMap("X", target->localWireDelay() + getCriticalPath()) ); 
-		target->setFrequency( 1.0 / ctperiod );
-		addSubComponent(yPaddedAdder);
-
-		outPortMap( yPaddedAdder, "R", "Y");
-		inPortMapCst ( yPaddedAdder, "Cin", "'1'");
-		inPortMapCst ( yPaddedAdder, "Y", "subOp2");
-		inPortMap( yPaddedAdder, "X", "subOp1");
-	
-		vhdl << instance(yPaddedAdder, "theYAdder") << endl;
-		syncCycleFromSignal("Y", yPaddedAdder->getOutputDelay("R"));
+		FixFunctionByPiecewisePoly *fe = NULL;
+		magicTable* mTable = NULL;
+		IntAdder* addexpZminus1 = NULL;
+		IntAdder* expArounded0 = NULL;
+		Operator* lowProd = NULL;
+		IntAdder *finalAdder = NULL;
+		IntAdder *roundedExpSigOperandAdder = NULL;
+		for (int l=0; l<lanes; l++) {
+			string lane = (lanes == 1 ? "" : join("_",l));
+			string R    = (lanes == 1 ? "R" : join("R",l));
+
+			if(expYTabulated) {
+				setCycleFromSignal("expY"+lane, getSignalDelay("expY"+lane));
+				vhdl << "-- signal delay at BRAM output = "<<getSignalDelay("expY"+lane)<<endl;
+			}
 
-		vhdl << tab << "-- Now compute the exp of this fixed-point value" <<endl;
+			else{
+				if(useMagicTableExpZmZm1 || useMagicTableExpZm1) { // use a dual table, works up to single precision
+					setCycleFromSignal("Y"+lane, yPaddedAdder->getOutputDelay("R"));
+					//The following is really designed for k=9
+					if(k!=9){
+						REPORT(0, "k!=9, setting it to 9 to use the magic exp dual table")
+							k=9;
+					}
+					vhdl << tab << declare("Addr1"+lane, k) << " <= Y" << lane << range(sizeY-1, sizeY-k) << ";\n";
+					vhdl << tab << declare("Z"+lane, sizeZ) << " <= Y" << lane << range(sizeZ-1, 0) << ";\n";
+
+					int sizeExpZPart;
+					if(useMagicTableExpZmZm1){
+						vhdl << tab << declare("Addr2"+lane, k) << " <= Z" << lane << range(sizeZ-1, sizeZ-k) << ";\n";
+						sizeExpZPart=sizeExpZmZm1;
+					}
+					else {// useMagicTableExpZm1
+						vhdl << tab << declare("Addr2"+lane, k) << " <= Z" << lane;
+						// possibly pad right with zeroes; If we are here, sizeZ<=k
+						if(sizeZ<k)
+							vhdl << " & " << rangeAssign(k-sizeZ-1,0, "'0'");
+						vhdl<< ";\n";
+						sizeExpZPart=sizeExpZm1;
+					}
+
+					if (l==0) {
+						mTable = new magicTable(target, sizeExpA, sizeExpZPart, useMagicTableExpZmZm1);
+						addSubComponent(mTable);
+					}
+
+					// TODO: delegate this cycle management to Table
+					/* Magic Table is an instance of DualTable which is, for now combinatorial */
+					//				nextCycle(); //However, to get the MagicTable inferred as a dual-port ram, it needs buffered inputs
+					outPortMap(mTable, "Y2", "expZ_output"+lane);
+					inPortMap(mTable, "X2", "Addr2"+lane);
+					outPortMap(mTable, "Y1", "expA_output"+lane);
+					inPortMap(mTable, "X1", "Addr1"+lane);
+					vhdl << instance(mTable, "table"+lane);
+					setSignalDelay("expZ_output"+lane,  target->RAMDelay() );
+					syncCycleFromSignal("expZ_output"+lane, getSignalDelay("expZ_output"+lane));
+
+					vhdl << tab << declare("expA"+lane, sizeExpA) << " <=  expA_output" << lane << range(sizeExpA+sizeExpZPart-1, sizeExpZPart) << ";" << endl;
+					setSignalDelay("expA"+lane, getSignalDelay("expZ_output"+lane)); // TODO should be done automatically by instance()
+
+					if(useMagicTableExpZm1){
+						vhdl << tab << declare("expZminus1"+lane, sizeExpZm1) << " <= expZ_output" << lane << range(sizeExpZPart-1, 0) << ";" << endl;
+					}
+					else { // useMagicTableexpZmZm1
+						vhdl << tab << declare("expZmZm1"+lane, sizeExpZmZm1) << " <= expZ_output" << lane << range(sizeExpZPart-1, 0) << ";" << endl;
+					}
+					// TODO: If we are here, the rest of the computation fits in one DSP block: we should pack it for it.
+				}
 
-		if(expYTabulated) {
-			ExpYTable* table;
-			table = new ExpYTable(target, sizeY, sizeExpY); // e^A-1 has MSB weight 1
-			addSubComponent(table);
-			outPortMap(table, "Y", "expY");
-			inPortMap(table, "X", "Y");
-			vhdl << instance(table, "table");
-
-			setSignalDelay("expY",  table->getOutputDelay("Y"));
-			syncCycleFromSignal("expY", getSignalDelay("expY"));
-			vhdl << "-- signal delay at BRAM output = "<<getSignalDelay("expY")<<endl;
-		}
 
-		else{
-			if(useMagicTableExpZmZm1 || useMagicTableExpZm1) { // use a dual table, works up to single precision			
-				//The following is really designed for k=9
-				if(k!=9){
-					REPORT(0, "k!=9, setting it to 9 to use the magic exp dual table")
-						k=9;	
+				else { // generic case, use a polynomial evaluator
+					// Addr1, Z and Zhigh have been built, and expA read from the (possibly shared) table, above
+					setCycleFromSignal("expA"+lane, getSignalDelay("expA"+lane));
+					vhdl << "-- signal delay at BRAM output = "<<getSignalDelay("expA"+lane)<<endl;
+					//cpexpA = getCriticalPath();
+					syncCycleFromSignal("Zhigh"+lane, cpZhigh );
+
+					if (l==0) {
+						REPORT(LIST, "Generating the polynomial approximation, this may take some time");
+						// We want the LSB value to be  2^(wF+g)
+						ostringstream function;
+						function << "1b"<<2*k-1<<"*(exp(x*1b-" << k << ")-x*1b-" << k << "-1)";  // e^z-z-1
+						fe = new FixFunctionByPiecewisePoly(target, function.str(),
+						                                    -sizeZhigh, // lsbIn,
+						                                    -1, // msbOut // was -2*k
+						                                    -wF-g+2*k-1, // lsbOut // was -wF-g
+						                                    d, // degree
+						                                    true, // finalRounding
+						                                    0.25, // approxErrorBudget, default
+						                                    0, // scheme: Horner
+						                                    0, // mergedSteps: none
+						                                    inDelayMap("X", target->localWireDelay() + getCriticalPath()) );
+						addSubComponent(fe);
+					}
+					inPortMap(fe, "X", "Zhigh"+lane);
+					outPortMap(fe, "Y", "expZmZm1"+lane);
+					vhdl << instance(fe, "poly"+lane);
+					syncCycleFromSignal("expZmZm1"+lane, fe->getOutputDelay("Y") );
+
+				}// end if magic table/generic
+
+				// Do we need the adder that adds back Z to e^Z-Zm1?
+				if(!useMagicTableExpZm1) {
+					// here we have in expZmZm1 e^Z-Z-1
+					// Alignment of expZmZm10:  MSB has weight -2*k, LSB has weight -(wF+g).
+					//		vhdl << tab << declare("ShouldBeZero2", (sizeExpY-
+					//		sizeExpZmZm1)) << " <= expZmZm1_0" << range(sizeExpY-1,
+					//		sizeExpZmZm1)  << "; -- for debug to check it is always
+					//		0" <<endl;
+
+					vhdl << tab << "-- Computing Z + (exp(Z)-1-Z)" << endl;
+
+					if (l==0) {
+						addexpZminus1 = new IntAdder( target, sizeExpZm1, inDelayMap( "X", target->localWireDelay() + getCriticalPath() ) );
+						addSubComponent(addexpZminus1);
+					}
+
+					vhdl << tab << declare( "expZminus1X"+lane, sizeExpZm1) <<
+							" <= '0' & Z" << lane << ";"<<endl;
+
+					vhdl << tab << declare( "expZminus1Y"+lane, sizeExpZm1) << " <= " <<
+							rangeAssign(sizeZ, sizeZ-k+1, "'0'") <<
+							" & expZmZm1" << lane << " ;" << endl;
+
+					inPortMap(addexpZminus1, "X", "expZminus1X"+lane);
+					inPortMap(addexpZminus1, "Y", "expZminus1Y"+lane);
+					inPortMapCst( addexpZminus1, "Cin" , " '0' ");
+					outPortMap( addexpZminus1, "R", "expZminus1"+lane);
+					vhdl << instance( addexpZminus1, "Adder_expZminus1"+lane);
+					syncCycleFromSignal("expZminus1"+lane, addexpZminus1->getOutputDelay("R") );
+				} // now we have in expZminus1 e^Z-1
+
+				setCycleFromSignal("expA"+lane, getSignalDelay("expA"+lane));
+
+				// Now, if we want g=3 (needed for the magic table to fit a BRAM for single prec)
+				// we need to keep max error below 4 ulp.
+				// Every half-ulp counts, in particular we need to round expA instead of truncating it...
+				// The following "if" is because I have tried several alternatives to get rid of this addition.
+				if(useMagicTableExpZm1 || useMagicTableExpZmZm1) {
+					vhdl << tab << "-- Rounding expA to the same accuracy as expZminus1" << endl;
+					vhdl << tab << "--   (truncation would not be accurate enough and require one more guard bit)" << endl;
+					if (l==0) {
+						expArounded0 = new IntAdder( target, sizeMultIn+1, inDelayMap( "X", target->RAMToLogicWireDelay() + getCriticalPath()) );
+						addSubComponent(expArounded0);
+					}
+
+					inPortMapCst(expArounded0, "X", "expA"+lane+range(sizeExpA-1, sizeExpA-sizeMultIn-1));
+					inPortMapCst(expArounded0, "Y", zg(sizeMultIn+1,0));
+					inPortMapCst( expArounded0, "Cin" , " '1' ");
+					outPortMap( expArounded0, "R", "expArounded0"+lane);
+					vhdl << instance( expArounded0, "Adder_expArounded0"+lane);
+					syncCycleFromSignal("expArounded0"+lane, expArounded0->getOutputDelay("R") );
+
+					vhdl << tab << declare("expArounded"+lane, sizeMultIn) << " <= expArounded0" << lane << range(sizeMultIn, 1) << ";" << endl;
 				}
-				vhdl << tab << declare("Addr1", k) << " <= Y" << range(sizeY-1, sizeY-k) << ";\n";
-				vhdl << tab << declare("Z", sizeZ) << " <= Y" << range(sizeZ-1, 0) << ";\n";
-				
-				int sizeExpZPart;
-				if(useMagicTableExpZmZm1){
-					vhdl << tab << declare("Addr2", k) << " <= Z" << range(sizeZ-1, sizeZ-k) << ";\n";
-					sizeExpZPart=sizeExpZmZm1;
+				else{ // if  generic we have a faithful expZmZm1, not a CR one: we need g=4, so anyway we do not need to worry
+					vhdl << tab << "-- Truncating expA to the same accuracy as expZminus1" << endl;
+					vhdl << tab << declare("expArounded"+lane, sizeMultIn) << " <= expA" << lane << range(sizeExpA-1, sizeExpA-sizeMultIn) << ";" << endl;
 				}
-				else {// useMagicTableExpZm1
-					vhdl << tab << declare("Addr2", k) << " <= Z";
-					// possibly pad right with zeroes; If we are here, sizeZ<=k
-					if(sizeZ<k)
-						vhdl << " & " << rangeAssign(k-sizeZ-1,0, "'0'");
-					vhdl<< ";\n";
-					sizeExpZPart=sizeExpZm1;
+				if(useMagicTableExpZm1)
+					syncCycleFromSignal( "expZminus1"+lane);
+				else
+					syncCycleFromSignal( "expZminus1"+lane, addexpZminus1->getOutputDelay("R"));
+				nextCycle();
+
+				// using a truncated multiplier
+				int sizeProd;
+				sizeProd = sizeExpZm1+1;
+				if (l==0) {
+					lowProd = new IntMultiplier(target, sizeMultIn, sizeExpZm1,
+					                            sizeProd,  // truncated
+					                            false,  /*unsigned*/
+					                            inDelayMap("X", target->LogicToDSPWireDelay() + getCriticalPath() ) );
+					addSubComponent(lowProd);
 				}
 
-				magicTable* table = new magicTable(target, sizeExpA, sizeExpZPart, useMagicTableExpZmZm1);
-				addSubComponent(table);
-			
-				// TODO: delegate this cycle management to Table
-				/* Magic Table is an instance of DualTable which is, for now combinatorial */
-				//				nextCycle(); //However, to get the MagicTable inferred as a dual-port ram, it needs buffered inputs			
-				outPortMap(table, "Y2", "expZ_output");
-				inPortMap(table, "X2", "Addr2");
-				outPortMap(table, "Y1", "expA_output");
-				inPortMap(table, "X1", "Addr1");
-				vhdl << instance(table, "table");
-				setSignalDelay("expZ_output",  target->RAMDelay() );
-				syncCycleFromSignal("expZ_output", getSignalDelay("expZ_output"));
-			
-				vhdl << tab << declare("expA", sizeExpA) << " <=  expA_output" << range(sizeExpA+sizeExpZPart-1, sizeExpZPart) << ";" << endl;
-				setSignalDelay("expA", getSignalDelay("expZ_output")); // TODO should be done automatically by instance()
+				inPortMap(lowProd, "X", "expArounded"+lane);
+				inPortMap(lowProd, "Y", "expZminus1"+lane);
+				outPortMap(lowProd, "R", "lowerProduct"+lane);
 
-				if(useMagicTableExpZm1){
-					vhdl << tab << declare("expZminus1", sizeExpZm1) << " <= expZ_output" << range(sizeExpZPart-1, 0) << ";" << endl;
-				}
-				else { // useMagicTableexpZmZm1
-					vhdl << tab << declare("expZmZm1", sizeExpZmZm1) << " <= expZ_output" << range(sizeExpZPart-1, 0) << ";" << endl;
+				vhdl << instance(lowProd, "TheLowerProduct"+lane)<<endl;
+				syncCycleFromSignal("lowerProduct"+lane, lowProd->getOutputDelay("R") );
+				nextCycle(); // needed for the 1-DSP case TODO: fix in IntMultiplier instead
+				vhdl << tab << declare("extendedLowerProduct"+lane,sizeExpY) << " <= (" << rangeAssign(sizeExpY-1, sizeExpY-k+1, "'0'")
+				     << " & lowerProduct" << lane << range(sizeProd-1, 0) << ");" << endl;
+
+
+				vhdl << tab << "-- Final addition -- the product MSB bit weight is -k+2 = "<< -k+2 << endl;
+				// remember that sizeExpA==sizeExpY
+				if (l==0) {
+					finalAdder = new IntAdder(target, sizeExpY, inDelayMap( "X", target->localWireDelay() + getCriticalPath()));
+					addSubComponent(finalAdder);
 				}
-				// TODO: If we are here, the rest of the computation fits in one DSP block: we should pack it for it.
-			}
 
+				inPortMap(finalAdder, "X", "expA"+lane);
+				inPortMap(finalAdder, "Y", "extendedLowerProduct"+lane);
+				inPortMapCst(finalAdder, "Cin", "'0'");
+				outPortMap(finalAdder, "R", "expY"+lane);
 
-			else { // generic case, use a polynomial evaluator
-				vhdl << tab << declare("Addr1", k) << " <= Y" << range(sizeY-1, sizeY-k) << ";\n";
-				vhdl << tab << declare("Z", sizeZ) << " <= Y" << range(sizeZ-1, 0) << ";\n";
-				vhdl << tab << declare("Zhigh", sizeZhigh) << " <= Z" << range(sizeZ-1, sizeZ-sizeZhigh) << ";\n";
-				
-				double cpZhigh = getCriticalPath();
-				//			manageCriticalPath( target->LogicToRAMWireDelay() + target->RAMDelay() );
-				ExpYTable* table;
-				table = new ExpYTable(target, k, sizeExpA); // e^A-1 has MSB weight 1
-				addSubComponent(table);
-				outPortMap(table, "Y", "expA");
-				inPortMap(table, "X", "Addr1");
-				vhdl << instance(table, "table");
-				setSignalDelay("expA",  table->getOutputDelay("Y"));
-				syncCycleFromSignal("expA", getSignalDelay("expA"));
-				vhdl << "-- signal delay at BRAM output = "<<getSignalDelay("expA")<<endl;
-				//cpexpA = getCriticalPath();
-				syncCycleFromSignal("Zhigh", cpZhigh );
-				
-				REPORT(LIST, "Generating the polynomial approximation, this may take some time");
-				// We want the LSB value to be  2^(wF+g)
-				FixFunctionByPiecewisePoly *fe;
-				ostringstream function;
-				function << "1b"<<2*k-1<<"*(exp(x*1b-" << k << ")-x*1b-" << k << "-1)";  // e^z-z-1
-				fe = new FixFunctionByPiecewisePoly(target, function.str(), 
-																						-sizeZhigh, // lsbIn,
-																						-1, // msbOut // was -2*k
-																						-wF-g+2*k-1, // lsbOut // was -wF-g 
-																						d, // degree
-																						true, // finalRounding
-																						0.25, // approxErrorBudget, default
-																						inDelayMap("X", target->localWireDelay() + getCriticalPath()) );
-				addSubComponent(fe);
-				inPortMap(fe, "X", "Zhigh");
-				outPortMap(fe, "Y", "expZmZm1");
-				vhdl << instance(fe, "poly");
-				syncCycleFromSignal("expZmZm1", fe->getOutputDelay("Y") );
-
-			}// end if magic table/generic
-
-			// Do we need the adder that adds back Z to e^Z-Zm1? 
-			if(!useMagicTableExpZm1) {
-				// here we have in expZmZm1 e^Z-Z-1
-				// Alignment of expZmZm10:  MSB has weight -2*k, LSB has weight -(wF+g).
-				//		vhdl << tab << declare("ShouldBeZero2", (sizeExpY-
-				//		sizeExpZmZm1)) << " <= expZmZm1_0" << range(sizeExpY-1,
-				//		sizeExpZmZm1)  << "; -- for debug to check it is always
-				//		0" <<endl;
-				
-				vhdl << tab << "-- Computing Z + (exp(Z)-1-Z)" << endl;
+				vhdl << instance(finalAdder,"TheFinalAdder"+lane) << endl;
+				syncCycleFromSignal("expY"+lane, finalAdder->getOutputDelay("R") );
 
-				addexpZminus1 = new IntAdder( target, sizeExpZm1, inDelayMap( "X", target->localWireDelay() + getCriticalPath() ) );
-				addSubComponent(addexpZminus1);
-				
-				vhdl << tab << declare( "expZminus1X", sizeExpZm1) << 
-						" <= '0' & Z;"<<endl;
+			} // end if(expYTabulated)
 
-				vhdl << tab << declare( "expZminus1Y", sizeExpZm1) << " <= " <<
-						rangeAssign(sizeZ, sizeZ-k+1, "'0'") << 
-						" & expZmZm1 ;" << endl;
-				
-				inPortMap(addexpZminus1, "X", "expZminus1X");
-				inPortMap(addexpZminus1, "Y", "expZminus1Y");
-				inPortMapCst( addexpZminus1, "Cin" , " '0' ");
-				outPortMap( addexpZminus1, "R", "expZminus1");
-				vhdl << instance( addexpZminus1, "Adder_expZminus1");
-				syncCycleFromSignal("expZminus1", addexpZminus1->getOutputDelay("R") );
-			} // now we have in expZminus1 e^Z-1
-
-			setCycleFromSignal("expA", getSignalDelay("expA"));
-
-			// Now, if we want g=3 (needed for the magic table to fit a BRAM for single prec)
-			// we need to keep max error below 4 ulp.
-			// Every half-ulp counts, in particular we need to round expA instead of truncating it...
-			// The following "if" is because I have tried several alternatives to get rid of this addition.
-			if(useMagicTableExpZm1 || useMagicTableExpZmZm1) {
-				vhdl << tab << "-- Rounding expA to the same accuracy as expZminus1" << endl;
-				vhdl << tab << "--   (truncation would not be accurate enough and require one more guard bit)" << endl;
-				IntAdder* expArounded0 = new IntAdder( target, sizeMultIn+1, inDelayMap( "X", target->RAMToLogicWireDelay() + getCriticalPath()) );
-				addSubComponent(expArounded0);
-				
-				inPortMapCst(expArounded0, "X", "expA"+range(sizeExpA-1, sizeExpA-sizeMultIn-1));
-				inPortMapCst(expArounded0, "Y", zg(sizeMultIn+1,0));
-				inPortMapCst( expArounded0, "Cin" , " '1' ");
-				outPortMap( expArounded0, "R", "expArounded0");
-				vhdl << instance( expArounded0, "Adder_expArounded0");
-				syncCycleFromSignal("expArounded0", expArounded0->getOutputDelay("R") );
-		
-				vhdl << tab << declare("expArounded", sizeMultIn) << " <= expArounded0" << range(sizeMultIn, 1) << ";" << endl;
-			}
-			else{ // if  generic we have a faithful expZmZm1, not a CR one: we need g=4, so anyway we do not need to worry
-				vhdl << tab << "-- Truncating expA to the same accuracy as expZminus1" << endl;
-				vhdl << tab << declare("expArounded", sizeMultIn) << " <= expA" << range(sizeExpA-1, sizeExpA-sizeMultIn) << ";" << endl;
+
+			// The following is generic normalization/rounding code if we have in expY an approx of exp(y) of size 	sizeExpY
+			// with MSB of weight 2^1
+			// We start a cycle here
+	//		nextCycle();
+
+			vhdl << tab << declare("needNoNorm"+lane) << " <= expY" << lane << "(" << sizeExpY-1 << ");" << endl;
+			manageCriticalPath( target->localWireDelay(wE+wF+2) + target->lutDelay() );
+			vhdl << tab << "-- Rounding: all this should consume one row of LUTs" << endl;
+			vhdl << tab << declare("preRoundBiasSig"+lane, wE+wF+2)
+			     << " <= conv_std_logic_vector(" << bias << ", wE+2)  & expY" << lane << range(sizeExpY-2, sizeExpY-2-wF+1) << " when needNoNorm" << lane << " = '1'" << endl
+			     << tab << tab << "else conv_std_logic_vector(" << bias-1 << ", wE+2)  & expY" << lane << range(sizeExpY-3, sizeExpY-3-wF+1) << " ;" << endl;
+
+			vhdl << tab << declare("roundBit"+lane) << " <= expY" << lane << "(" << sizeExpY-2-wF << ")  when needNoNorm" << lane << " = '1'    else expY" << lane << "(" <<  sizeExpY-3-wF << ") ;" << endl;
+			vhdl << tab << declare("roundNormAddend"+lane, wE+wF+2) << " <= K" << lane << "(" << wE << ") & K" << lane << " & "<< rangeAssign(wF-1, 1, "'0'") << " & roundBit" << lane << ";" << endl;
+
+
+			if (l==0) {
+				roundedExpSigOperandAdder = new IntAdder(target, wE+wF+2, inDelayMap( "X", target->localWireDelay() + getCriticalPath()));
+				addSubComponent(roundedExpSigOperandAdder);
 			}
-			if(useMagicTableExpZm1)
-				syncCycleFromSignal( "expZminus1");
-			else
-				syncCycleFromSignal( "expZminus1", addexpZminus1->getOutputDelay("R"));
-			nextCycle();
-		
-#if 0 // full product, truncated
-			int sizeProd;
-			sizeProd = sizeMultIn + sizeExpZm1;
-			Operator* lowProd;
-			lowProd = new IntMultiplier(target, sizeMultIn, sizeExpZm1,  
-			                            0,  // untruncated
-			                            false,  /*unsigned*/
-			                            inDelayMap("X", target->LogicToDSPWireDelay() + getCriticalPath() ) );
-			addSubComponent(lowProd);
-			
-			inPortMap(lowProd, "X", "expArounded");
-			inPortMap(lowProd, "Y", "expZminus1");
-			outPortMap(lowProd, "R", "lowerProduct");
-			
-			vhdl << instance(lowProd, "TheLowerProduct")<<endl;
-			syncCycleFromSignal("lowerProduct", lowProd->getOutputDelay("R") );
-			nextCycle(); // needed for the 1-DSP case TODO: fix in IntMultiplier instead 
-			vhdl << tab << declare("extendedLowerProduct",sizeExpY) << " <= (" << rangeAssign(sizeExpY-1, sizeExpY-k+1, "'0'") 
-			     << " & lowerProduct" << range(sizeProd-1, sizeProd - (sizeExpY-k+1)) << ");" << endl;
-
-
-#else // using a truncated multiplier
-
-			int sizeProd;
-			sizeProd = sizeExpZm1+1;
-			Operator* lowProd;
-			lowProd = new IntMultiplier(target, sizeMultIn, sizeExpZm1,  
-			                            sizeProd,  // truncated
-			                            false,  /*unsigned*/
-			                            inDelayMap("X", target->LogicToDSPWireDelay() + getCriticalPath() ) );
-			addSubComponent(lowProd);
-			
-			inPortMap(lowProd, "X", "expArounded");
-			inPortMap(lowProd, "Y", "expZminus1");
-			outPortMap(lowProd, "R", "lowerProduct");
-			
-			vhdl << instance(lowProd, "TheLowerProduct")<<endl;
-			syncCycleFromSignal("lowerProduct", lowProd->getOutputDelay("R") );
-			nextCycle(); // needed for the 1-DSP case TODO: fix in IntMultiplier instead 
-			vhdl << tab << declare("extendedLowerProduct",sizeExpY) << " <= (" << rangeAssign(sizeExpY-1, sizeExpY-k+1, "'0'") 
-			     << " & lowerProduct" << range(sizeProd-1, 0) << ");" << endl;
 
-#endif
+			inPortMap(roundedExpSigOperandAdder, "X", "preRoundBiasSig"+lane);
+			inPortMap(roundedExpSigOperandAdder, "Y", "roundNormAddend"+lane);
+			inPortMapCst(roundedExpSigOperandAdder, "Cin", "'0'");
+			outPortMap(roundedExpSigOperandAdder, "R", "roundedExpSigRes"+lane);
 
+			vhdl << instance(roundedExpSigOperandAdder,"roundedExpSigOperandAdder"+lane) << endl;
+			syncCycleFromSignal("roundedExpSigRes"+lane, roundedExpSigOperandAdder->getOutputDelay("R") );
+			vhdl << tab << "-- delay at adder output is " << getCriticalPath() << endl;
 
-			vhdl << tab << "-- Final addition -- the product MSB bit weight is -k+2 = "<< -k+2 << endl;
-			// remember that sizeExpA==sizeExpY
-			IntAdder *finalAdder = new IntAdder(target, sizeExpY, inDelayMap( "X", target->localWireDelay() + getCriticalPath()));
-			addSubComponent(finalAdder);
-			
-			
-			inPortMap(finalAdder, "X", "expA");
-			inPortMap(finalAdder, "Y", "extendedLowerProduct");
-			inPortMapCst(finalAdder, "Cin", "'0'");
-			outPortMap(finalAdder, "R", "expY");
-		
-			vhdl << instance(finalAdder,"TheFinalAdder") << endl;
-			syncCycleFromSignal("expY", finalAdder->getOutputDelay("R") );
-			
-		} // end if(expYTabulated)
-				       
+			manageCriticalPath( target->localWireDelay() + target->lutDelay() );
+			vhdl << tab << declare("roundedExpSig"+lane, wE+wF+2) << " <= roundedExpSigRes" << lane << " when Xexn" << lane << "=\"01\" else "
+			     << " \"000\" & (wE-2 downto 0 => '1') & (wF-1 downto 0 => '0');" << endl;
 
-		// The following is generic normalization/rounding code if we have in expY an approx of exp(y) of size 	sizeExpY 
-		// with MSB of weight 2^1
-		// We start a cycle here
-//		nextCycle();
+			string rES = "roundedExpSig"+lane;
+			string Xexn = "Xexn"+lane;
+			string XSign = "XSign"+lane;
+			manageCriticalPath( target->localWireDelay() + target->lutDelay() );
+			vhdl << tab << declare("ofl1"+lane) << " <= not " << XSign << " and oufl0" << lane << " and (not " << Xexn << "(1) and " << Xexn << "(0)); -- input positive, normal,  very large" << endl;
+			vhdl << tab << declare("ofl2"+lane) << " <= not " << XSign << " and (" << rES << "(wE+wF) and not " << rES << "(wE+wF+1)) and (not " << Xexn << "(1) and " << Xexn << "(0)); -- input positive, normal, overflowed" << endl;
+			vhdl << tab << declare("ofl3"+lane) << " <= not " << XSign << " and " << Xexn << "(1) and not " << Xexn << "(0);  -- input was -infty" << endl;
+			vhdl << tab << declare("ofl"+lane) << " <= ofl1" << lane << " or ofl2" << lane << " or ofl3" << lane << ";" << endl;
 
-		vhdl << tab << declare("needNoNorm") << " <= expY(" << sizeExpY-1 << ");" << endl;
-		manageCriticalPath( target->localWireDelay(wE+wF+2) + target->lutDelay() );		
-		vhdl << tab << "-- Rounding: all this should consume one row of LUTs" << endl; 
-		vhdl << tab << declare("preRoundBiasSig", wE+wF+2)
-		     << " <= conv_std_logic_vector(" << bias << ", wE+2)  & expY" << range(sizeExpY-2, sizeExpY-2-wF+1) << " when needNoNorm = '1'" << endl
-		     << tab << tab << "else conv_std_logic_vector(" << bias-1 << ", wE+2)  & expY" << range(sizeExpY-3, sizeExpY-3-wF+1) << " ;" << endl;
+			vhdl << tab << declare("ufl1"+lane) << " <= (" << rES << "(wE+wF) and " << rES << "(wE+wF+1))  and (not " << Xexn << "(1) and " << Xexn << "(0)); -- input normal" << endl;
+			vhdl << tab << declare("ufl2"+lane) << " <= " << XSign << " and " << Xexn << "(1) and not " << Xexn << "(0);  -- input was -infty" << endl;
+			vhdl << tab << declare("ufl3"+lane) << " <= " << XSign << " and oufl0" << lane << "  and (not " << Xexn << "(1) and " << Xexn << "(0)); -- input negative, normal,  very large" << endl;
 
-		vhdl << tab << declare("roundBit") << " <= expY(" << sizeExpY-2-wF << ")  when needNoNorm = '1'    else expY(" <<  sizeExpY-3-wF << ") ;" << endl;
-		vhdl << tab << declare("roundNormAddend", wE+wF+2) << " <= K(" << wE << ") & K & "<< rangeAssign(wF-1, 1, "'0'") << " & roundBit;" << endl;
+			vhdl << tab << declare("ufl"+lane) << " <= ufl1" << lane << " or ufl2" << lane << " or ufl3" << lane << ";" << endl;
 
-		
-		IntAdder *roundedExpSigOperandAdder = new IntAdder(target, wE+wF+2, inDelayMap( "X", target->localWireDelay() + getCriticalPath()));
-		addSubComponent(roundedExpSigOperandAdder);
-		
-		inPortMap(roundedExpSigOperandAdder, "X", "preRoundBiasSig");
-		inPortMap(roundedExpSigOperandAdder, "Y", "roundNormAddend");
-		inPortMapCst(roundedExpSigOperandAdder, "Cin", "'0'");
-		outPortMap(roundedExpSigOperandAdder, "R", "roundedExpSigRes");
-		
-		vhdl << instance(roundedExpSigOperandAdder,"roundedExpSigOperandAdder") << endl;
-		syncCycleFromSignal("roundedExpSigRes", roundedExpSigOperandAdder->getOutputDelay("R") );
-		vhdl << tab << "-- delay at adder output is " << getCriticalPath() << endl;
+			vhdl << tab << declare("Rexn"+lane, 2) << " <= \"11\" when " << Xexn << " = \"11\"" << endl
+			     << tab << tab << "else \"10\" when ofl" << lane << "='1'" << endl
+			     << tab << tab << "else \"00\" when ufl" << lane << "='1'" << endl
+			     << tab << tab << "else \"01\";" << endl;
 
-		manageCriticalPath( target->localWireDelay() + target->lutDelay() );
-		vhdl << tab << declare("roundedExpSig", wE+wF+2) << " <= roundedExpSigRes when Xexn=\"01\" else "
-		     << " \"000\" & (wE-2 downto 0 => '1') & (wF-1 downto 0 => '0');" << endl;
-	
-		manageCriticalPath( target->localWireDelay() + target->lutDelay() );
-		vhdl << tab << declare("ofl1") << " <= not XSign and oufl0 and (not Xexn(1) and Xexn(0)); -- input positive, normal,  very large" << endl;
-		vhdl << tab << declare("ofl2") << " <= not XSign and (roundedExpSig(wE+wF) and not roundedExpSig(wE+wF+1)) and (not Xexn(1) and Xexn(0)); -- input positive, normal, overflowed" << endl;
-		vhdl << tab << declare("ofl3") << " <= not XSign and Xexn(1) and not Xexn(0);  -- input was -infty" << endl;
-		vhdl << tab << declare("ofl") << " <= ofl1 or ofl2 or ofl3;" << endl;
-
-		vhdl << tab << declare("ufl1") << " <= (roundedExpSig(wE+wF) and roundedExpSig(wE+wF+1))  and (not Xexn(1) and Xexn(0)); -- input normal" << endl;
-		vhdl << tab << declare("ufl2") << " <= XSign and Xexn(1) and not Xexn(0);  -- input was -infty" << endl;
-		vhdl << tab << declare("ufl3") << " <= XSign and oufl0  and (not Xexn(1) and Xexn(0)); -- input negative, normal,  very large" << endl;
-
-		vhdl << tab << declare("ufl") << " <= ufl1 or ufl2 or ufl3;" << endl;
-
-		vhdl << tab << declare("Rexn", 2) << " <= \"11\" when Xexn = \"11\"" << endl
-		     << tab << tab << "else \"10\" when ofl='1'" << endl
-		     << tab << tab << "else \"00\" when ufl='1'" << endl
-		     << tab << tab << "else \"01\";" << endl;
-		
-		vhdl << tab << "R <= Rexn & '0' & roundedExpSig" << range(wE+wF-1, 0) << ";" << endl;
-		outDelayMap["R"] = getCriticalPath();
+			vhdl << tab << R << " <= Rexn" << lane << " & '0' & " << rES << range(wE+wF-1, 0) << ";" << endl;
+			outDelayMap[R] = getCriticalPath();
+		} // end of the lane
 
-	}	
+	}
 
 	FPExp::~FPExp()
 	{
@@ -806,32 +881,41 @@ namespace flopoco{
 
 	void FPExp::emulate(TestCase * tc)
 	{
-		/* Get I/O values */
-		mpz_class svX = tc->getInputValue("X");
-
-		/* Compute correct value */
-		FPNumber fpx(wE, wF, svX);
-
-		mpfr_t x, ru,rd;
-		mpfr_init2(x,  1+wF);
-		mpfr_init2(ru, 1+wF);
-		mpfr_init2(rd, 1+wF); 
-		fpx.getMPFR(x);
-		mpfr_exp(rd, x, GMP_RNDD);
-		mpfr_exp(ru, x, GMP_RNDU);
-		FPNumber  fprd(wE, wF, rd);
-		FPNumber  fpru(wE, wF, ru);
-		mpz_class svRD = fprd.getSignalValue();
-		mpz_class svRU = fpru.getSignalValue();
-		tc->addExpectedOutput("R", svRD);
-		tc->addExpectedOutput("R", svRU);
-		mpfr_clears(x, ru, rd, NULL);
+		for (int l=0; l<lanes; l++) {
+			/* Get I/O values */
+			mpz_class svX = tc->getInputValue(lanes==1 ? "X" : join("X",l));
+
+			/* Compute correct value */
+			FPNumber fpx(wE, wF, svX);
+
+			mpfr_t x, ru,rd;
+			mpfr_init2(x,  1+wF);
+			mpfr_init2(ru, 1+wF);
+			mpfr_init2(rd, 1+wF); 
+			fpx.getMPFR(x);
+			mpfr_exp(rd, x, GMP_RNDD);
+			mpfr_exp(ru, x, GMP_RNDU);
+			FPNumber  fprd(wE, wF, rd);
+			FPNumber  fpru(wE, wF, ru);
+			mpz_class svRD = fprd.getSignalValue();
+			mpz_class svRU = fpru.getSignalValue();
+			tc->addExpectedOutput((lanes==1 ? "R" : join("R",l)), svRD);
+			tc->addExpectedOutput((lanes==1 ? "R" : join("R",l)), svRU);
+			mpfr_clears(x, ru, rd, NULL);
+		}
 	}
  
 
 
 	void FPExp::buildStandardTestCases(TestCaseList* tcl){
 		TestCase *tc;
+		// With several lanes, the standard inputs are sent to all of them
+		string X = (lanes==1 ? "X" : "X0");
+		auto emulateAllLanes = [&](TestCase* tc) {
+			for (int l=1; l<lanes; l++)
+				tc->addInput(join("X",l), tc->getInputValue("X0"));
+			emulate(tc);
+		};
 
 		mpfr_t x, y;
 		FPNumber *fx, *fy;
@@ -843,50 +927,50 @@ namespace flopoco{
 
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", log(2));
-		emulate(tc);
+		tc->addFPInput(X, log(2));
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", FPNumber::plusDirtyZero);
-		emulate(tc);
+		tc->addFPInput(X, FPNumber::plusDirtyZero);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", FPNumber::minusDirtyZero);
-		emulate(tc);
+		tc->addFPInput(X, FPNumber::minusDirtyZero);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", 1.0);
-		emulate(tc);
+		tc->addFPInput(X, 1.0);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", 2.0);
-		emulate(tc);
+		tc->addFPInput(X, 2.0);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", 1.5);
-		emulate(tc);
+		tc->addFPInput(X, 1.5);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", -1.0);
-		emulate(tc);
+		tc->addFPInput(X, -1.0);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", -2.0);
-		emulate(tc);
+		tc->addFPInput(X, -2.0);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
-		tc->addFPInput("X", -3.0);
-		emulate(tc);
+		tc->addFPInput(X, -3.0);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 
 		tc = new TestCase(this); 
@@ -900,8 +984,8 @@ namespace flopoco{
 		// d = mpfr_get_d(y, GMP_RNDN);
 		// cout << d << endl;
 		fy = new FPNumber(wE, wF, y); 
-		tc->addFPInput("X", fy);
-		emulate(tc);
+		tc->addFPInput(X, fy);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 		delete(fx); 
 
@@ -909,8 +993,8 @@ namespace flopoco{
 		tc->addComment("The first number whose exp is infinite");
 		mpfr_nextabove(y);
 		fy = new FPNumber(wE, wF, y); 
-		tc->addFPInput("X", fy);
-		emulate(tc);
+		tc->addFPInput(X, fy);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 		delete(fy);
 
@@ -930,8 +1014,8 @@ namespace flopoco{
 		// cout << d << endl;
 
 		fy = new FPNumber(wE, wF, y); 
-		tc->addFPInput("X", fy);
-		emulate(tc);
+		tc->addFPInput(X, fy);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 		delete(fx); 
 
@@ -939,8 +1023,8 @@ namespace flopoco{
 		tc->addComment("The first number whose exp flushes to zero");
 		mpfr_nextbelow(y);
 		fy = new FPNumber(wE, wF, y); 
-		tc->addFPInput("X", fy);
-		emulate(tc);
+		tc->addFPInput(X, fy);
+		emulateAllLanes(tc);
 		tcl->add(tc);
 		delete(fy);
 	
@@ -962,18 +1046,20 @@ namespace flopoco{
 		mpz_class normalExn = mpz_class(1)<<(wE+wF+1);
 		mpz_class bias = ((1<<(wE-1))-1);
 		/* Fill inputs */
-		if ((i & 7) == 0) { //fully random
-			x = getLargeRandom(wE+wF+3);
-		}
-		else
-			{
-				mpz_class e = (getLargeRandom(wE+wF) % (wE+wF+2) ) -wF-3; // Should be between -wF-3 and wE-2
-				//cout << e << endl;
-				e = bias + e;
-				mpz_class sign = getLargeRandom(1);
-				x  = getLargeRandom(wF) + (e << wF) + (sign<<(wE+wF)) + normalExn;
+		for (int l=0; l<lanes; l++) {
+			if ((i & 7) == 0) { //fully random
+				x = getLargeRandom(wE+wF+3);
 			}
-		tc->addInput("X", x);
+			else
+				{
+					mpz_class e = (getLargeRandom(wE+wF) % (wE+wF+2) ) -wF-3; // Should be between -wF-3 and wE-2
+					//cout << e << endl;
+					e = bias + e;
+					mpz_class sign = getLargeRandom(1);
+					x  = getLargeRandom(wF) + (e << wF) + (sign<<(wE+wF)) + normalExn;
+				}
+			tc->addInput((lanes==1 ? "X" : join("X",l)), x);
+		}
 		/* Get correct outputs */
 		emulate(tc);
 		return tc;
@@ -983,13 +1069,14 @@ namespace flopoco{
 
 
 	OperatorPtr FPExp::parseArguments(Target *target, vector<string> &args) {
-		int wE, wF, k, d, g;
+		int wE, wF, k, d, g, lanes;
 		UserInterface::parseStrictlyPositiveInt(args, "wE", &wE); 
 		UserInterface::parseStrictlyPositiveInt(args, "wF", &wF);
 		UserInterface::parsePositiveInt(args, "k", &k);
 		UserInterface::parsePositiveInt(args, "d", &d);
 		UserInterface::parseInt(args, "g", &g);
-		return new FPExp(target, wE, wF, k, d, g);
+		UserInterface::parseStrictlyPositiveInt(args, "lanes", &lanes);
+		return new FPExp(target, wE, wF, k, d, g, false, emptyDelayMap, lanes);
 	}
 
 	void FPExp::registerFactory(){
@@ -1001,8 +1088,9 @@ namespace flopoco{
                         wF(int): mantissa size in bits;  \
                         d(int)=0: degree of the polynomial; \
                         k(int)=0: input size to the range reduction table, should be between 5 and 15. 0 choses a sensible default.;\
-                        g(int)=-1: number of guard bits",
-											 "Parameter d and k control the DSP/RamBlock tradeoff. In both cases, a value of 0 choses a sensible default. Parameter g is mostly for internal use.<br> For all the details, see <a href=\"bib/flopoco.html#DinechinPasca2010-FPT\">this article</a>.",
+                        g(int)=-1: number of guard bits;\
+                        lanes(int)=1: number of exponentials computed at each cycle, on inputs X0, X1... and outputs R0, R1... when larger than 1",
+											 "Parameter d and k control the DSP/RamBlock tradeoff. In both cases, a value of 0 choses a sensible default. Parameter g is mostly for internal use.<br> With lanes>1, the datapath is replicated, but two lanes share each dual-port e^Y (or e^A) table. The single-precision magic table already uses both of its ports and is not shared.<br> For all the details, see <a href=\"bib/flopoco.html#DinechinPasca2010-FPT\">this article</a>.",
 											 FPExp::parseArguments
 											 ) ;
 		
@@ -48,6 +48,15 @@ namespace flopoco{
 		public:
 			ExpYTable(Target* target, int wIn, int wOut);
 			mpz_class function(int x);
+			/** The table content, shared with ExpYDualTable */
+			static mpz_class value(int x, int wIn, int wOut);
+		};
+
+		/** @brief The same table as ExpYTable, with two read ports so that two lanes may share it */
+		class ExpYDualTable: public DualTable {
+		public:
+			ExpYDualTable(Target* target, int wIn, int wOut);
+			mpz_class function(int x);
 		};
 
 		/** @brief The constructor with manual control of all options
@@ -61,6 +70,9 @@ namespace flopoco{
 		* @param fullInput boolean, if true input mantissa is of size wE+wF+1, 
 		*                  so that  input shift doesn't padd it with 0s (useful 
 		*                  for FPPow)
+		* @param lanes number of exponentials computed in parallel, on inputs X0, X1... 
+		*              and outputs R0, R1... when larger than 1. Two lanes share each
+		*              dual-port e^Y (or e^A) table
 		*/
 		FPExp(
 				Target* target, 
@@ -70,7 +82,8 @@ namespace flopoco{
 				int d,
 				int guardBits=-1,
 				bool fullInput=false,
-				map<string, double> inputDelays = emptyDelayMap
+				map<string, double> inputDelays = emptyDelayMap,
+				int lanes=1
 			);
 
 		~FPExp();
@@ -94,6 +107,7 @@ namespace flopoco{
 		int k;  /**< Size of the address bits for the first table  */
 		int d;  /**< Degree of the polynomial approximation */
 		int g;  /**< Number of guard bits */
+		int lanes; /**< Number of exponentials computed in parallel */
 	};
 }
 #endif
@@ -574,11 +574,13 @@ namespace flopoco{
 		                              << "     else not X(wE+wF-1);                -- MSB of exponent" << endl;
 		double cpY0 = getCriticalPath();
 
+		addEstimatedAdderCost(wF-pfinal+2);
 		manageCriticalPath( target->adderDelay(wF-pfinal+2) + target->lutDelay() );
 		vhdl << tab << declare("absZ0", wF-pfinal+2) << " <=   Y0(wF-pfinal+1 downto 0)          when (sR='0') else" << endl
 			  << "             ((wF-pfinal+1 downto 0 => '0') - Y0(wF-pfinal+1 downto 0));" << endl;
 		vhdl << tab << declare("E", wE) << " <= (X(wE+wF-1 downto wF)) - (\"0\" & (wE-2 downto 1 => '1') & (not FirstBit));" << endl;
 
+		addEstimatedAdderCost(wE);
 		manageCriticalPath( target->adderDelay(wE) + target->lutDelay() );
 		vhdl << tab << declare("absE", wE) << " <= ((wE-1 downto 0 => '0') - E)   when sR = '1' else E;" << endl;
 		vhdl << tab << declare("EeqZero") << " <= '1' when E=(wE-1 downto 0 => '0') else '0';" << endl;
@@ -597,6 +599,7 @@ namespace flopoco{
 		setCycleFromSignal("lzo");
 		setCriticalPath( lzoc->getOutputDelay("O") );
 
+		addEstimatedAdderCost(intlog2(wF)+1);
 		manageCriticalPath( target->localWireDelay() + target->adderDelay(intlog2(wF)+1) );
 		double cpshiftval = getCriticalPath();
 		vhdl << tab << declare("pfinal_s", intlog2(wF)) << " <= \"" << unsignedBinary(mpz_class(pfinal), intlog2(wF)) << "\";"<<endl;
@@ -1058,6 +1061,7 @@ namespace flopoco{
 		if(1 -(1<<(wE-1)) < -wF) {
 			vhdl << tab <<	"-- No underflow possible" <<  endl;
 			vhdl << tab << declare("ufl") << " <= '0';" << endl;
+			addEstimatedAdderCost(wE);
 			manageCriticalPath( target->adderDelay(wE) );
 			cpE_small = getCriticalPath();
 			vhdl << tab << declare("E_small", wE) << " <=  (\"0\" & (wE-2 downto 2 => '1') & E0_sub)  -  ";
@@ -1068,6 +1072,7 @@ namespace flopoco{
 		}
 		else{
 			vhdl << tab <<	"-- Underflow may happen" <<  endl;
+			addEstimatedAdderCost(wE);
 			manageCriticalPath( target->adderDelay(wE) );
 			cpE_small = getCriticalPath();
 			vhdl << tab << declare("E_small", wE+1) << " <=  (\"00\" & (wE-2 downto 2 => '1') & E0_sub)  -  (";
@@ -1092,6 +1097,7 @@ namespace flopoco{
 
 		int E_normalSize = getSignalByName("E_normal")->width();
 
+		addEstimatedAdderCost(wE);
 		manageCriticalPath(getTarget()->lutDelay() + getTarget()->adderDelay(wE));
 		double cpER = getCriticalPath();
 
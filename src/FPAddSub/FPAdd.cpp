@@ -7,15 +7,20 @@ namespace flopoco{
 
 		OperatorPtr FPAdd::parseArguments(Target *target, vector<string> &args) {
 		int wE, wF;
-		bool sub, dualPath;
+		bool sub, dualPath, ieee;
 		UserInterface::parseStrictlyPositiveInt(args, "wE", &wE); 
 		UserInterface::parseStrictlyPositiveInt(args, "wF", &wF);
 		UserInterface::parseBoolean(args, "sub", &sub);
 		UserInterface::parseBoolean(args, "dualPath", &dualPath);
+		UserInterface::parseBoolean(args, "ieee", &ieee);
+		int lza;
+		UserInterface::parseInt(args, "lza", &lza);
+		if(dualPath && ieee)
+			throw string("FPAdd: the ieee option is only available for the single-path adder");
 		if(dualPath)
-			return new FPAddDualPath(target, wE, wF, sub); 
+			return new FPAddDualPath(target, wE, wF, sub, lza); 
 		else
-			return new FPAddSinglePath(target, wE, wF, sub);
+			return new FPAddSinglePath(target, wE, wF, sub, emptyDelayMap, ieee, lza);
 	}
 
 	void FPAdd::registerFactory(){
@@ -26,7 +31,9 @@ namespace flopoco{
 											 "wE(int): exponent size in bits; \
                         wF(int): mantissa size in bits; \
                         sub(bool)=false: implement a floating-point subtractor instead of an adder;\
-                        dualPath(bool)=false: use a dual-path algorithm, more expensive but shorter latency;",
+                        dualPath(bool)=false: use a dual-path algorithm, more expensive but shorter latency;\
+                        ieee(bool)=false: IEEE-754 inputs and output, subnormals included, without separate conversion operators;\
+                        lza(int)=-1: 1 to predict the normalization shift with a leading zero anticipator, 0 to count leading zeroes after the significand subtraction, -1 to choose according to the target delays;",
 											 "Single-path is lower hardware, longer latency than dual-path.<br> The difference between single-path and dual-path is well explained in textbooks such as Ercegovac and Lang's <em>Digital Arithmetic</em>, or Muller et al's <em>Handbook of floating-point arithmetic.</em>",
 											 FPAdd::parseArguments
 											 ) ;
@@ -99,6 +99,7 @@ FPAdd3Input::FPAdd3Input(Target* target, int wE, int wF, map<string, double> inp
 		//det max exponent difference:
 		setCycleFromSignal("eX");
 		setCriticalPath(cpinput);
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
 		vhdl << tab << declare("dexy",wE+1) << " <= (\"0\" & eX) - (\"0\" & eY);"<<endl;
 		vhdl << tab << declare("deyz",wE+1) << " <= (\"0\" & eY) - (\"0\" & eZ);"<<endl;
@@ -147,6 +148,7 @@ FPAdd3Input::FPAdd3Input(Target* target, int wE, int wF, map<string, double> inp
 		vhdl << tab << declare("mux3out",wE+1) << " <= dezx when m3='0' else deyz;"<<endl;
 
 		//possible negative fix
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
 		vhdl << tab << declare("nmux1out", wE+1) << " <=  not(mux1out) + '1';" <<endl;
 		vhdl << tab << declare("nmux2out", wE+1) << " <=  not(mux2out) + '1';" <<endl;
@@ -358,6 +360,7 @@ FPAdd3Input::FPAdd3Input(Target* target, int wE, int wF, map<string, double> inp
 		vhdl << tab << declare("tnexp", wE + 1) << "<= roundedExpFrac" << range(wE+wF+1, wF+1)<<";"<<endl;
 		//update exponent
 
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
 		vhdl << tab << declare("upexp",wE+1) << "  <=  tnexp + biasedZeros;"<<endl;
 
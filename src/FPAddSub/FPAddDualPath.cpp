@@ -42,18 +42,27 @@ namespace flopoco{
 #define DEBUGVHDL 0
 
 
-	FPAddDualPath::FPAddDualPath(Target* target, int wE, int wF, bool sub) :
+	FPAddDualPath::FPAddDualPath(Target* target, int wE, int wF, bool sub, int lza) :
 		Operator(target), wE(wE), wF(wF),  sub(sub){
 
 		ostringstream name, synch, synch2;
 
 		srcFileName="FPAddDualPath";
 
+		// the close path subtraction is on wF+2 bits
+		if(lza==-1)
+			useLZA = LZA::isFaster(target, wF+2);
+		else
+			useLZA = (lza==1);
+		REPORT(DETAILED, "Close path normalization " << (useLZA ? "with" : "without") << " leading zero anticipation");
+
 		if(sub)
 			name<<"FPSub_";
 		else
 			name<<"FPAdd_";
 		name<<wE<<"_"<<wF;
+		if(useLZA)
+			name<<"_LZA";
 		setNameWithFreq(name.str());
 
 		setCopyrightString("Bogdan Pasca, Florent de Dinechin (2008)");
@@ -109,6 +118,7 @@ namespace flopoco{
 		// determine if the fractional part of Y was shifted out of the operation //
 		vhdl<<tab<<declare("shiftedOut") << " <= ";
 		if (wE>sizeRightShift){
+			addEstimatedAdderCost(wE-sizeRightShift);
 			manageCriticalPath(target->adderDelay(wE-sizeRightShift));
 			for (int i=wE-1;i>=sizeRightShift;i--)
 				if (i==sizeRightShift)
@@ -169,6 +179,19 @@ namespace flopoco{
 		vhdl<<tab<<declare("fracYClose1",wF+3) << " <=  \"01\" & newY("<<wF-1<<" downto "<<0<<") & '0' when '0',"<<endl;
 		vhdl<<tab<<"               \"001\" & newY("<<wF-1<<" downto "<<0<<")       when others;"<<endl;
 
+		if(useLZA) {
+			// predict the normalization shift in parallel with the subtraction. The sign bits are both zero
+			REPORT(DETAILED, "Building close path leading zero anticipator");
+			vhdl<<tab<<declare("lzaXClose",wF+2) << " <= fracXClose1("<<wF+1<<" downto 0);"<<endl;
+			vhdl<<tab<<declare("lzaYClose",wF+2) << " <= fracYClose1("<<wF+1<<" downto 0);"<<endl;
+			lzaClose = new LZA(target, wF+2);
+			addSubComponent(lzaClose);
+			inPortMap  (lzaClose, "A", "lzaXClose");
+			inPortMap  (lzaClose, "B", "lzaYClose");
+			outPortMap (lzaClose, "O", "lzaCount");
+			vhdl << instance(lzaClose, "LZA_component");
+		}
+
 		// substract the fraction signals for the close path;
 
 		// instanciate the box that computes X-Y and Y-X. Note that it could take its inputs before the swap (TODO ?)
@@ -200,17 +223,39 @@ namespace flopoco{
 		vhdl<< tab << "          newX("<<wE+wF<<") xor (selectClosePath and "
 			 << "fracSignClose);"<<endl;
 
-		// LZC + Shifting. The number of leading zeros are returned together with the shifted input
-		REPORT(DETAILED, "Building close path LZC + shifter");
-		lzocs = new LZOCShifterSticky(target, wF+2, wF+2, intlog2(wF+2), false, 0);
+		int wCount = intlog2(wF+2);
+		if(useLZA) {
+			syncCycleFromSignal("lzaCount");
+			REPORT(DETAILED, "Building close path normalization shifter");
+			normShifter = new Shifter(target, wF+2, wF+2, Shifter::Left);
+			normShifter->changeName(getName()+"_NormShifter");
+			addSubComponent(normShifter);
+
+			inPortMap  (normShifter, "X", "fracRClose1");
+			inPortMap  (normShifter, "S", "lzaCount");
+			outPortMap (normShifter, "R","lzaShiftedFrac");
+			vhdl << instance(normShifter, "NormShifter");
+			syncCycleFromSignal("lzaShiftedFrac");
+
+			// the anticipated count may be one too small: then shift one more position
+			vhdl<<tab<< declare("lzaCorrection") << " <= not lzaShiftedFrac("<<wF+1<<");"<<endl;
+			vhdl<<tab<< declare("shiftedFrac",wF+2) << " <= lzaShiftedFrac("<<wF+1<<" downto 0) when lzaCorrection='0'"
+					<< " else lzaShiftedFrac("<<wF<<" downto 0) & '0';"<<endl;
+			vhdl<<tab<< declare("nZerosNew",wCount) << " <= lzaCount + lzaCorrection;"<<endl;
+		}
+		else {
+			// LZC + Shifting. The number of leading zeros are returned together with the shifted input
+			REPORT(DETAILED, "Building close path LZC + shifter");
+			lzocs = new LZOCShifterSticky(target, wF+2, wF+2, wCount, false, 0);
 
-		lzocs->changeName(getName()+"_LZCShifter");
-		addSubComponent(lzocs);
+			lzocs->changeName(getName()+"_LZCShifter");
+			addSubComponent(lzocs);
 
-		inPortMap  (lzocs, "I", "fracRClose1");
-		outPortMap (lzocs, "Count","nZerosNew");
-		outPortMap (lzocs, "O","shiftedFrac");
-		vhdl << instance(lzocs, "LZC_component");
+			inPortMap  (lzocs, "I", "fracRClose1");
+			outPortMap (lzocs, "Count","nZerosNew");
+			outPortMap (lzocs, "O","shiftedFrac");
+			vhdl << instance(lzocs, "LZC_component");
+		}
 
 		syncCycleFromSignal("shiftedFrac");/////////////////////////////////////////////////////////////////
 		// register the output
@@ -223,17 +268,20 @@ namespace flopoco{
 		// the rounding bit is computed:
 		vhdl<<tab<< declare("roundClose0") << " <= shiftedFrac(0) and shiftedFrac(1);"<<endl;
 		// Is the result zero?
-		vhdl<<tab<< declare("resultCloseIsZero0") << " <= '1' when nZerosNew"
-				<< " = CONV_STD_LOGIC_VECTOR(" << (1<< lzocs->getCountWidth())-1 // Should be wF+2 but this is a bug of LZOCShifterSticky: for all zeroes it returns this value
-				<< ", " << lzocs->getCountWidth()
-			 << ") else '0';" << endl;
+		if(useLZA) // the corrected count is meaningless for a zero result
+			vhdl<<tab<< declare("resultCloseIsZero0") << " <= '1' when fracRClose1 = ("<<wF+1<<" downto 0 => '0') else '0';" << endl;
+		else
+			vhdl<<tab<< declare("resultCloseIsZero0") << " <= '1' when nZerosNew"
+					<< " = CONV_STD_LOGIC_VECTOR(" << (1<< lzocs->getCountWidth())-1 // Should be wF+2 but this is a bug of LZOCShifterSticky: for all zeroes it returns this value
+					<< ", " << lzocs->getCountWidth()
+				 << ") else '0';" << endl;
 
 		// add two bits in order to absorb exceptions:
 		// the second 0 will become a 1 in case of overflow,
 		// the first 0 will become a 1 in case of underflow (negative biased exponent)
 		vhdl<<tab<< declare("exponentResultClose",wE+2) << " <= (\"00\" & "
 			 << "newX("<<wE+wF-1<<" downto "<<wF<<")) "
-			 <<"- (CONV_STD_LOGIC_VECTOR(0,"<<wE-lzocs->getCountWidth()+2<<") & nZerosNew);"
+			 <<"- (CONV_STD_LOGIC_VECTOR(0,"<<wE-wCount+2<<") & nZerosNew);"
 			 <<endl;
 
 
@@ -616,7 +664,9 @@ namespace flopoco{
 		UserInterface::parseStrictlyPositiveInt(args, "wE", &wE);
 		int wF;
 		UserInterface::parseStrictlyPositiveInt(args, "wF", &wF);
-		return new FPAddDualPath(target, wE, wF);
+		int lza;
+		UserInterface::parseInt(args, "lza", &lza);
+		return new FPAddDualPath(target, wE, wF, false, lza);
 	}
 
 	void FPAddDualPath::registerFactory(){
@@ -625,7 +675,8 @@ namespace flopoco{
 											 "BasicFloatingPoint", // categories
 											 "",
 											 "wE(int): exponent size in bits; \
-wF(int): mantissa size in bits;",
+wF(int): mantissa size in bits; \
+lza(int)=-1: 1 for a leading zero anticipator in the close path, 0 for a leading zero counter after the subtraction, -1 to choose according to the target delays;",
 											 "",
 											 FPAddDualPath::parseArguments
 											 ) ;
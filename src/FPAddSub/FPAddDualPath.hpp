@@ -10,6 +10,7 @@
 #include "../ShiftersEtc/LZOC.hpp"
 #include "../ShiftersEtc/Shifters.hpp"
 #include "../ShiftersEtc/LZOCShifterSticky.hpp"
+#include "../ShiftersEtc/LZA.hpp"
 #include "../TestBenches/FPNumber.hpp"
 #include "../IntAddSubCmp/IntAdder.hpp"
 #include "../IntAddSubCmp/IntDualSub.hpp"
@@ -25,8 +26,9 @@ namespace flopoco{
 		 * @param[in]		target		the target device
 		 * @param[in]		wE			the the with of the exponent for the f-p number X
 		 * @param[in]		wF			the the with of the fraction for the f-p number X
+		 * @param[in]		lza			1 to predict the close path normalization with a leading zero anticipator, 0 to count the leading zeroes after the subtraction, -1 to choose according to the target
 		 */
-		FPAddDualPath(Target* target, int wE, int wF, bool sub=false);
+		FPAddDualPath(Target* target, int wE, int wF, bool sub=false, int lza=-1);
 
 		/**
 		 * FPAddDualPath destructor
@@ -52,8 +54,14 @@ namespace flopoco{
 		int wF;
 		/** do you want an adder or a subtractor? */
 		bool sub;
+		/** use a leading zero anticipator in the close path? */
+		bool useLZA;
 		/** The combined leading zero counter and shifter for the close path */
 		LZOCShifterSticky* lzocs;
+		/** The leading zero anticipator for the close path, if useLZA */
+		LZA* lzaClose;
+		/** The normalization shifter for the close path, if useLZA */
+		Shifter* normShifter;
 		/** The integer adder object for subtraction in the close path */
 		IntAdder *fracSubClose;
 		/** The dual subtractor for the close path */
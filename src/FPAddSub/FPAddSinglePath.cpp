@@ -40,18 +40,34 @@ namespace flopoco{
 
 	FPAddSinglePath::FPAddSinglePath(Target* target,
 																	 int wE, int wF,
-																	 bool sub, map<string, double> inputDelays) :
-		Operator(target), wE(wE), wF(wF), sub(sub) {
+																	 bool sub, map<string, double> inputDelays, bool ieeeIO, int lza) :
+		Operator(target), wE(wE), wF(wF), sub(sub), ieeeIO(ieeeIO) {
 
 		srcFileName="FPAddSinglePath";
 
+		// The IEEE mode limits the normalization shift to the exponent, which requires an exact count
+		if(ieeeIO && lza==1)
+			THROWERROR("leading zero anticipation is not available in IEEE mode");
+		if(ieeeIO)
+			useLZA = false;
+		else if(lza==-1)
+			useLZA = LZA::isFaster(target, wF+5);
+		else
+			useLZA = (lza==1);
+		REPORT(DETAILED, "Normalization " << (useLZA ? "with" : "without") << " leading zero anticipation");
+
 		ostringstream name;
 		if(sub)
 			name<<"FPSub_";
 		else
 			name<<"FPAdd_";
 
-		name <<wE<<"_"<<wF<<"_uid"<<getNewUId();
+		name <<wE<<"_"<<wF;
+		if(ieeeIO)
+			name<<"_IEEE";
+		if(useLZA)
+			name<<"_LZA";
+		name <<"_uid"<<getNewUId();
 		setName(name.str());
 
 		setCopyrightString("Bogdan Pasca, Florent de Dinechin (2010)");
@@ -61,32 +77,74 @@ namespace flopoco{
 		/* Set up the IO signals */
 		/* Inputs: 2b(Exception) + 1b(Sign) + wE bits (Exponent) + wF bits(Fraction) */
 		// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-		addFPInput ("X", wE, wF);
-		addFPInput ("Y", wE, wF);
-		addFPOutput("R", wE, wF);
+		/* or in IEEE format: 1b(Sign) + wE bits (Exponent) + wF bits(Fraction) */
+		// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+		string X="X", Y="Y";
+		if(ieeeIO) {
+			addIEEEInput ("X", wE, wF);
+			addIEEEInput ("Y", wE, wF);
+			addIEEEOutput("R", wE, wF);
+
+			/* A subnormal is aligned as a number of exponent field 1 without implicit bit:
+				 it enters the alignment shifter as is, without the normalization of InputIEEE.
+				 The exception bits are rebuilt so that the rest of the datapath is unchanged,
+				 but the exponent field is kept so that the swap comparison remains correct. */
+			vhdl<<"-- IEEE input decoding --"<<endl;
+			setCriticalPath(getMaxInputDelays(inputDelays));
+			manageCriticalPath(target->localWireDelay() + target->eqConstComparatorDelay(wE));
+			for (string V : {"X", "Y"}) {
+				vhdl << tab << declare("expField"+V,wE) << " <= " << V << range(wE+wF-1, wF) << ";"<<endl;
+				vhdl << tab << declare("expZero"+V) << " <= '1' when expField" << V << "=" << zg(wE,0) << " else '0';"<<endl;
+				vhdl << tab << declare("expMax"+V) << " <= '1' when expField" << V << "=" << og(wE,0) << " else '0';"<<endl;
+				vhdl << tab << declare("fracZero"+V) << " <= '1' when " << V << range(wF-1, 0) << "=" << zg(wF,0) << " else '0';"<<endl;
+			}
+			manageCriticalPath(target->localWireDelay() + target->lutDelay());
+			for (string V : {"X", "Y"}) {
+				vhdl << tab << declare("exn"+V,2) << " <= \"00\" when expZero" << V << "='1' and fracZero" << V << "='1' else" << endl
+						 << tab << tab << "\"10\" when expMax" << V << "='1' and fracZero" << V << "='1' else" << endl
+						 << tab << tab << "\"11\" when expMax" << V << "='1' else" << endl
+						 << tab << tab << "\"01\";" << endl;
+				vhdl << tab << declare("fp"+V,wE+wF+3) << " <= exn" << V << " & " << V << range(wE+wF, 0) << ";"<<endl;
+				vhdl << tab << declare("expAdj"+V,wE) << " <= expField" << V << range(wE-1, 1) << " & (expField" << V << of(0) << " or expZero" << V << ");"<<endl;
+			}
+			X="fpX";
+			Y="fpY";
+		}
+		else {
+			addFPInput ("X", wE, wF);
+			addFPInput ("Y", wE, wF);
+			addFPOutput("R", wE, wF);
+		}
 
 		//=========================================================================|
 		//                          Swap/Difference                                |
 		// ========================================================================|
 		vhdl<<"-- Exponent difference and swap  --"<<endl;
 
-		vhdl << tab << declare("excExpFracX",2+wE+wF) << " <= X"<<range(wE+wF+2, wE+wF+1) << " & X"<<range(wE+wF-1, 0)<<";"<<endl;
-		vhdl << tab << declare("excExpFracY",2+wE+wF) << " <= Y"<<range(wE+wF+2, wE+wF+1) << " & Y"<<range(wE+wF-1, 0)<<";"<<endl;
+		vhdl << tab << declare("excExpFracX",2+wE+wF) << " <= " << X << range(wE+wF+2, wE+wF+1) << " & " << X << range(wE+wF-1, 0)<<";"<<endl;
+		vhdl << tab << declare("excExpFracY",2+wE+wF) << " <= " << Y << range(wE+wF+2, wE+wF+1) << " & " << Y << range(wE+wF-1, 0)<<";"<<endl;
 
 		/*		setCriticalPath(getMaxInputDelays(inputDelays));
 					manageCriticalPath(target->localWireDelay() + target->eqComparatorDelay(wE+wF+2));
 					vhdl<< tab << declare("eqdiffsign") << " <= '1' when excExpFracX = excExpFracY else '0';"<<endl; */
 
-		setCriticalPath(getMaxInputDelays(inputDelays));
+		// in IEEE mode, the exponent difference is that of the exponents seen by the alignment
+		string expOpX = (ieeeIO ? "expAdjX" : "X"+range(wE+wF-1,wF));
+		string expOpY = (ieeeIO ? "expAdjY" : "Y"+range(wE+wF-1,wF));
+		if(!ieeeIO)
+			setCriticalPath(getMaxInputDelays(inputDelays));
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
-		vhdl<< tab << declare("eXmeY",wE+1) << " <= (\"0\" & X"<<range(wE+wF-1,wF)<<") - (\"0\" & Y"<<range(wE+wF-1,wF)<<");"<<endl;
-		vhdl<< tab << declare("eYmeX",wE+1) << " <= (\"0\" & Y"<<range(wE+wF-1,wF)<<") - (\"0\" & X"<<range(wE+wF-1,wF)<<");"<<endl;
+		vhdl<< tab << declare("eXmeY",wE+1) << " <= (\"0\" & "<<expOpX<<") - (\"0\" & "<<expOpY<<");"<<endl;
+		vhdl<< tab << declare("eYmeX",wE+1) << " <= (\"0\" & "<<expOpY<<") - (\"0\" & "<<expOpX<<");"<<endl;
 		double cpeXmeY = getCriticalPath();
 
 
-		setCriticalPath(getMaxInputDelays(inputDelays));
+		if(!ieeeIO)
+			setCriticalPath(getMaxInputDelays(inputDelays));
 
 		if (wF < 30){
+			addEstimatedAdderCost(wE);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE)); //comparator delay implemented for now as adder
 			vhdl<< tab << declare("swap")       << " <= '0' when excExpFracX >= excExpFracY else '1';"<<endl;
 		}else{
@@ -111,18 +169,25 @@ namespace flopoco{
 
 		manageCriticalPath(target->localWireDelay() + target->lutDelay());
 
-		string pmY="Y";
+		string pmY=Y;
 		if ( sub ) {
-			vhdl << tab << declare("mY",wE+wF+3)   << " <= Y" << range(wE+wF+2,wE+wF+1) << " & not(Y"<<of(wE+wF)<<") & Y" << range(wE+wF-1,0) << ";"<<endl;
+			vhdl << tab << declare("mY",wE+wF+3)   << " <= " << Y << range(wE+wF+2,wE+wF+1) << " & not(" << Y << of(wE+wF)<<") & " << Y << range(wE+wF-1,0) << ";"<<endl;
 			pmY = "mY";
 		}
 
 		// depending on the value of swap, assign the corresponding values to the newX and newY signals
 
-		vhdl<<tab<<declare("newX",wE+wF+3) << " <= X when swap = '0' else "<< pmY << ";"<<endl;
-		vhdl<<tab<<declare("newY",wE+wF+3) << " <= " << pmY <<" when swap = '0' else X;"<<endl;
+		vhdl<<tab<<declare("newX",wE+wF+3) << " <= " << X << " when swap = '0' else "<< pmY << ";"<<endl;
+		vhdl<<tab<<declare("newY",wE+wF+3) << " <= " << pmY <<" when swap = '0' else " << X << ";"<<endl;
 		//break down the signals
-		vhdl << tab << declare("expX",wE) << "<= newX"<<range(wE+wF-1,wF)<<";"<<endl;
+		if(ieeeIO) {
+			// exponent field 0 (zero or subnormal): the implicit bit is 0 and the exponent is 1
+			vhdl << tab << declare("expXZero") << " <= '1' when newX"<<range(wE+wF-1,wF)<<"="<<zg(wE,0)<<" else '0';"<<endl;
+			vhdl << tab << declare("expYZero") << " <= '1' when newY"<<range(wE+wF-1,wF)<<"="<<zg(wE,0)<<" else '0';"<<endl;
+			vhdl << tab << declare("expX",wE) << "<= newX"<<range(wE+wF-1,wF+1)<<" & (newX"<<of(wF)<<" or expXZero);"<<endl;
+		}
+		else
+			vhdl << tab << declare("expX",wE) << "<= newX"<<range(wE+wF-1,wF)<<";"<<endl;
 		vhdl << tab << declare("excX",2)  << "<= newX"<<range(wE+wF+2,wE+wF+1)<<";"<<endl;
 		vhdl << tab << declare("excY",2)  << "<= newY"<<range(wE+wF+2,wE+wF+1)<<";"<<endl;
 		vhdl << tab << declare("signX")   << "<= newX"<<of(wE+wF)<<";"<<endl;
@@ -131,7 +196,10 @@ namespace flopoco{
 		vhdl << tab << declare("sXsYExnXY",6) << " <= signX & signY & excX & excY;"<<endl;
 		vhdl << tab << declare("sdExnXY",4) << " <= excX & excY;"<<endl;
 		manageCriticalPath(target->localWireDelay()+ target->lutDelay());
-		vhdl << tab << declare("fracY",wF+1) << " <= "<< zg(wF+1)<<" when excY=\"00\" else ('1' & newY("<<wF-1<<" downto 0));"<<endl;
+		if(ieeeIO) // a zero has a null fraction
+			vhdl << tab << declare("fracY",wF+1) << " <= (not expYZero) & newY("<<wF-1<<" downto 0);"<<endl;
+		else
+			vhdl << tab << declare("fracY",wF+1) << " <= "<< zg(wF+1)<<" when excY=\"00\" else ('1' & newY("<<wF-1<<" downto 0));"<<endl;
 		double cpfracY = getCriticalPath();
 
 
@@ -212,7 +280,10 @@ namespace flopoco{
 		vhdl<<tab<< declare("EffSubVector", wF+4) << " <= ("<<wF+3<<" downto 0 => EffSub);"<<endl;
 		vhdl<<tab<< declare("fracYfarXorOp", wF+4) << " <= fracYfar xor EffSubVector;"<<endl;
 		//pad fraction of X [overflow][inplicit 1][fracX][guard bits]
-		vhdl<<tab<< declare("fracXfar", wF+4)      << " <= \"01\" & (newX("<<wF-1<<" downto 0)) & \"00\";"<<endl;
+		if(ieeeIO)
+			vhdl<<tab<< declare("fracXfar", wF+4)      << " <= '0' & (not expXZero) & (newX("<<wF-1<<" downto 0)) & \"00\";"<<endl;
+		else
+			vhdl<<tab<< declare("fracXfar", wF+4)      << " <= \"01\" & (newX("<<wF-1<<" downto 0)) & \"00\";"<<endl;
 
 		if (getCycleFromSignal("sticky")==getCycleFromSignal("fracXfar"))
 			setCriticalPath( max (cpsticky, getCriticalPath()) );
@@ -222,6 +293,20 @@ namespace flopoco{
 		manageCriticalPath(target->localWireDelay()+ target->lutDelay());
 		vhdl<<tab<< declare("cInAddFar")           << " <= EffSub and not sticky;"<< endl;//TODO understand why
 
+		if(useLZA) {
+			/* In a subtraction, fracGRS computed below is exactly (fracXfar & '0') - (fracYfar & sticky):
+				 its leading zero count is predicted from these two in parallel with the addition */
+			REPORT(DETAILED, "Building leading zero anticipator");
+			vhdl<<tab<< declare("lzaX", wF+5) << " <= fracXfar & '0';"<<endl;
+			vhdl<<tab<< declare("lzaY", wF+5) << " <= fracYfar & sticky;"<<endl;
+			lzaFrac = new LZA(target, wF+5, inDelayMap("A", getCriticalPath()));
+			addSubComponent(lzaFrac);
+			inPortMap  (lzaFrac, "A", "lzaX");
+			inPortMap  (lzaFrac, "B", "lzaY");
+			outPortMap (lzaFrac, "O", "lzaCount");
+			vhdl << instance(lzaFrac, "LZA_component");
+		}
+
 		//result is always positive.
 		fracAddFar = new IntAdder(target,wF+4, inDelayMap("X", getCriticalPath()));
 		addSubComponent(fracAddFar);
@@ -243,33 +328,117 @@ namespace flopoco{
 		//shift in place
 		vhdl << tab << declare("fracGRS",wF+5) << "<= fracAddResult & sticky; "<<endl;
 
-		//incremented exponent.
-		vhdl << tab << declare("extendedExpInc",wE+2) << "<= (\"00\" & expX) + '1';"<<endl;
-
-
-		lzocs = new LZOCShifterSticky(target, wF+5, wF+5, intlog2(wF+5), false, 0, inDelayMap("I",getCriticalPath()));
-		addSubComponent(lzocs);
-		inPortMap  (lzocs, "I", "fracGRS");
-		outPortMap (lzocs, "Count","nZerosNew");
-		outPortMap (lzocs, "O","shiftedFrac");
-		vhdl << instance(lzocs, "LZC_component");
-		syncCycleFromSignal("shiftedFrac");
-		setCriticalPath(lzocs->getOutputDelay("O"));
-		// 		double cpnZerosNew = getCriticalPath();
-		double cpshiftedFrac = getCriticalPath();
+		double cpshiftedFrac;
+		if(ieeeIO) {
+			/* The normalization shift is limited to expX, so that the exponent of the result is at least 1:
+				 this directly produces subnormal results, which are exact. 
+				 It requires to separate the leading zero count from the shift */
+			int wCount = intlog2(wF+5);
+			if(wCount > wE) // expX is too small to hold the shift value
+				THROWERROR("wE=" << wE << " is too small for wF=" << wF << " in IEEE mode");
+			lzc = new LZOC(target, wF+5, inDelayMap("I",getCriticalPath()));
+			addSubComponent(lzc);
+			inPortMap  (lzc, "I", "fracGRS");
+			inPortMapCst(lzc, "OZB", "'0'");
+			outPortMap (lzc, "O","nZerosNew");
+			vhdl << instance(lzc, "LZC_component");
+			syncCycleFromSignal("nZerosNew");
+			setCriticalPath(lzc->getOutputDelay("O"));
+
+			int wCmp = max(wE, wCount)+1;
+			addEstimatedAdderCost(wCmp);
+			manageCriticalPath(target->localWireDelay() + target->adderDelay(wCmp));
+			vhdl << tab << declare("subnormalR") << " <= '1' when (" << zg(wCmp-wCount,0) << " & nZerosNew) > (" << zg(wCmp-wE,0) << " & expX) else '0';"<<endl;
+			manageCriticalPath(target->localWireDelay() + target->lutDelay());
+			vhdl << tab << declare("normShiftVal", wCount) << " <= expX" << range(wCount-1,0) << " when subnormalR='1' else nZerosNew;"<<endl;
+
+			normShifter = new Shifter(target, wF+5, wF+5, Shifter::Left, inDelayMap("S",getCriticalPath()));
+			addSubComponent(normShifter);
+			inPortMap  (normShifter, "X", "fracGRS");
+			inPortMap  (normShifter, "S", "normShiftVal");
+			outPortMap (normShifter, "R","normShifted");
+			vhdl << instance(normShifter, "NormShifter");
+			syncCycleFromSignal("normShifted");
+			setCriticalPath(normShifter->getOutputDelay("R"));
+			vhdl << tab << declare("shiftedFrac",wF+5) << " <= normShifted" << range(wF+4,0) << ";"<<endl;
+			cpshiftedFrac = getCriticalPath();
+
+			/* a subnormal result has exponent field 0, and its exponent is 1 */
+			setCycleFromSignal("normShiftVal");
+			// two additions, as the increment and the subtraction of the other branches
+			addEstimatedAdderCost(wE+2);
+			addEstimatedAdderCost(wE+2);
+			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));
+			vhdl << tab << declare("updatedExp",wE+2) << " <= ((\"00\" & expX) + (not subnormalR)) - (" << zg(wE+2-wCount,0) <<" & normShiftVal);"<<endl;
+			vhdl << tab << declare("eqdiffsign")<< " <= '1' when fracGRS="<<zg(wF+5,0)<<" else '0';"<<endl;
+			if(syncCycleFromSignal("shiftedFrac"))
+				setCriticalPath(cpshiftedFrac);
+		}
+		else if(useLZA) {
+			int wCount = intlog2(wF+5);
+			//incremented exponent.
+			addEstimatedAdderCost(wE+2);
+			vhdl << tab << declare("extendedExpInc",wE+2) << "<= (\"00\" & expX) + '1';"<<endl;
+
+			// The sum of two normal significands has its leading one in one of the two leading positions
+			if(syncCycleFromSignal("lzaCount"))
+				setCriticalPath(lzaFrac->getOutputDelay("O"));
+			manageCriticalPath(target->localWireDelay() + target->lutDelay());
+			vhdl << tab << declare("lzaShiftVal", wCount) << " <= lzaCount when EffSub='1' else " << zg(wCount,0) << ";"<<endl;
+
+			normShifter = new Shifter(target, wF+5, wF+5, Shifter::Left, inDelayMap("S",getCriticalPath()));
+			addSubComponent(normShifter);
+			inPortMap  (normShifter, "X", "fracGRS");
+			inPortMap  (normShifter, "S", "lzaShiftVal");
+			outPortMap (normShifter, "R","lzaShiftedFrac");
+			vhdl << instance(normShifter, "NormShifter");
+			syncCycleFromSignal("lzaShiftedFrac");
+			setCriticalPath(normShifter->getOutputDelay("R"));
+
+			// the anticipated count may be one too small: then shift one more position
+			manageCriticalPath(target->localWireDelay() + target->lutDelay());
+			vhdl << tab << declare("lzaCorrection") << " <= not lzaShiftedFrac" << of(wF+4) << ";"<<endl;
+			vhdl << tab << declare("shiftedFrac",wF+5) << " <= lzaShiftedFrac" << range(wF+4,0) << " when lzaCorrection='0'"
+					 << " else lzaShiftedFrac" << range(wF+3,0) << " & '0';"<<endl;
+			cpshiftedFrac = getCriticalPath();
+
+			addEstimatedAdderCost(wCount);
+			addEstimatedAdderCost(wE+2);
+			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));
+			vhdl << tab << declare("nZerosNew", wCount) << " <= lzaShiftVal + lzaCorrection;"<<endl;
+			vhdl << tab << declare("updatedExp",wE+2) << " <= extendedExpInc - (" << zg(wE+2-wCount,0) <<" & nZerosNew);"<<endl;
+			// the corrected count is meaningless for a zero result
+			vhdl << tab << declare("eqdiffsign")<< " <= '1' when fracGRS="<<zg(wF+5,0)<<" else '0';"<<endl;
+		}
+		else {
+			//incremented exponent.
+			addEstimatedAdderCost(wE+2);
+			vhdl << tab << declare("extendedExpInc",wE+2) << "<= (\"00\" & expX) + '1';"<<endl;
 
+			lzocs = new LZOCShifterSticky(target, wF+5, wF+5, intlog2(wF+5), false, 0, inDelayMap("I",getCriticalPath()));
+			addSubComponent(lzocs);
+			inPortMap  (lzocs, "I", "fracGRS");
+			outPortMap (lzocs, "Count","nZerosNew");
+			outPortMap (lzocs, "O","shiftedFrac");
+			vhdl << instance(lzocs, "LZC_component");
+			syncCycleFromSignal("shiftedFrac");
+			setCriticalPath(lzocs->getOutputDelay("O"));
+			// 		double cpnZerosNew = getCriticalPath();
+			cpshiftedFrac = getCriticalPath();
 
 
 
-		//need to decide how much to add to the exponent
-		/*		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));*/
-		// 	vhdl << tab << declare("expPart",wE+2) << " <= (" << zg(wE+2-lzocs->getCountWidth(),0) <<" & nZerosNew) - 1;"<<endl;
-		//update exponent
 
-		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));
-		vhdl << tab << declare("updatedExp",wE+2) << " <= extendedExpInc - (" << zg(wE+2-lzocs->getCountWidth(),0) <<" & nZerosNew);"<<endl;
-		vhdl << tab << declare("eqdiffsign")<< " <= '1' when nZerosNew="<<og(lzocs->getCountWidth(),0)<<" else '0';"<<endl;
+			//need to decide how much to add to the exponent
+			/*		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));*/
+			// 	vhdl << tab << declare("expPart",wE+2) << " <= (" << zg(wE+2-lzocs->getCountWidth(),0) <<" & nZerosNew) - 1;"<<endl;
+			//update exponent
 
+			addEstimatedAdderCost(wE+2);
+			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+2));
+			vhdl << tab << declare("updatedExp",wE+2) << " <= extendedExpInc - (" << zg(wE+2-lzocs->getCountWidth(),0) <<" & nZerosNew);"<<endl;
+			vhdl << tab << declare("eqdiffsign")<< " <= '1' when nZerosNew="<<og(lzocs->getCountWidth(),0)<<" else '0';"<<endl;
+		}
 
 		//concatenate exponent with fraction to absorb the possible carry out
 		vhdl<<tab<<declare("expFrac",wE+2+wF+1)<<"<= updatedExp & shiftedFrac"<<range(wF+3,3)<<";"<<endl;
@@ -309,12 +478,17 @@ namespace flopoco{
 
 		// 		vhdl<<tab<<declare("RoundedExpFrac",wE+2+wF+1)<<"<= expFrac + addToRoundBit;"<<endl;
 
-		//possible update to exception bits
-		vhdl << tab << declare("upExc",2)<<" <= RoundedExpFrac"<<range(wE+wF+2,wE+wF+1)<<";"<<endl;
-
 		vhdl << tab << declare("fracR",wF)<<" <= RoundedExpFrac"<<range(wF,1)<<";"<<endl;
 		vhdl << tab << declare("expR",wE) <<" <= RoundedExpFrac"<<range(wF+wE,wF+1)<<";"<<endl;
 
+		//possible update to exception bits
+		if(ieeeIO) { // no underflow, and the largest exponent field is an overflow
+			manageCriticalPath(target->localWireDelay() + target->eqConstComparatorDelay(wE));
+			vhdl << tab << declare("upExc",2)<<" <= \"01\" when RoundedExpFrac"<<range(wE+wF+2,wE+wF+1)<<"=\"01\" or expR="<<og(wE,0)<<" else \"00\";"<<endl;
+		}
+		else
+			vhdl << tab << declare("upExc",2)<<" <= RoundedExpFrac"<<range(wE+wF+2,wE+wF+1)<<";"<<endl;
+
 		manageCriticalPath(target->localWireDelay() + target->lutDelay());
 		vhdl << tab << declare("exExpExc",4) << " <= upExc & excRt;"<<endl;
 		vhdl << tab << "with (exExpExc) select "<<endl;
@@ -329,8 +503,18 @@ namespace flopoco{
 
 
 		// assign result
-		vhdl<<tab<< declare("computedR",wE+wF+3) << " <= excR & signR2 & expR & fracR;"<<endl;
-		vhdl << tab << "R <= computedR;"<<endl;
+		if(ieeeIO) {
+			manageCriticalPath(target->localWireDelay() + target->lutDelay());
+			vhdl << tab << "with excR select " << endl;
+			vhdl << tab << "R <= signR2 & " << zg(wE+wF,0) << " when \"00\"," << endl
+					 << tab << tab << "signR2 & expR & fracR when \"01\"," << endl
+					 << tab << tab << "signR2 & " << og(wE,0) << " & " << zg(wF,0) << " when \"10\"," << endl
+					 << tab << tab << "'0' & " << og(wE+wF,0) << " when others; -- NaN" << endl;
+		}
+		else {
+			vhdl<<tab<< declare("computedR",wE+wF+3) << " <= excR & signR2 & expR & fracR;"<<endl;
+			vhdl << tab << "R <= computedR;"<<endl;
+		}
 
 		/*		manageCriticalPath(target->localWireDelay() +  target->lutDelay());
 					vhdl<<tab<<"with sdExnXY select"<<endl;
@@ -350,22 +534,39 @@ namespace flopoco{
 		mpz_class svY = tc->getInputValue("Y");
 
 		/* Compute correct value */
-		FPNumber fpx(wE, wF, svX);
-		FPNumber fpy(wE, wF, svY);
 		mpfr_t x, y, r;
 		mpfr_init2(x, 1+wF);
 		mpfr_init2(y, 1+wF);
 		mpfr_init2(r, 1+wF);
-		fpx.getMPFR(x);
-		fpy.getMPFR(y);
+		if(ieeeIO) {
+			IEEENumber ieeex(wE, wF), ieeey(wE, wF);
+			ieeex = svX;
+			ieeey = svY;
+			ieeex.getMPFR(x);
+			ieeey.getMPFR(y);
+		}
+		else {
+			FPNumber fpx(wE, wF, svX);
+			FPNumber fpy(wE, wF, svY);
+			fpx.getMPFR(x);
+			fpy.getMPFR(y);
+		}
+		// A result in the subnormal range is exact, so rounding on 1+wF bits is correct
 		if(sub)
 			mpfr_sub(r, x, y, GMP_RNDN);
 		else
 			mpfr_add(r, x, y, GMP_RNDN);
 
 		// Set outputs
-		FPNumber  fpr(wE, wF, r);
-		mpz_class svR = fpr.getSignalValue();
+		mpz_class svR;
+		if(ieeeIO) {
+			IEEENumber ieeer(wE, wF, r);
+			svR = ieeer.getSignalValue();
+		}
+		else {
+			FPNumber  fpr(wE, wF, r);
+			svR = fpr.getSignalValue();
+		}
 		tc->addExpectedOutput("R", svR);
 
 		// clean up
@@ -379,6 +580,67 @@ namespace flopoco{
 	void FPAddSinglePath::buildStandardTestCases(TestCaseList* tcl){
 		TestCase *tc;
 
+		if(ieeeIO) {
+			mpz_class minSubnormal = mpz_class(1);
+			mpz_class maxSubnormal = (mpz_class(1)<<wF) - 1;
+			mpz_class minNormal = mpz_class(1)<<wF;
+			mpz_class negative  = mpz_class(1)<<(wE+wF);
+
+			tc = new TestCase(this);
+			tc->addIEEEInput("X", 1.0);
+			tc->addIEEEInput("Y", -1.0);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addIEEEInput("X", IEEENumber::plusInfty);
+			tc->addIEEEInput("Y", IEEENumber::minusInfty);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addIEEEInput("X", IEEENumber::minusZero);
+			tc->addIEEEInput("Y", IEEENumber::minusZero);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addComment("subnormal + subnormal = subnormal");
+			tc->addInput("X", minSubnormal);
+			tc->addInput("Y", minSubnormal);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addComment("subnormal + subnormal = normal");
+			tc->addInput("X", maxSubnormal);
+			tc->addInput("Y", minSubnormal);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addComment("normal - normal = subnormal");
+			tc->addInput("X", minNormal + 5);
+			tc->addInput("Y", minNormal + 2 + negative);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addComment("normal - subnormal = subnormal");
+			tc->addInput("X", minNormal);
+			tc->addInput("Y", minSubnormal + negative);
+			emulate(tc);
+			tcl->add(tc);
+
+			tc = new TestCase(this);
+			tc->addComment("1.0 + subnormal");
+			tc->addIEEEInput("X", 1.0);
+			tc->addInput("Y", maxSubnormal);
+			emulate(tc);
+			tcl->add(tc);
+			return;
+		}
+
 		// Regression tests
 		tc = new TestCase(this);
 		tc->addFPInput("X", 1.0);
@@ -474,6 +736,15 @@ namespace flopoco{
 			x = getLargeRandom(wE+wF+3);
 			y = getLargeRandom(wE+wF+3);
 		}
+		if(ieeeIO) {
+			if ((i & 7) == 6) {// tiny numbers, with subnormal inputs and results
+				x  = getLargeRandom(wF) + (getLargeRandom(1) << wF) + (getLargeRandom(1) << (wE+wF));
+				y  = getLargeRandom(wF) + (getLargeRandom(1) << wF) + (getLargeRandom(1) << (wE+wF));
+			}
+			// remove the FloPoCo exception bits
+			x = x & ((mpz_class(1)<<(wE+wF+1)) - 1);
+			y = y & ((mpz_class(1)<<(wE+wF+1)) - 1);
+		}
 		// Random swap
 		mpz_class swap = getLargeRandom(1);
 		if (swap == mpz_class(0)) {
@@ -494,7 +765,9 @@ namespace flopoco{
 		UserInterface::parseStrictlyPositiveInt(args, "wE", &wE);
 		int wF;
 		UserInterface::parseStrictlyPositiveInt(args, "wF", &wF);
-		return new FPAddSinglePath(target, wE, wF);
+		int lza;
+		UserInterface::parseInt(args, "lza", &lza);
+		return new FPAddSinglePath(target, wE, wF, false, emptyDelayMap, false, lza);
 	}
 
 	void FPAddSinglePath::registerFactory(){
@@ -503,7 +776,8 @@ namespace flopoco{
 											 "BasicFloatingPoint", // categories
 											 "",
 											 "wE(int): exponent size in bits; \
-wF(int): mantissa size in bits;",
+wF(int): mantissa size in bits; \
+lza(int)=-1: 1 for a leading zero anticipator, 0 for a leading zero counter after the addition, -1 to choose according to the target delays;",
 											 "",
 											 FPAddSinglePath::parseArguments
 											 ) ;
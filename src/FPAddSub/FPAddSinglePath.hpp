@@ -10,6 +10,7 @@
 #include "../ShiftersEtc/LZOC.hpp"
 #include "../ShiftersEtc/Shifters.hpp"
 #include "../ShiftersEtc/LZOCShifterSticky.hpp"
+#include "../ShiftersEtc/LZA.hpp"
 #include "../TestBenches/FPNumber.hpp"
 #include "../IntAddSubCmp/IntAdder.hpp"
 #include "../IntAddSubCmp/IntDualSub.hpp"
@@ -25,8 +26,12 @@ namespace flopoco{
 		 * @param[in]		target		the target device
 		 * @param[in]		wE			the the with of the exponent
 		 * @param[in]		wF			the the with of the fraction
+		 * @param[in]		ieeeIO	if true, inputs and output are in IEEE-754 format, including subnormals.
+		 *                        The conversions are merged in the alignment and normalization shifters
+		 * @param[in]		lza			1 to predict the normalization shift with a leading zero anticipator, 0 to count the leading zeroes after the addition,
+		 *                        -1 to choose according to the target. Not available with ieeeIO
 		 */
-		FPAddSinglePath(Target* target, int wE, int wF, bool sub=false, map<string, double> inputDelays = emptyDelayMap);
+		FPAddSinglePath(Target* target, int wE, int wF, bool sub=false, map<string, double> inputDelays = emptyDelayMap, bool ieeeIO=false, int lza=-1);
 
 		/**
 		 * FPAddSinglePath destructor
@@ -52,9 +57,19 @@ namespace flopoco{
 		int wF;
 		/** Is this an FPAdd or an FPSub? */
 		bool sub;
+		/** Are the inputs and output in IEEE format instead of FloPoCo format? */
+		bool ieeeIO;
+		/** Is the normalization shift predicted by a leading zero anticipator? */
+		bool useLZA;
 
 		/** The combined leading zero counter and shifter for the close path */
 		LZOCShifterSticky* lzocs;
+		/** In IEEE mode, the leading zero counter and the normalization shifter, 
+				separated so that the shift can be limited to produce subnormal results */
+		LZOC* lzc;
+		Shifter* normShifter;
+		/** The leading zero anticipator working in parallel with the fraction addition, if useLZA */
+		LZA* lzaFrac;
 		/** The integer adder object for subtraction in the close path */
 		IntAdder *fracSubClose;
 		/** The dual subtractor for the close path */
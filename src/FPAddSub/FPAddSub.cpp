@@ -72,6 +72,7 @@ FPAddSub::FPAddSub(Target* target, int wEX, int wFX, int wEY, int wFY, int wER,
 		vhdl << tab << declare("excExpFracY",2+wE+wF) << " <= Y"<<range(wE+wF+2, wE+wF+1) << " & Y"<<range(wE+wF-1, 0)<<";"<<endl;
 
 		setCriticalPath(getMaxInputDelays(inputDelays));
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath(target->localWireDelay(wE+1) + target->adderDelay(wE+1));
 
 		vhdl<< tab << declare("eXmeY",wE+1) << " <= (\"0\" & X"<<range(wE+wF-1,wF)<<") - (\"0\" & Y"<<range(wE+wF-1,wF)<<");"<<endl;
@@ -82,6 +83,7 @@ FPAddSub::FPAddSub(Target* target, int wEX, int wFX, int wEY, int wFY, int wER,
 		setCriticalPath(getMaxInputDelays(inputDelays));
 
 		if (wF < 30){
+			addEstimatedAdderCost(wE+wF+2);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+wF+2)); //comparator delay implemented for now as adder
 			vhdl<< tab << declare("swap")       << " <= '0' when excExpFracX >= excExpFracY else '1';"<<endl;
 		}else{
@@ -262,6 +264,7 @@ FPAddSub::FPAddSub(Target* target, int wEX, int wFX, int wEY, int wFY, int wER,
 		}
 
 		//incremented exponent.
+		addEstimatedAdderCost(wE+2);
 		manageCriticalPath(target->localWireDelay(wF+2)+ target->adderDelay(wE+2));
 
 		vhdl << tab << declare("extendedExp",wE+2) << "<= \"00\" & expX;"<<endl;
@@ -292,6 +295,7 @@ FPAddSub::FPAddSub(Target* target, int wEX, int wFX, int wEY, int wFY, int wER,
 		double cpshiftedFrac = getCriticalPath();
 
 		//update exponent
+		addEstimatedAdderCost(wE+2);
 		manageCriticalPath(target->localWireDelay(wF+2)+ target->adderDelay(wE+2) + target->lutDelay());
 
 		vhdl << tab << declare("updatedExpSub",wE+2) << " <= extendedExpInc - (" << zg(wE+2-lzocs->getCountWidth(),0) <<" & nZerosNew);"<<endl;
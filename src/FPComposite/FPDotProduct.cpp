@@ -103,6 +103,7 @@ namespace flopoco{
 		setSignalDelay("mFrac", mMult->getOutputDelay("R"));
 
 		/*in parallel manage exponents */
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath( target->localWireDelay() + target->adderDelay(wE+1));		
 		vhdl << tab << declare("sumExp",wE+1) << " <= (\"0\" & expX) + (\"0\" & expY);"<<endl;
 		
@@ -110,6 +111,7 @@ namespace flopoco{
 		vhdl << tab << declare("overflow") << " <= sumExp"<<of(wE)<<";"<<endl;
 		
 		/* subtract bias */
+		addEstimatedAdderCost(wE+1);
 		manageCriticalPath( target->localWireDelay() + target->adderDelay(wE+1));		
 		vhdl << tab << declare("sumExpMBias",wE+1) << " <= sumExp - (\"0\" & CONV_STD_LOGIC_VECTOR("<<intpow2(wE-1)-1<<","<<wE<<"));"<<endl;
 		
@@ -28,15 +28,17 @@
 #include "utils.hpp"
 #include "Operator.hpp"
 #include "FPLargeAcc.hpp"
+#include "BitHeap/BitHeap.hpp"
 
 using namespace std;
 
 namespace flopoco{
 
-	FPLargeAcc::FPLargeAcc(Target* target, int wEX, int wFX, int MaxMSBX, int MSBA, int LSBA, map<string, double> inputDelays,  bool forDotProd, int wFY): 
+	FPLargeAcc::FPLargeAcc(Target* target, int wEX, int wFX, int MaxMSBX, int MSBA, int LSBA, map<string, double> inputDelays,  bool forDotProd, int wFY, int lanes, bool carrySave): 
 		Operator(target), 
-		wEX_(wEX), wFX_(wFX), MaxMSBX_(MaxMSBX), LSBA_(LSBA), MSBA_(MSBA), AccValue_(0), xOvf(0)
+		wEX_(wEX), wFX_(wFX), MaxMSBX_(MaxMSBX), LSBA_(LSBA), MSBA_(MSBA), lanes_(lanes), carrySave_(carrySave), forDotProd_(forDotProd), AccValue_(0), xOvf(0), xUnf(0), accOvf(0)
 	{
+		srcFileName = "FPLargeAcc";
 		// You probably want to remove the following line to have the warnings come back
 		//if you modify this operator
 		setHasDelay1Feedbacks(); 
@@ -57,12 +59,20 @@ namespace flopoco{
 				" This accumulator would never accumulate a bit." << endl;
 			exit (EXIT_FAILURE);
 		}
+		if (lanes_ < 1)
+			THROWERROR("lanes should be at least 1, got " << lanes_);
+		if (forDotProd && lanes_ > 1)
+			THROWERROR("multi-lane accumulation is not supported inside FPDotProduct");
 
 		ostringstream name; 
 		name <<"FPLargeAcc_"<<wEX_<<"_"<<wFX_<<"_"
 				 <<(MaxMSBX_>=0?"":"M")<<abs(MaxMSBX_)<<"_"
 				 <<(MSBA_>=0?"":"M")<<abs(MSBA_)<<"_" 
 				 <<(LSBA_>=0?"":"M")<<abs(LSBA_);
+		if (lanes_ > 1)
+			name << "_L" << lanes_;
+		if (carrySave_)
+			name << "_CS";
 		setName(name.str());
 
 		// This operator is a sequential one
@@ -76,8 +86,11 @@ namespace flopoco{
 			addInput ("excX_dprod", 2);
 			addInput ("fracX_dprod", 1+wFX+1+wFY);
 			addInput ("expX_dprod", wEX);
-		}else
+		}else if (lanes_ == 1)
 			addFPInput ("X", wEX_,wFX_);
+		else
+			for (int l=0; l<lanes_; l++)
+				addFPInput (join("X",l), wEX_,wFX_);
 		
 
 		addInput   ("newDataSet");
@@ -114,87 +127,154 @@ namespace flopoco{
 		}
 
 		/* set-up carry-save parameters */		
-		int chunkSize_;
-		target->suggestSlackSubaddSize(chunkSize_ , sizeAcc_, target->localWireDelay() + target->lutDelay());
+		if (carrySave_) {
+			// one full adder per bit: the loop is a single LUT level
+			chunkSize_ = 1;
+		}
+		else {
+			target->suggestSlackSubaddSize(chunkSize_ , sizeAcc_, target->localWireDelay() + target->lutDelay());
+		}
 		REPORT( DEBUG, "Addition chunk size in FPLargeAcc is:"<<chunkSize_);
 		 
-		int nbOfChunks    = ceil(double(sizeAcc_)/double(chunkSize_));
+		nbOfChunks_       = ceil(double(sizeAcc_)/double(chunkSize_));
+		int nbOfChunks    = nbOfChunks_;
 		int lastChunkSize = ( sizeAcc_ % chunkSize_ == 0 ? chunkSize_  : sizeAcc_ % chunkSize_);
 
+		/* The input alignment is replicated for each lane. With a single lane, 
+			 the signal names are those of the original single-input accumulator */
+		for (int l=0; l<lanes_; l++) {
+			string lane = (lanes_ == 1 ? "" : join("_",l));
+			string X    = (lanes_ == 1 ? "X" : join("X",l));
+			setCycle(0);
+
+			/* if FPLargeAcc is used in FPDotProduct, then its input fraction is twice as large */
+			if (!forDotProd){
+				vhdl << tab << declare("fracX"+lane,wFX_+1) << " <=  \"1\" & " << X << range(wFX_-1,0) << ";" << endl;
+				vhdl << tab << declare("expX"+lane ,wEX_  ) << " <= " << X << range(wEX_+wFX_-1,wFX_) << ";" << endl;
+				vhdl << tab << declare("signX"+lane) << " <= " << X << of(wEX_+wFX_) << ";" << endl;
+				vhdl << tab << declare("exnX"+lane ,2     ) << " <= " << X << range(wEX_+wFX_+2,wEX_+wFX_+1) << ";" << endl;
+			}else{
+				vhdl << tab << declare("fracX",wFX_ + wFY +2) << " <= fracX_dprod;" << endl;
+				vhdl << tab << declare("expX" ,wEX_  ) << " <= expX_dprod;" << endl;
+				vhdl << tab << declare("signX") << " <= sigX_dprod;" << endl;
+				vhdl << tab << declare("exnX" ,2     ) << " <= excX_dprod;" << endl;
+			}
 
-		/* if FPLargeAcc is used in FPDotProduct, then its input fraction is twice as large */
-		if (!forDotProd){
-			vhdl << tab << declare("fracX",wFX_+1) << " <=  \"1\" & X" << range(wFX_-1,0) << ";" << endl;
-			vhdl << tab << declare("expX" ,wEX_  ) << " <= X" << range(wEX_+wFX_-1,wFX_) << ";" << endl;
-			vhdl << tab << declare("signX") << " <= X" << of(wEX_+wFX_) << ";" << endl;
-			vhdl << tab << declare("exnX" ,2     ) << " <= X" << range(wEX_+wFX_+2,wEX_+wFX_+1) << ";" << endl;
-		}else{
-			vhdl << tab << declare("fracX",wFX_ + wFY +2) << " <= fracX_dprod;" << endl;
-			vhdl << tab << declare("expX" ,wEX_  ) << " <= expX_dprod;" << endl;
-			vhdl << tab << declare("signX") << " <= sigX_dprod;" << endl;
-			vhdl << tab << declare("exnX" ,2     ) << " <= excX_dprod;" << endl;
-		}
+			setCriticalPath( getMaxInputDelays(inputDelays));
+			addEstimatedAdderCost(wEX+1);
+			manageCriticalPath( target->localWireDelay() + target->adderDelay(wEX+1)); 
+
+			/* declaring the underflow and overflow conditions of the input X. 
+			these two flags are used to reparameter the accumulator following a test
+			run. If Xoverflow has happened, then MaxMSBX needs to be increased and 
+			the accumulation result is invalidated. If Xunderflow is raised then 
+			user can lower LSBA for obtaining a even better accumulation precision */
+			vhdl << tab << declare("xOverflowCond"+lane ,1, false, Signal::registeredWithSyncReset) << " <= '1' when (( expX"<<lane<<" > CONV_STD_LOGIC_VECTOR("<<MaxMSBX_ + E0X_<<","<< wEX_<<")) or (exnX"<<lane<<" >= \"10\")) else '0' ;"<<endl; 
+			vhdl << tab << declare("xUnderflowCond"+lane,1, false, Signal::registeredWithSyncReset) << " <= '1' when (expX"<<lane<<" < CONV_STD_LOGIC_VECTOR("<<LSBA_ + E0X_<<","<<wEX_<<")) else '0' ;" << endl;  
+			
+			mpz_class exp_offset = E0X_+LSBA_;
+			vhdl << tab << declare("shiftVal"+lane,wEX_+1) << " <= (\"0\" & expX"<<lane<<") - CONV_STD_LOGIC_VECTOR("<< exp_offset <<","<<  wEX_+1<<");" << endl;
 
-		setCriticalPath( getMaxInputDelays(inputDelays));
-		manageCriticalPath( target->localWireDelay() + target->adderDelay(wEX+1)); 
+			if (l==0) {
+				shifter_ = new Shifter(target, (forDotProd?wFX_+wFY+2:wFX_+1), maxShift_, Shifter::Left, inDelayMap("X", target->localWireDelay() + getCriticalPath()));
+				addSubComponent(shifter_);
+			}
 
-		/* declaring the underflow and overflow conditions of the input X. 
-		these two flags are used to reparameter the accumulator following a test
-		run. If Xoverflow has happened, then MaxMSBX needs to be increased and 
-		the accumulation result is invalidated. If Xunderflow is raised then 
-		user can lower LSBA for obtaining a even better accumulation precision */
-		vhdl << tab << declare("xOverflowCond" ,1, false, Signal::registeredWithSyncReset) << " <= '1' when (( expX > CONV_STD_LOGIC_VECTOR("<<MaxMSBX_ + E0X_<<","<< wEX_<<")) or (exnX >= \"10\")) else '0' ;"<<endl; 
-		vhdl << tab << declare("xUnderflowCond",1, false, Signal::registeredWithSyncReset) << " <= '1' when (expX < CONV_STD_LOGIC_VECTOR("<<LSBA_ + E0X_<<","<<wEX_<<")) else '0' ;" << endl;  
+			inPortMap   (shifter_, "X", "fracX"+lane);
+			inPortMapCst(shifter_, "S", "shiftVal"+lane+range(shifter_->getShiftInWidth() - 1,0));
+			outPortMap  (shifter_, "R", "shifted_frac"+lane);
+			vhdl << instance(shifter_, "FPLargeAccInputShifter"+lane);
 		
-		mpz_class exp_offset = E0X_+LSBA_;
-		vhdl << tab << declare("shiftVal",wEX_+1) << " <= (\"0\" & expX) - CONV_STD_LOGIC_VECTOR("<< exp_offset <<","<<  wEX_+1<<");" << endl;
+			syncCycleFromSignal("shifted_frac"+lane);
 
-		shifter_ = new Shifter(target, (forDotProd?wFX_+wFY+2:wFX_+1), maxShift_, Shifter::Left, inDelayMap("X", target->localWireDelay() + getCriticalPath()));
-		addSubComponent(shifter_);
 
-		inPortMap   (shifter_, "X", "fracX");
-		inPortMapCst(shifter_, "S", "shiftVal"+range(shifter_->getShiftInWidth() - 1,0));
-		outPortMap  (shifter_, "R", "shifted_frac");
-		vhdl << instance(shifter_, "FPLargeAccInputShifter");
-	
-		syncCycleFromSignal("shifted_frac");
 
+			/* determine if the input has been shifted out from the accumulator. 
+			In this case the accumulator will added 0 */
+			vhdl << tab << declare("flushedToZero"+lane) << " <= '1' when (shiftVal" << lane << of(wEX_)<<"='1' or exnX"<<lane<<"=\"00\") else '0';" << endl;
 
+			/* in most FPGAs computation of the summand2c will be done in one LUT level */
+			vhdl << tab << declare("summand"+lane, sizeSummand_, true, (lanes_==1 ? Signal::registeredWithSyncReset : Signal::wire)) << "<= " << 
+						zg(sizeSummand_) << " when flushedToZero"<<lane<<"='1' else shifted_frac"<<lane << range(sizeShiftedFrac_-1,wFX_)<<";" << endl;
+
+			vhdl << tab << "-- 2's complement of the summand" << endl;
+			/* Don't compute 2's complement just yet, just invert the bits and leave 
+			the addition of the extra 1 in accumulation, as a carry in bit for the 
+			first chunk*/
+			vhdl << tab << declare("summand2c"+lane, sizeSummand_, true) << " <= summand"<<lane<<" when (signX"<<lane<<"='0' or flushedToZero"<<lane<<"='1') else not(summand"<<lane<<");"<< endl;
+		}
 
-		/* determine if the input has been shifted out from the accumulator. 
-		In this case the accumulator will added 0 */
-		vhdl << tab << declare("flushedToZero") << " <= '1' when (shiftVal" << of(wEX_)<<"='1' or exnX=\"00\") else '0';" << endl;
+		if (lanes_ == 1) {
+			vhdl << tab << "-- sign extension of the summand to accumulator size" << endl;
+			vhdl << tab << declare("ext_summand2c",sizeAcc_,true) << " <= " << (sizeAcc_-1<sizeSummand_?"":rangeAssign(sizeAcc_-1, sizeSummand_, "signX and not flushedToZero")+" & ") << "summand2c;" << endl;
 
-		/* in most FPGAs computation of the summand2c will be done in one LUT level */
-		vhdl << tab << declare("summand", sizeSummand_, true, Signal::registeredWithSyncReset) << "<= " << 
-					zg(sizeSummand_) << " when flushedToZero='1' else shifted_frac" << range(sizeShiftedFrac_-1,wFX_)<<";" << endl;
+			vhdl << tab << "-- accumulation itself" << endl;
+			//determine the value of the carry in bit
+			vhdl << tab << declare("carryBit_0",1,false) << " <= signX and not flushedToZero;" << endl; 
+		}
+		else {
+			/* The lanes are summed by a bit heap working modulo 2^sizeAcc_. 
+				 The 2's complement carry-in bits of all the lanes are absorbed there, 
+				 so the accumulation loop itself is the same as for one lane. */
+			for (int l=0; l<lanes_; l++)
+				syncCycleFromSignal(join("summand2c_",l));
+
+			BitHeap* bitHeap = new BitHeap(this, sizeAcc_, false, "lanes");
+			for (int l=0; l<lanes_; l++) {
+				vhdl << tab << declare(join("negate_",l)) << " <= " << join("signX_",l) << " and not " << join("flushedToZero_",l) << ";" << endl;
+				if (sizeSummand_ < sizeAcc_) {
+					vhdl << tab << declare(join("sext_summand2c_",l), sizeSummand_+1, true) << " <= " << join("negate_",l) << " & " << join("summand2c_",l) << ";" << endl;
+					bitHeap->addSignedBitVector(0, join("sext_summand2c_",l), sizeSummand_+1);
+				}
+				else
+					bitHeap->addUnsignedBitVector(0, join("summand2c_",l), sizeSummand_);
+				bitHeap->addBit(0, join("negate_",l));
+			}
+			bitHeap->generateCompressorVHDL();
 
-		vhdl << tab << "-- 2's complement of the summand" << endl;
-		/* Don't compute 2's complement just yet, just invert the bits and leave 
-		the addition of the extra 1 in accumulation, as a carry in bit for the 
-		first chunk*/
-		vhdl << tab << declare("summand2c", sizeSummand_, true) << " <= summand when (signX='0' or flushedToZero='1') else not(summand);"<< endl;
+			vhdl << tab << declare("xOverflowCond" ,1, false, Signal::registeredWithSyncReset) << " <= ";
+			for (int l=0; l<lanes_; l++)
+				vhdl << join("xOverflowCond_",l) << (l<lanes_-1 ? " or " : ";\n");
+			vhdl << tab << declare("xUnderflowCond" ,1, false, Signal::registeredWithSyncReset) << " <= ";
+			for (int l=0; l<lanes_; l++)
+				vhdl << join("xUnderflowCond_",l) << (l<lanes_-1 ? " or " : ";\n");
 
-		vhdl << tab << "-- sign extension of the summand to accumulator size" << endl;
-		vhdl << tab << declare("ext_summand2c",sizeAcc_,true) << " <= " << (sizeAcc_-1<sizeSummand_?"":rangeAssign(sizeAcc_-1, sizeSummand_, "signX and not flushedToZero")+" & ") << "summand2c;" << endl;
+			vhdl << tab << "-- sum of the lanes, already in 2's complement" << endl;
+			vhdl << tab << declare("ext_summand2c",sizeAcc_,true) << " <= " << bitHeap->getSumName(sizeAcc_-1,0) << ";" << endl;
 
-		vhdl << tab << "-- accumulation itself" << endl;
-		//determine the value of the carry in bit
-		vhdl << tab << declare("carryBit_0",1,false) << " <= signX and not flushedToZero;" << endl; 
-		
+			vhdl << tab << "-- accumulation itself" << endl;
+			vhdl << tab << declare("carryBit_0",1,false) << " <= '0';" << endl; 
+		}
 		
-		for (i=0; i < nbOfChunks; i++) {
-			ostringstream accReg;
-			accReg<<"acc_"<<i;
-
-			vhdl << tab << declare(join("acc_",i),(i!=nbOfChunks-1?chunkSize_:lastChunkSize) ,true, Signal::registeredWithSyncReset) << " <= " << 
-				join("acc_",i,"_ext")<<range((i!=nbOfChunks-1?chunkSize_-1:lastChunkSize-1),0) << ";" << endl;
-			vhdl << tab << declare(join("carryBit_",i+1),1, false, Signal::registeredWithSyncReset) <<"  <= " << join("acc_",i,"_ext")<<of((i!=nbOfChunks-1?chunkSize_:lastChunkSize)) << ";" << endl;
-			nextCycle();		
-			vhdl << tab << declare(join("acc_",i,"_ext"),(i!=nbOfChunks-1?chunkSize_:lastChunkSize)+1) << " <= ( \"0\" & (" <<join("acc_",i)<< " and "<<rangeAssign( (i!=nbOfChunks-1?chunkSize_:lastChunkSize)-1,0, "not(newDataSet)") <<")) + " <<
-				"( \"0\" & ext_summand2c" << range( (i!=nbOfChunks-1?chunkSize_*(i+1)-1:sizeAcc_-1), chunkSize_*i) << ") + " << 
-				"("<<join("carryBit_",i) << (i>0?" and not(newDataSet)":"")<< ");" << endl;
+		string accCarryOut;
+		if (carrySave_) {
+			/* Carry-save accumulation: the loop is one full adder per bit. 
+				 The carries are kept in a second register, and propagated by LargeAccToFP */
+			vhdl << tab << declare("accCS", sizeAcc_, true, Signal::registeredWithSyncReset) << " <= accCS_sum;" << endl;
+			vhdl << tab << declare("carryCS", sizeAcc_, true, Signal::registeredWithSyncReset) << " <= accCS_carry;" << endl;
+			nextCycle();
+			vhdl << tab << declare("accCS_in", sizeAcc_, true) << " <= accCS and " << rangeAssign(sizeAcc_-1,0, "not(newDataSet)") << ";" << endl;
+			vhdl << tab << declare("carryCS_in", sizeAcc_, true) << " <= (carryCS" << range(sizeAcc_-2,0) << " and " << rangeAssign(sizeAcc_-2,0, "not(newDataSet)") << ") & carryBit_0;" << endl;
+			vhdl << tab << declare("accCS_sum", sizeAcc_, true) << " <= accCS_in xor ext_summand2c xor carryCS_in;" << endl;
+			vhdl << tab << declare("accCS_carry", sizeAcc_, true) << " <= (accCS_in and ext_summand2c) or (accCS_in and carryCS_in) or (ext_summand2c and carryCS_in);" << endl;
 			setCycleFromSignal("carryBit_0");
+			accCarryOut = "carryCS" + of(sizeAcc_-1);
+		}
+		else {
+			for (i=0; i < nbOfChunks; i++) {
+				ostringstream accReg;
+				accReg<<"acc_"<<i;
+
+				vhdl << tab << declare(join("acc_",i),(i!=nbOfChunks-1?chunkSize_:lastChunkSize) ,true, Signal::registeredWithSyncReset) << " <= " << 
+					join("acc_",i,"_ext")<<range((i!=nbOfChunks-1?chunkSize_-1:lastChunkSize-1),0) << ";" << endl;
+				vhdl << tab << declare(join("carryBit_",i+1),1, false, Signal::registeredWithSyncReset) <<"  <= " << join("acc_",i,"_ext")<<of((i!=nbOfChunks-1?chunkSize_:lastChunkSize)) << ";" << endl;
+				nextCycle();		
+				vhdl << tab << declare(join("acc_",i,"_ext"),(i!=nbOfChunks-1?chunkSize_:lastChunkSize)+1) << " <= ( \"0\" & (" <<join("acc_",i)<< " and "<<rangeAssign( (i!=nbOfChunks-1?chunkSize_:lastChunkSize)-1,0, "not(newDataSet)") <<")) + " <<
+					"( \"0\" & ext_summand2c" << range( (i!=nbOfChunks-1?chunkSize_*(i+1)-1:sizeAcc_-1), chunkSize_*i) << ") + " << 
+					"("<<join("carryBit_",i) << (i>0?" and not(newDataSet)":"")<< ");" << endl;
+				setCycleFromSignal("carryBit_0");
+			}
+			accCarryOut = join("carryBit_",nbOfChunks);
 		}
 
 		setCycleFromSignal("carryBit_0",false);
@@ -202,28 +282,37 @@ namespace flopoco{
 		setCycleFromSignal("carryBit_0",false);
 		vhdl << tab << declare("xUnderflowRegister",1,false, Signal::registeredWithSyncReset) << " <= "; nextCycle(false); vhdl << "xUnderflowRegister or xUnderflowCond;"<<endl;
 		setCycleFromSignal("carryBit_0",false);
-		vhdl << tab << declare("accOverflowRegister",1,false, Signal::registeredWithSyncReset) << " <= "; nextCycle(false); vhdl << "accOverflowRegister or "<<join("carryBit_",nbOfChunks) << ";"<<endl;
+		vhdl << tab << declare("accOverflowRegister",1,false, Signal::registeredWithSyncReset) << " <= "; nextCycle(false); vhdl << "accOverflowRegister or "<< accCarryOut << ";"<<endl;
 		setCycleFromSignal("carryBit_0",false);
 
 		nextCycle();
 		
-		//compose the acc signal 
-		vhdl << tab << declare("acc", sizeAcc_) << " <= ";
-		for (i=nbOfChunks-1;i>=0;i--)
-			vhdl << join("acc_",i) <<  (i>0?" & ":";\n");
-	
-		vhdl << tab << declare("carry", sizeAcc_) << " <= ";
-		for (i=nbOfChunks-1;i>=0; i--){
-			vhdl << (i<nbOfChunks-1?join("carryBit_",i+1)+" & ":"");
-			vhdl << (i==nbOfChunks-1?zg(lastChunkSize-(i>0?1:0))+(i>0?" & ":""):(i>0?zg(chunkSize_-1)+" & ":zg(chunkSize_)));
-		}vhdl << ";" << endl;
-
-		if (nbOfChunks > 1 ){
+		if (carrySave_) {
+			// the carry out of bit i has weight i+1
+			vhdl << tab << declare("acc", sizeAcc_) << " <= accCS;" << endl;
+			vhdl << tab << declare("carry", sizeAcc_) << " <= carryCS" << range(sizeAcc_-2,0) << " & '0';" << endl;
 			vhdl << tab << "A <=   acc;" << endl;
 			vhdl << tab << "C <=   carry;" << endl;
-		}else{
-			vhdl << tab << "A <=  acc_0;" << endl;
-			vhdl << tab << "C <=   carry;" << endl;
+		}
+		else {
+			//compose the acc signal 
+			vhdl << tab << declare("acc", sizeAcc_) << " <= ";
+			for (i=nbOfChunks-1;i>=0;i--)
+				vhdl << join("acc_",i) <<  (i>0?" & ":";\n");
+		
+			vhdl << tab << declare("carry", sizeAcc_) << " <= ";
+			for (i=nbOfChunks-1;i>=0; i--){
+				vhdl << (i<nbOfChunks-1?join("carryBit_",i+1)+" & ":"");
+				vhdl << (i==nbOfChunks-1?zg(lastChunkSize-(i>0?1:0))+(i>0?" & ":""):(i>0?zg(chunkSize_-1)+" & ":zg(chunkSize_)));
+			}vhdl << ";" << endl;
+
+			if (nbOfChunks > 1 ){
+				vhdl << tab << "A <=   acc;" << endl;
+				vhdl << tab << "C <=   carry;" << endl;
+			}else{
+				vhdl << tab << "A <=  acc_0;" << endl;
+				vhdl << tab << "C <=   carry;" << endl;
+			}
 		}
 	
 //		nextCycle();
@@ -235,6 +324,12 @@ namespace flopoco{
 
 		setCycleFromSignal("acc");
 		vhdl << tab << "ready <= newDataSet;"<<endl;
+
+		// initialize stuff for emulate
+		for (i=0; i < nbOfChunks_; i++) 
+			accChunk_.push_back(mpz_class(0));
+		for (i=0; i <= nbOfChunks_; i++) 
+			carryChunk_.push_back(mpz_class(0));
 	}
 
 
@@ -566,7 +661,92 @@ namespace flopoco{
 		}
 	}
 
+	mpz_class FPLargeAcc::laneSummand(mpz_class svX, int& negate, bool& xOverflow, bool& xUnderflow)
+	{
+		mpz_class exn  = svX >> (wEX_+wFX_+1);
+		mpz_class sign = (svX >> (wEX_+wFX_)) & 1;
+		mpz_class exp  = (svX >> wFX_) & ((mpz_class(1) << wEX_) - 1);
+		mpz_class frac = (svX & ((mpz_class(1) << wFX_) - 1)) + (mpz_class(1) << wFX_);
+
+		xOverflow  = (exp > MaxMSBX_ + E0X_) || (exn >= 2);
+		xUnderflow = (exp < LSBA_ + E0X_);
+
+		mpz_class shiftVal = exp - (E0X_ + LSBA_);
+		bool flushedToZero = (shiftVal < 0) || (exn == 0);
+
+		mpz_class summand = 0;
+		if (!flushedToZero) {
+			// the shifter only sees the low bits of shiftVal
+			int s = mpz_class(shiftVal & ((mpz_class(1) << shifter_->getShiftInWidth()) - 1)).get_si();
+			mpz_class shifted = (frac << s) & ((mpz_class(1) << sizeShiftedFrac_) - 1);
+			summand = shifted >> wFX_;
+		}
+
+		negate = (sign == 1 && !flushedToZero) ? 1 : 0;
+		if (negate == 0)
+			return summand;
+		// one's complement, sign-extended to sizeAcc_ bits
+		return ((mpz_class(1) << sizeAcc_) - 1) - summand;
+	}
+
 	void FPLargeAcc::emulate(TestCase* tc){
+		if (forDotProd_) // the inputs are not FP numbers, nothing to emulate
+			return;
+
+		mpz_class svNewDataSet = tc->getInputValue("newDataSet");
+		mpz_class accMask = (mpz_class(1) << sizeAcc_) - 1;
+
+		/* What enters the accumulation loop: one summand and one carry-in bit */
+		mpz_class summand = 0;
+		int carryIn = 0;
+		for (int l=0; l<lanes_; l++) {
+			int negate;
+			bool ovf, unf;
+			mpz_class s = laneSummand(tc->getInputValue(lanes_==1 ? "X" : join("X",l)), negate, ovf, unf);
+			if (ovf) xOvf = 1;
+			if (unf) xUnf = 1;
+			if (lanes_ == 1) {
+				summand = s;
+				carryIn = negate;
+			}
+			else // the bit heap absorbs the carry-in bits
+				summand = (summand + s + negate) & accMask;
+		}
+
+		/* Bit-exact model of the chunked (or carry-save, with chunks of 1 bit) loop */
+		if (svNewDataSet == 1) {
+			for (int i=0; i<nbOfChunks_; i++) 
+				accChunk_[i] = 0;
+			for (int i=1; i<=nbOfChunks_; i++) 
+				carryChunk_[i] = 0;
+		}
+		vector<mpz_class> newCarry(nbOfChunks_+1, mpz_class(0));
+		for (int i=0; i<nbOfChunks_; i++) {
+			int lsb = chunkSize_*i;
+			int w = min(chunkSize_, sizeAcc_-lsb);
+			mpz_class chunkMask = (mpz_class(1) << w) - 1;
+			mpz_class sum = accChunk_[i] + ((summand >> lsb) & chunkMask) + (i==0 ? mpz_class(carryIn) : carryChunk_[i]);
+			accChunk_[i] = sum & chunkMask;
+			newCarry[i+1] = sum >> w;
+		}
+		for (int i=1; i<=nbOfChunks_; i++) 
+			carryChunk_[i] = newCarry[i];
+		if (carryChunk_[nbOfChunks_] == 1)
+			accOvf = 1;
+
+		mpz_class svA = 0, svC = 0;
+		for (int i=0; i<nbOfChunks_; i++) {
+			svA += accChunk_[i] << (chunkSize_*i);
+			if (i>0)
+				svC += carryChunk_[i] << (chunkSize_*i);
+		}
+
+		tc->addExpectedOutput("A", svA);
+		tc->addExpectedOutput("C", svC);
+		tc->addExpectedOutput("XOverflow", mpz_class(xOvf));
+		tc->addExpectedOutput("XUnderflow", mpz_class(xUnf));
+		tc->addExpectedOutput("AccOverflow", mpz_class(accOvf));
+		tc->addExpectedOutput("ready", svNewDataSet);
 	}
 
 	TestCase* FPLargeAcc::buildRandomTestCase(int i){
@@ -574,26 +754,28 @@ namespace flopoco{
 		TestCase *tc;
 		mpz_class x;
 
-		/* normal exception bits */
-		mpz_class normalExn = mpz_class(1)<<(wEX_+wFX_+1);
+		tc = new TestCase(this); 
+		for (int l=0; l<lanes_; l++) {
+			/* normal exception bits */
+			mpz_class normalExn = mpz_class(1)<<(wEX_+wFX_+1);
 
-		/*really random sign*/
-		mpz_class sign = mpz_class(getLargeRandom(1)%2)<<(wEX_+wFX_);
+			/*really random sign*/
+			mpz_class sign = mpz_class(getLargeRandom(1)%2)<<(wEX_+wFX_);
 
-		/* do exponent */
-		mpz_class exponent = getLargeRandom(wEX_);
-		while (! (MaxMSBX_ >= exponent - (intpow2(wEX_-1)-1))){
-			exponent = getLargeRandom(wEX_);
-		}
-		/* shift exponent in place */
-		exponent = exponent << (wFX_);
+			/* do exponent */
+			mpz_class exponent = getLargeRandom(wEX_);
+			while (! (MaxMSBX_ >= exponent - (intpow2(wEX_-1)-1))){
+				exponent = getLargeRandom(wEX_);
+			}
+			/* shift exponent in place */
+			exponent = exponent << (wFX_);
 
-		mpz_class frac = getLargeRandom(wFX_);		
-		
-		x = normalExn + sign + exponent + frac;
+			mpz_class frac = getLargeRandom(wFX_);		
+			
+			x = normalExn + sign + exponent + frac;
 
-		tc = new TestCase(this); 
-		tc->addInput("X", x);
+			tc->addInput((lanes_==1 ? "X" : join("X",l)), x);
+		}
 
 		if (i == 0){
 			tc->addInput("newDataSet", mpz_class(1));	
@@ -608,13 +790,16 @@ namespace flopoco{
 	}
 	
 	OperatorPtr FPLargeAcc::parseArguments(Target *target, vector<string> &args) {
-		int wEX, wFX, MaxMSBX, MSBA, LSBA;
+		int wEX, wFX, MaxMSBX, MSBA, LSBA, lanes;
+		bool carrySave;
 		UserInterface::parseStrictlyPositiveInt(args, "wEX", &wEX); 
 		UserInterface::parseStrictlyPositiveInt(args, "wFX", &wFX);
 		UserInterface::parseInt(args, "MaxMSBX", &MaxMSBX);
 		UserInterface::parseInt(args, "MSBA", &MSBA);
 		UserInterface::parseInt(args, "LSBA", &LSBA);
-		return new FPLargeAcc(target, wEX, wFX, MaxMSBX, MSBA, LSBA);
+		UserInterface::parseStrictlyPositiveInt(args, "lanes", &lanes);
+		UserInterface::parseBoolean(args, "carrySave", &carrySave);
+		return new FPLargeAcc(target, wEX, wFX, MaxMSBX, MSBA, LSBA, emptyDelayMap, false, -1, lanes, carrySave);
 	}
 
 	void FPLargeAcc::registerFactory(){
@@ -626,8 +811,10 @@ namespace flopoco{
                         wFX(int): the width of the fractional part;  \
                         MaxMSBX(int): the weight of the MSB of the expected exponent of X; \
                         MSBA(int): the weight of the least significand bit of the accumulator;\
-                        LSBA(int): the weight of the most significand bit of the accumulator",
-											 "Kulisch-like accumulator of floating-point numbers into a large fixed-point accumulator. By tuning the MaxMSB_in, LSB_acc and MSB_acc parameters to a given application, rounding error may be reduced to a provably arbitrarily low level, at a very small hardware cost compared to using a floating-point adder for accumulation. <br> For details on the technique used and an example of application, see <a href=\"bib/flopoco.html#DinechinPascaCret2008:FPT\">this article</a>",
+                        LSBA(int): the weight of the most significand bit of the accumulator;\
+                        lanes(int)=1: number of summands input at each cycle, on inputs X0, X1, ... when larger than 1;\
+                        carrySave(bool)=false: use a carry-save accumulator, whose loop is a single LUT level",
+											 "Kulisch-like accumulator of floating-point numbers into a large fixed-point accumulator. By tuning the MaxMSB_in, LSB_acc and MSB_acc parameters to a given application, rounding error may be reduced to a provably arbitrarily low level, at a very small hardware cost compared to using a floating-point adder for accumulation. <br> With lanes>1, several summands are aligned in parallel and summed by a bit heap before entering the accumulator. With carrySave=true, the accumulator output C is a full carry vector, to be resolved by LargeAccToFP. <br> For details on the technique used and an example of application, see <a href=\"bib/flopoco.html#DinechinPascaCret2008:FPT\">this article</a>",
 											 FPLargeAcc::parseArguments
 											 ) ;
 		
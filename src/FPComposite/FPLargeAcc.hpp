@@ -22,8 +22,10 @@ namespace flopoco{
 		 * @param MaxMSBX the weight of the MSB of the expected exponent of X
 		 * @param LSBA the weight of the least significand bit of the accumulator
 		 * @param MSBA the weight of the most significand bit of the accumulator
+		 * @param lanes the number of floating-point summands input at each cycle
+		 * @param carrySave if true, use a carry-save accumulator (one LUT level in the loop) instead of a chunked carry-select one
 		 */ 
-		FPLargeAcc(Target* target, int wEX, int wFX, int MaxMSBX, int MSBA, int LSBA, map<string, double> inputDelays = emptyDelayMap, bool forDotProd = false, int wFY = -1);
+		FPLargeAcc(Target* target, int wEX, int wFX, int MaxMSBX, int MSBA, int LSBA, map<string, double> inputDelays = emptyDelayMap, bool forDotProd = false, int wFY = -1, int lanes = 1, bool carrySave = false);
 	
 		/** Destructor */
 		~FPLargeAcc();
@@ -46,6 +48,15 @@ namespace flopoco{
 		mpz_class mapFP2Acc(FPNumber X);
 	
 		mpz_class sInt2C2(mpz_class X, int width);
+
+		/** Computes the bit-exact summand that one input lane feeds to the accumulator
+		 * @param svX the FloPoCo FP input, as a bit vector
+		 * @param negate set to the carry-in bit that completes the 2's complement of a negative summand
+		 * @param xOverflow set to the input overflow condition
+		 * @param xUnderflow set to the input underflow condition
+		 * @return the one's complement summand, sign-extended to the accumulator size
+		 */
+		mpz_class laneSummand(mpz_class svX, int& negate, bool& xOverflow, bool& xUnderflow);
 		
 		/** Factory method that parses arguments and calls the constructor */
 		static OperatorPtr parseArguments(Target *target , vector<string> &args);
@@ -59,10 +70,17 @@ namespace flopoco{
 		int MaxMSBX_; /**< the weight of the MSB of the expected exponent of X */
 		int LSBA_;    /**< the weight of the least significand bit of the accumulator */
 		int MSBA_;    /**< the weight of the most significand bit of the accumulator */
+		int lanes_;   /**< the number of floating-point summands input at each cycle */
+		bool carrySave_; /**< if true, the accumulator is in carry-save form */
+		bool forDotProd_; /**< if true, the inputs come from FPDotProduct */
 
 		mpz_class AccValue_;
 		int currentIteration;
 		int xOvf;	
+		int xUnf;
+		int accOvf;
+		vector<mpz_class> accChunk_;   /**< for emulate: the accumulator chunks */
+		vector<mpz_class> carryChunk_; /**< for emulate: carryChunk_[i] is the registered carry into chunk i */
 
 	private:
 		Shifter* shifter_;          /**<Shifter object for shifting X in place */
@@ -76,6 +94,8 @@ namespace flopoco{
 		string   summand2cname_;    /**< ??? */
 		int      c2ChunkSize_;      /**< for c2 addition */
 		int      c2PipelineDepth_;  /**< for c2 addition */
+		int      chunkSize_;        /**< size of an accumulation chunk, 1 in carry-save mode */
+		int      nbOfChunks_;       /**< number of accumulation chunks */
 
 		int additionNumberOfChunks_;         /**< Number of chunks of the accumulation addition */
 		int rebalancedAdditionChunkSize_;    /**< The chunk size after rebalancing */
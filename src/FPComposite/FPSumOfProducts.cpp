@@ -0,0 +1,541 @@
+/*
+  A floating-point sum of products for FloPoCo
+
+  The n significand products are aligned to the largest one and summed
+  in a single bit heap, then the sum is normalized and rounded once.
+  This replaces a tree of FPMult and FPAdd, which rounds at each node.
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+  developed by the Arenaire team at Ecole Normale Superieure de Lyon
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  2008-2026.
+  All rights reserved.
+
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <math.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <gmpxx.h>
+#include "utils.hpp"
+#include "Operator.hpp"
+
+#include "FPSumOfProducts.hpp"
+#include "BitHeap/BitHeap.hpp"
+
+using namespace std;
+
+namespace flopoco{
+
+	FPSumOfProducts::FPSumOfProducts(Target* target, int wE, int wF, int n, int maxCancellation, map<string, double> inputDelays):
+		Operator(target), wE(wE), wF(wF), n(n), maxCancellation(maxCancellation)
+	{
+		srcFileName="FPSumOfProducts";
+		ostringstream name;
+		name << "FPSumOfProducts_" << wE << "_" << wF << "_" << n << "_c" << maxCancellation;
+		setName(name.str());
+		setCopyrightString("FloPoCo developers (2026)");
+
+		if(n<2)
+			THROWERROR("n should be at least 2, got " << n);
+		if(maxCancellation<0)
+			THROWERROR("maxCancellation should be positive or zero, got " << maxCancellation);
+
+		// Error analysis
+		// Each aligned product is truncated twice (product truncation, then shifter output truncation):
+		// less than 2 ulps of the sum LSB each, hence less than 2n <= 2^(intlog2(n)+1) ulps total.
+		// If the leading one of the computed sum is at position wF+intlog2(n)+4 or above,
+		// this error is less than 1/8 ulp of the computed sum, and the final round to nearest is a faithful rounding
+		// of the exact sum. A product in [1,2) has its leading one at position wF+g:
+		// g = intlog2(n)+4+maxCancellation guard bits allow maxCancellation bits of cancellation.
+		// Beyond, the result is faithful only if the sum of the aligned products is exact:
+		// otherwise NotFaithful is raised.
+		g  = intlog2(n) + 4 + maxCancellation;
+		wP = wF + g + 2;              // aligned product, MSB of weight 2^1 since products are in [1,4)
+		wS = wP + intlog2(n) + 1;     // n such products, plus a sign bit
+		int wM = wS - 1;              // magnitude of the sum
+		maxLZC = wM - 5 - wF - intlog2(n); // largest leading zero count of the sum with a faithful result
+		int bias = (1<<(wE-1)) - 1;
+		int wER = wE + 3;             // result exponent, signed, before overflow/underflow detection
+		REPORT(DETAILED, "guard bits g=" << g << ", aligned product size wP=" << wP << ", sum size wS=" << wS);
+
+		for(int i=0; i<n; i++) {
+			addFPInput(join("X",i), wE, wF);
+			addFPInput(join("Y",i), wE, wF);
+		}
+		addFPOutput("R", wE, wF, 2);
+		addOutput("NotFaithful");
+
+		setCriticalPath(getMaxInputDelays(inputDelays));
+
+		//---------------------------------------------------------------------
+		// Exceptions and exponents of the products
+		for(int i=0; i<n; i++) {
+			vhdl << tab << declare(join("exnX",i), 2) << " <= " << join("X",i) << range(wE+wF+2, wE+wF+1) << ";" << endl;
+			vhdl << tab << declare(join("exnY",i), 2) << " <= " << join("Y",i) << range(wE+wF+2, wE+wF+1) << ";" << endl;
+			vhdl << tab << declare(join("sP",i)) << " <= " << join("X",i) << of(wE+wF) << " xor " << join("Y",i) << of(wE+wF) << ";" << endl;
+			vhdl << tab << declare(join("isNormal",i)) << " <= '1' when " << join("exnX",i) << "=\"01\" and " << join("exnY",i) << "=\"01\" else '0';" << endl;
+			vhdl << tab << declare(join("isNaN",i)) << " <= '1' when " << join("exnX",i) << "=\"11\" or " << join("exnY",i) << "=\"11\""
+					 << " or (" << join("exnX",i) << "=\"10\" and " << join("exnY",i) << "=\"00\")"
+					 << " or (" << join("exnX",i) << "=\"00\" and " << join("exnY",i) << "=\"10\") else '0';" << endl;
+			vhdl << tab << declare(join("isInf",i)) << " <= '1' when (" << join("exnX",i) << "=\"10\" or " << join("exnY",i) << "=\"10\") and " << join("isNaN",i) << "='0' else '0';" << endl;
+		}
+
+		vhdl << tab << declare("anyNaN") << " <= ";
+		for(int i=0; i<n; i++)
+			vhdl << join("isNaN",i) << (i<n-1 ? " or " : ";\n");
+		vhdl << tab << declare("infPos") << " <= ";
+		for(int i=0; i<n; i++)
+			vhdl << "(" << join("isInf",i) << " and not " << join("sP",i) << ")" << (i<n-1 ? " or " : ";\n");
+		vhdl << tab << declare("infNeg") << " <= ";
+		for(int i=0; i<n; i++)
+			vhdl << "(" << join("isInf",i) << " and " << join("sP",i) << ")" << (i<n-1 ? " or " : ";\n");
+
+		// The exponent of a product (biased twice); the non-normal products get the smallest exponent
+		addEstimatedAdderCost(wE+1);
+		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1));
+		for(int i=0; i<n; i++) {
+			vhdl << tab << declare(join("EP",i), wE+1) << " <= (\"0\" & " << join("X",i) << range(wE+wF-1, wF) << ") + (\"0\" & " << join("Y",i) << range(wE+wF-1, wF) << ")"
+					 << " when " << join("isNormal",i) << "='1' else " << zg(wE+1) << ";" << endl;
+		}
+
+		// Max of the exponents, by a binary tree of comparators
+		vector<string> level;
+		for(int i=0; i<n; i++)
+			level.push_back(join("EP",i));
+		int l=0;
+		while(level.size()>1) {
+			addEstimatedAdderCost(wE+1);
+			manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1) + target->lutDelay());
+			vector<string> next;
+			for(unsigned j=0; j+1<level.size(); j+=2) {
+				string e = join("EMax_", l, "_", j/2);
+				vhdl << tab << declare(e, wE+1) << " <= " << level[j] << " when " << level[j] << " > " << level[j+1] << " else " << level[j+1] << ";" << endl;
+				next.push_back(e);
+			}
+			if(level.size() % 2 == 1)
+				next.push_back(level.back());
+			level = next;
+			l++;
+		}
+		vhdl << tab << declare("EMax", wE+1) << " <= " << level[0] << ";" << endl;
+
+		// The shift values. A product shifted by wP or more is completely shifted out.
+		int sizeRightShift = intlog2(wP);
+		addEstimatedAdderCost(wE+1);
+		manageCriticalPath(target->localWireDelay(n) + target->adderDelay(wE+1));
+		for(int i=0; i<n; i++) {
+			vhdl << tab << declare(join("fullShiftVal",i), wE+1) << " <= EMax - " << join("EP",i) << "; -- positive result" << endl;
+		}
+		addEstimatedAdderCost(wE+1);
+		manageCriticalPath(target->localWireDelay() + target->adderDelay(wE+1) + target->lutDelay());
+		for(int i=0; i<n; i++) {
+			string fsv = join("fullShiftVal",i);
+			vhdl << tab << declare(join("shiftVal",i), sizeRightShift) << " <= ";
+			if(wE+1 >= sizeRightShift) {
+				vhdl << fsv << range(sizeRightShift-1, 0);
+				if((wP >> (wE+1)) == 0) // otherwise fullShiftVal is always smaller than wP
+					vhdl << " when " << fsv << " < CONV_STD_LOGIC_VECTOR(" << wP << "," << wE+1 << ")" << endl
+							 << tab << tab << "    else CONV_STD_LOGIC_VECTOR(" << wP << "," << sizeRightShift << ")";
+			}
+			else
+				vhdl << zg(sizeRightShift-wE-1) << " & " << fsv;
+			vhdl << ";" << endl;
+		}
+		double cpShiftVal = getCriticalPath();
+
+		//---------------------------------------------------------------------
+		// Back to cycle 0 for the significand datapath
+		setCycle(0);
+		setCriticalPath(getMaxInputDelays(inputDelays));
+
+		IntMultiplier* mult = new IntMultiplier(target, 1+wF, 1+wF, 0 /* untruncated */, false /* unsigned */,
+		                                        inDelayMap("X", target->localWireDelay() + getCriticalPath()));
+		addSubComponent(mult);
+		for(int i=0; i<n; i++) {
+			vhdl << tab << declare(join("mX",i), wF+1) << " <= '1' & " << join("X",i) << range(wF-1, 0) << ";" << endl;
+			vhdl << tab << declare(join("mY",i), wF+1) << " <= '1' & " << join("Y",i) << range(wF-1, 0) << ";" << endl;
+			inPortMap (mult, "X", join("mX",i));
+			inPortMap (mult, "Y", join("mY",i));
+			outPortMap(mult, "R", join("mP",i));
+			vhdl << instance(mult, join("SignificandMultiplier",i));
+		}
+		syncCycleFromSignal(join("mP",n-1), false);
+		setCriticalPath(mult->getOutputDelay("R"));
+
+		// Truncate the products to wP bits, and zero the non-normal ones
+		int prodSize = 2*wF+2;
+		manageCriticalPath(target->localWireDelay() + target->lutDelay());
+		for(int i=0; i<n; i++) {
+			vhdl << tab << declare(join("P",i), wP) << " <= ";
+			if(wP <= prodSize)
+				vhdl << join("mP",i) << range(prodSize-1, prodSize-wP);
+			else
+				vhdl << join("mP",i) << " & " << zg(wP-prodSize);
+			vhdl << " when " << join("isNormal",i) << "='1' else " << zg(wP) << ";" << endl;
+			vhdl << tab << declare(join("truncatedP",i)) << " <= ";
+			if(wP < prodSize)
+				vhdl << join("isNormal",i) << " when " << join("mP",i) << range(prodSize-wP-1, 0) << " /= " << zg(prodSize-wP) << " else '0';" << endl;
+			else
+				vhdl << "'0';" << endl;
+		}
+
+		// Synchronize exponent and significand datapaths
+		syncCycleFromSignal(join("shiftVal",n-1), cpShiftVal, false);
+
+		Shifter* rightShifter = new Shifter(target, wP, wP, Shifter::Right, inDelayMap("X", target->localWireDelay() + getCriticalPath()));
+		addSubComponent(rightShifter);
+		for(int i=0; i<n; i++) {
+			inPortMap  (rightShifter, "X", join("P",i));
+			inPortMap  (rightShifter, "S", join("shiftVal",i));
+			outPortMap (rightShifter, "R", join("shiftedP",i));
+			vhdl << instance(rightShifter, join("AlignmentShifter",i));
+		}
+		syncCycleFromSignal(join("shiftedP",n-1), false);
+		setCriticalPath(rightShifter->getOutputDelay("R"));
+
+		// Ignore the bits that are shifted out, and prepare the signed summands:
+		// a negative product is complemented here, the missing 1 is added to the bit heap
+		int shiftedSize = getSignalByName(join("shiftedP",0))->width();
+		manageCriticalPath(target->localWireDelay() + target->lutDelay());
+		for(int i=0; i<n; i++) {
+			vhdl << tab << declare(join("alignedP",i), wP) << " <= " << join("shiftedP",i) << range(shiftedSize-1, shiftedSize-wP) << ";" << endl;
+			vhdl << tab << declare(join("summand",i), wP+1) << " <= " << join("sP",i) << " & (" << join("alignedP",i)
+					 << " xor " << rangeAssign(wP-1, 0, join("sP",i)) << ");" << endl;
+			vhdl << tab << declare(join("lostBits",i)) << " <= '1' when " << join("truncatedP",i) << "='1'"
+					 << " or " << join("shiftedP",i) << range(shiftedSize-wP-1, 0) << " /= " << zg(shiftedSize-wP) << " else '0';" << endl;
+		}
+		// Is the sum of the aligned products exact?
+		vhdl << tab << declare("inexactSum") << " <= ";
+		for(int i=0; i<n; i++)
+			vhdl << join("lostBits",i) << (i<n-1 ? " or " : ";\n");
+
+		//---------------------------------------------------------------------
+		// The single bit heap
+		BitHeap* bitHeap = new BitHeap(this, wS, false, "sop");
+		for(int i=0; i<n; i++) {
+			bitHeap->addSignedBitVector(0, join("summand",i), wP+1);
+			bitHeap->addBit(0, join("sP",i));
+		}
+		bitHeap->generateCompressorVHDL();
+		vhdl << tab << declare("sum", wS) << " <= " << bitHeap->getSumName(wS-1, 0) << ";" << endl;
+
+		//---------------------------------------------------------------------
+		// Sign-magnitude conversion
+		manageCriticalPath(target->localWireDelay(wS) + target->lutDelay());
+		vhdl << tab << declare("sumSign") << " <= sum" << of(wS-1) << ";" << endl;
+		vhdl << tab << declare("sumZero") << " <= '1' when sum = " << zg(wS) << " else '0';" << endl;
+		vhdl << tab << declare("sumXor", wM) << " <= sum" << range(wM-1, 0) << " xor " << rangeAssign(wM-1, 0, "sumSign") << ";" << endl;
+
+		IntAdder* absAdder = new IntAdder(target, wM, inDelayMap("X", target->localWireDelay() + getCriticalPath()));
+		addSubComponent(absAdder);
+		inPortMap   (absAdder, "X", "sumXor");
+		inPortMapCst(absAdder, "Y", zg(wM));
+		inPortMap   (absAdder, "Cin", "sumSign");
+		outPortMap  (absAdder, "R", "absSum");
+		vhdl << instance(absAdder, "AbsAdder");
+		syncCycleFromSignal("absSum", false);
+		setCriticalPath(absAdder->getOutputDelay("R"));
+
+		// Normalization
+		LZOCShifterSticky* lzocs = new LZOCShifterSticky(target, wM, wF+2, intlog2(wM), true, 0, inDelayMap("I", target->localWireDelay() + getCriticalPath()));
+		addSubComponent(lzocs);
+		int countWidth = lzocs->getCountWidth();
+		inPortMap (lzocs, "I", "absSum");
+		outPortMap(lzocs, "Count", "lzc");
+		outPortMap(lzocs, "O", "normSum");
+		outPortMap(lzocs, "Sticky", "sticky");
+		vhdl << instance(lzocs, "Normalizer");
+		syncCycleFromSignal("normSum", false);
+		setCriticalPath(lzocs->getOutputDelay("O"));
+
+		// The leading one of absSum has weight EMax-2*bias+1+(wM-wP)-lzc
+		addEstimatedAdderCost(wER);
+		manageCriticalPath(target->localWireDelay() + target->adderDelay(wER));
+		vhdl << tab << declare("expR", wER) << " <= (\"00\" & EMax) + CONV_STD_LOGIC_VECTOR(" << wS-wP-bias << "," << wER << ")"
+				 << " - (" << zg(wER-countWidth) << " & lzc);" << endl;
+
+		// Round to nearest even. The carry of the rounding may propagate into the exponent
+		vhdl << tab << declare("roundUp") << " <= normSum(0) and (normSum(1) or sticky);" << endl;
+		vhdl << tab << declare("expFracR", wER+wF) << " <= expR & normSum" << range(wF, 1) << ";" << endl;
+
+		IntAdder* roundingAdder = new IntAdder(target, wER+wF, inDelayMap("X", target->localWireDelay() + getCriticalPath()));
+		addSubComponent(roundingAdder);
+		inPortMap   (roundingAdder, "X", "expFracR");
+		inPortMapCst(roundingAdder, "Y", zg(wER+wF));
+		inPortMap   (roundingAdder, "Cin", "roundUp");
+		outPortMap  (roundingAdder, "R", "roundedExpFrac");
+		vhdl << instance(roundingAdder, "RoundingAdder");
+		syncCycleFromSignal("roundedExpFrac", false);
+		setCriticalPath(roundingAdder->getOutputDelay("R"));
+
+		//---------------------------------------------------------------------
+		// Exceptions
+		manageCriticalPath(target->localWireDelay() + 2*target->lutDelay());
+		vhdl << tab << declare("underflow") << " <= roundedExpFrac" << of(wER+wF-1) << ";" << endl;
+		vhdl << tab << declare("overflow") << " <= '1' when underflow='0' and roundedExpFrac" << range(wER+wF-2, wE+wF) << " /= " << zg(wER-1-wE) << " else '0';" << endl;
+		vhdl << tab << declare("exnR", 2) << " <= \"11\" when anyNaN='1' or (infPos='1' and infNeg='1')" << endl
+				 << tab << tab << "else \"10\" when infPos='1' or infNeg='1' or (overflow='1' and sumZero='0')" << endl
+				 << tab << tab << "else \"00\" when sumZero='1' or underflow='1'" << endl
+				 << tab << tab << "else \"01\";" << endl;
+		vhdl << tab << declare("signR") << " <= infNeg when (infPos='1' or infNeg='1') else sumSign;" << endl;
+
+		vhdl << tab << "R <= exnR & signR & roundedExpFrac" << range(wE+wF-1, 0) << ";" << endl;
+		// Cancellation beyond the guard bits, and an inexact sum of the aligned products
+		vhdl << tab << "NotFaithful <= '1' when inexactSum='1' and lzc > CONV_STD_LOGIC_VECTOR(" << maxLZC << "," << countWidth << ")"
+				 << " and anyNaN='0' and infPos='0' and infNeg='0' else '0';" << endl;
+		outDelayMap["R"] = getCriticalPath();
+	}
+
+	FPSumOfProducts::~FPSumOfProducts() {
+	}
+
+
+
+	void FPSumOfProducts::emulate(TestCase * tc)
+	{
+		/* The expected result is a faithful rounding of the exact sum of products, computed with MPFR.
+			 NotFaithful is computed by a bit-exact model of the alignment:
+			 when it is raised, the expected R is the rounding of the sum of the aligned products */
+		int bias = (1<<(wE-1)) - 1;
+		int prodSize = 2*wF+2;
+		mpz_class fracMask = (mpz_class(1) << wF) - 1;
+		mpz_class expMask  = (mpz_class(1) << wE) - 1;
+		bool anyNaN=false, infPos=false, infNeg=false;
+		vector<mpz_class> E(n), P(n);
+		vector<int> S(n);
+		vector<bool> isNormal(n);
+		mpz_class EMax = 0;
+		mpz_class EMin = -1;
+
+		for(int i=0; i<n; i++) {
+			mpz_class svX = tc->getInputValue(join("X",i));
+			mpz_class svY = tc->getInputValue(join("Y",i));
+			int exnX = mpz_class(svX >> (wE+wF+1)).get_si();
+			int exnY = mpz_class(svY >> (wE+wF+1)).get_si();
+			S[i] = mpz_class(((svX ^ svY) >> (wE+wF)) & 1).get_si();
+
+			bool isNaN = (exnX==3) || (exnY==3) || (exnX==2 && exnY==0) || (exnX==0 && exnY==2);
+			bool isInf = !isNaN && (exnX==2 || exnY==2);
+			anyNaN |= isNaN;
+			if(isInf) {
+				if(S[i]==0) infPos=true;
+				else        infNeg=true;
+			}
+
+			isNormal[i] = (exnX==1 && exnY==1);
+			if(isNormal[i]) {
+				E[i] = ((svX >> wF) & expMask) + ((svY >> wF) & expMask);
+				P[i] = ((svX & fracMask) + (mpz_class(1) << wF)) * ((svY & fracMask) + (mpz_class(1) << wF));
+				if(EMin < 0 || E[i] < EMin)
+					EMin = E[i];
+			}
+			else {
+				E[i] = 0;
+				P[i] = 0;
+			}
+			if(E[i] > EMax)
+				EMax = E[i];
+		}
+
+		if(anyNaN || (infPos && infNeg)) {
+			tc->addExpectedOutput("R", mpz_class(3) << (wE+wF+1));
+			tc->addExpectedOutput("NotFaithful", 0);
+			return;
+		}
+		if(infPos || infNeg) {
+			tc->addExpectedOutput("R", (mpz_class(2) << (wE+wF+1)) + (mpz_class(infNeg?1:0) << (wE+wF)));
+			tc->addExpectedOutput("NotFaithful", 0);
+			return;
+		}
+
+		// Bit-exact model of the alignment, with truncation of the shifted-out bits
+		mpz_class sum = 0;
+		bool inexactSum = false;
+		for(int i=0; i<n; i++) {
+			mpz_class t;
+			if(wP <= prodSize) {
+				t = P[i] >> (prodSize-wP);
+				if((t << (prodSize-wP)) != P[i])
+					inexactSum = true;
+			}
+			else
+				t = P[i] << (wP-prodSize);
+			mpz_class d = EMax - E[i];
+			mpz_class a = 0;
+			if(d < wP)
+				a = t >> d.get_si();
+			if((a << d.get_si()) != t)
+				inexactSum = true;
+			if(S[i]==0)
+				sum += a;
+			else
+				sum -= a;
+		}
+		int wM = wS-1;
+		mpz_class absSum = abs(sum);
+		int lzc = (absSum==0 ? wM : wM - (int)mpz_sizeinbase(absSum.get_mpz_t(), 2));
+
+		if(inexactSum && lzc > maxLZC) {
+			// sum has LSB weight 2^(EMax-2*bias-(wP-2)); it is rounded once to the output format
+			mpfr_t r;
+			mpfr_init2(r, 1+wF);
+			mpfr_set_z(r, sum.get_mpz_t(), GMP_RNDN);
+			mpfr_mul_2si(r, r, EMax.get_si() - 2*bias - (wP-2), GMP_RNDN);
+			FPNumber fpr(wE, wF, r);
+			tc->addExpectedOutput("R", fpr.getSignalValue());
+			tc->addExpectedOutput("NotFaithful", 1);
+			mpfr_clear(r);
+			return;
+		}
+
+		// The exact sum, with LSB weight 2^(EMin-2*bias-2*wF)
+		mpz_class exactSum = 0;
+		for(int i=0; i<n; i++) {
+			if(isNormal[i]) {
+				if(S[i]==0)
+					exactSum += P[i] << mpz_class(E[i]-EMin).get_si();
+				else
+					exactSum -= P[i] << mpz_class(E[i]-EMin).get_si();
+			}
+		}
+		mpfr_t exact, rd, ru;
+		mpfr_init2(exact, mpz_sizeinbase(exactSum.get_mpz_t(), 2) + 1);
+		mpfr_inits2(1+wF, rd, ru, (mpfr_ptr) 0);
+		mpfr_set_z(exact, exactSum.get_mpz_t(), GMP_RNDN); // exact
+		if(EMin >= 0)
+			mpfr_mul_2si(exact, exact, EMin.get_si() - 2*bias - 2*wF, GMP_RNDN);
+		mpfr_set(rd, exact, GMP_RNDD);
+		mpfr_set(ru, exact, GMP_RNDU);
+		FPNumber fprd(wE, wF, rd);
+		FPNumber fpru(wE, wF, ru);
+		tc->addExpectedOutput("R", fprd.getSignalValue());
+		if(fpru.getSignalValue() != fprd.getSignalValue())
+			tc->addExpectedOutput("R", fpru.getSignalValue());
+		tc->addExpectedOutput("NotFaithful", 0);
+		mpfr_clears(exact, rd, ru, (mpfr_ptr) 0);
+	}
+
+
+
+	void FPSumOfProducts::buildStandardTestCases(TestCaseList* tcl){
+		TestCase *tc;
+
+		// all ones
+		tc = new TestCase(this);
+		for(int i=0; i<n; i++) {
+			tc->addFPInput(join("X",i), 1.0);
+			tc->addFPInput(join("Y",i), 1.0);
+		}
+		emulate(tc);
+		tcl->add(tc);
+
+		// exact cancellation
+		tc = new TestCase(this);
+		for(int i=0; i<n; i++) {
+			tc->addFPInput(join("X",i), (i%2==0 ? 1.5 : -1.5));
+			tc->addFPInput(join("Y",i), (i==n-1 && n%2==1 ? 0.0 : 3.0));
+		}
+		emulate(tc);
+		tcl->add(tc);
+
+		// cancellation of the large products, beyond the guard bits: NotFaithful
+		tc = new TestCase(this);
+		for(int i=0; i<n; i++) {
+			tc->addFPInput(join("X",i), (i==0 ? 1.0 : (i==1 ? -1.0 : 1.0/(1<<20))));
+			tc->addFPInput(join("Y",i), (i<2 ? 1.0 : 1.0/(1<<20)));
+		}
+		emulate(tc);
+		tcl->add(tc);
+
+		// one large product and small ones
+		tc = new TestCase(this);
+		for(int i=0; i<n; i++) {
+			tc->addFPInput(join("X",i), (i==0 ? 1024.0 : 0.001));
+			tc->addFPInput(join("Y",i), (i==0 ? 1.0 : -0.5));
+		}
+		emulate(tc);
+		tcl->add(tc);
+
+		// infinity times zero
+		tc = new TestCase(this);
+		for(int i=0; i<n; i++) {
+			tc->addFPInput(join("X",i), (i==0 ? FPNumber::plusInfty : FPNumber::largestPositive));
+			tc->addFPInput(join("Y",i), (i==0 ? FPNumber::plusDirtyZero : FPNumber::smallestPositive));
+		}
+		emulate(tc);
+		tcl->add(tc);
+
+		// opposite infinities
+		tc = new TestCase(this);
+		for(int i=0; i<n; i++) {
+			tc->addFPInput(join("X",i), (i<2 ? FPNumber::plusInfty : FPNumber::plusDirtyZero));
+			tc->addFPInput(join("Y",i), (i==0 ? 2.0 : -2.0));
+		}
+		emulate(tc);
+		tcl->add(tc);
+	}
+
+
+
+	TestCase* FPSumOfProducts::buildRandomTestCase(int i){
+		TestCase *tc;
+		mpz_class normalExn = mpz_class(1)<<(wE+wF+1);
+		mpz_class bias = (mpz_class(1)<<(wE-1)) - 1;
+
+		tc = new TestCase(this);
+		for(int j=0; j<n; j++) {
+			mpz_class x, y;
+			if((i & 7) == 7) { // fully random
+				x = getLargeRandom(wE+wF+3);
+				y = getLargeRandom(wE+wF+3);
+			}
+			else { // normal numbers with exponents close to the bias, so that the products overlap
+				int spread = ((i & 7) == 0 ? 1 : intlog2(wF)+1);
+				mpz_class ex = bias - (mpz_class(1) << (spread-1)) + getLargeRandom(spread);
+				mpz_class ey = bias - (mpz_class(1) << (spread-1)) + getLargeRandom(spread);
+				x = normalExn + (getLargeRandom(1) << (wE+wF)) + (ex << wF) + getLargeRandom(wF);
+				y = normalExn + (getLargeRandom(1) << (wE+wF)) + (ey << wF) + getLargeRandom(wF);
+			}
+			tc->addInput(join("X",j), x);
+			tc->addInput(join("Y",j), y);
+		}
+		/* Get correct outputs */
+		emulate(tc);
+		return tc;
+	}
+
+
+
+	OperatorPtr FPSumOfProducts::parseArguments(Target *target, vector<string> &args) {
+		int wE, wF, n, maxCancellation;
+		UserInterface::parseStrictlyPositiveInt(args, "wE", &wE);
+		UserInterface::parseStrictlyPositiveInt(args, "wF", &wF);
+		UserInterface::parseStrictlyPositiveInt(args, "n", &n);
+		UserInterface::parseInt(args, "maxCancellation", &maxCancellation);
+		if(maxCancellation==-1)
+			maxCancellation = wF;
+		return new FPSumOfProducts(target, wE, wF, n, maxCancellation);
+	}
+
+	void FPSumOfProducts::registerFactory(){
+		UserInterface::add("FPSumOfProducts", // name
+											 "Floating-point sum of n products, with a single rounding.",
+											 "CompositeFloatingPoint",
+											 "FPDotProduct", // seeAlso
+											 "wE(int): exponent size in bits; \
+                        wF(int): mantissa size in bits; \
+                        n(int): number of products; \
+                        maxCancellation(int)=-1: number of bits of cancellation with a guaranteed faithful result, -1 selects wF",
+											 "Computes X0*Y0+...+X(n-1)*Y(n-1). The significand products are aligned to the largest one and summed in a single bit heap, then the sum is normalized and rounded once. This is much smaller and faster than a tree of FPMult and FPAdd. The result is a faithful rounding of the exact sum as long as the cancellation among the products is at most maxCancellation bits, each of which costs one guard bit, or when no bit is lost in the alignment. Otherwise the output NotFaithful is raised. For an exact (Kulisch) accumulation, see FPDotProduct.",
+											 FPSumOfProducts::parseArguments
+											 ) ;
+	}
+}
@@ -0,0 +1,69 @@
+#ifndef FPSUMOFPRODUCTS_HPP
+#define FPSUMOFPRODUCTS_HPP
+#include <vector>
+#include <sstream>
+#include <gmp.h>
+#include <mpfr.h>
+#include <gmpxx.h>
+
+#include "Operator.hpp"
+#include "ShiftersEtc/Shifters.hpp"
+#include "ShiftersEtc/LZOCShifterSticky.hpp"
+#include "IntAddSubCmp/IntAdder.hpp"
+#include "IntMult/IntMultiplier.hpp"
+#include "TestBenches/FPNumber.hpp"
+#include "utils.hpp"
+
+namespace flopoco{
+
+	/** The FPSumOfProducts class: computes X0*Y0 + ... + X(n-1)*Y(n-1) with a single rounding.
+	 * All the significand products are aligned to the largest one and summed in a single bit heap.
+	 * The aligned products are truncated g bits below the rounding position of the largest product.
+	 * The result R is a faithful rounding of the exact sum when the cancellation is at most maxCancellation bits,
+	 * or when the sum of the aligned products is exact. Otherwise, the output NotFaithful is set.
+	 */
+	class FPSumOfProducts : public Operator
+	{
+	public:
+
+		/**
+		 * The FPSumOfProducts constructor
+		 * @param[in]		target	the target device
+		 * @param[in]		wE			the width of the exponent of the inputs and output
+		 * @param[in]		wF      the width of the fraction of the inputs and output
+		 * @param[in]		n       the number of products
+		 * @param[in]		maxCancellation the number of bits of cancellation that keep the result faithful
+		 **/
+		FPSumOfProducts(Target* target, int wE, int wF, int n, int maxCancellation, map<string, double> inputDelays = emptyDelayMap);
+
+		/**
+		 * FPSumOfProducts destructor
+		 */
+		~FPSumOfProducts();
+
+		void emulate(TestCase * tc);
+
+		void buildStandardTestCases(TestCaseList* tcl);
+
+		TestCase* buildRandomTestCase(int i);
+
+		/** Factory method that parses arguments and calls the constructor */
+		static OperatorPtr parseArguments(Target *target , vector<string> &args);
+
+		/** Factory register method */
+		static void registerFactory();
+
+	protected:
+		int wE;  /**< The width of the exponent */
+		int wF;  /**< The width of the fraction */
+		int n;   /**< The number of products */
+		int maxCancellation; /**< The number of bits of cancellation with a guaranteed faithful result */
+
+	private:
+		int g;   /**< The number of guard bits below the rounding position of the largest product */
+		int wP;  /**< The width of an aligned product (MSB has weight 2^1) */
+		int wS;  /**< The width of the bit heap sum, sign included */
+		int maxLZC; /**< The largest leading zero count of the magnitude of the sum that ensures a faithful result */
+	};
+}
+#endif
@@ -34,9 +34,9 @@ using namespace std;
 
 namespace flopoco{
 
-	LargeAccToFP::LargeAccToFP(Target* target, int MSBA, int LSBA, int wEOut, int wFOut): 
+	LargeAccToFP::LargeAccToFP(Target* target, int MSBA, int LSBA, int wEOut, int wFOut, bool carrySave): 
 		Operator(target), 
-		LSBA_(LSBA), MSBA_(MSBA), wEOut_(wEOut), wFOut_(wFOut)
+		LSBA_(LSBA), MSBA_(MSBA), wEOut_(wEOut), wFOut_(wFOut), carrySave_(carrySave)
 	{
 		srcFileName = "LargeAccToFP";
 		ownTarget_ = target;
@@ -56,25 +56,23 @@ namespace flopoco{
 		addInput("AccOverflow");
 		addFPOutput ("R", wEOut_, wFOut_);
 
-		vhdl << tab <<declare("signA") << " <= A" << of(sizeAcc_-1)<<";"<<endl;
-		vhdl << tab <<declare("signC") << " <= C" << of(sizeAcc_-1)<<";"<<endl;
-		
 		vhdl << tab <<declare("AccOverflowFlag") << " <= AccOverflow;"<<endl;	
 
-		vhdl << tab << declare("extA", sizeAcc_+1) << " <= signA & A;"<<endl;
-		vhdl << tab << declare("extC", sizeAcc_+1) << " <= signC & C;"<<endl;
-		
-		IntAdder *a = new IntAdder(target, sizeAcc_+1);
+		/* A+C is only defined modulo 2^sizeAcc_: with a carry-save accumulator, 
+			 C is a full-width carry vector, and sign-extending A and C separately 
+			 would be wrong. Therefore add them on sizeAcc_ bits and sign-extend the sum. */
+		IntAdder *a = new IntAdder(target, sizeAcc_);
 		addSubComponent(a);
 	
-		inPortMap( a,   "X",   "extA");
-		inPortMap( a,   "Y",   "extC");
+		inPortMap( a,   "X",   "A");
+		inPortMap( a,   "Y",   "C");
 		inPortMapCst(a, "Cin", "'0'");
-		outPortMap( a,  "R",   "acc");
+		outPortMap( a,  "R",   "accSum");
 		vhdl << instance(a,    "CarryPropagation");
 	
-		syncCycleFromSignal("acc");
+		syncCycleFromSignal("accSum");
 		setCriticalPath( a->getOutputDelay("R"));
+		vhdl << tab << declare("acc", sizeAcc_+1) << " <= accSum" << of(sizeAcc_-1) << " & accSum;" << endl;
 		setSignalDelay( "acc", getCriticalPath());
 
 		vhdl << tab << declare("resSign") << " <= acc" << of(sizeAcc_) << ";" << endl;
@@ -96,22 +94,26 @@ namespace flopoco{
 		setCriticalPath( lzocShifterSticky_->getOutputDelay("O") );	
 		setSignalDelay("resFrac",getCriticalPath());
 
+		addEstimatedAdderCost(countWidth_+1);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(countWidth_+1));
 		vhdl << tab <<declare("unbiasedExp", countWidth_+1) << " <= CONV_STD_LOGIC_VECTOR("<<MSBA_+1<<","<<countWidth_+1<<") - (\"0\" & nZO);"<<endl;
 		expBias_ =  intpow2(wEOut-1) - 1;
 		if (countWidth_+1 < wEOut_){
 			/* accumulator does not cover all exponent range */
+			addEstimatedAdderCost(wEOut_);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEOut_));
 			vhdl << tab << declare("bias"     , wEOut_) << " <= CONV_STD_LOGIC_VECTOR("<<expBias_<<","<<wEOut_<<");"<<endl; //fixed value
 			vhdl << tab << declare("expBiased", wEOut_) << " <= bias + ("<< rangeAssign(wEOut_-1,countWidth_+1, "unbiasedExp"+of(countWidth_))<<" & unbiasedExp);"<<endl;
 			vhdl << tab << declare("excBits"  , 2)      << " <=\"01\";"<<endl;
 		} else if (countWidth_+1 == wEOut_){
+			addEstimatedAdderCost(wEOut_);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEOut_));
 			vhdl << tab << declare("bias"     ,wEOut_) << " <= CONV_STD_LOGIC_VECTOR("<<expBias_<<","<<wEOut_<<");"<<endl; //fixed value
 			vhdl << tab << declare("expBiased",wEOut_) << " <= bias + unbiasedExp;"<<endl;
 			vhdl << tab << declare("excBits"  ,2)      << " <=\"01\";"<<endl;
 		}else{
 			/* acc covers more range than destination output format */
+			addEstimatedAdderCost(countWidth_+1);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(countWidth_+1));
 			vhdl << tab << declare("bias"   , countWidth_+1) << " <= CONV_STD_LOGIC_VECTOR("<<expBias_<<","<<countWidth_+1<<");"<<endl; 
 			vhdl << tab << declare("expExt" , countWidth_+1) << " <= bias + unbiasedExp;"<<endl;
@@ -170,11 +172,11 @@ namespace flopoco{
 		
 	
 		mpz_class newAcc;
-		newAcc = svA + svC;
-				  	
 		mpz_class tmpSUB = (mpz_class(1) << (MSBA_ - LSBA_+1))    ;
 		mpz_class tmpCMP = (mpz_class(1) << (MSBA_ - LSBA_  )) - 1;
 
+		// the sum is computed modulo 2^sizeAcc_
+		newAcc = (svA + svC) & (tmpSUB - 1);
 		if (newAcc > tmpCMP)
 			newAcc = newAcc - tmpSUB;
 
@@ -237,7 +239,9 @@ namespace flopoco{
 
 		tc->addInput("A", A);
 		
-		if (k==1)
+		if (carrySave_)
+			tc->addInput("C", getLargeRandom(MSBA_-LSBA_) << 1);
+		else if (k==1)
 			tc->addInput("C", mpz_class(0));
 		else{
 			for (int j=0;j<k-1;j++){
@@ -256,11 +260,13 @@ namespace flopoco{
 	
 	OperatorPtr LargeAccToFP::parseArguments(Target *target, vector<string> &args) {
 		int MSBA, LSBA, wE_out, wF_out;
+		bool carrySave;
 		UserInterface::parseStrictlyPositiveInt(args, "wE_out", &wE_out); 
 		UserInterface::parseStrictlyPositiveInt(args, "wF_out", &wF_out);
 		UserInterface::parseInt(args, "MSBA", &MSBA);
 		UserInterface::parseInt(args, "LSBA", &LSBA);
-		return new LargeAccToFP(target, MSBA, LSBA, wE_out, wF_out);
+		UserInterface::parseBoolean(args, "carrySave", &carrySave);
+		return new LargeAccToFP(target, MSBA, LSBA, wE_out, wF_out, carrySave);
 	}
 
 	void LargeAccToFP::registerFactory(){
@@ -271,7 +277,8 @@ namespace flopoco{
 											 "wE_out(int): the width of the output exponent ; \
                         wF_out(int): the width of the output fractional part;  \
                         MSBA(int): the weight of the most significand bit of the accumulator; \
-                        LSBA(int): the weight of the least significand bit of the accumulator",
+                        LSBA(int): the weight of the least significand bit of the accumulator; \
+                        carrySave(bool)=false: set to true when the accumulator was built with carrySave=true",
 											 "Converts the (fixed-point) output of FPLargeAcc or FPDotProduct (with the same parameters) into a floating-point number.  <br> For details on the technique used and an example of application, see <a href=\"bib/flopoco.html#DinechinPascaCret2008:FPT\">this article</a>",
 											 LargeAccToFP::parseArguments
 											 ) ;
@@ -23,8 +23,9 @@ namespace flopoco{
 		 * @param MSBA the weight of the most significand bit of the accumulator
 		 * @param wEOut the width of the output exponent 
 		 * @param eFOut the width of the output fractional part
+		 * @param carrySave true if C is a full carry-save vector (FPLargeAcc with carrySave)
 		 */ 
-		LargeAccToFP(Target* target, int MSBA, int LSBA, int wEOut, int wFOut);
+		LargeAccToFP(Target* target, int MSBA, int LSBA, int wEOut, int wFOut, bool carrySave=false);
 
 		/** Destructor */
 		~LargeAccToFP();
@@ -47,6 +48,7 @@ namespace flopoco{
 		int MSBA_;    /**< the weight of the most significand bit of the accumulator */
 		int wEOut_;   /**< the width of the output exponent */
 		int wFOut_;   /**< the width of the output fractional part */
+		bool carrySave_; /**< true if C is a full carry-save vector */
 
 	private:
 		Target* ownTarget_;
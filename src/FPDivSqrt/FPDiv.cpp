@@ -40,7 +40,7 @@ namespace flopoco{
 #define DEBUGVHDL 0
 
 
-	FPDiv::FPDiv(Target* target, int wE, int wF, int radix) :
+	FPDiv::FPDiv(Target* target, int wE, int wF, int radix, int prescaling) :
 		Operator(target), wE(wE), wF(wF) {
 
 		int i;
@@ -51,20 +51,77 @@ namespace flopoco{
 		name<<"FPDiv_"<<wE<<"_"<<wF;
 		setNameWithFreq(name.str());
 
-		if(radix !=0  && radix!=4 && radix !=8) {
-			THROWERROR("Got radix = " << radix << ". Only possible choices for radix are 0, 4 or 8" );
+		if(radix !=0  && radix!=4 && radix !=8 && radix !=16) {
+			THROWERROR("Got radix = " << radix << ". Only possible choices for radix are 0, 4, 8 or 16" );
 		}
-		
-		if(radix==0){ // 0 means "let FloPoCo choose"
-			if( (target->lutInputs() <= 4) || (!target->isPipelined()))
-				radix=4;
+		if(prescaling<-1 || prescaling>1) {
+			THROWERROR("Got prescaling = " << prescaling << ". Only possible choices for prescaling are -1, 0 or 1" );
+		}
+		if(radix==8 && prescaling==0) {
+			THROWERROR("Radix 8 always prescales the operands, prescaling=0 is not an option" );
+		}
+
+		// The delay of one iteration for each radix.
+		// The radix-4 selection table has 5 inputs: 4 bits of the partial remainder and one bit of the divisor.
+		// It needs two LUT levels on 4-input LUTs. With prescaling, the divisor is in [3/4, 1[ and the table only has 4 inputs.
+		// Radix 16 overlaps two radix-4 iterations: the second digit is selected speculatively for each value of the first one,
+		// so the second selection table is replaced with a mux controlled by the carry of the first addition.
+		double selTableDelay = (target->lutInputs() >= 5 ? 1 : 2) * target->lutDelay();
+		double srt4stepdelay =  selTableDelay + target->lutDelay() + target->localWireDelay() + target->localWireDelay(wF+4) + target->adderDelay(wF+4);
+		double srt8stepdelay =  3*target->lutDelay() + 2*target->localWireDelay()+ target->localWireDelay(2*wF+14) + target->adderDelay(wF+7);
+		double srt16stepdelay =  2*srt4stepdelay - selTableDelay;
+		double srt4PrescaledStepdelay = srt4stepdelay - selTableDelay + target->lutDelay();
+		double srt16PrescaledStepdelay = 2*srt4PrescaledStepdelay - target->lutDelay();
+		// The prescaling multiplies X and Y by 1, 5/4 or 3/2 depending on the two leading bits of Y: one addition and a mux
+		double prescalingDelay = target->adderDelay(wF+4) + target->lutDelay() + target->localWireDelay();
+
+		if(radix==0){ // 0 means "let FloPoCo choose": minimize the number of cycles (or the delay if not pipelined), then the radix
+			int nDigit4 = (wF+6) >> 1;
+			int nDigit8 = floor(((double)(wF + 9))/3);
+			int candidateRadix[5] = {4, 4, 8, 16, 16};
+			int candidatePrescaling[5] = {0, 1, 1, 0, 1};
+			int nbIterations[5] = {nDigit4-1, nDigit4-1, nDigit8-1, nDigit4/2, nDigit4/2};
+			double stepDelay[5] = {srt4stepdelay, srt4PrescaledStepdelay, srt8stepdelay, srt16stepdelay, srt16PrescaledStepdelay};
+			int bestCycles=0;
+			double bestDelay=0;
+			for(int j=0; j<5; j++) {
+				if(candidateRadix[j]==8 && target->lutInputs() <= 4) // the radix-8 selection table has 7 inputs
+					continue;
+				if(prescaling!=-1 && candidateRadix[j]!=8 && candidatePrescaling[j]!=prescaling)
+					continue;
+				if(prescaling==0 && candidateRadix[j]==8)
+					continue;
+				double delay = nbIterations[j]*stepDelay[j] + candidatePrescaling[j]*prescalingDelay;
+				int cycles = 0;
+				if(target->isPipelined()) {
+					int iterationsPerCycle = max(1, (int) floor(1/(target->frequency()*stepDelay[j])));
+					// the prescaling counts as a fraction of an iteration
+					double work = nbIterations[j] + candidatePrescaling[j]*prescalingDelay/stepDelay[j];
+					cycles = ceil(work / iterationsPerCycle);
+				}
+				REPORT(DETAILED, "Radix " << candidateRadix[j] << (candidatePrescaling[j] ? " with prescaling" : "") << ": "
+							 << nbIterations[j] << " iterations, delay " << delay << ", " << cycles << " cycles");
+				if(radix==0 || cycles<bestCycles || (!target->isPipelined() && delay<bestDelay)) {
+					radix = candidateRadix[j];
+					prescaling = candidatePrescaling[j];
+					bestCycles = cycles;
+					bestDelay = delay;
+				}
+			}
+			REPORT(INFO, "Using radix " << radix << " SRT algorithm" << (prescaling==1 ? " with prescaling" : ""));
+		}
+		else if(prescaling==-1) { // radix given, only the prescaling to choose: prescale if it saves time
+			double nbIterations = (radix==16 ? ((wF+6)>>1)/2 : ((wF+6)>>1)-1);
+			if(radix==16)
+				prescaling = (nbIterations*srt16PrescaledStepdelay + prescalingDelay < nbIterations*srt16stepdelay ? 1 : 0);
 			else
-				radix=8;
-			REPORT(INFO, "Using radix " << radix << " SRT algorithm");
+				prescaling = (nbIterations*srt4PrescaledStepdelay + prescalingDelay < nbIterations*srt4stepdelay ? 1 : 0);
 		}
+		if(radix==8)
+			prescaling = 1;
+
 
 
-	 
 		if(radix==8)
 		{
 			int extraBit = 0;
@@ -101,6 +158,7 @@ namespace flopoco{
 			/////////////////////////////////////////////////////////////////////////Prescaling
 			//TODO : maybe we can reduce fX and fY
 			setCriticalPath(0);
+			addEstimatedAdderCost(wF+3);
 			manageCriticalPath(target->adderDelay(wF+3));
 			vhdl << tab << " -- Prescaling" << endl;
 			vhdl << tab << "with partialFY " << range(wF-1, wF-2) << " select" << endl;
@@ -120,8 +178,6 @@ namespace flopoco{
 			vhdl << tab << declare(wInit.str(), wF+6) << " <=  \"00\" & fX;" << endl; //TODO : review that
 
 
-			double srt8stepdelay =  3*target->lutDelay() + 2*target->localWireDelay()+ target->localWireDelay(2*wF+14) + target->adderDelay(wF+7);
-
 			SelFunctionTable* table;
 			table = new SelFunctionTable(target, 0.75, 1.0, 2, 5, 7, 8, 7, 4);
 			addSubComponent(table);
@@ -253,8 +309,15 @@ namespace flopoco{
 			}
 
 
-		else ////////////////////////// Radix 4 version  ////////////////////////
+		else ////////////////////////// Radix 4 and radix 16 version  ////////////////////////
 			//TODO : the old version is using 5-input's LUTs, try to fit in 4-input's LUTs (same as above : select qA and qB and make a 2-levels addition)
+			// Radix 16 performs the radix-4 iterations by pairs. The first iteration of a pair also computes,
+			// for each of the 7 possible values of its digit and each value of the carry into the selection bits,
+			// the selection bits of the second iteration (on a 4-bit adder) and the corresponding digit (in a selection table).
+			// The second digit is then selected by the first digit and by the actual carry, extracted from the first addition.
+			// This produces exactly the same digits as radix 4.
+			// With prescaling, X and Y are first multiplied by the same factor, so that the divisor is in [3/4, 1[ and
+			// the selection table no longer needs a bit of the divisor. All the remainder datapath is then 2 bits wider.
 		{
 			int alpha=3; // can be 3 or 2. At the moment, 2 doesn't work.
 			// -------- Parameter set up -----------------
@@ -264,8 +327,16 @@ namespace flopoco{
 			addFPInput ("Y", wE, wF);
 			addFPOutput("R", wE, wF);
 
-			vhdl << tab << declare("fX",wF+1) << " <= \"1\" & X(" << wF-1 << " downto 0);" << endl;
-			vhdl << tab << declare("fY",wF+1) << " <= \"1\" & Y(" << wF-1 << " downto 0);" << endl;
+			// With prescaling, the divisor gets 2 more bits: wW is the position of its leading one
+			int wW = (prescaling==1 ? wF+2 : wF);
+			if(prescaling==1) {
+				vhdl << tab << declare("partialFX",wF+1) << " <= \"1\" & X(" << wF-1 << " downto 0);" << endl;
+				vhdl << tab << declare("partialFY",wF+1) << " <= \"1\" & Y(" << wF-1 << " downto 0);" << endl;
+			}
+			else {
+				vhdl << tab << declare("fX",wF+1) << " <= \"1\" & X(" << wF-1 << " downto 0);" << endl;
+				vhdl << tab << declare("fY",wF+1) << " <= \"1\" & Y(" << wF-1 << " downto 0);" << endl;
+			}
 
 			vhdl << tab << "-- exponent difference, sign and exception combination computed early, to have less bits to pipeline" << endl;
 
@@ -279,20 +350,49 @@ namespace flopoco{
 			vhdl << tab << tab << tab << "\"00\"  when \"0001\" | \"0010\" | \"0110\", -- zero" <<endl;
 			vhdl << tab << tab << tab << "\"10\"  when \"0100\" | \"1000\" | \"1001\", -- overflow" <<endl;
 			vhdl << tab << tab << tab << "\"11\"  when others;                   -- NaN" <<endl;
+
+			if(prescaling==1) {
+				// Same prescaling as radix 8: both operands are multiplied by 3/2, 5/4 or 1 so that the divisor is in [3/4, 1[.
+				// The quotient is unchanged, and the selection function no longer depends on the divisor.
+				setCriticalPath(0);
+				manageCriticalPath(prescalingDelay);
+				vhdl << tab << " -- Prescaling" << endl;
+				vhdl << tab << "with partialFY " << range(wF-1, wF-2) << " select" << endl;
+				vhdl << tab << tab << declare("fY", wW+1) << " <= " << endl;
+				vhdl << tab << tab << tab << "(\"0\" & partialFY & \"0\") + (partialFY & \"00\") when \"00\","<<endl; // [1/2, 5/8[ * 3/2 => [3/4, 15/16[
+				vhdl << tab << tab << tab << "(\"00\" & partialFY) + (partialFY & \"00\") when \"01\","<<endl; // [5/8, 3/4[ * 5/4 => [25/32, 15/16[
+				vhdl << tab << tab << tab << "partialFY &\"00\" when others;"<<endl; // no prescaling
+
+				// X may grow up to 3: one more bit
+				vhdl << tab << "with partialFY " << range(wF-1, wF-2) << " select" << endl;
+				vhdl << tab << tab << declare("fX", wW+2) << " <= " << endl;
+				vhdl << tab << tab << tab << "(\"00\" & partialFX & \"0\") + (\"0\" & partialFX & \"00\") when \"00\","<<endl;
+				vhdl << tab << tab << tab << "(\"000\" & partialFX) + (\"0\" & partialFX & \"00\") when \"01\","<<endl;
+				vhdl << tab << tab << tab << "\"0\" & partialFX &\"00\" when others;"<<endl;
+			}
+
 			vhdl << tab << " -- compute 3Y" << endl;
-			vhdl << tab << declare("fYTimes3",wF+3) << " <= (\"00\" & fY) + (\"0\" & fY & \"0\");" << endl; // TODO an IntAdder here
+			vhdl << tab << declare("fYTimes3",wW+3) << " <= (\"00\" & fY) + (\"0\" & fY & \"0\");" << endl; // TODO an IntAdder here
 
 			ostringstream wInit;
 			wInit << "w"<<nDigit-1;
-			vhdl << tab << declare(wInit.str(), wF+3) <<" <=  \"00\" & fX;" << endl;
+			vhdl << tab << declare(wInit.str(), wW+3) <<" <=  " << (prescaling==1 ? "\"0\"" : "\"00\"") << " & fX;" << endl;
+
+			if(radix==16) {
+				vhdl << tab << declare("fYmult1", wW+4) << " <= \"000\" & fY;" << endl;
+				vhdl << tab << declare("fYmult2", wW+4) << " <= \"00\" & fY & \"0\";" << endl;
+				vhdl << tab << declare("fYmult3", wW+4) << " <= \"0\" & fYTimes3;" << endl;
+			}
 
 			//			nextCycle();/////////////////////////////////////////////////////////////
-			setCriticalPath(0);
+			if(prescaling==0)
+				setCriticalPath(0);
 
-			double srt4stepdelay =  2*target->lutDelay() + target->localWireDelay() + target->localWireDelay(wF+4) + target->adderDelay(wF+4);
 
 			SelFunctionTable* table;
-			if(alpha==3)
+			if(alpha==3 && prescaling==1) // The divisor is in [3/4, 1[: 4 bits of the partial remainder are enough (check with NbBitsMin dMin=0.75)
+				table = new SelFunctionTable(target, 0.75, 1.0, 0, 4, 3, 4, 4, 3);
+			else if(alpha==3)
 				table = new SelFunctionTable(target, 0.5, 1.0, 1, 4, 3, 4, 5, 3);
 			else if(alpha==2)
 				//				table = new SelFunctionTable(target, 0.5, 1.0, 3, 7, 2, 4, 10, 3);
@@ -301,8 +401,19 @@ namespace flopoco{
 			
 			addSubComponent(table);
 
+			if(radix==16 && alpha!=3)
+				THROWERROR("radix 16 is only implemented for alpha=3");
+			if(prescaling==1 && alpha!=3)
+				THROWERROR("prescaling is only implemented for alpha=3");
+
 			for(i=nDigit-1; i>=1; i--) {
-				manageCriticalPath(srt4stepdelay);
+				// In radix 16, the digit of the second iteration of a pair has been speculated by the first one
+				bool secondOfPair = (radix==16) && ((nDigit-1-i)%2 == 1);
+				bool firstOfPair = (radix==16) && !secondOfPair && (i>=2);
+				if(firstOfPair)
+					manageCriticalPath(prescaling==1 ? srt16PrescaledStepdelay : srt16stepdelay);
+				else if(!secondOfPair)
+					manageCriticalPath(prescaling==1 ? srt4PrescaledStepdelay : srt4stepdelay);
 
 				ostringstream wi, qi, wim1, seli, qiTimesD, wipad, wim1full, tInstance;
 				wi << "w" << i;						//actual partial remainder
@@ -328,15 +439,38 @@ namespace flopoco{
 						wi-1full = wi-qi*D
 					*	left shifting wi-1full to obtain wi-1, next partial remainder to work on
 				*/
-				if(alpha==3)
-					vhdl << tab << declare(seli.str(),5) << " <= " << wi.str() << range( wF+2, wF-1) << " & fY" << of(wF-1)  << ";" << endl;
-				else // alpha==2
-					vhdl << tab << declare(seli.str(),9) << " <= " << wi.str() << range( wF+2, wF-3) << " & fY" << range(wF-1,wF-3)  << ";" << endl;
-					//vhdl << tab << declare(seli.str(),10) << " <= " << wi.str() << range( wF+2, wF-4) << " & fY" << range(wF-1,wF-3)  << ";" << endl;
-					
-				inPortMap (table , "X", seli.str());
-				outPortMap(table , "Y", qi.str());
-				vhdl << instance(table , tInstance.str());
+				if(secondOfPair) {
+					// the carry into the selection bits in the addition of the previous iteration
+					vhdl << tab << declare(join("carry", i)) << " <= " << join("w", i, "full") << of(wW-2)
+							 << " xor " << join("w", i+1, "pad") << of(wW-2)
+							 << " xor " << join("q", i+1, "D") << of(wW-2)
+							 << " xor not " << join("q", i+1) << of(2) << ";" << endl;
+					// the speculated digits, indexed by 2*(code of the previous digit) + carry
+					for(int carry=0; carry<2; carry++) {
+						vhdl << tab << "with " << join("q", i+1) << " select" << endl;
+						vhdl << tab << tab << declare(join("qc", i, "_", carry), 3) << " <= " << endl;
+						for(int code=1; code<8; code++) {
+							if(code!=4)
+								vhdl << tab << tab << tab << join("qs", i, "_", 2*code+carry) << " when \"" << unsignedBinary(code, 3) << "\"," << endl;
+						}
+						vhdl << tab << tab << tab << join("qs", i, "_", 0) << " when others;" << endl;
+					}
+					vhdl << tab << declare(qi.str(), 3) << " <= " << join("qc", i, "_", 1) << " when " << join("carry", i) << "='1'"
+							 << " else " << join("qc", i, "_", 0) << ";" << endl;
+				}
+				else {
+					if(alpha==3 && prescaling==1)
+						vhdl << tab << declare(seli.str(),4) << " <= " << wi.str() << range( wW+2, wW-1) << ";" << endl;
+					else if(alpha==3)
+						vhdl << tab << declare(seli.str(),5) << " <= " << wi.str() << range( wW+2, wW-1) << " & fY" << of(wW-1)  << ";" << endl;
+					else // alpha==2
+						vhdl << tab << declare(seli.str(),9) << " <= " << wi.str() << range( wW+2, wW-3) << " & fY" << range(wW-1,wW-3)  << ";" << endl;
+					//vhdl << tab << declare(seli.str(),10) << " <= " << wi.str() << range( wW+2, wW-4) << " & fY" << range(wW-1,wW-3)  << ";" << endl;
+
+					inPortMap (table , "X", seli.str());
+					outPortMap(table , "Y", qi.str());
+					vhdl << instance(table , tInstance.str());
+				}
 				vhdl << endl;
 
 				if(alpha==3) {
@@ -344,55 +478,83 @@ namespace flopoco{
 #if 1  // The following leads to higher frequency and higher resource usage: 
 					// For (8,23) on Virtex6 with ISE this gives 466Mhz, 1083 regs+ 1029 LUTs 
 					vhdl << tab << "with " << qi.str() << " select" << endl;
-					vhdl << tab << tab << declare(qiTimesD.str(),wF+4) << " <= "<< endl ;
+					vhdl << tab << tab << declare(qiTimesD.str(),wW+4) << " <= "<< endl ;
 					vhdl << tab << tab << tab << "\"000\" & fY            when \"001\" | \"111\"," << endl;
 					vhdl << tab << tab << tab << "\"00\" & fY & \"0\"       when \"010\" | \"110\"," << endl;
 					vhdl << tab << tab << tab << "\"0\" & fYTimes3        when \"011\" | \"101\"," << endl;
-					vhdl << tab << tab << tab << "(" << wF+3 << " downto 0 => '0')  when others;" << endl;
+					vhdl << tab << tab << tab << "(" << wW+3 << " downto 0 => '0')  when others;" << endl;
 					vhdl << endl;
 #else // Recompute 3Y locally to save the registers: the LUT is used anyway
 					// For (8,23) on Virtex6 with ISE this gives 345Mhz, 856 regs+ 1051 LUTs 
 					vhdl << tab << "with " << qi.str() << " select" << endl;
-					vhdl << tab << tab << declare(join("addendA",i),wF+4) << " <= "<< endl ;
+					vhdl << tab << tab << declare(join("addendA",i),wW+4) << " <= "<< endl ;
 					vhdl << tab << tab << tab << "\"000\" & fY            when \"001\" | \"111\" | \"011\" | \"101\"," << endl;
-					vhdl << tab << tab << tab << "(" << wF+3 << " downto 0 => '0')  when others;" << endl;
+					vhdl << tab << tab << tab << "(" << wW+3 << " downto 0 => '0')  when others;" << endl;
 
 					vhdl << tab << "with " << qi.str() << " select" << endl;
-					vhdl << tab << tab << declare(join("addendB",i),wF+4) << " <= "<< endl ;
+					vhdl << tab << tab << declare(join("addendB",i),wW+4) << " <= "<< endl ;
 					vhdl << tab << tab << tab << "\"00\" & fY & \"0\"       when \"010\" | \"110\"| \"011\" | \"101\"," << endl;
-					vhdl << tab << tab << tab << "(" << wF+3 << " downto 0 => '0')  when others;" << endl;
+					vhdl << tab << tab << tab << "(" << wW+3 << " downto 0 => '0')  when others;" << endl;
 					
-					vhdl << tab << tab << declare(qiTimesD.str(),wF+4) << " <= " << join("addendA",i) << " + " << join("addendB",i) << ";"<< endl ;
+					vhdl << tab << tab << declare(qiTimesD.str(),wW+4) << " <= " << join("addendA",i) << " + " << join("addendB",i) << ";"<< endl ;
 					vhdl << endl;
 #endif				
-					vhdl << tab << declare(wipad.str(), wF+4) << " <= " << wi.str() << " & \"0\";" << endl;
+					vhdl << tab << declare(wipad.str(), wW+4) << " <= " << wi.str() << " & \"0\";" << endl;
+
+					if(firstOfPair) {
+						// Speculation of the next digit: selection bits of the next iteration for each digit code and carry
+						for(int code=0; code<8; code++) {
+							if(code==4)
+								continue;
+							for(int carry=0; carry<2; carry++) {
+								if(code==0 && carry==1) // adding 0: no carry
+									continue;
+								int index = 2*code+carry;
+								vhdl << tab << declare(join("ws", i-1, "_", index), 4) << " <= " << wipad.str() << range(wW+1, wW-2);
+								if(code>=1 && code<=3) // positive digit: subtract the multiple
+									vhdl << " + (not fYmult" << code << range(wW+1, wW-2) << ")";
+								else if(code>=5) // negative digit: add the multiple
+									vhdl << " + fYmult" << 8-code << range(wW+1, wW-2);
+								if(carry==1)
+									vhdl << " + \"0001\"";
+								vhdl << ";" << endl;
+								if(prescaling==1)
+									vhdl << tab << declare(join("sels", i-1, "_", index), 4) << " <= " << join("ws", i-1, "_", index) << ";" << endl;
+								else
+									vhdl << tab << declare(join("sels", i-1, "_", index), 5) << " <= " << join("ws", i-1, "_", index) << " & fY" << of(wW-1)  << ";" << endl;
+								inPortMap (table , "X", join("sels", i-1, "_", index));
+								outPortMap(table , "Y", join("qs", i-1, "_", index));
+								vhdl << instance(table , join("SelFunctionTableSpec", i-1, "_", index));
+							}
+						}
+					}
 					vhdl << tab << "with " << qi.str() << "(2) select" << endl;
-					vhdl << tab << declare(wim1full.str(), wF+4) << "<= " << wipad.str() << " - " << qiTimesD.str() << " when '0'," << endl;
+					vhdl << tab << declare(wim1full.str(), wW+4) << "<= " << wipad.str() << " - " << qiTimesD.str() << " when '0'," << endl;
 					vhdl << tab << "      " << wipad.str() << " + " << qiTimesD.str() << " when others;" << endl;
 					vhdl << endl;
-					vhdl << tab << declare(wim1.str(),wF+3) << " <= " << wim1full.str()<<range(wF+1,0)<<" & \"0\";" << endl;
+					vhdl << tab << declare(wim1.str(),wW+3) << " <= " << wim1full.str()<<range(wW+1,0)<<" & \"0\";" << endl;
 				} // end if alpha=3
 				else {
 					vhdl << tab << "with " << qi.str() << " select" << endl;
-					vhdl << tab << tab << declare(qiTimesD.str(),wF+4) << " <= "<< endl ;
+					vhdl << tab << tab << declare(qiTimesD.str(),wW+4) << " <= "<< endl ;
 					vhdl << tab << tab << tab << "\"000\" & fY            when \"001\" | \"111\"," << endl;
 					vhdl << tab << tab << tab << "\"00\" & fY & \"0\"       when \"010\" | \"110\"," << endl;
-					vhdl << tab << tab << tab << "(" << wF+3 << " downto 0 => '0')  when others;" << endl;
+					vhdl << tab << tab << tab << "(" << wW+3 << " downto 0 => '0')  when others;" << endl;
 					vhdl << endl;
-					vhdl << tab << declare(wipad.str(), wF+4) << " <= " << wi.str() << " & \"0\";" << endl;
+					vhdl << tab << declare(wipad.str(), wW+4) << " <= " << wi.str() << " & \"0\";" << endl;
 					vhdl << tab << "with " << qi.str() << "(2) select" << endl;
-					vhdl << tab << declare(wim1full.str(), wF+4) << "<= " << wipad.str() << " - " << qiTimesD.str() << " when '0'," << endl;
+					vhdl << tab << declare(wim1full.str(), wW+4) << "<= " << wipad.str() << " - " << qiTimesD.str() << " when '0'," << endl;
 					vhdl << tab << "      " << wipad.str() << " + " << qiTimesD.str() << " when others;" << endl;
 					vhdl << endl;
-					vhdl << tab << declare(wim1.str(),wF+3) << " <= " << wim1full.str()<<range(wF+1,0)<<" & \"0\";" << endl;
+					vhdl << tab << declare(wim1.str(),wW+3) << " <= " << wim1full.str()<<range(wW+1,0)<<" & \"0\";" << endl;
 
 				}
 			} // end loop
 
 			manageCriticalPath(srt4stepdelay);
 
-			vhdl << tab << declare("q0",3) << "(2 downto 0) <= \"000\" when  w0 = (" << wF+2 << " downto 0 => '0')" << endl;
-			vhdl << tab << "             else w0(" << wF+2 << ") & \"10\";" << endl;
+			vhdl << tab << declare("q0",3) << "(2 downto 0) <= \"000\" when  w0 = (" << wW+2 << " downto 0 => '0')" << endl;
+			vhdl << tab << "             else w0(" << wW+2 << ") & \"10\";" << endl;
 
 			for(i=nDigit-1; i>=1; i--) {
 				ostringstream qi, qPi, qMi;
@@ -469,11 +631,16 @@ namespace flopoco{
 
 
 	// Various functions that used to be in NbBitsMin
-	void FPDiv::computeNbBit (int radix, int digitSet)
+	// dMin and dMax bound the divisor: 1/2 and 1 without prescaling, a narrower interval with prescaling,
+	// which allows for fewer bits of the divisor in the selection table.
+	void FPDiv::computeNbBit (int radix, int digitSet, double dMin, double dMax)
 	{
 
 		double ro = (double)digitSet/(radix-1);
-		cout<<"Rendundancy coefficiant is rho="<<ro<<endl<<endl;
+		cout<<"Rendundancy coefficiant is rho="<<ro<<endl;
+		cout<<"Divisor in ["<<dMin<<", "<<dMax<<"["<<endl<<endl;
+		if(ro<=0.5 || ro>1)
+			cout<<"WARNING: the digit set should satisfy radix/2 <= digitSet <= radix-1"<<endl;
 
 		// eq. 5.82 p. 293 of Digital Arithmetic
 		double exactDeltaMin = 1-log2((2*ro - 1)/(2*(digitSet-1)));
@@ -508,16 +675,16 @@ namespace flopoco{
 		//radix = 8;
 		//digitSet = 7;
 
-		if(checkDistrib(delta, nbBit-delta+1, radix, digitSet))
+		if(checkDistrib(delta, nbBit-delta+1, radix, digitSet, dMin, dMax))
 		{
 			int gain = 0;
 			cout<<"Optimization found!"<<endl;
-			while(checkDistrib(delta, nbBit-delta, radix, digitSet))
+			while(checkDistrib(delta, nbBit-delta, radix, digitSet, dMin, dMax))
 			{
 				nbBit--;
 				gain++;
 			}
-			while(checkDistrib(delta-1, nbBit-delta+1, radix, digitSet))
+			while(delta>1 && checkDistrib(delta-1, nbBit-delta+1, radix, digitSet, dMin, dMax))
 			{
 				delta--;
 				nbBit--;
@@ -537,7 +704,7 @@ namespace flopoco{
 		cout<<nbBit-delta+1;
 		cout<<" bits for the partial remainder"<<endl;
 
-		plotPDDiagram(delta-1, nbBit-delta+1, radix, digitSet);
+		plotPDDiagram(delta-1, nbBit-delta+1, radix, digitSet, dMin, dMax);
 		//plotPDDiagram(3, 5, 8, 7);
 
 		cout<<"An implementation of this configuration is approximately "<<estimateCost(nbBit, radix, digitSet)<<" times larger than the actual implementation"<<endl;
@@ -545,9 +712,10 @@ namespace flopoco{
 	}
 
 	//Produces the P-D Diagram corresponding to the previous analysis in svg format
-	void FPDiv::plotPDDiagram(int delta, int t, int radix, int digitSet)
+	void FPDiv::plotPDDiagram(int delta, int t, int radix, int digitSet, double dMin, double dMax)
 	{
 		double ro = (double)digitSet/((double)radix-1);
+		double dScale = max(1.0, dMax); // the horizontal axis is [0, dScale]
 
 		ofstream svg("PDDiagram.svg", ios::out|ios::trunc);
 		const int width = 1024;
@@ -560,7 +728,7 @@ namespace flopoco{
 		svg<<"<!DOCTYPE  svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">"<<endl;
 		svg<<"<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" version=\"1.1\" >"<<endl;
 		svg<<"<text y=\"15\">Les cases incluent leurs bords bas et gauche</text>"<<endl;
-		svg<<"<text y=\"40\">		radix"<<radix<<", [-"<<digitSet<<","<<digitSet<<"]"<<"</text>"<<endl;
+		svg<<"<text y=\"40\">		radix"<<radix<<", [-"<<digitSet<<","<<digitSet<<"]"<<", d in ["<<dMin<<","<<dMax<<"["<<"</text>"<<endl;
 
 		//Lk-Uk
 		for(int i = -digitSet; i <= digitSet; i++)
@@ -580,12 +748,13 @@ namespace flopoco{
 
 		//Horizontal axis subdiv
 		int nbSubdiv = pow(2, delta);
-		int pitch = width/nbSubdiv;
+		int xMin = width*dMin/dScale;
+		int xMax = width*dMax/dScale;
 
 		for(int i = 0; i <= nbSubdiv; i++)
 		{
-			svg<<"	<line x1=\""<<50+width/2+i*pitch/2<<"\" y1=\""<<50+height/2+maxH;//50+3*height/4-((delta%2==0?i:i-1)*(-digitSet-ro)*(height/2)/(digitSet+1)/2/nbSubdiv);
-			svg<<"\" x2=\""<<50+width/2+i*pitch/2<<"\" y2=\""<<50+height/2+minH;// /4-((delta%2==0?i:i-1)*(digitSet+ro)*(height/2)/(digitSet+1)/2/nbSubdiv);
+			svg<<"	<line x1=\""<<50+xMin+i*(xMax-xMin)/nbSubdiv<<"\" y1=\""<<50+height/2+maxH;//50+3*height/4-((delta%2==0?i:i-1)*(-digitSet-ro)*(height/2)/(digitSet+1)/2/nbSubdiv);
+			svg<<"\" x2=\""<<50+xMin+i*(xMax-xMin)/nbSubdiv<<"\" y2=\""<<50+height/2+minH;// /4-((delta%2==0?i:i-1)*(digitSet+ro)*(height/2)/(digitSet+1)/2/nbSubdiv);
 			svg<<"\" style=\"stroke:rgb(100,100,100);stroke-width:2\"/>"<<endl;
 		}
 
@@ -595,7 +764,7 @@ namespace flopoco{
 
 		for(int i = -nbSubdiv/2; i <= nbSubdiv/2; i++)
 		{
-			svg<<"	<line x1=\""<<50+width/2<<"\" y1=\""<<50+height/2+i*2*minH/nbSubdiv;
+			svg<<"	<line x1=\""<<50+xMin<<"\" y1=\""<<50+height/2+i*2*minH/nbSubdiv;
 			svg<<"\" x2=\""<<50+width<<"\" y2=\""<<50+height/2+i*2*minH/nbSubdiv;
 			svg<<"\" style=\"stroke:rgb(100,100,100);stroke-width:1\"/>"<<endl;
 		}
@@ -605,11 +774,11 @@ namespace flopoco{
 		svg<<"	<line x1=\""<<50<<"\" y1=\""<<50<<"\" x2=\""<<50<<"\" y2=\""<<50+height<<"\" style=\"stroke:rgb(0,0,0);stroke-width:2\"/>"<<endl;//vertical 0
 		svg<<"	<line x1=\""<<50<<"\" y1=\""<<50+height/2<<"\" x2=\""<<50+width<<"\" y2=\""<<50+height/2<<"\" style=\"stroke:rgb(0,0,0);stroke-width:2\"/>"<<endl;//horizontal
 
-		svg<<"	<line x1=\""<<50+width<<"\" y1=\""<<50+height/2+minH;
-		svg<<"\" x2=\""<<50+width<<"\" y2=\""<<50+height/2+maxH<<"\" style=\"stroke:rgb(255,0,0);stroke-width:2\"/>"<<endl;//vertical 1
+		svg<<"	<line x1=\""<<50+xMax<<"\" y1=\""<<50+height/2+minH*dMax/dScale;
+		svg<<"\" x2=\""<<50+xMax<<"\" y2=\""<<50+height/2+maxH*dMax/dScale<<"\" style=\"stroke:rgb(255,0,0);stroke-width:2\"/>"<<endl;//vertical dMax
 
-		svg<<"	<line x1=\""<<50+width/2<<"\" y1=\""<<50+height/2+minH/2;
-		svg<<"\" x2=\""<<50+width/2<<"\" y2=\""<<50+height/2+maxH/2<<"\" style=\"stroke:rgb(255,0,0);stroke-width:2\"/>"<<endl;//vertical 0.5
+		svg<<"	<line x1=\""<<50+xMin<<"\" y1=\""<<50+height/2+minH*dMin/dScale;
+		svg<<"\" x2=\""<<50+xMin<<"\" y2=\""<<50+height/2+maxH*dMin/dScale<<"\" style=\"stroke:rgb(255,0,0);stroke-width:2\"/>"<<endl;//vertical dMin
 
 		//Prescaling (cas particulier base 8, digitSet 7)
 	//	svg<<"	<line x1=\""<<50+width/2<<"\" y1=\""<<50+height/2+minH/2;
@@ -650,16 +819,17 @@ namespace flopoco{
 	}
 
 
-	bool FPDiv::checkDistrib(int delta, int t, int radix, int digitSet)
+	bool FPDiv::checkDistrib(int delta, int t, int radix, int digitSet, double dMin, double dMax)
 	{
-		double ro = digitSet/(radix-1);
-		double wMax = U(digitSet, ro, 1);
+		double ro = (double)digitSet/(radix-1);
+		double wMax = U(digitSet, ro, dMax);
+		double dPitch = (dMax-dMin)*pow(2, -(delta-1)); // the width of a column of the P-D diagram
 
 		for(int k = -digitSet+1; k <= digitSet; k++)
 		{
 
 			//the position of the left intersection with Lk
-			double leftL = L(k, ro, 0.5);
+			double leftL = L(k, ro, dMin);
 			double leftCeiledL = pow(2,-(t-log2(radix)-1))*ceil(pow(2, (t-log2(radix)-1))*leftL);
 			int leftLineL = (wMax-leftCeiledL)*pow(2,t)/(2*wMax);//line number in the grid from P-D diagram
 			int leftCol = 0;
@@ -667,23 +837,23 @@ namespace flopoco{
 			vector<int> crossedBoxes;
 
 			//the position of the left intersection with Uk-1
-			double leftU = U(k, ro, 0.5);
+			double leftU = U(k, ro, dMin);
 			double leftCeiledU = pow(2,-(t-log2(radix)-1))*ceil(pow(2, (t-log2(radix)-1))*leftU);
 			int leftLineU = (wMax-leftCeiledU)*pow(2,t)/(2*wMax);//line number in the grid from P-D diagram
 			bool leftCornerU = (leftU-leftCeiledU == 0);
 
 			int index;
 
-			for(double i = 0.5; i < 1 ; i += pow(2, -delta))
+			for(double i = dMin; i < dMax ; i += dPitch)
 			{
 				//the position of the right intersection with Lk
-				double rightL = L(k, ro, i+pow(2, -delta));//value of Lk for d=i
+				double rightL = L(k, ro, i+dPitch);//value of Lk for d=i
 				double rightCeiledL = pow(2,-(t-log2(radix)-1))*ceil(pow(2, (t-log2(radix)-1))*rightL);
 				int rightLineL = (wMax-rightCeiledL)*pow(2,t)/(2*wMax);//line number in the grid from P-D diagram
-				int rightCol = (i-0.5+pow(2, -delta))*pow(2, delta-1)/0.5;
+				int rightCol = (i-dMin+dPitch)/dPitch;
 
 				//the position of the right intersection with Uk-1
-				double rightU = U(k-1, ro, i+pow(2, -delta));//value of Uk-1 for d=i
+				double rightU = U(k-1, ro, i+dPitch);//value of Uk-1 for d=i
 				double rightCeiledU = pow(2,-(t-log2(radix)-1))*ceil(pow(2, (t-log2(radix)-1))*rightU);
 				int rightLineU = (wMax-rightCeiledU)*pow(2,t)/(2*wMax);//line number in the grid from P-D diagram
 
@@ -828,7 +998,9 @@ namespace flopoco{
 		UserInterface::parseStrictlyPositiveInt(args, "wF", &wF);
 		int radix;
 		UserInterface::parsePositiveInt(args, "radix", &radix);
-		return new FPDiv(target, wE, wF, radix);
+		int prescaling;
+		UserInterface::parseInt(args, "prescaling", &prescaling);
+		return new FPDiv(target, wE, wF, radix, prescaling);
 	}
 
 	void FPDiv::registerFactory(){
@@ -838,8 +1010,9 @@ namespace flopoco{
 											 "http://www.cs.ucla.edu/digital_arithmetic/files/ch5.pdf",
 											 "wE(int): exponent size in bits; \
 wF(int): mantissa size in bits; \
-radix(int)=0: Can be 0, 4 or 8. Default 0 means: let FloPoCo choose between 4 and 8. In your context, the other choice may have a better area/speed trade-offs;",
-											"The algorithm used here is the division by digit recurrence (SRT). In radix 4, we use a maximally redundant digit set. In radix 8, we use split-digits in [-10,10], and a bit of prescaling.",
+radix(int)=0: Can be 0, 4, 8 or 16. Default 0 means: let FloPoCo choose the radix that minimizes the latency according to the target delay model. In your context, another choice may have a better area/speed trade-offs;\
+prescaling(int)=-1: radix 4 and 16 only. 1 prescales the operands so that the selection table only depends on the partial remainder, 0 does not, -1 lets FloPoCo choose;",
+											"The algorithm used here is the division by digit recurrence (SRT). In radix 4, we use a maximally redundant digit set. In radix 8, we use split-digits in [-10,10], and a bit of prescaling. Radix 16 overlaps two radix-4 iterations, the second digit being selected speculatively. Radix 4 and 16 may prescale the operands by 5/4 or 3/2, which removes the divisor bit from the selection table: it then fits in 4-input LUTs.",
 											FPDiv::parseArguments
 											 ) ;
 
@@ -848,9 +1021,14 @@ radix(int)=0: Can be 0, 4 or 8. Default 0 means: let FloPoCo choose between 4 an
 
 	OperatorPtr FPDiv::NbBitsMinParseArguments(Target *target, vector<string> &args) {
 		int radix, digitSet;
+		double dMin, dMax;
 		UserInterface::parseStrictlyPositiveInt(args, "radix", &radix);
 		UserInterface::parseStrictlyPositiveInt(args, "digitSet", &digitSet);
-		computeNbBit(radix, digitSet);
+		UserInterface::parseFloat(args, "dMin", &dMin);
+		UserInterface::parseFloat(args, "dMax", &dMax);
+		if(dMin<=0 || dMax<=dMin)
+			throw string("NbBitsMin: we need 0 < dMin < dMax");
+		computeNbBit(radix, digitSet, dMin, dMax);
 		return NULL;
 	}
 
@@ -860,7 +1038,9 @@ radix(int)=0: Can be 0, 4 or 8. Default 0 means: let FloPoCo choose between 4 an
 											 "Miscellaneous", // categories
 											 "",
 											 "radix(int): It has to be 2^n; \
-digitSet(int): the range you allow for each digit [-digitSet, digitSet]",
+digitSet(int): the range you allow for each digit [-digitSet, digitSet]; \
+dMin(real)=0.5: lower bound of the divisor, larger than 1/2 if the divisor is prescaled; \
+dMax(real)=1.0: upper bound of the divisor",
 											 "",
 											 FPDiv::NbBitsMinParseArguments
 											 ) ;
@@ -20,8 +20,11 @@ namespace flopoco{
 		 * @param[in]		target		the target device
 		 * @param[in]		wE			the width of the exponent for the f-p number X
 		 * @param[in]		wF			the width of the fraction for the f-p number X
+		 * @param[in]		radix		4, 8 or 16, or 0 to choose out of the target delay model
+		 * @param[in]		prescaling	radix 4 and 16 only: 1 to prescale the operands so that the selection table does not need the divisor,
+		 *							0 not to, -1 to choose out of the target delay model
 		 */
-		FPDiv(Target* target, int wE, int wF, int radix=0);
+		FPDiv(Target* target, int wE, int wF, int radix=0, int prescaling=-1);
 
 		/**
 		 * FPDiv destructor
@@ -44,12 +47,12 @@ namespace flopoco{
 		static void registerFactory();
 
 	private:
-		static void plotPDDiagram(int delta, int t, int radix, int digitSet);
-		static bool checkDistrib(int delta, int t, int radix, int digitSet);
+		static void plotPDDiagram(int delta, int t, int radix, int digitSet, double dMin=0.5, double dMax=1.0);
+		static bool checkDistrib(int delta, int t, int radix, int digitSet, double dMin=0.5, double dMax=1.0);
 		static double L(int k, double ro, double d);
 		static double U(int k, double ro, double d);
 		static double estimateCost(int nbBit, int radix, int digitSet);
-		static void computeNbBit(int radix, int digitSet);
+		static void computeNbBit(int radix, int digitSet, double dMin=0.5, double dMax=1.0);
 	public:
 		static void NbBitsMinRegisterFactory();
 		static OperatorPtr NbBitsMinParseArguments(Target *target, vector<string> &args);
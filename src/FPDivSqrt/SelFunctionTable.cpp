@@ -16,7 +16,7 @@ namespace flopoco
 		setCopyrightString("Maxime Christ, Florent de Dinechin (2015)");
 		ostringstream name;
 		srcFileName="SelFunctionTable";
-		name << "SelFunctionTable_r"<< radix;
+		name << "SelFunctionTable_r"<< radix << "_" << wIn; // e.g. the prescaled radix-4 table has one input less
 		setName(name.str());
 
 		ro = ((double)digitSet)/(radix-1);
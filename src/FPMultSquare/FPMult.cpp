@@ -62,10 +62,12 @@ namespace flopoco{
 		vhdl << tab << declare("expY", wEY_) << " <= Y"<< range(wEY_ + wFY_ -1, wFY_) << ";" << endl;
 
 		//Add exponents and substract bias
+		addEstimatedAdderCost(wEX+2);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(wEX+2));
 		vhdl << tab << declare("expSumPreSub", wEX_+2) << " <= (\"00\" & expX) + (\"00\" & expY);" << endl;
 		vhdl << tab << declare("bias", wEX_+2) << " <= CONV_STD_LOGIC_VECTOR(" << intpow2(wER-1)-1 << ","<<wEX_+2<<");"<< endl;
 
+		addEstimatedAdderCost(wEX+2);
 		manageCriticalPath(target->localWireDelay() + target->adderDelay(wEX+2));
 		vhdl << tab << declare("expSum",wEX+2) << " <= expSumPreSub - bias;" << endl;
 		double exponentCriticalPath=getCriticalPath();
@@ -128,6 +130,7 @@ namespace flopoco{
 
 			vhdl << tab<< declare("norm") << " <= sigProd" << of(sigProdSize -1) << ";"<<endl;
 
+			addEstimatedAdderCost(wEX+2);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(wEX+2));
 			double expPostNormCriticalPath=getCriticalPath();
 			vhdl << tab<< "-- exponent update"<<endl;
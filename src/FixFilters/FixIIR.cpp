@@ -297,6 +297,7 @@ namespace flopoco {
 				//manage the critical path
 				syncCycleFromSignal(join("Pb", i));
 				syncCycleFromSignal(join("S", i));
+				addEstimatedAdderCost(size);
 				manageCriticalPath(target->adderDelay(size));
 
 				// Addition
@@ -332,6 +333,7 @@ namespace flopoco {
 				vhdl << instance(mult, join("mult", n+i));
 
 				//manage the critical path
+				addEstimatedAdderCost(size);
 				manageCriticalPath(target->adderDelay(size));
 
 				// Addition
@@ -348,6 +350,7 @@ namespace flopoco {
 
 			//manage the critical path
 			syncCycleFromSignal(join("S", n+m));
+			addEstimatedAdderCost(wO+1);
 			manageCriticalPath(target->adderDelay(wO+1));
 
 
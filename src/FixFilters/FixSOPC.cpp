@@ -269,6 +269,7 @@ namespace flopoco{
 			vhdl << tab << declare("S0", sumSize) << " <= " << zg(sumSize) << ";" << endl;
 			for(int i=0; i< n; i++)		{
 				//manage the critical path
+				addEstimatedAdderCost(sumSize);
 				manageCriticalPath(getTarget()->adderDelay(sumSize));
 				// Addition
 				int pSize = getSignalByName(join("P", i))->width();
@@ -282,6 +283,7 @@ namespace flopoco{
 			// Rounding costs one more adder to add the half-ulp round bit.
 			// This could be avoided by pushing this bit in one of the KCM tables
 			syncCycleFromSignal(join("S", n));
+			addEstimatedAdderCost(msbOut-lsbOut+1);
 			manageCriticalPath(getTarget()->adderDelay(msbOut-lsbOut+1));
 			vhdl << tab << declare("R_int", sumSize+1) << " <= " <<  join("S", n) << range(sumSize-1, sumSize-(msbOut-lsbOut+1)-1) << " + (" << zg(sumSize) << " & \'1\');" << endl;
 			vhdl << tab << "R <= " <<  "R_int" << range(sumSize, 1) << ";" << endl;
@@ -17,6 +17,7 @@
 
 #include "BasicPolyApprox.hpp"
 #include "../UserInterface.hpp"
+#include "../Tools/Profiler.hpp"
 #include <string>
 #include <sstream>
 #include <iomanip>
@@ -113,6 +114,7 @@ namespace flopoco{
 
 	// This is a static (class) method.
 	void BasicPolyApprox::guessDegree(sollya_obj_t fS, sollya_obj_t rangeS, double targetAccuracy, int* degreeInfP, int* degreeSupP) {
+		Profiler::Scope p("sollya guessdegree");
 		// Accuracy has to be converted to sollya objects
 		// a few constant objects
 		if(DETAILED <= UserInterface::verbose)
@@ -174,6 +176,7 @@ g(int)=-1: the number of guardbits added. Using -1 gives sensible default",
 
 	void BasicPolyApprox::buildApproxFromTargetAccuracy(double targetAccuracy, int addGuardBits)
 	{
+		Profiler::Scope p("BasicPolyApprox (sollya fpminimax and supnorm)");
 		// a few constant objects
 		sollya_obj_t fS = f->fS; // no need to free this one
 		sollya_obj_t rangeS = f->rangeS; // no need to free this one
@@ -255,6 +258,7 @@ g(int)=-1: the number of guardbits added. Using -1 gives sensible default",
 
 	void BasicPolyApprox::buildApproxFromDegreeAndLSBs()
 	{
+		Profiler::Scope p("BasicPolyApprox (sollya fpminimax and supnorm)");
 		sollya_obj_t fS = f->fS; // no need to free this one
 		sollya_obj_t rangeS = f->rangeS; // no need to free this one
 		sollya_obj_t degreeS = sollya_lib_constant_from_int(degree);
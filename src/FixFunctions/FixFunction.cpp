@@ -15,6 +15,7 @@
 */
 
 #include "FixFunction.hpp"
+#include "../Tools/Profiler.hpp"
 #include <sstream>
 
 namespace flopoco{
@@ -43,6 +44,7 @@ namespace flopoco{
 		description = completeDescription.str();
 
 		// Now do the parsing in Sollya
+		Profiler::Scope p("sollya parse", sollyaString_);
 		fS= sollya_lib_parse_string(sollyaString_.c_str());
 
 		/* If  parse error throw an exception */
@@ -78,6 +80,7 @@ namespace flopoco{
 
 	void FixFunction::eval(mpfr_t r, mpfr_t x) const
 	{
+		Profiler::Scope p("sollya evaluate");
 		sollya_lib_evaluate_function_at_point(r, fS, x, NULL);
 	}
 
@@ -89,6 +92,7 @@ namespace flopoco{
 
 		mpfr_inits(mpX, mpR, NULL);
 		mpfr_set_d(mpX, x, GMP_RNDN);
+		Profiler::Scope p("sollya evaluate");
 		sollya_lib_evaluate_function_at_point(mpR, fS, mpX, NULL);
 		r = mpfr_get_d(mpR, GMP_RNDN);
 
@@ -16,6 +16,7 @@
 #include <string.h>
 #include <sstream>
 #include <vector>
+#include <thread>
 
 #include <gmp.h>
 #include <gmpxx.h>
@@ -416,6 +417,7 @@ namespace flopoco
 		int wi = obj->inputSize;
 		int gammai, betai, pi;
 		oneTableError = vector<vector<vector<double>>>(wi, vector<vector<double>>(wi, vector<double>(wi))); // there will be holes
+		oneTableSlope = vector<vector<vector<double>>>(wi, vector<vector<double>>(wi, vector<double>(wi, -1))); // filled on demand
 
 		for(pi=0; pi<wi; pi++) {
 			for(betai=1; betai<wi-pi-1; betai++) {
@@ -445,13 +447,28 @@ namespace flopoco
 		vector<int> gammaimin;
 		vector<int> gammai;
 		vector<int> betai;
+		vector<int> pi(nbTables);
 
 		int sizeMax = obj->outputSize * obj->inputRange;
-		smallest = new Multipartite(this, f, f->wIn, f->wOut);
-		smallest->totalSize = sizeMax;
+		int smallestSize = sizeMax;
+		smallest = NULL;
+
+		// The number of guard bits is minimal for a null math error (see Multipartite::computeGuardBits()):
+		// with it, the size formulas of Multipartite::computeSizes() give lower bounds of the table sizes.
+		int minGuardBits = (int) floor(-obj->outputSize - 1 + log2(nbTables / intpow2(-obj->outputSize - 1)));
+
+		int nbThreads = std::thread::hardware_concurrency();
+		if(nbThreads < 1)
+			nbThreads = 1;
 
 		for (int alpha = alphamin; alpha <= alphamax; alpha++)
 		{
+			// The TIV alone is already too large (the TO sizes are positive), and it only grows with alpha
+			int tivSizeMin = (int) intpow2(alpha) * (obj->outputSize + minGuardBits);
+			if(tivSizeMin >= smallestSize)
+				break;
+
+			vector<Multipartite*> candidates;
 			beta = n-alpha;
 			betaEnum = betaenum(beta, nbTables);
 			for(unsigned int e = 0; e < betaEnum.size(); e++) {
@@ -463,36 +480,80 @@ namespace flopoco
 					gammaimin[i] = gammaiMin[p][betai[i]];
 					p += betai[i];
 				}
+				pi[0] = 0;
+				for (int i = 1; i < nbTables; i++)
+					pi[i] = pi[i-1] + betai[i-1];
 
 				alphaEnum = alphaenum(alpha,nbTables,gammaimin);
 				for(unsigned int ae = 0; ae < alphaEnum.size(); ae++)
 				{
 					gammai = alphaEnum[ae];
 
-					mpt = new Multipartite(f, nbTables,
-										   alpha, beta,
-										   gammai, betai, this);
-
-					if(mpt->mathError < obj->epsilonT)
-					{
-						mpt->buildGuardBitsAndSizes();
+					// Same sum as Multipartite::computeMathErrors()
+					double mathError = 0;
+					for (int i = 0; i < nbTables; i++)
+						mathError += oneTableError[pi[i]][betai[i]][gammai[i]];
+					if(mathError >= obj->epsilonT)
+						continue;
+
+					int sizeMin = tivSizeMin;
+					for (int i = 0; i < nbTables; i++) {
+						double r = oneTableSlopeRange(pi[i], betai[i], gammai[i]);
+						sizeMin += (int)intpow2(gammai[i]+betai[i]-1) * ((int)ceil(obj->outputSize + minGuardBits + log2(r)) - 1);
 					}
-					else
-						mpt->totalSize = sizeMax;
+					if(sizeMin >= smallestSize)
+						continue;
+
+					candidates.push_back(new Multipartite(f, nbTables,
+										   alpha, beta,
+										   gammai, betai, this));
+				}
+			}
 
-					if(mpt->totalSize < smallest->totalSize)
-						smallest = mpt;
+			// All the slopes of the candidates are memoised: sizing them is now thread-safe arithmetic
+			int nbCandidateThreads = min(nbThreads, (int)candidates.size() / 64 + 1);
+			auto sizeCandidates = [&candidates, nbCandidateThreads](int t) {
+				for (size_t c = t; c < candidates.size(); c += nbCandidateThreads)
+					candidates[c]->buildGuardBitsAndSizes();
+			};
+			vector<std::thread> threads;
+			for (int t = 1; t < nbCandidateThreads; t++)
+				threads.push_back(std::thread(sizeCandidates, t));
+			sizeCandidates(0);
+			for (auto& t: threads)
+				t.join();
+
+			// In enumeration order, so that ties are broken as in the exhaustive search
+			for (unsigned int c = 0; c < candidates.size(); c++) {
+				mpt = candidates[c];
+				if(mpt->totalSize < smallestSize) {
+					if(smallest != NULL)
+						delete smallest;
+					smallest = mpt;
+					smallestSize = mpt->totalSize;
 				}
+				else
+					delete mpt;
 			}
+			REPORT(DEBUG, "alpha=" << alpha << ": " << candidates.size() << " decompositions sized on " << nbCandidateThreads << " threads, best size " << smallestSize);
 		}
 		/* If  parse error throw an exception */
-		if (smallest->totalSize == sizeMax)
+		if (smallest == NULL)
 			throw("It seems we could not find a decomposition");
 
 		return smallest;
 	}
 
 
+	double FixFunctionByMultipartiteTable::oneTableSlopeRange(int pi, int betai, int gammai)
+	{
+		double& r = oneTableSlope[pi][betai][gammai];
+		if(r < 0)
+			r = obj->slopeRange(pi, betai, gammai);
+		return r;
+	}
+
+
 	/** 5th equation implementation */
 	double FixFunctionByMultipartiteTable::epsilon(int ci_, int gammai, int betai, int pi)
 	{
@@ -73,12 +73,22 @@ namespace flopoco
 			void buildGammaiMin();
 
 			/**
-			 * @brief enumerateDec : This function enumerates all the decompositions and returns the smallest one
+			 * @brief enumerateDec : This function enumerates all the decompositions and returns the smallest one.
+			 * The enumeration is a branch and bound: a decomposition whose size lower bound (computed with the minimal number
+			 * of guard bits) is not smaller than the best size so far is not built. For each alpha, the surviving decompositions
+			 * are then sized in parallel, and ties are broken by enumeration order, so the result is the one of the exhaustive search.
 			 * @return The smallest Multipartite decomposition.
 			 * @throw "It seems we could not find a decomposition" if there isn't any decomposition with an acceptable error
 			 */
 			Multipartite* enumerateDec();
 
+			/**
+			 * @brief oneTableSlopeRange : the memoised Multipartite::slopeRange() of the TO table defined by pi, betai and gammai.
+			 * It evaluates the function the first time only, which is not thread-safe:
+			 * enumerateDec() calls it for all the candidates before sizing them in parallel
+			 */
+			double oneTableSlopeRange(int pi, int betai, int gammai);
+
 
 			/** Some needed methods, extracted from the article */
 
@@ -100,6 +110,7 @@ namespace flopoco
 			Multipartite* bestMP;
 
 			vector<vector<vector<double>>> oneTableError;
+			vector<vector<vector<double>>> oneTableSlope;  /**< memo of oneTableSlopeRange(), negative if not computed yet */
 			vector<vector<int>> gammaiMin;
 
 			int g;				/**< the number of extra guard bits to be used for the computations */
@@ -64,12 +64,18 @@ namespace flopoco{
 #define DEBUGVHDL 0
 
 
-	FixFunctionByPiecewisePoly::FixFunctionByPiecewisePoly(Target* target, string func, int lsbIn_, int msbOut_, int lsbOut_, int degree_, bool finalRounding_, double approxErrorBudget_, map<string, double> inputDelays):
-		Operator(target, inputDelays), degree(degree_), lsbIn(lsbIn_), msbOut(msbOut_), lsbOut(lsbOut_), finalRounding(finalRounding_), approxErrorBudget(approxErrorBudget_){
+	FixFunctionByPiecewisePoly::FixFunctionByPiecewisePoly(Target* target, string func, int lsbIn_, int msbOut_, int lsbOut_, int degree_, bool finalRounding_, double approxErrorBudget_, int scheme_, int mergedSteps_, map<string, double> inputDelays):
+		Operator(target, inputDelays), degree(degree_), lsbIn(lsbIn_), msbOut(msbOut_), lsbOut(lsbOut_), finalRounding(finalRounding_), approxErrorBudget(approxErrorBudget_), scheme(scheme_), mergedSteps(mergedSteps_){
 
 		if(finalRounding==false){
 			THROWERROR("FinalRounding=false not implemented yet" );
 		}
+		if(scheme<0 || scheme>2){
+			THROWERROR("scheme should be 0 (Horner), 1 (Estrin) or 2 (hybrid), got " << scheme);
+		}
+		if(mergedSteps<-1){
+			THROWERROR("mergedSteps should be -1 (all the steps) or a non-negative number of steps, got " << mergedSteps);
+		}
 
 		f=new FixFunction(func, false, lsbIn, msbOut, lsbOut); // this will provide emulate etc.
 		
@@ -152,7 +158,7 @@ namespace flopoco{
 
 			
 			// What follows is related to Horner evaluator
-			// Here I wish I could plug other (more parallel) evaluators. 
+			// The evaluator may also use the more parallel Estrin scheme, or a hybrid: see FixHornerEvaluator
 
 			//  compute the size of the intermediate terms sigma_i  (Horner-specific)  
 			computeSigmaSignsAndMSBs(); // TODO make it a method of FixHornerEvaluator?
@@ -162,12 +168,13 @@ namespace flopoco{
 				REPORT(0, "WARNING: msbOut is set to " << msbOut << " but I compute that it should be " << sigmaMSB[0]);
 
 
-			REPORT(INFO, "Now building the Horner evaluator for rounding error budget "<< roundingErrorBudget);
+			REPORT(INFO, "Now building the polynomial evaluator for rounding error budget "<< roundingErrorBudget);
+			FixHornerEvaluator::EvaluationScheme evaluationScheme = (FixHornerEvaluator::EvaluationScheme) scheme;
 			// This builds an architecture such as eps_finalround < 2^(lsbOut-1) and eps_round<2^(lsbOut-2)
 #if 0 // This constructor computes sigma and msbs only out of the formats
-			FixHornerEvaluator* horner = new FixHornerEvaluator(target, lsbIn+alpha+1, msbOut, lsbOut, degree, polyApprox->MSB, polyApprox->LSB, roundingErrorBudget);		
+			FixHornerEvaluator* horner = new FixHornerEvaluator(target, lsbIn+alpha+1, msbOut, lsbOut, degree, polyApprox->MSB, polyApprox->LSB, roundingErrorBudget, true, true, evaluationScheme, mergedSteps);		
 #else // This constructor uses the more accurate data computed out of the actual polynomials
-			FixHornerEvaluator* horner = new FixHornerEvaluator(target, lsbIn+alpha+1, msbOut, lsbOut, degree, polyApprox->MSB, polyApprox->LSB, sigmaSign, sigmaMSB, roundingErrorBudget);		
+			FixHornerEvaluator* horner = new FixHornerEvaluator(target, lsbIn+alpha+1, msbOut, lsbOut, degree, polyApprox->MSB, polyApprox->LSB, sigmaSign, sigmaMSB, roundingErrorBudget, true, true, evaluationScheme, mergedSteps);		
 #endif
 			addSubComponent(horner);
 
@@ -367,7 +374,7 @@ namespace flopoco{
 
 	
 	OperatorPtr FixFunctionByPiecewisePoly::parseArguments(Target *target, vector<string> &args) {
-		int lsbIn, msbOut, lsbOut, d;
+		int lsbIn, msbOut, lsbOut, d, scheme, mergedSteps;
 		string f;
 		double approxErrorBudget;
 		UserInterface::parseString(args, "f", &f); 
@@ -376,7 +383,9 @@ namespace flopoco{
 		UserInterface::parseInt(args, "lsbOut", &lsbOut);
 		UserInterface::parsePositiveInt(args, "d", &d);
 		UserInterface::parseFloat(args, "approxErrorBudget", &approxErrorBudget);
-		return new FixFunctionByPiecewisePoly(target, f, lsbIn, msbOut, lsbOut, d, true, approxErrorBudget);
+		UserInterface::parseInt(args, "scheme", &scheme);
+		UserInterface::parseInt(args, "mergedSteps", &mergedSteps);
+		return new FixFunctionByPiecewisePoly(target, f, lsbIn, msbOut, lsbOut, d, true, approxErrorBudget, scheme, mergedSteps);
 	}
 
 	void FixFunctionByPiecewisePoly::registerFactory(){
@@ -389,7 +398,9 @@ namespace flopoco{
                         msbOut(int): weight of output MSB;\
                         lsbOut(int): weight of output LSB;\
                         d(int): degree of the polynomial;\
-                        approxErrorBudget(real)=0.25: error budget in ulp for the approximation, between 0 and 0.5",                        
+                        approxErrorBudget(real)=0.25: error budget in ulp for the approximation, between 0 and 0.5;\
+                        scheme(int)=0: polynomial evaluation scheme, 0 for Horner, 1 for Estrin (logarithmic depth), 2 for a cost-driven Horner/Estrin hybrid;\
+                        mergedSteps(int)=0: number of final Horner steps whose products are summed in a single bit heap, -1 for all of them",                        
 											 "This operator uses a table for coefficients, and Horner evaluation with truncated multipliers sized just right.<br>For more details, see <a href=\"bib/flopoco.html#DinJolPas2010-poly\">this article</a>.",
 											 FixFunctionByPiecewisePoly::parseArguments
 											 ) ;
@@ -31,12 +31,14 @@ namespace flopoco{
 			 @param[bool]   finalRounding: if false, the operator outputs its guard bits as well, saving the half-ulp rounding error. 
 			                 This makes sense in situations that further process the result with further guard bits.
 			 @param[bool]   plainStupidVHDL: if true, generate * and +; if false, use BitHeap-based FixMultAdd
+			 @param[int]    scheme  polynomial evaluation scheme: 0 for Horner, 1 for Estrin, 2 for a Horner/Estrin hybrid (see FixHornerEvaluator)
+			 @param[int]    mergedSteps  number of final Horner steps merged into a single bit heap, -1 for all (see FixHornerEvaluator)
 			 
 			 One could argue that MSB weight is redundant, as it can be deduced from an analysis of the function. 
 			 This would require quite a lot of work for non-trivial functions (isolating roots of the derivative etc).
 			 So this is currently left to the user.
 		 */
-		FixFunctionByPiecewisePoly(Target* target, string func, int lsbIn, int msbOut, int lsbOut, int degree, bool finalRounding = true,  double approxErrorBudget=0.25, map<string, double> inputDelays = emptyDelayMap);
+		FixFunctionByPiecewisePoly(Target* target, string func, int lsbIn, int msbOut, int lsbOut, int degree, bool finalRounding = true,  double approxErrorBudget=0.25, int scheme=0, int mergedSteps=0, map<string, double> inputDelays = emptyDelayMap);
 
 		/**
 		 * FixFunctionByPiecewisePoly destructor
@@ -64,6 +66,8 @@ namespace flopoco{
 		FixFunction *f;
 		bool finalRounding;
 		double approxErrorBudget;
+		int scheme;
+		int mergedSteps;
 		vector<mpz_class> coeffTableVector;
 		vector <int> sigmaSign; /** +1 if sigma is always positive, -1 if sigma is always negative, O if sigma needs to be signed */
 		vector<int> sigmaMSB;   /**< vector of MSB weights for each sigma term. Note that these MSB consider that sigma is signed: one may remove 1 if sigmaSign is +1 or -1  */
@@ -28,6 +28,7 @@
 
 #include "FixFunctionBySimplePoly.hpp"
 #include "IntMult/FixMultAdd.hpp"
+#include "FixHornerEvaluator.hpp"
 
 using namespace std;
 
@@ -36,8 +37,8 @@ namespace flopoco{
 #define DEBUGVHDL 0
 
 
-	FixFunctionBySimplePoly::FixFunctionBySimplePoly(Target* target, string func, bool signedIn, int lsbIn, int msbOut, int lsbOut, bool finalRounding_, map<string, double> inputDelays):
-		Operator(target, inputDelays), finalRounding(finalRounding_){
+	FixFunctionBySimplePoly::FixFunctionBySimplePoly(Target* target, string func, bool signedIn, int lsbIn, int msbOut, int lsbOut, bool finalRounding_, int scheme_, map<string, double> inputDelays):
+		Operator(target, inputDelays), finalRounding(finalRounding_), scheme(scheme_){
 		f = new FixFunction(func, signedIn, lsbIn, msbOut, lsbOut);
 
 		srcFileName="FixFunctionBySimplePoly";
@@ -45,6 +46,9 @@ namespace flopoco{
 		if(finalRounding==false){
 			THROWERROR("FinalRounding=false not implemented yet" );
 		}
+		if(scheme<0 || scheme>2){
+			THROWERROR("scheme should be 0 (Horner), 1 (Estrin) or 2 (hybrid), got " << scheme);
+		}
 
 		ostringstream name;
 		name<<"FixFunctionBySimplePoly_"<<getNewUId();
@@ -64,7 +68,8 @@ namespace flopoco{
 			vhdl << tab << declareFixPoint("Xs", true, 0, lsbIn) << " <= signed('0' & X);  -- sign extension of X" << endl;
 
 		// Polynomial approximation
-		double targetApproxError = pow(2,lsbOut-1);
+		// FixHornerEvaluator has an error analysis of its own: leave it half the error budget, as FixFunctionByPiecewisePoly does
+		double targetApproxError = pow(2,lsbOut-(scheme==0 ? 1 : 2));
 		poly = new BasicPolyApprox(f, targetApproxError, -1);
 		double approxErrorBound = poly->approxErrorBound;
 
@@ -97,51 +102,72 @@ namespace flopoco{
 			vhdl << endl;
 		}
 
-		// TODO: error analysis for evaluation.
-		// The following comment is no longer true
-		// Here we assume all the coefficients already include the proper number of guard bits
-		int sigmaMSB=coeffMSB[degree];
-		int sigmaLSB=coeffLSB[degree];
-		vhdl << tab << declareFixPoint(join("Sigma", degree), true, sigmaMSB, sigmaLSB)
-				 << " <= " << join("A", degree)  << ";" << endl;
+		if(scheme!=0) {
+			// The Estrin and hybrid schemes are those of FixHornerEvaluator, which expects all the coefficients at the same LSB
+			double roundingErrorBudget=exp2(lsbOut-1)-approxErrorBound;
+			REPORT(INFO, "Now building the polynomial evaluator for rounding error budget "<< roundingErrorBudget);
+			FixHornerEvaluator* evaluator = new FixHornerEvaluator(target, lsbIn, msbOut, lsbOut, degree, coeffMSB, poly->LSB, roundingErrorBudget,
+																														 true, true, (FixHornerEvaluator::EvaluationScheme) scheme);
+			addSubComponent(evaluator);
+			vhdl << tab << declare("Xv", 1-lsbIn) << " <= std_logic_vector(Xs);" << endl;
+			inPortMap(evaluator, "X", "Xv");
+			for(int i=0; i<=degree; i++) {
+				resizeFixPoint(join("Ar",i), join("A",i), coeffMSB[i], poly->LSB);
+				vhdl << tab << declare(join("Av",i), coeffMSB[i]-poly->LSB+1) << " <= std_logic_vector(" << join("Ar",i) << ");" << endl;
+				inPortMap(evaluator, join("A",i), join("Av",i));
+			}
+			outPortMap(evaluator, "R", "Ys");
+			vhdl << instance(evaluator, "evaluator") << endl;
+			syncCycleFromSignal("Ys");
+			vhdl << tab << "Y <= Ys;" << endl;
+		}
+		else {
+			// TODO: error analysis for evaluation.
+			// The following comment is no longer true
+			// Here we assume all the coefficients already include the proper number of guard bits
+			int sigmaMSB=coeffMSB[degree];
+			int sigmaLSB=coeffLSB[degree];
+			vhdl << tab << declareFixPoint(join("Sigma", degree), true, sigmaMSB, sigmaLSB)
+					 << " <= " << join("A", degree)  << ";" << endl;
 
-		for(int i=degree-1; i>=0; i--) {
+			for(int i=degree-1; i>=0; i--) {
 
-			int xTruncLSB = max(lsbIn, sigmaLSB-sigmaMSB);
+				int xTruncLSB = max(lsbIn, sigmaLSB-sigmaMSB);
 
-			int pMSB=sigmaMSB+0 + 1;
-			sigmaMSB = max(pMSB-1, coeffMSB[i]) +1; // +1 to absorb addition overflow
-			sigmaLSB = coeffLSB[i];
+				int pMSB=sigmaMSB+0 + 1;
+				sigmaMSB = max(pMSB-1, coeffMSB[i]) +1; // +1 to absorb addition overflow
+				sigmaLSB = coeffLSB[i];
 
-			resizeFixPoint(join("XsTrunc", i), "Xs", 0, xTruncLSB);
+				resizeFixPoint(join("XsTrunc", i), "Xs", 0, xTruncLSB);
 
-			if(target->plainVHDL()) {				// No pipelining here
-				vhdl << tab << declareFixPoint(join("P", i), true, pMSB,  sigmaLSB  + xTruncLSB /*LSB*/)
-						 <<  " <= "<< join("XsTrunc", i) <<" * Sigma" << i+1 << ";" << endl;
-				// However the bit of weight pMSB is a 0. We want to keep the bits from  pMSB-1
-				resizeFixPoint(join("Ptrunc", i), join("P", i), sigmaMSB, sigmaLSB);
-				resizeFixPoint(join("Aext", i), join("A", i), sigmaMSB, sigmaLSB);
+				if(target->plainVHDL()) {				// No pipelining here
+					vhdl << tab << declareFixPoint(join("P", i), true, pMSB,  sigmaLSB  + xTruncLSB /*LSB*/)
+							 <<  " <= "<< join("XsTrunc", i) <<" * Sigma" << i+1 << ";" << endl;
+					// However the bit of weight pMSB is a 0. We want to keep the bits from  pMSB-1
+					resizeFixPoint(join("Ptrunc", i), join("P", i), sigmaMSB, sigmaLSB);
+					resizeFixPoint(join("Aext", i), join("A", i), sigmaMSB, sigmaLSB);
 
-				vhdl << tab << declareFixPoint(join("Sigma", i), true, sigmaMSB, sigmaLSB)   << " <= " << join("Aext", i) << " + " << join("Ptrunc", i) << ";" << endl;
-		}
+					vhdl << tab << declareFixPoint(join("Sigma", i), true, sigmaMSB, sigmaLSB)   << " <= " << join("Aext", i) << " + " << join("Ptrunc", i) << ";" << endl;
+			}
 
-			else { // using FixMultAdd
-				REPORT(DETAILED, " i=" << i);
-				FixMultAdd::newComponentAndInstance(this,
-																						join("Step",i),     // instance name
-																						join("XsTrunc",i),  // x
-																						join("Sigma", i+1), // y
-																						join("A", i),       // a
-																						join("Sigma", i),   // result
-																						sigmaMSB, sigmaLSB  // outMSB, outLSB
-																						);
-				syncCycleFromSignal(join("Sigma", i));
+				else { // using FixMultAdd
+					REPORT(DETAILED, " i=" << i);
+					FixMultAdd::newComponentAndInstance(this,
+																							join("Step",i),     // instance name
+																							join("XsTrunc",i),  // x
+																							join("Sigma", i+1), // y
+																							join("A", i),       // a
+																							join("Sigma", i),   // result
+																							sigmaMSB, sigmaLSB  // outMSB, outLSB
+																							);
+					syncCycleFromSignal(join("Sigma", i));
+				}
 			}
-		}
 
-		resizeFixPoint("Ys", "Sigma0",  msbOut, lsbOut);
+			resizeFixPoint("Ys", "Sigma0",  msbOut, lsbOut);
 
-		vhdl << tab << "Y <= " << "std_logic_vector(Ys);" << endl;
+			vhdl << tab << "Y <= " << "std_logic_vector(Ys);" << endl;
+		}
 	}
 
 
@@ -185,15 +211,16 @@ namespace flopoco{
 	{
 		string f;
 		bool signedIn;
-		int lsbIn, msbOut, lsbOut;
+		int lsbIn, msbOut, lsbOut, scheme;
 
 		UserInterface::parseString(args, "f", &f);
 		UserInterface::parseBoolean(args, "signedIn", &signedIn);
 		UserInterface::parseInt(args, "lsbIn", &lsbIn);
 		UserInterface::parseInt(args, "msbOut", &msbOut);
 		UserInterface::parseInt(args, "lsbOut", &lsbOut);
+		UserInterface::parseInt(args, "scheme", &scheme);
 
-		return new FixFunctionBySimplePoly(target, f, signedIn, lsbIn, msbOut, lsbOut);
+		return new FixFunctionBySimplePoly(target, f, signedIn, lsbIn, msbOut, lsbOut, true, scheme);
 	}
 
 	void FixFunctionBySimplePoly::registerFactory()
@@ -206,7 +233,8 @@ namespace flopoco{
 lsbIn(int): weight of input LSB, for instance -8 for an 8-bit input;\
 msbOut(int): weight of output MSB;\
 lsbOut(int): weight of output LSB;\
-signedIn(bool)=true: defines the input range : [0,1) if false, and [-1,1) otherwise\
+signedIn(bool)=true: defines the input range : [0,1) if false, and [-1,1) otherwise;\
+scheme(int)=0: polynomial evaluation scheme, 0 for Horner, 1 for Estrin (logarithmic depth), 2 for a cost-driven Horner/Estrin hybrid\
 ",
 						   "This operator uses a table for coefficients, and Horner evaluation with truncated multipliers sized just right.<br>For more details, see <a href=\"bib/flopoco.html#DinJolPas2010-poly\">this article</a>.",
 						   FixFunctionBySimplePoly::parseArguments
@@ -26,12 +26,13 @@ namespace flopoco{
 			 @param[int]    lsbOut  output LSB weight
 			 @param[bool]   finalRounding: if false, the operator outputs its guard bits as well, saving the half-ulp rounding error.
 							 This makes sense in situations that further process the result with further guard bits.
+			 @param[int]    scheme  polynomial evaluation scheme: 0 for Horner, 1 for Estrin, 2 for a Horner/Estrin hybrid (see FixHornerEvaluator)
 
 			 One could argue that MSB weight is redundant, as it can be deduced from an analysis of the function.
 			 This would require quite a lot of work for non-trivial functions (isolating roots of the derivative etc).
 			 So this is currently left to the user.
 		 */
-		FixFunctionBySimplePoly(Target* target, string func, bool signedIn, int lsbIn, int msbOut, int lsbOut, bool finalRounding = true,  map<string, double> inputDelays = emptyDelayMap);
+		FixFunctionBySimplePoly(Target* target, string func, bool signedIn, int lsbIn, int msbOut, int lsbOut, bool finalRounding = true, int scheme=0, map<string, double> inputDelays = emptyDelayMap);
 
 		/**
 		 * FixFunctionBySimplePoly destructor
@@ -50,6 +51,7 @@ namespace flopoco{
 		FixFunction *f;
 		BasicPolyApprox *poly;
 		bool finalRounding;
+		int scheme;
 
 		vector<int> coeffMSB;
 		vector<int> coeffLSB;
@@ -16,6 +16,8 @@
 
 #include "FixHornerEvaluator.hpp"
 #include "IntMult/FixMultAdd.hpp"
+#include "IntMult/IntMultiplier.hpp"
+#include "BitHeap/BitHeap.hpp"
 
 using namespace std;
 
@@ -72,6 +74,45 @@ using namespace std;
 		 */
 
 
+	/* The Estrin and hybrid schemes
+
+		 The coefficients are split in blocks of b consecutive coefficients (b a power of two).
+		 Each block is evaluated in X by Horner, giving a polynomial of degree ceil((d+1)/b)-1 in X^b,
+		 which is evaluated by Estrin:
+		 level k combines pairs of values of level k-1 as  v_j = v_2j + X^(b.2^(k-1)) * v_2j+1
+		 The powers X^(2^k) are obtained by successive squarings, in parallel with the Horner leaves.
+		 b=2 is the classical Estrin scheme; b>=d+1 is Horner.
+
+		 Every node is a multiply-add R = A + Y*B with |Y|<=1, so the error analysis is the same for all nodes:
+		 eps_R = eps_A + (1+eps_Y)*eps_B + 2^msbB*(eps_Y + eps_trunc(Y)) + eps_round(R)
+		 where the truncation of Y to the size of B is accounted exactly as the truncation of X in a Horner step.
+		 A squaring of a value computed with an error e incurs an error 2e+e^2, plus its own rounding error.
+		 As for Horner, all the LSBs start at lsbCoeff and are decreased together until the budget is met.
+		 MSBs are worst-case: max(msbA, msbB)+1.
+
+		 The hybrid scheme tries all the block sizes and keeps the one that minimizes
+		 (sum of the multiplier input bit products) * (number of multipliers on the critical path).
+		 */
+
+
+	/* Merged Horner steps
+
+		 Each Horner step is a FixMultAdd, i.e. a bit heap followed by a carry propagation.
+		 The last k steps may instead be expanded as
+		 sigma_0 = a_0 + a_1.X + a_2.X^2 + ... + a_(k-1).X^(k-1) + sigma_k.X^k
+		 where all the products are virtual multipliers of a single bit heap: one carry propagation instead of k.
+		 The powers X^j and the products a_j.X^j only depend on the inputs, so they are computed in parallel with
+		 the Horner steps down to sigma_k: only the product sigma_k.X^k remains on the critical path.
+
+		 The powers are computed by successive faithful multiplications, X^j being rounded to lsbXPow[j]
+		 such that its error, multiplied by the largest multiplicand, is about half an ulp of sigma_0:
+		 eps(X^j) = eps(X^(j-1)) + 2^lsbXPow[j]  (since |X|<=1)
+		 The bit heap has enough guard bits for the worst truncated product, plus log2(k+1) bits for the sum of
+		 the k truncated products and the truncated a_0, so it is faithful like a FixMultAdd:
+		 eps_merged = sum_j 2^msb(a_j).eps(X^j) + 2^msbSigma[k].eps(X^k) + 2^lsbSigma[0]
+		 */
+
+
 #define LARGE_PREC 1000 // 1000 bits should be enough for everybody
 
 
@@ -89,7 +130,7 @@ namespace flopoco{
 		// Now compute the rounding error entailed by this setup, and loop if it overshoots the budget
 		while (!done){
 			error=0.0;
-			for(int i=degree-1; i>=0; i--) {
+			for(int i=degree-1; i>=mergedSteps; i--) {
 				// Truncation of x:
 				// One input to the mult will be sigma[i+1], of size msbSigma[i+1]-lsbSigma[i+1]+1
 				// The other will be X, of size 0-lsbIn+1;  truncate it to the same size:
@@ -108,6 +149,8 @@ namespace flopoco{
 					error += exp2(lsbSigma[i]);
 				REPORT(DETAILED, "i="<< i  << " lsbXtrunc=" << 	lsbXTrunc[i] << " msbP=" << msbP[i]<< " lsbP=" << lsbP[i]<< " msbSigma=" << 	msbSigma[i]<< " lsbSigma=" << 	lsbSigma[i]);
 			}
+			if(mergedSteps>0)
+				error += mergedStepsError();
 			if(error < roundingErrorBudget){
 				REPORT(INFO, "Rounding error bounded by "<< error  << ": Success!");
 				done=true;
@@ -122,22 +165,248 @@ namespace flopoco{
 
 		
 		// A bit of reporting
-		for(int i=degree-1; i>=0; i--) {
+		for(int i=degree-1; i>=mergedSteps; i--) {
 			REPORT(INFO, "  level " << i << " requires a signed " << 0-lsbXTrunc[i]+1 << "x" <<  msbSigma[i+1] - lsbSigma[i+1] +1 << " multiplier");
 		}
+		if(mergedSteps>0)
+			REPORT(INFO, "  levels " << mergedSteps-1 << " to 0 are merged in a bit heap, X^" << mergedSteps << " being rounded to weight " << lsbXPow[mergedSteps]);
 	} 
 
 
 
+	double FixHornerEvaluator::mergedStepsError(){
+		int k=mergedSteps;
+		int msbMax = msbSigma[k];
+		for(int j=1; j<k; j++)
+			msbMax = max(msbMax, msbCoeff[j]);
+
+		double error=0;
+		double errPow=0;
+		lsbXPow[1] = lsbIn; // X itself is exact
+		for(int j=2; j<=k; j++) {
+			lsbXPow[j] = max(lsbXPow[j-1]+lsbIn, lsbSigma[0]-msbMax-1);
+			if(lsbXPow[j] != lsbXPow[j-1]+lsbIn) // the power is not exact
+				errPow += exp2(lsbXPow[j]); // faithful multiplier
+			int msbMultiplicand = (j<k ? msbCoeff[j] : msbSigma[k]);
+			error += exp2(msbMultiplicand) * errPow;
+		}
+		// The bit heap is faithful
+		error += exp2(lsbSigma[0]);
+		return error;
+	}
+
+
+
+
+	void FixHornerEvaluator::buildEstrinTree(int blockSize_){
+		blockSize = blockSize_;
+		nodeName.clear();
+		nodeA.clear();
+		nodeB.clear();
+		nodePow.clear();
+		msbOf.clear();
+		lsbOf.clear();
+
+		for(int i=0; i<=degree; i++) {
+			msbOf[join("As", i)] = msbCoeff[i];
+			lsbOf[join("As", i)] = lsbCoeff;
+		}
+
+		int log2b=0;
+		while((1<<log2b) < blockSize)
+			log2b++;
+		nbPow=1;
+
+		// The Horner leaves
+		vector<string> level;
+		int nbBlocks = (degree+blockSize)/blockSize;
+		for(int j=0; j<nbBlocks; j++) {
+			int first = j*blockSize;
+			int last = min(first+blockSize-1, degree);
+			string sigma = join("As", last);
+			for(int i=last-1; i>=first; i--) {
+				string name = join("Leaf", j, "_", i);
+				nodeName.push_back(name);
+				nodeA.push_back(join("As", i));
+				nodeB.push_back(sigma);
+				nodePow.push_back(0);
+				// A+B*X with |X|<=1: knowing only the MSBs of A and B, |A+B*X| may exceed 2^max(msbA,msbB), hence the +1.
+				// Tightening it would need the actual ranges of the node values, as for msbSigma in Horner
+				msbOf[name] = max(msbOf[join("As", i)], msbOf[sigma]) + 1;
+				sigma = name;
+			}
+			level.push_back(sigma);
+		}
+
+		// The Estrin tree
+		int k=0;
+		while(level.size()>1) {
+			k++;
+			vector<string> nextLevel;
+			for(size_t j=0; j<level.size(); j+=2) {
+				if(j+1 < level.size()) {
+					string name = join("Estrin", k, "_", j/2);
+					nodeName.push_back(name);
+					nodeA.push_back(level[j]);
+					nodeB.push_back(level[j+1]);
+					nodePow.push_back(log2b+k-1);
+					nbPow = max(nbPow, log2b+k);
+					msbOf[name] = max(msbOf[level[j]], msbOf[level[j+1]]) + 1;
+					nextLevel.push_back(name);
+				}
+				else
+					nextLevel.push_back(level[j]);
+			}
+			level = nextLevel;
+		}
+		rootName = level[0];
+
+		lsbPow.assign(nbPow, lsbIn);
+		errPow.assign(nbPow, 0.0);
+		lsbYTrunc.assign(nodeName.size(), lsbIn);
+	}
+
+
+
+	void FixHornerEvaluator::computeEstrinLSBs(){
+		int lsbEval = lsbCoeff; // this one will decrease if we need more accuracy
+		double error;
+		bool done=false;
+		while (!done){
+			// The powers of X
+			lsbPow[0] = lsbIn;
+			errPow[0] = 0;
+			for(int k=1; k<nbPow; k++) {
+				lsbPow[k] = max(lsbEval, 2*lsbPow[k-1]);
+				double e = errPow[k-1];
+				errPow[k] = 2*e + e*e;
+				if(lsbPow[k] != 2*lsbPow[k-1]) { // the square is not exact
+					if(getTarget()->plainVHDL())
+						errPow[k] += exp2(lsbPow[k]-1);
+					else
+						errPow[k] += exp2(lsbPow[k]);
+				}
+			}
+
+			// The nodes, in topological order
+			map<string, double> errOf;
+			for(int i=0; i<=degree; i++)
+				errOf[join("As", i)] = 0;
+			for(size_t n=0; n<nodeName.size(); n++) {
+				int p = nodePow[n];
+				int msbY = (p==0 ? 0 : 1);
+				int msbB = msbOf[nodeB[n]];
+				int lsbB = lsbOf[nodeB[n]];
+				// Truncate Y to the size of B
+				lsbYTrunc[n] = max(lsbPow[p], msbY + lsbB - msbB);
+				lsbOf[nodeName[n]] = lsbEval;
+				double e = errOf[nodeA[n]] + (1+errPow[p])*errOf[nodeB[n]] + exp2(msbB)*errPow[p];
+				if(lsbYTrunc[n] != lsbPow[p]) // there has been some truncation
+					e += exp2(msbB + lsbYTrunc[n]);
+				if(getTarget()->plainVHDL()) 	// we will be able to round the product to lsbEval
+					e += exp2(lsbEval-1);
+				else // we will truncate the product to lsbEval
+					e += exp2(lsbEval);
+				errOf[nodeName[n]] = e;
+			}
+			error = errOf[rootName];
+
+			if(error < roundingErrorBudget){
+				REPORT(DETAILED, "Block size " << blockSize << ": rounding error bounded by "<< error  << ": Success!");
+				done=true;
+			}
+			else {
+				REPORT(DEBUG, "Block size " << blockSize << ": rounding error bounded by "<< error  << ", error budget was " << roundingErrorBudget << ": decreasing LSBs...");
+				lsbEval--;
+			}
+		} // while
+	}
+
+
+
+	double FixHornerEvaluator::estrinCost(){
+		double area=0;
+		vector<int> depthPow(nbPow, 0);
+		for(int k=1; k<nbPow; k++) {
+			int w = (k==1 ? 0 : 1) - lsbPow[k-1] + 1;
+			area += w*w;
+			depthPow[k] = k;
+		}
+		map<string, int> depth;
+		for(int i=0; i<=degree; i++)
+			depth[join("As", i)] = 0;
+		for(size_t n=0; n<nodeName.size(); n++) {
+			int p = nodePow[n];
+			int wY = (p==0 ? 0 : 1) - lsbYTrunc[n] + 1;
+			int wB = msbOf[nodeB[n]] - lsbOf[nodeB[n]] + 1;
+			area += wY*wB;
+			depth[nodeName[n]] = 1 + max(depthPow[p], max(depth[nodeA[n]], depth[nodeB[n]]));
+		}
+		REPORT(DETAILED, "Block size " << blockSize << ": area=" << area << " depth=" << depth[rootName]);
+		return area * depth[rootName];
+	}
+
+
+
+	void FixHornerEvaluator::chooseEstrinScheme(){
+		if(!signedXandCoeffs)
+			THROWERROR("The Estrin and hybrid schemes are only implemented for signed X and coefficients");
+
+		if(scheme==Estrin) {
+			buildEstrinTree(2);
+			computeEstrinLSBs();
+			return;
+		}
+
+		// Hybrid: try all the power-of-two block sizes, the last one being plain Horner
+		int bestBlockSize=0;
+		double bestCost=0;
+		for(int b=2; ; b*=2) {
+			buildEstrinTree(b);
+			computeEstrinLSBs();
+			double cost = estrinCost();
+			if(bestBlockSize==0 || cost<bestCost) {
+				bestBlockSize=b;
+				bestCost=cost;
+			}
+			if(b>=degree+1)
+				break;
+		}
+		if(bestBlockSize>=degree+1) { // Horner wins: use its more accurate MSB analysis
+			REPORT(INFO, "Hybrid scheme: Horner is the cheapest");
+			scheme=Horner;
+		}
+		else {
+			REPORT(INFO, "Hybrid scheme: Horner blocks of " << bestBlockSize << " coefficients combined by Estrin");
+			buildEstrinTree(bestBlockSize);
+			computeEstrinLSBs();
+		}
+	}
+
+
+
 	
 	void FixHornerEvaluator::initialize(){
 		setNameWithFreqAndUID("FixHornerEvaluator");		
 		setCopyrightString("F. de Dinechin (2014)");
 		srcFileName="FixHornerEvaluator";
 
+		if(roundingErrorBudget==-1)
+			roundingErrorBudget=exp2(lsbOut-2);
+
 		if(!signedXandCoeffs)
 			REPORT(0,"signedXandCoeffs=false, this code has probably never been tested in this case. If it works, please remove this warning. If it doesn't, we deeply apologize and invite you to fix it.");
 
+		if(mergedSteps==-1 || mergedSteps>degree)
+			mergedSteps=degree;
+		if(mergedSteps<=1 || scheme!=Horner || !signedXandCoeffs)
+			mergedSteps=0; // merging one step is what FixMultAdd does already
+		if(mergedSteps>0 && getTarget()->plainVHDL()) {
+			REPORT(INFO, "mergedSteps is ignored in plainVHDL mode");
+			mergedSteps=0;
+		}
+		lsbXPow.assign(mergedSteps+1, lsbIn);
+
 			// computing the coeff sizes
 		for (int i=0; i<=degree; i++)
 			coeffSize.push_back(msbCoeff[i]-lsbCoeff+1); // see FixConstant.hpp for the constant format
@@ -172,11 +441,16 @@ namespace flopoco{
 					 << " <= " << (signedXandCoeffs?"signed":"unsigned") << "(" << join("A",i) << ");" <<endl;
 		}
 
+		if(scheme!=Horner) {
+			generateEstrinVHDL();
+			return;
+		}
+
 		// Initialize the Horner recurrence
 		vhdl << tab << declareFixPoint(join("Sigma", degree), true, msbSigma[degree], lsbSigma[degree])
 				 << " <= " << join("As", degree)  << ";" << endl;
 
-		for(int i=degree-1; i>=0; i--) {
+		for(int i=degree-1; i>=mergedSteps; i--) {
 			resizeFixPoint(join("XsTrunc", i), "Xs", 0, lsbXTrunc[i]);
 
 			//  assemble faithful operators (either FixMultAdd, or truncated mult)
@@ -210,6 +484,8 @@ namespace flopoco{
 			syncCycleFromSignal(join("Sigma", i));
 			nextCycle();
 		}
+		if(mergedSteps>0)
+			generateMergedVHDL();
 		if(finalRounding)
 			resizeFixPoint("Ys", "Sigma0",  msbOut, lsbOut);
 
@@ -218,22 +494,183 @@ namespace flopoco{
 	}
 
 
+
+	void FixHornerEvaluator::generateMergedVHDL(){
+		int k=mergedSteps;
+		int sigmaCycle = getCurrentCycle();
+
+		// The powers X^j, in parallel with the Horner steps
+		setCycleFromSignal("Xs");
+		for(int j=2; j<=k; j++) {
+			string prev = (j==2 ? "Xs" : join("XPow", j-1));
+			int msbPrev = (j==2 ? 0 : 1);
+			IntMultiplier::newComponentAndInstance(this,
+																						 join("Pow", j),
+																						 prev, "Xs",
+																						 join("XPowFull", j),
+																						 msbPrev+1, lsbXPow[j]
+																						 );
+			syncCycleFromSignal(join("XPowFull", j));
+			resizeFixPoint(join("XPow", j), join("XPowFull", j), 1, lsbXPow[j]);
+		}
+
+		// The bit heap
+		int wOut = msbSigma[0]-lsbSigma[0]+1;
+		int g=0;
+		for(int j=1; j<=k; j++) {
+			int wA = (j<k ? msbCoeff[j]-lsbCoeff+1 : msbSigma[k]-lsbSigma[k]+1);
+			int wY = (j==1 ? 0 : 1) - lsbXPow[j] + 1;
+			g = max(g, IntMultiplier::neededGuardBits(getTarget(), wA, wY, wOut));
+		}
+		g += intlog2(k); // the k products and a_0 are each truncated
+		int lsbHeap = lsbSigma[0]-g;
+		REPORT(DETAILED, "Merged steps: bit heap of size " << wOut+g << ", out of which " << g << " guard bits");
+		BitHeap* bitHeap = new BitHeap(this, wOut+g);
+		bitHeap->setSignedIO(true);
+
+		for(int j=1; j<=k; j++) {
+			string a = (j<k ? join("As", j) : join("Sigma", k));
+			string y = (j==1 ? "Xs" : join("XPow", j));
+			int msbA = (j<k ? msbCoeff[j] : msbSigma[k]);
+			int lsbA = (j<k ? lsbCoeff : lsbSigma[k]);
+			int msbY = (j==1 ? 0 : 1);
+			if(j<k)
+				setCycleFromSignal(a);
+			else
+				setCycle(sigmaCycle);
+			syncCycleFromSignal(y);
+			// the virtual multipliers work on std_logic_vectors
+			vhdl << tab << declare(join("MergedA", j), msbA-lsbA+1) << " <= std_logic_vector(" << a << ");" << endl;
+			vhdl << tab << declare(join("MergedY", j), msbY-lsbXPow[j]+1) << " <= std_logic_vector(" << y << ");" << endl;
+			new IntMultiplier(this,
+												bitHeap,
+												getSignalByName(join("MergedY", j)),
+												getSignalByName(join("MergedA", j)),
+												lsbA+lsbXPow[j]-lsbHeap, // offset of the LSB of the product in the bit heap
+												false /*negate*/,
+												true /*signed*/);
+		}
+
+		// The addend a_0, possibly truncated
+		setCycleFromSignal("As0");
+		vhdl << tab << declare("MergedA0", msbCoeff[0]-lsbCoeff+1) << " <= std_logic_vector(As0);" << endl;
+		int weightA0 = lsbCoeff-lsbHeap;
+		bitHeap->addSignedBitVector(weightA0, "MergedA0", msbCoeff[0]-lsbCoeff+1, max(0, -weightA0), (weightA0<0));
+
+		// The rounding bit
+		bitHeap->addConstantOneBit(g-1);
+
+		setCycle(sigmaCycle);
+		bitHeap->generateCompressorVHDL();
+		vhdl << tab << declare("Sigma0_slv", wOut) << " <= " << bitHeap->getSumName() << range(wOut+g-1, g) << ";" << endl;
+		vhdl << tab << declareFixPoint("Sigma0", true, msbSigma[0], lsbSigma[0]) << " <= signed(Sigma0_slv);" << endl;
+	}
+
+
+
+	void FixHornerEvaluator::generateEstrinVHDL(){
+		// The powers X^(2^k), by successive squarings
+		for(int k=1; k<nbPow; k++) {
+			string prev = (k==1 ? "Xs" : join("XPow", k-1));
+			int msbPrev = (k==1 ? 0 : 1);
+			int lsbPrev = lsbPow[k-1];
+			setCycleFromSignal(prev);
+			if(getTarget()->plainVHDL()) {
+				vhdl << tab << declareFixPoint(join("XPowFull", k), true, 2*msbPrev+1, 2*lsbPrev)
+						 << " <= " << prev << " * " << prev << ";" << endl;
+				setCycle(getCurrentCycle() + getTarget()->plainMultDepth(msbPrev-lsbPrev+1, msbPrev-lsbPrev+1) );
+				if(lsbPow[k] == 2*lsbPrev)
+					resizeFixPoint(join("XPow", k), join("XPowFull", k), 1, lsbPow[k]);
+				else {
+					resizeFixPoint(join("XPowTrunc", k), join("XPowFull", k), 1, lsbPow[k]-1);
+					vhdl << tab << declareFixPoint(join("XPowBeforeRound", k), true, 1, lsbPow[k]-1)
+							 << " <= " << join("XPowTrunc", k) << "+'1';" << endl;
+					resizeFixPoint(join("XPow", k), join("XPowBeforeRound", k), 1, lsbPow[k]);
+				}
+				nextCycle();
+			}
+			else {
+				IntMultiplier::newComponentAndInstance(this,
+																							 join("Square", k),
+																							 prev, prev,
+																							 join("XPowFull", k),
+																							 2*msbPrev+1, lsbPow[k]
+																							 );
+				syncCycleFromSignal(join("XPowFull", k));
+				resizeFixPoint(join("XPow", k), join("XPowFull", k), 1, lsbPow[k]);
+			}
+		}
+
+		// The multiply-add nodes
+		for(size_t n=0; n<nodeName.size(); n++) {
+			int p = nodePow[n];
+			string y = (p==0 ? "Xs" : join("XPow", p));
+			int msbY = (p==0 ? 0 : 1);
+			string name = nodeName[n];
+			int msbB = msbOf[nodeB[n]];
+			int lsbB = lsbOf[nodeB[n]];
+			setCycleFromSignal(nodeA[n]);
+			syncCycleFromSignal(nodeB[n]);
+			syncCycleFromSignal(y);
+			resizeFixPoint(join(name, "_Y"), y, msbY, lsbYTrunc[n]);
+
+			if(getTarget()->plainVHDL()) {	// stupid pipelining here, as in Horner
+				vhdl << tab << declareFixPoint(join(name, "_P"), true, msbY+msbB+1,  lsbYTrunc[n]+lsbB)
+						 <<  " <= "<< join(name, "_Y") << " * " << nodeB[n] << ";" << endl;
+				resizeFixPoint(join(name, "_Ptrunc"), join(name, "_P"), msbOf[name], lsbOf[name]-1);
+				resizeFixPoint(join(name, "_Aext"), nodeA[n], msbOf[name], lsbOf[name]-1);
+				setCycle(getCurrentCycle() + getTarget()->plainMultDepth(msbY-lsbYTrunc[n]+1, msbB-lsbB+1) );
+				vhdl << tab << declareFixPoint(join(name, "_BeforeRound"), true, msbOf[name], lsbOf[name]-1)
+						 << " <= " << join(name, "_Aext") << " + " << join(name, "_Ptrunc") << "+'1';" << endl;
+				resizeFixPoint(name, join(name, "_BeforeRound"), msbOf[name], lsbOf[name]);
+				nextCycle();
+			}
+			else {
+				FixMultAdd::newComponentAndInstance(this,
+																						join(name, "_Step"), // instance name
+																						join(name, "_Y"),    // x
+																						nodeB[n],            // y
+																						nodeA[n],            // a
+																						name,                // result
+																						msbOf[name], lsbOf[name]
+																						);
+			}
+			syncCycleFromSignal(name);
+		}
+
+		setCycleFromSignal(rootName);
+		if(finalRounding)
+			resizeFixPoint("Ys", rootName,  msbOut, lsbOut);
+
+		vhdl << tab << "R <= " << "std_logic_vector(Ys);" << endl;
+	}
+
+
 	// A naive constructor that does a worst case analysis of datapath looing onnly at the coeff sizes
 	FixHornerEvaluator::FixHornerEvaluator(Target* target,
 																				 int lsbIn_, int msbOut_, int lsbOut_,
 																				 int degree_, vector<int> msbCoeff_, int lsbCoeff_,
 																				 double roundingErrorBudget_,
 																				 bool signedXandCoeffs_,
-																				 bool finalRounding_, map<string, double> inputDelays)
+																				 bool finalRounding_, EvaluationScheme scheme_,
+																				 int mergedSteps_,
+																				 map<string, double> inputDelays)
 	: Operator(target), degree(degree_), lsbIn(lsbIn_), msbOut(msbOut_), lsbOut(lsbOut_),
 		msbCoeff(msbCoeff_), lsbCoeff(lsbCoeff_),
 		roundingErrorBudget(roundingErrorBudget_) ,signedXandCoeffs(signedXandCoeffs_),
-		finalRounding(finalRounding_)
+		finalRounding(finalRounding_), scheme(scheme_), mergedSteps(mergedSteps_)
   {
 		initialize();
 
+		if(scheme!=Horner)
+			chooseEstrinScheme();
+		if(scheme!=Horner) {
+			generateVHDL();
+			return;
+		}
+
 		// initialize the vectors to the proper size so we can use them as arrays. I know.
-		for (int i=0; i<degree; i++) {
+		for (int i=0; i<=degree; i++) {
 			msbSigma.push_back(0);
 			signSigma.push_back(0); // For signSigma this happens to be the default
 			msbP.push_back(0);
@@ -265,17 +702,27 @@ namespace flopoco{
 																				 vector<int> sigmaSign_, vector<int> sigmaMSB_,
 																				 double roundingErrorBudget_,
 																				 bool signedXandCoeffs_,
-																				 bool finalRounding_, map<string, double> inputDelays)
+																				 bool finalRounding_, EvaluationScheme scheme_,
+																				 int mergedSteps_,
+																				 map<string, double> inputDelays)
 	: Operator(target), degree(degree_), lsbIn(lsbIn_), msbOut(msbOut_), lsbOut(lsbOut_),
 		msbCoeff(msbCoeff_), lsbCoeff(lsbCoeff_),
 		roundingErrorBudget(roundingErrorBudget_) ,
 		signedXandCoeffs(signedXandCoeffs_),
-		finalRounding(finalRounding_),
+		finalRounding(finalRounding_), scheme(scheme_), mergedSteps(mergedSteps_),
 		signSigma(sigmaSign_),  msbSigma(sigmaMSB_)
   {
 		initialize();
+
+		if(scheme!=Horner)
+			chooseEstrinScheme();
+		if(scheme!=Horner) {
+			generateVHDL();
+			return;
+		}
+
 		// initialize the vectors to the proper size so we can use them as arrays. I know.
-		for (int i=0; i<degree; i++) {
+		for (int i=0; i<=degree; i++) {
 			msbP.push_back(0);
 			lsbP.push_back(0);
 			lsbSigma.push_back(0);
@@ -25,11 +25,21 @@ namespace flopoco{
 
 	/** An Horner polynomial evaluator computing just right.
 	 It assumes the input X is an signed number in [-1, 1[ so msbX=-wX.
+	 Instead of the Horner scheme, it may also use the Estrin scheme, whose depth is logarithmic in the degree,
+	 or a hybrid scheme that evaluates blocks of coefficients by Horner and combines them by Estrin.
+	 In the Horner scheme, the last steps may also be merged into a single bit heap (see mergedSteps).
 	*/
 
   class FixHornerEvaluator : public Operator
   {
   public:
+		/** The evaluation schemes */
+		typedef enum {
+			Horner=0, /**< d multiply-adds in sequence */
+			Estrin=1, /**< pairs of coefficients combined by powers X^(2^k): depth log2(d+1) */
+			Hybrid=2  /**< Horner blocks combined by Estrin, the block size being chosen to minimize area*depth */
+		} EvaluationScheme;
+
     /** The constructor with manual control of all options.
      * @param    lsbIn input lsb weight, 
 			 @param    msbOut  output MSB weight, used to determine wOut
@@ -41,6 +51,10 @@ namespace flopoco{
 			 @param    signedXandCoeffs  true if the coefficients are signed numbers (usually true)
 			 @param   finalRounding: if false, the operator outputs its guard bits as well, saving the half-ulp rounding error. 
 			                 This makes sense in situations that further process the result with further guard bits.
+			 @param   scheme: the evaluation scheme, see EvaluationScheme
+			 @param   mergedSteps: number k of final Horner steps merged into a single bit heap, computing 
+			                 sigma_0 = a_0 + a_1.X + ... + a_(k-1).X^(k-1) + sigma_k.X^k with one carry propagation.
+			                 0 or 1 means the classical Horner, -1 means all the steps. Ignored by the other schemes and by plainVHDL.
 
      */
 
@@ -55,10 +69,13 @@ namespace flopoco{
 											 double roundingErrorBudget=-1,
 											 bool signedXandCoeffs=true, 
 											 bool finalRounding=true,
+											 EvaluationScheme scheme=Horner,
+											 int mergedSteps=0,
 											 map<string, double> inputDelays = emptyDelayMap);
 
 		
-		/** An optimized constructor if the caller has been able to compute the signs and MSBs of the sigma terms */
+		/** An optimized constructor if the caller has been able to compute the signs and MSBs of the sigma terms.
+		    These are Horner-specific: the Estrin and hybrid schemes ignore them and use the worst-case MSBs */
     FixHornerEvaluator(Target* target, 
 											 int lsbIn,
 											 int msbOut,
@@ -70,6 +87,8 @@ namespace flopoco{
 											 double roundingErrorBudget=-1,
 											 bool signedXandCoeffs=true, 
 											 bool finalRounding=true,
+											 EvaluationScheme scheme=Horner,
+											 int mergedSteps=0,
 											 map<string, double> inputDelays = emptyDelayMap);
 
     ~FixHornerEvaluator();
@@ -88,6 +107,8 @@ namespace flopoco{
 		bool finalRounding;               /** If true, the operator returns a rounded result (i.e. add the half-ulp then truncate)
 																					If false, the operator returns the full, unrounded results including guard bits */
 		vector<int> coeffSize;            /**< vector of the sizes of the coefficients, computed out of MSB and LSB. See FixConstant.hpp for the constant format */
+		EvaluationScheme scheme;          /**< the evaluation scheme actually used (Hybrid resolves to Horner or to Estrin-style blocks) */
+		int mergedSteps;                  /**< number of final Horner steps merged in a single bit heap, 0 if none */
 
 		// internal architectural parameters; max degree = 1000 should be enough for anybody
 		vector <int> signSigma;
@@ -96,10 +117,34 @@ namespace flopoco{
 		vector <int> lsbSigma;
 		vector <int> lsbP;
 		vector <int> lsbXTrunc;
+		vector <int> lsbXPow;             /**< LSB of X^j in the merged steps. Its MSB is 1 for j>1, as X^j may be equal to 1 */
+
+		// internal architectural parameters of the Estrin and hybrid schemes.
+		// The evaluation is a list, in topological order, of multiply-add nodes R = A + Y*B where Y is a power X^(2^k)
+		int blockSize;                    /**< number of coefficients of each Horner leaf: 2 for Estrin */
+		int nbPow;                        /**< number of powers X^(2^k) used, X itself included */
+		vector<int> lsbPow;               /**< LSB of X^(2^k). Its MSB is 1 for k>0, as X^(2^k) may be equal to 1 */
+		vector<double> errPow;            /**< bound on the rounding error of X^(2^k) */
+		vector<string> nodeName;          /**< name of the result R of each node */
+		vector<string> nodeA;             /**< name of the addend A of each node */
+		vector<string> nodeB;             /**< name of the multiplicand B of each node */
+		vector<int> nodePow;              /**< Y of each node is X^(2^nodePow) */
+		vector<int> lsbYTrunc;            /**< LSB to which Y is truncated before the multiplication */
+		map<string, int> msbOf;           /**< MSB of the coefficients and node results, indexed by name */
+		map<string, int> lsbOf;           /**< LSB of the coefficients and node results, indexed by name */
+		string rootName;                  /**< the node (or coefficient) holding the value of the polynomial */
 
 		void computeLSBs(); /**< error analysis that ensures the rounding budget is met */ 
 		void initialize(); /**< initialization factored out between various constructors */ 
 		void generateVHDL(); /**< generation of the VHDL once all the parameters have been computed */ 
+		double mergedStepsError(); /**< error analysis of the merged steps, for the current lsbSigma[0] */
+		void generateMergedVHDL(); /**< generation of the VHDL of the merged steps, once Sigma_k is computed */
+
+		void buildEstrinTree(int blockSize); /**< builds the list of nodes of the Estrin/hybrid scheme for a given block size, with worst-case MSBs */
+		void computeEstrinLSBs(); /**< error analysis of the Estrin/hybrid scheme that ensures the rounding budget is met */
+		double estrinCost(); /**< area*depth cost of the Estrin/hybrid scheme, area being counted in multiplier input bit products */
+		void chooseEstrinScheme(); /**< builds the Estrin tree, or chooses the block size of the hybrid scheme */
+		void generateEstrinVHDL(); /**< generation of the VHDL of the Estrin/hybrid scheme */
 
   };
 
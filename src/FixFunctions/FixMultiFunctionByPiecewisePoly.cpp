@@ -0,0 +1,364 @@
+/*
+  Several functions of the same input, by piecewise polynomials sharing their segments
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+  developed by the Arenaire team at Ecole Normale Superieure de Lyon
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+
+  All rights reserved.
+
+  */
+
+/*
+	The approximations of all the functions are built with the same alpha (the largest one needed),
+	so the address A and the reduced argument Z are common, and the coefficients of all the functions
+	are read from one wide table.
+
+	Each polynomial is evaluated as p(Z) = a_0 + a_1.Z + ... + a_d.Z^d:
+	the powers Z^j are computed once, by successive faithful multiplications, and shared by all the functions;
+	the products a_j.Z^j are faithful to lsbEval, and summed with a_0 in one bit heap per function.
+
+	Error analysis, for each function (|Z|<=1):
+	  eps(Z^j)   = eps(Z^(j-1)) + 2^lsbPow[j]    (0 if the power is exact)
+	  eps_eval   = sum_j  2^msb(a_j).eps(Z^j) + 2^lsbEval   (the latter if the product is rounded)
+	The final rounding bit is added to a_0 in the table, so the bit heap output is truncated to lsbOut,
+	and the evaluation error budget is 2^(lsbOut-1) - approxErrorBound as in FixFunctionByPiecewisePoly.
+	lsbEval starts at lsbOut-1 and is decreased until every function meets its budget.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <math.h>
+#include <string.h>
+
+#include <gmp.h>
+#include <mpfr.h>
+
+#include <gmpxx.h>
+#include "../utils.hpp"
+#include "../UserInterface.hpp"
+#include "GenericTable.hpp"
+#include "IntMult/IntMultiplier.hpp"
+#include "BitHeap/BitHeap.hpp"
+
+#include "FixMultiFunctionByPiecewisePoly.hpp"
+
+using namespace std;
+
+namespace flopoco{
+
+	FixMultiFunctionByPiecewisePoly::FixMultiFunctionByPiecewisePoly(Target* target, vector<string> funcs, int lsbIn_, int msbOut_, int lsbOut_, int degree_, double approxErrorBudget_, map<string, double> inputDelays):
+		Operator(target, inputDelays), nbFunctions(funcs.size()), degree(degree_), lsbIn(lsbIn_), msbOut(msbOut_), lsbOut(lsbOut_), approxErrorBudget(approxErrorBudget_){
+
+		if(nbFunctions==0)
+			THROWERROR("No function to evaluate");
+		if(degree<1)
+			THROWERROR("degree should be at least 1, got " << degree << ": for a simple table, use FixFunctionByTable");
+
+		srcFileName="FixMultiFunctionByPiecewisePoly";
+		ostringstream name;
+		name<<"FixMultiFunctionByPiecewisePoly_"<<getNewUId();
+		setName(name.str());
+
+		setCriticalPath(getMaxInputDelays(inputDelays));
+		setCopyrightString("FloPoCo developers (2026)");
+
+		for (int k=0; k<nbFunctions; k++) {
+			f.push_back(new FixFunction(funcs[k], false, lsbIn, msbOut, lsbOut)); // this will provide emulate etc.
+			addHeaderComment("-- Y" + to_string(k) + " evaluates " +  f[k]-> getDescription() + "\n");
+		}
+
+		int wX=-lsbIn;
+		addInput("X", wX);
+		for (int k=0; k<nbFunctions; k++)
+			addOutput(join("Y",k), msbOut-lsbOut+1, 2);
+		useNumericStd();
+
+		buildApproximations();
+		buildCoeffTable();
+		computeLSBs();
+
+		// The shared address decoding and reduced argument
+		vhdl << tab << declare("A", alpha)  << " <= X" << range(wX-1, wX-alpha) << ";" << endl;
+		vhdl << tab << declare("Z", wX-alpha)  << " <= X" << range(wX-alpha-1, 0) << ";" << endl;
+		vhdl << tab << declare("Zslv", wX-alpha)  << " <= (not Z(" << wX-alpha-1 << ")) & Z" << range(wX-alpha-2, 0) << "; -- centering the interval" << endl;
+		int lsbZ = lsbIn+alpha+1;
+		vhdl << tab << declareFixPoint("Zs", true, 0, lsbZ) << " <= signed(Zslv);" << endl;
+
+		// The shared coefficient table
+		GenericTable* coeffTable = new GenericTable(target, alpha, coeffTableOutputSize, coeffTableVector);
+		addSubComponent(coeffTable);
+		inPortMap(coeffTable, "X", "A");
+		outPortMap(coeffTable, "Y", "Coeffs");
+		vhdl << instance(coeffTable, "coeffTable") << endl;
+
+		// The shared powers of Z, in parallel with the table
+		setCycleFromSignal("Zs");
+		for(int j=2; j<=degree; j++) {
+			string prev = (j==2 ? "Zs" : join("ZPow", j-1));
+			int msbPrev = (j==2 ? 0 : 1);
+			IntMultiplier::newComponentAndInstance(this,
+																						 join("Pow", j),
+																						 prev, "Zs",
+																						 join("ZPowFull", j),
+																						 msbPrev+1, lsbPow[j]
+																						 );
+			syncCycleFromSignal(join("ZPowFull", j));
+			resizeFixPoint(join("ZPow", j), join("ZPowFull", j), 1, lsbPow[j]);
+		}
+
+		// Split the table output into each coefficient
+		setCycleFromSignal("Coeffs");
+		int currentShift=0;
+		for (int k=0; k<nbFunctions; k++) {
+			PiecewisePolyApprox* pa = polyApprox[k];
+			for(int i=degree; i>=0; i--) {
+				int actualSize = pa->MSB[i] - pa->LSB + (pa->coeffSigns[i]==0 ? 1 : 0);
+				vhdl << tab << declare(join("A",k,"_",i), pa->MSB[i] - pa->LSB +1)
+						 << " <= ";
+				if (pa->coeffSigns[i]!=0) // add constant sign back
+					vhdl << (pa->coeffSigns[i]==1? "\"0\"" :  "\"1\"") << " & " ;
+				vhdl << "Coeffs" << range(currentShift + actualSize-1, currentShift) << ";" << endl;
+				vhdl << tab << declareFixPoint(join("As",k,"_",i), true, pa->MSB[i], pa->LSB) << " <= signed(" << join("A",k,"_",i) << ");" << endl;
+				currentShift += actualSize;
+			}
+		}
+
+		// Each function: the products a_j.Z^j and a_0 summed in a bit heap
+		for (int k=0; k<nbFunctions; k++) {
+			PiecewisePolyApprox* pa = polyApprox[k];
+			int lsbHeap = min(lsbEval, pa->LSB);
+			BitHeap* bitHeap = new BitHeap(this, msbOut-lsbHeap+1, true, join("Y",k));
+			bitHeap->setSignedIO(true);
+			int lastCycle = getCurrentCycle();
+
+			for(int j=1; j<=degree; j++) {
+				string z = (j==1 ? "Zs" : join("ZPow", j));
+				string p = join("P",k,"_",j);
+				int msbZ = (j==1 ? 0 : 1);
+				int lsbP = max(lsbEval, pa->LSB+lsbPow[j]);
+				setCycleFromSignal(join("As",k,"_",j));
+				syncCycleFromSignal(z);
+				IntMultiplier::newComponentAndInstance(this,
+																							 join("Mult",k,"_",j),
+																							 z, join("As",k,"_",j),
+																							 join(p, "Full"),
+																							 pa->MSB[j]+msbZ+1, lsbP
+																							 );
+				syncCycleFromSignal(join(p, "Full"));
+				// modulo 2^(msbOut+1), as the sum fits in the output format
+				resizeFixPoint(p, join(p, "Full"), msbOut, lsbP);
+				vhdl << tab << declare(join(p, "_slv"), msbOut-lsbP+1) << " <= std_logic_vector(" << p << ");" << endl;
+				bitHeap->addSignedBitVector(lsbP-lsbHeap, join(p, "_slv"), msbOut-lsbP+1);
+				lastCycle = max(lastCycle, getCurrentCycle());
+			}
+
+			setCycleFromSignal(join("As",k,"_",0));
+			resizeFixPoint(join("As",k,"_0_ext"), join("As",k,"_",0), msbOut, pa->LSB);
+			vhdl << tab << declare(join("As",k,"_0_slv"), msbOut-pa->LSB+1) << " <= std_logic_vector(" << join("As",k,"_0_ext") << ");" << endl;
+			bitHeap->addSignedBitVector(pa->LSB-lsbHeap, join("As",k,"_0_slv"), msbOut-pa->LSB+1);
+
+			setCycle(lastCycle);
+			bitHeap->generateCompressorVHDL();
+			vhdl << tab << join("Y",k) << " <= " << bitHeap->getSumName() << range(msbOut-lsbHeap, lsbOut-lsbHeap) << ";" << endl;
+		}
+	}
+
+
+
+	FixMultiFunctionByPiecewisePoly::~FixMultiFunctionByPiecewisePoly() {
+		// the approximations refer to the functions
+		for (auto i: polyApprox)
+			delete i;
+		for (auto i: f)
+			delete i;
+	}
+
+
+
+	void FixMultiFunctionByPiecewisePoly::buildApproximations() {
+		double targetAcc= approxErrorBudget*pow(2, lsbOut);
+		alpha=0;
+		for (int k=0; k<nbFunctions; k++) {
+			REPORT(INFO, "Computing polynomial approximation of " << f[k]->getDescription() << " for target accuracy "<< targetAcc);
+			polyApprox.push_back(new PiecewisePolyApprox(f[k], targetAcc, degree));
+			alpha = max(alpha, polyApprox[k]->alpha);
+		}
+		// Rebuild the approximations that need fewer segments with the common alpha.
+		// An approximation may end up with a larger alpha (see PiecewisePolyApprox), then we iterate.
+		bool done=false;
+		while(!done) {
+			done=true;
+			for (int k=0; k<nbFunctions; k++) {
+				if(polyApprox[k]->alpha < alpha) {
+					REPORT(DETAILED, "Rebuilding the approximation of " << f[k]->getDescription() << " with alpha=" << alpha);
+					delete polyApprox[k];
+					polyApprox[k] = new PiecewisePolyApprox(f[k], targetAcc, degree, alpha);
+					if(polyApprox[k]->alpha > alpha) {
+						alpha = polyApprox[k]->alpha;
+						done=false;
+					}
+				}
+			}
+		}
+		REPORT(INFO, "All the functions use alpha=" << alpha);
+
+		// Resize their MSB to the one input by the user.
+		for (int k=0; k<nbFunctions; k++) {
+			for (int i=0; i<(1<<alpha); i++) {
+				polyApprox[k] -> poly[i] -> coeff[0] -> changeMSB(msbOut);
+			}
+			polyApprox[k] -> MSB[0] = msbOut;
+		}
+	}
+
+
+
+	void FixMultiFunctionByPiecewisePoly::buildCoeffTable() {
+		// First compute the table output size
+		coeffTableOutputSize=0;
+		for (int k=0; k<nbFunctions; k++) {
+			for (int i=0; i<=degree; i++) {
+				coeffTableOutputSize += polyApprox[k]->MSB[i] - polyApprox[k]->LSB + (polyApprox[k]->coeffSigns[i]==0? 1 : 0);
+			}
+		}
+		REPORT(DETAILED, "Coeff table input size  = " << alpha);
+		REPORT(DETAILED, "Coeff table output size = " << coeffTableOutputSize);
+
+		for(int x=0; x<(1<<alpha); x++) {
+			mpz_class z=0;
+			int currentShift=0;
+			for (int k=0; k<nbFunctions; k++) {
+				PiecewisePolyApprox* pa = polyApprox[k];
+				for(int i=degree; i>=0; i--) {
+					int size = pa->MSB[i] - pa->LSB + (pa->coeffSigns[i]==0? 1: 0);
+					mpz_class coeff = pa-> getCoeff(x, i); // coeff of degree i from poly number x
+					if (pa->coeffSigns[i] != 0) {// sign is constant among all the coefficients: remove it from here, it will be added back as a constant in the VHDL
+						mpz_class mask = (mpz_class(1)<<(pa->MSB[i] - pa->LSB) ) - 1; // size is msb-lsb+1
+						coeff = coeff & mask;
+					}
+					if(i==0){ // coeff of degree 0: add the final round bit
+						coeff += mpz_class(1)<<(lsbOut-1 - pa->LSB);
+						// This may overflow in the case -tiny -> +tiny: this is OK modulo 2^size (two's complement)
+						coeff = coeff & ((mpz_class(1)<<size) -1);
+					}
+					z += coeff << currentShift;
+					currentShift += size;
+				}
+			}
+			coeffTableVector.push_back(z);
+		}
+	}
+
+
+
+	void FixMultiFunctionByPiecewisePoly::computeLSBs() {
+		int lsbZ = lsbIn+alpha+1;
+		int msbMax = INT_MIN;
+		for (int k=0; k<nbFunctions; k++)
+			for (int j=1; j<=degree; j++)
+				msbMax = max(msbMax, polyApprox[k]->MSB[j]);
+
+		lsbPow.assign(degree+1, lsbZ);
+		lsbEval = lsbOut-1;
+		bool done=false;
+		while(!done) {
+			vector<double> errPow(degree+1, 0.0);
+			for(int j=2; j<=degree; j++) {
+				lsbPow[j] = max(lsbPow[j-1]+lsbZ, lsbEval-msbMax-1);
+				errPow[j] = errPow[j-1];
+				if(lsbPow[j] != lsbPow[j-1]+lsbZ) // the power is not exact
+					errPow[j] += exp2(lsbPow[j]); // faithful multiplier
+			}
+			done=true;
+			for (int k=0; k<nbFunctions; k++) {
+				PiecewisePolyApprox* pa = polyApprox[k];
+				double error=0;
+				for(int j=1; j<=degree; j++) {
+					error += exp2(pa->MSB[j]) * errPow[j];
+					if(lsbEval > pa->LSB+lsbPow[j]) // the product is rounded
+						error += exp2(lsbEval);
+				}
+				double budget = exp2(lsbOut-1) - pa->approxErrorBound;
+				REPORT(DEBUG, "lsbEval=" << lsbEval << ": rounding error of Y" << k << " bounded by " << error << ", budget is " << budget);
+				if(error >= budget)
+					done=false;
+			}
+			if(!done)
+				lsbEval--;
+		}
+		REPORT(INFO, "Products rounded to weight " << lsbEval << ", Z^" << degree << " rounded to weight " << lsbPow[degree]);
+	}
+
+
+
+	void FixMultiFunctionByPiecewisePoly::emulate(TestCase* tc){
+		mpz_class x = tc->getInputValue("X");
+		for (int k=0; k<nbFunctions; k++) {
+			mpz_class rd, ru;
+			f[k]->eval(x, rd, ru, false);
+			tc->addExpectedOutput(join("Y",k), rd);
+			tc->addExpectedOutput(join("Y",k), ru);
+		}
+	}
+
+
+
+	void FixMultiFunctionByPiecewisePoly::buildStandardTestCases(TestCaseList* tcl){
+		TestCase *tc;
+
+		tc = new TestCase(this);
+		tc->addInput("X", 0);
+		emulate(tc);
+		tcl->add(tc);
+
+		tc = new TestCase(this);
+		tc->addInput("X", (mpz_class(1) << (-lsbIn)) -1);
+		emulate(tc);
+		tcl->add(tc);
+	}
+
+
+
+	OperatorPtr FixMultiFunctionByPiecewisePoly::parseArguments(Target *target, vector<string> &args) {
+		int lsbIn, msbOut, lsbOut, d;
+		string f;
+		double approxErrorBudget;
+		UserInterface::parseString(args, "f", &f);
+		UserInterface::parseInt(args, "lsbIn", &lsbIn);
+		UserInterface::parseInt(args, "msbOut", &msbOut);
+		UserInterface::parseInt(args, "lsbOut", &lsbOut);
+		UserInterface::parseStrictlyPositiveInt(args, "d", &d);
+		UserInterface::parseFloat(args, "approxErrorBudget", &approxErrorBudget);
+		vector<string> funcs;
+		stringstream ss(f);
+		string func;
+		while(getline(ss, func, ':'))
+			funcs.push_back(func);
+		return new FixMultiFunctionByPiecewisePoly(target, funcs, lsbIn, msbOut, lsbOut, d, approxErrorBudget);
+	}
+
+
+
+	void FixMultiFunctionByPiecewisePoly::registerFactory(){
+		UserInterface::add("FixMultiFunctionByPiecewisePoly", // name
+											 "Evaluator of several functions of the same input on [0,1), using piecewise polynomials sharing their segments.",
+											 "FunctionApproximation",
+											 "FixFunctionByPiecewisePoly",
+											 "f(string): colon-separated list of functions to be evaluated, between double-quotes, for instance \"sin(x):cos(x)\";\
+                        lsbIn(int): weight of input LSB, for instance -8 for an 8-bit input;\
+                        msbOut(int): weight of the MSB of the outputs;\
+                        lsbOut(int): weight of the LSB of the outputs;\
+                        d(int): degree of the polynomials;\
+                        approxErrorBudget(real)=0.25: error budget in ulp for the approximation, between 0 and 0.5",
+											 "Output Yi evaluates the i-th function. The address decoding, the coefficient table and the powers of the reduced argument are shared by all the functions, and each polynomial is summed in a bit heap.",
+											 FixMultiFunctionByPiecewisePoly::parseArguments
+											 ) ;
+	}
+
+}
@@ -0,0 +1,72 @@
+#ifndef FixMultiFunctionByPiecewisePoly_HPP
+#define FixMultiFunctionByPiecewisePoly_HPP
+#include <vector>
+#include <sstream>
+#include <gmp.h>
+#include <mpfr.h>
+#include <gmpxx.h>
+
+#include "../Operator.hpp"
+#include "FixFunction.hpp"
+#include "PiecewisePolyApprox.hpp"
+
+namespace flopoco{
+
+	/** The FixMultiFunctionByPiecewisePoly class: several functions of the same input evaluated in parallel.
+			All the piecewise approximations use the same segments, so there is one address decoding,
+			one wide coefficient table, and one reduced argument Z whose powers are shared by all the functions.
+			Each function is then evaluated as a_0 + a_1.Z + ... + a_d.Z^d, the products being summed in one bit heap.
+	*/
+	class FixMultiFunctionByPiecewisePoly : public Operator
+	{
+	public:
+		/**
+			 The constructor
+			 @param[vector<string>] funcs  the functions, input range should be [0,1]
+			 @param[int]    lsbIn   input LSB weight
+			 @param[int]    msbOut  output MSB weight, common to all the outputs
+			 @param[int]    lsbOut  output LSB weight, common to all the outputs
+			 @param[int]    degree  degree of the polynomial approximations
+			 @param[double] approxErrorBudget  error budget in ulp for the approximation, between 0 and 0.5
+			 The output of function i is Yi.
+		 */
+		FixMultiFunctionByPiecewisePoly(Target* target, vector<string> funcs, int lsbIn, int msbOut, int lsbOut, int degree, double approxErrorBudget=0.25, map<string, double> inputDelays = emptyDelayMap);
+
+		~FixMultiFunctionByPiecewisePoly();
+
+		void emulate(TestCase * tc);
+
+		void buildStandardTestCases(TestCaseList* tcl);
+
+		/** Factory method that parses arguments and calls the constructor */
+		static OperatorPtr parseArguments(Target *target , vector<string> &args);
+
+		/** Factory register method */
+		static void registerFactory();
+
+	private:
+		int nbFunctions;
+		int degree;
+		int lsbIn;
+		int msbOut;
+		int lsbOut;
+		int alpha;                              /**< common address size of the coefficient table */
+		double approxErrorBudget;
+		vector<FixFunction*> f;
+		vector<PiecewisePolyApprox*> polyApprox;
+		int coeffTableOutputSize;
+		vector<mpz_class> coeffTableVector;
+		int lsbEval;                            /**< LSB of the products a_j.Z^j */
+		vector<int> lsbPow;                     /**< LSB of Z^j. Its MSB is 1 for j>1, as Z^j may be equal to 1 */
+
+		/** Builds the approximations, with the same alpha for all of them */
+		void buildApproximations();
+		/** Builds the wide coefficient table, including the final rounding bits */
+		void buildCoeffTable();
+		/** Error analysis: computes lsbEval and lsbPow such that each function meets its rounding error budget */
+		void computeLSBs();
+	};
+
+}
+
+#endif
@@ -13,21 +13,22 @@
 
   */
 #include "HOTBM.hpp"
-#include "Function.hpp"
 #include "HOTBM/Param.hh"
 #include "HOTBM/HOTBMInstance.hh"
 #include "HOTBM/Exhaustive.hh"
 #include "../utils.hpp"
+#include "../UserInterface.hpp"
 
 
 namespace flopoco{
 
-	HOTBM::HOTBM(Target* target, string func, string namebase, int wI, int wO, int n, double xmin, double xmax, double scale)
-		: Operator(target), inst(0), f(*new Function(func, xmin, xmax, scale)), wI(wI), wO(wO)
+	HOTBM::HOTBM(Target* target, string func, int wI, int wO, int n)
+		: Operator(target), inst(0), f(new FixFunction(func, false, -wI, 1, -wO)), wI(wI), wO(wO)
 	{
+		srcFileName="HOTBM";
 		try {
 			Param p(wI, wO, n);
-			Exhaustive ex(f, p);
+			Exhaustive ex(*f, p);
 
 			inst = 0;
 			inst = ex.getInstance();
@@ -40,13 +41,11 @@ namespace flopoco{
 
 		{
 			std::ostringstream o;
-			if(namebase != "")
-				o << namebase << "_";
-
-			o << "hotbm_" << vhdlize(func) << wI << "_" << wO << "_" << n;
-			o << "_" << vhdlize(xmin) << "_" << vhdlize(xmax) << "_" << vhdlize(scale);
-			uniqueName_ = o.str();
+			o << "HOTBM_" << wI << "_" << wO << "_" << n;
+			setNameWithFreqAndUID(o.str());
 		}
+		setCopyrightString("Jeremie Detrey, Christian Klein, Florent de Dinechin (2005-2011)");
+		addHeaderComment("-- Evaluator for " +  f-> getDescription() + "\n");
 		setCombinatorial();
 		addInput("X", wI);
 		addOutput("R", wO+1, 2);  // faithful rounding
@@ -58,6 +57,7 @@ namespace flopoco{
 	{
 		if (inst)
 			delete inst;
+		delete f;
 	}
 
 	void HOTBM::emulate(TestCase* tc)
@@ -68,14 +68,15 @@ namespace flopoco{
 		// int outSign = 0;
 
 		mpfr_t mpX, mpR;
-		mpfr_inits(mpX, mpR, 0, NULL);
+		mpfr_init2(mpX, wI+1);
+		mpfr_init2(mpR, 10*(wO+1));
 
 		/* Convert a random signal to an mpfr_t in [0,1[ */
 		mpfr_set_z(mpX, sx.get_mpz_t(), GMP_RNDN);
 		mpfr_div_2si(mpX, mpX, wI, GMP_RNDN);
 
 		/* Compute the function */
-		f.eval(mpR, mpX);
+		f->eval(mpR, mpX);
 
 		/* Compute the signal value */
 		if (mpfr_signbit(mpR))
@@ -103,4 +104,32 @@ namespace flopoco{
 
 	int HOTBM::wIn() const { return wI; }
 	int HOTBM::wOut() const { return wO + 1; }
+
+
+	OperatorPtr HOTBM::parseArguments(Target *target, vector<string> &args)
+	{
+		string f;
+		int wIn, wOut, n;
+		UserInterface::parseString(args, "f", &f);
+		UserInterface::parseStrictlyPositiveInt(args, "wIn", &wIn);
+		UserInterface::parseStrictlyPositiveInt(args, "wOut", &wOut);
+		UserInterface::parseStrictlyPositiveInt(args, "n", &n);
+		return new HOTBM(target, f, wIn, wOut, n);
+	}
+
+	void HOTBM::registerFactory()
+	{
+		UserInterface::add("HOTBM", // name
+											 "Evaluator of the absolute value of a function f on [0,1) using the Higher-Order Table-Based Method.",
+											 "FunctionApproximation",
+											 "FixFunctionByPiecewisePoly,FixFunctionByMultipartiteTable",
+											 "f(string): function to be evaluated between double-quotes, for instance \"exp(x*x)\";\
+wIn(int): input size: the input LSB has weight 2^-wIn;\
+wOut(int): the output LSB has weight 2^-wOut, the output is in [0,2);\
+n(int)=2: degree of the polynomial approximation",
+											 "The HOTBM method is described in J. Detrey and F. de Dinechin, <i>Table-based polynomials for fast hardware function evaluation</i>, ASAP 2005. \
+The exploration of the parameters is multithreaded, and the terms are summed in a bit heap.",
+											 HOTBM::parseArguments
+											 ) ;
+	}
 }
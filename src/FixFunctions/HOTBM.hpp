@@ -7,21 +7,31 @@
 #include <gmpxx.h>
 
 #include "../Operator.hpp"
+#include "FixFunction.hpp"
 
 
 namespace flopoco{
 
 	class HOTBMInstance;
-	class Function;
 
 	/**
 	 * Implements an Operator around HOTBM. Acts like a wrapper around
 	 * HOTBM classes.
+	 * The input is in [0,1), the output is the absolute value of the function, faithfully rounded.
+	 * The minimax approximations are computed by Sollya through the FixFunction,
+	 * the exploration of the parameter space is multithreaded (see Exhaustive),
+	 * and the terms are summed in a bit heap.
 	 */
 	class HOTBM : public Operator
 	{
 	public:
-		HOTBM(Target* target, string func, string namebase, int wI, int wO, int n, double xmin = 0, double xmax = 1, double scale = 1);
+		/**
+		 * @param func the function, a Sollya expression of x
+		 * @param wI   the input size: the input is in [0,1) with an LSB of weight 2^-wI
+		 * @param wO   the output LSB has weight 2^-wO, the output is in [0,2)
+		 * @param n    the degree of the approximation
+		 */
+		HOTBM(Target* target, string func, int wI, int wO, int n);
 		~HOTBM();
 
 		// Overloading the virtual functions of Operator
@@ -33,9 +43,15 @@ namespace flopoco{
 		// defined in HOTBMInstance.cc
 		void genVHDL();
 
+		/** Factory method that parses arguments and calls the constructor */
+		static OperatorPtr parseArguments(Target *target , vector<string> &args);
+
+		/** Factory register method */
+		static void registerFactory();
+
 	private:
 		HOTBMInstance *inst;
-		Function &f;
+		FixFunction *f;
 
 		int wI, wO;
 	};
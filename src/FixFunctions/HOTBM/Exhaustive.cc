@@ -16,6 +16,12 @@
 
 */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
 #include "Util.hh"
 #include "Exhaustive.hh"
 
@@ -29,7 +35,7 @@ namespace flopoco{
 
 
 
-	Exhaustive::Exhaustive(Function &f_, Param &p_)
+	Exhaustive::Exhaustive(FixFunction &f_, Param &p_)
 		: f(f_), p(p_), instance(NULL)
 	{
 		HOTBMInstance::verbose = false;
@@ -306,32 +312,76 @@ namespace flopoco{
 		return area*area * delay;
 	}
 
+	/* The candidates of pList are built speculatively by a pool of threads,
+	 * then the outcomes are replayed in list order, so that the result
+	 * is the one of the sequential search: stop at the first failure if nMax
+	 * is -1, stop after nMax successes otherwise. */
 	int Exhaustive::process(list<Param> &pList, tInstSet &instSet, int nMax)
 	{
-		int n = 0;
-		int count = 0;
-
 		if (nMax > 0)
 			pList.reverse();
 
-		for (list<Param>::iterator p = pList.begin(); (p != pList.end()) && ((nMax < 0) || (count < nMax)); p++) {
-			try {
-				//(*p).print(cerr);
-				n++;
-
-				HOTBMInstance *inst = new HOTBMInstance(f, *p);
-				instSet.insert(tInstance(inst, score(*inst)));
-				count++;
+		vector<Param *> params;
+		for (list<Param>::iterator p = pList.begin(); p != pList.end(); p++)
+			params.push_back(&*p);
+		size_t size = params.size();
+		vector<HOTBMInstance *> insts(size, (HOTBMInstance *)NULL);
+		vector<char> failed(size, 0);
+		vector<exception_ptr> errors(size);
+
+		// with nMax = -1, nothing after the first failure is useful
+		atomic<size_t> next(0), firstFailure(size);
+		auto worker = [&]() {
+			size_t k;
+			while ((k = next++) < size && k <= firstFailure) {
+				try {
+					insts[k] = new HOTBMInstance(f, *params[k]);
+				}
+				catch (const char *) {
+					failed[k] = 1;
+					size_t ff = firstFailure;
+					while (nMax == -1 && k < ff && !firstFailure.compare_exchange_weak(ff, k))
+						;
+				}
+				catch (...) {
+					errors[k] = current_exception();
+				}
+			}
+			HOTBMInstance::releaseTermCache();
+		};
+		size_t nbThreads = std::max(1u, thread::hardware_concurrency());
+		vector<thread> threads;
+		for (size_t t = 0; t < std::min(nbThreads, size); t++)
+			threads.push_back(thread(worker));
+		for (size_t t = 0; t < threads.size(); t++)
+			threads[t].join();
 
-				//cerr << "\033[100C\033[20D" << (long long int)score(*inst) << endl;
+		int n = 0;
+		int count = 0;
+		exception_ptr error;
+		for (size_t k = 0; (k < size) && ((nMax < 0) || (count < nMax)); k++) {
+			n++;
+			if (errors[k]) {
+				error = errors[k];
+				break;
 			}
-			catch (const char *s) {
-				//cerr << "\033[100CX" << endl;
+			if (failed[k]) {
 				if (nMax == -1)
 					break;
+				continue;
 			}
+			instSet.insert(tInstance(insts[k], score(*insts[k])));
+			insts[k] = NULL;
+			count++;
 		}
 
+		// the speculative instances that the sequential search would not have built
+		for (size_t k = 0; k < size; k++)
+			if (insts[k])
+				delete insts[k];
+		if (error)
+			rethrow_exception(error);
+
 		return n;
 	}
 
@@ -13,7 +13,7 @@ namespace flopoco{
 
 	class Exhaustive {
 	public:
-		Exhaustive(Function &f_, Param &p_);
+		Exhaustive(FixFunction &f_, Param &p_);
 		~Exhaustive();
 
 		HOTBMInstance *getInstance();
@@ -30,7 +30,7 @@ namespace flopoco{
 		int process(list<Param> &pList, tInstSet &instSet, int nMax = -1);
 		void skim(tInstSet &instSet, int nMax);
 
-		Function &f;
+		FixFunction &f;
 		Param p;
 
 		HOTBMInstance *instance;
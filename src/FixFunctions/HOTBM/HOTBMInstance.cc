@@ -24,6 +24,7 @@
 #include "TermPowMult.hh"
 #include "HOTBMInstance.hh"
 #include "../HOTBM.hpp"
+#include "BitHeap/BitHeap.hpp"
 
 namespace flopoco{
 
@@ -104,11 +105,14 @@ namespace flopoco{
 	bool HOTBMInstance::force = false;
 
 	HOTBMInstance::tApproxCache HOTBMInstance::approxCache;
-	HOTBMInstance::tTermCache HOTBMInstance::termCache;
+	mutex HOTBMInstance::approxMutex;
+	thread_local HOTBMInstance::tTermCache HOTBMInstance::termCache;
+	vector<Term *> HOTBMInstance::orphanTerms;
+	mutex HOTBMInstance::orphanMutex;
 
 
 
-	HOTBMInstance::HOTBMInstance(Function &f_, Param &p_)
+	HOTBMInstance::HOTBMInstance(FixFunction &f_, Param &p_)
 		: f(f_), p(p_), tList(NULL), kAdjust(NULL)
 	{
 		computeApprox();
@@ -157,6 +161,24 @@ namespace flopoco{
 				termCache_.insert(*p);
 		}
 		termCache = termCache_;
+
+		lock_guard<mutex> lock(orphanMutex);
+		vector<Term *> orphanTerms_;
+		for (vector<Term *>::iterator t = orphanTerms.begin(); t != orphanTerms.end(); t++) {
+			if (full || !(*t)->refCount)
+				delete *t;
+			else
+				orphanTerms_.push_back(*t);
+		}
+		orphanTerms = orphanTerms_;
+	}
+
+	void HOTBMInstance::releaseTermCache()
+	{
+		lock_guard<mutex> lock(orphanMutex);
+		for (tTermCache::iterator p = termCache.begin(); p != termCache.end(); p++)
+			orphanTerms.push_back(p->second);
+		termCache.clear();
 	}
 
 	void HOTBMInstance::tune()
@@ -250,7 +272,8 @@ namespace flopoco{
 
 	void HOTBMInstance::computeApprox()
 	{
-		tParam paramKey(f.getName(), p);
+		lock_guard<mutex> lock(approxMutex);
+		tParam paramKey(f.getDescription(), p);
 		for (int i = 0; i <= p.n; i++) {
 			delete paramKey.second.t[i];
 			paramKey.second.t[i] = NULL;
@@ -268,7 +291,7 @@ namespace flopoco{
 			bool inCache = false;
 			{
 				ostringstream buf;
-				buf << "cache/" << hexencode(f.getName()) << "_" << p.wI << "_" << p.alpha << "_" << p.n << ".minimax";
+				buf << "cache/" << hexencode(f.getDescription()) << "_" << p.wI << "_" << p.alpha << "_" << p.n << ".minimax";
 				fCache = new fstream(buf.str().c_str(), fstream::in);
 				inCache = fCache->is_open();
 				if (!inCache) {
@@ -287,7 +310,7 @@ namespace flopoco{
 				int w = (int)(1 + p.alpha / log2(10));
 
 				for (long long int i = 0; i < P(p.alpha); i++) {
-					if (!(i % 16)) {
+					if (verbose && !(i % 16)) {
 						cerr.width(w); cerr << i << " / ";
 						cerr.width(w); cerr << P(p.alpha) << "   ";
 					}
@@ -327,9 +350,11 @@ namespace flopoco{
 						throw (string(s) + "\nMinimax exited abruptly. Memory might leak.").c_str();
 					}
 
-					cerr << " ";
-					if (!((i+1) % 16) || (i+1 == P(p.alpha)))
-						;//cerr << endl;
+					if (verbose) {
+						cerr << " ";
+						if (!((i+1) % 16) || (i+1 == P(p.alpha)))
+							cerr << endl;
+					}
 				}
 			}
 			else {
@@ -399,7 +424,7 @@ namespace flopoco{
 			cerr << "Building terms...";
 
 		for (int i = 0; i <= p.n; i++) {
-			tTermParam paramKey(tParam(f.getName(), p), i);
+			tTermParam paramKey(tParam(f.getDescription(), p), i);
 			for (int j = 0; j <= p.n; j++) {
 				if (j == i)
 					continue;
@@ -574,7 +599,7 @@ namespace flopoco{
 
 		vhdl << "--------------------------------------------------------------------------------" << endl;
 		vhdl << "--------------------------------------------------------------------------------" << endl;
-		vhdl << "-- HOTBM instance for function " << f.getName() << "." << endl;
+		vhdl << "-- HOTBM instance for function " << f->getDescription() << "." << endl;
 		vhdl << "-- wI = " << p.wI << "; wO = " << p.wO << "." << endl;
 		vhdl << "-- Order-" << p.n << " polynomial approximation." << endl;
 		vhdl << "-- Decomposition:" << endl;
@@ -585,7 +610,7 @@ namespace flopoco{
 				<< (i == p.n ? "." : ";") << endl;
 		}
 		vhdl << "-- Guard bits: g = " << p.g << "." << endl;
-		vhdl << "-- Command line: " << f.getName() << " ";
+		vhdl << "-- Command line: " << f->getDescription() << " ";
 		{
 			ostringstream os;
 			p.print(os);
@@ -595,10 +620,10 @@ namespace flopoco{
 
 		for (int i = 0; i <= p.n; i++) {
 			if (p.t[i]->alpha)
-				vhdl << declare (join("a_",i),p.t[i]->alpha) << " <= x"
+				vhdl << declare (join("a_",i),p.t[i]->alpha) << " <= X"
 				     << range (p.wI-1, p.wI-p.t[i]->alpha) << ";\n";
 			if (p.t[i]->beta)
-				vhdl << declare (join("b_",i),p.t[i]->beta) << " <= x"
+				vhdl << declare (join("b_",i),p.t[i]->beta) << " <= X"
 				     << range (p.beta-1, p.beta-p.t[i]->beta) << ";\n";
 
 			ostringstream buf;
@@ -611,13 +636,16 @@ namespace flopoco{
 			if (p.t[i]->alpha)
 				inPortMap (op, "a", join("a_",i));
 
-			oplist.push_back(op);
+			addSubComponent(op);
 			vhdl << instance(op, join("t_",i));
 		}
-		vhdl << declare ("sum", p.wO+p.g+1) << " <= ";
+
+		// The terms are two's complement, and their sum modulo 2^(wO+g+1) is the result
+		BitHeap *bh = new BitHeap(this, p.wO+p.g+1, false, "sum");
+		bh->setSignedIO(false);
 		for (int i = 0; i <= p.n; i++)
-			vhdl << (i ? " + " : "") << "r_" << i;
-		vhdl << ";" << endl;
-		vhdl << "  r <= sum" << range (p.wO+p.g, p.g) << ";" << endl;
+			bh->addUnsignedBitVector(0, join("r_",i), p.wO+p.g+1);
+		bh->generateCompressorVHDL();
+		vhdl << "  R <= " << bh->getSumName() << range (p.wO+p.g, p.g) << ";" << endl;
 	}
 }
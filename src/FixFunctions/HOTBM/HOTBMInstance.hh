@@ -2,8 +2,10 @@
 #define _HOTBMINSTANCE_HH_
 
 #include <list>
+#include <mutex>
+#include <vector>
 
-#include "../Function.hpp"
+#include "../FixFunction.hpp"
 #include "Param.hh"
 #include "PWPolynomial.hh"
 #include "Term.hh"
@@ -30,13 +32,16 @@ namespace flopoco{
 
 	class HOTBMInstance {
 	public:
-		HOTBMInstance(Function &f_, Param &p_);
+		HOTBMInstance(FixFunction &f_, Param &p_);
 		~HOTBMInstance();
 
 		Param &getParam();
 
 		static void freeApproxCache();
 		static void freeTermCache(bool full = false);
+		/** Hands the term cache of the calling thread over to freeTermCache(),
+		 * to be called by a worker thread of the search before it exits */
+		static void releaseTermCache();
 
 		void roundTables(bool full = true);
 		void tune();
@@ -67,7 +72,10 @@ namespace flopoco{
 		typedef map<tTermParam, tTerm, ltTermParam> tTermCache;
 
 		static tApproxCache approxCache;
-		static tTermCache termCache;
+		static mutex approxMutex;          /**< protects approxCache and Sollya, which are shared by the search threads */
+		static thread_local tTermCache termCache; /**< terms are mutated by roundTables(), so each thread has its own */
+		static vector<Term *> orphanTerms; /**< terms of the caches of finished threads, freed by freeTermCache() */
+		static mutex orphanMutex;
 
 		void computeApprox();
 		void buildTerms();
@@ -76,7 +84,7 @@ namespace flopoco{
 		double eval(long long int x);
 		long long int evalRound(long long int x);
 
-		Function &f;
+		FixFunction &f;
 		Param p;
 
 		double **kList;
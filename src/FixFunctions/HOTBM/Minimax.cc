@@ -21,68 +21,68 @@
 #include "sollya.h"
 
 #define EPSILON 1.0e-12
+#define COEFF_PREC 100
 
 namespace flopoco{
 
 	/*
-	 * Uses libsollya to compute the minimax polynomial
-	 * using the remez algorithm
+	 * Uses Sollya to compute the minimax polynomial
+	 * of the FixFunction using the remez algorithm
 	 */
-	Minimax::Minimax(Function &f_, double ia_, double ib_, int d)
+	Minimax::Minimax(FixFunction &f_, double ia_, double ib_, int d)
 		: mpP(NULL)
 	{
-		/* Nice progress message */
-		cerr << "*";
+		/* No progress message: this is called from the worker threads of Exhaustive */
 
 		/* Convert parameters to their required type */
-		mpfr_t ia, ib, prec;
-		mpfr_inits(ia, ib, prec, NULL);
+		mpfr_t ia, ib;
+		mpfr_init2(ia, 53);
+		mpfr_init2(ib, 53);
 		mpfr_set_d(ia, ia_, GMP_RNDN);
 		mpfr_set_d(ib, ib_, GMP_RNDN);
-		mpfr_set_d(prec, EPSILON, GMP_RNDN);
-
-		/* Create input functions */
-		sollya_node_t f = copyTree(f_.getSollyaNode());
-		sollya_node_t w = parseString("1");
-
-		/* Other paramters */
-		sollya_chain_t monoms = makeIntPtrChainFromTo(0,d);
+		sollya_obj_t rangeS = sollya_lib_range_from_bounds(ia, ib);
+		sollya_obj_t degreeS = sollya_lib_constant_from_int(d);
+		sollya_obj_t weightS = sollya_lib_parse_string("1");
+		sollya_obj_t qualityS = sollya_lib_constant_from_double(EPSILON);
 
 		/* Call remez */
-		sollya_node_t nRemez = remez(f, w, monoms, ia, ib, &prec, getToolPrecision());
+		sollya_obj_t pS = sollya_lib_remez(f_.fS, degreeS, rangeS, weightS, qualityS, NULL);
+		if(sollya_lib_obj_is_error(pS))
+			throw "Minimax: Sollya failed to compute the minimax polynomial";
 
 		/* Extract coefficients */
-		int degree;
-		sollya_node_t *nCoef;
-		mpfr_t *coef;
-
-		getCoefficients(&degree, &nCoef, nRemez);
-		coef = new mpfr_t[degree+1];
-		int i;
-		for (i = 0; i <= degree; i++)
-			{
-				mpfr_init(coef[i]);
-				evaluateConstantExpression(coef[i], nCoef[i], getToolPrecision());
-			}
+		mpfr_t *coef = new mpfr_t[d+1];
+		for (int i = 0; i <= d; i++) {
+			sollya_obj_t iS = sollya_lib_constant_from_int(i);
+			sollya_obj_t coeffS = sollya_lib_coeff(pS, iS);
+			mpfr_init2(coef[i], COEFF_PREC);
+			sollya_lib_get_constant(coef[i], coeffS);
+			sollya_lib_clear_obj(coeffS);
+			sollya_lib_clear_obj(iS);
+		}
 
 		/* Create the long-awaited polynomial */
-		mpP = new MPPolynomial(degree, coef);
+		mpP = new MPPolynomial(d, coef);
 
 		/* Compute the error */
-		sollya_node_t nDiff = makeSub(f, nRemez);
-		mpfr_init(mpErr);
-		uncertifiedInfnorm(mpErr, nDiff, ia, ib, 501/*default in sollya*/, getToolPrecision()); 
+		sollya_obj_t diffS = sollya_lib_sub(f_.fS, pS);
+		sollya_obj_t errS = sollya_lib_dirtyinfnorm(diffS, rangeS);
+		mpfr_init2(mpErr, COEFF_PREC);
+		sollya_lib_get_constant(mpErr, errS);
 
 		/* Cleanup */
-		for (i = 0; i <= degree; i++)
+		for (int i = 0; i <= d; i++)
 			mpfr_clear(coef[i]);
-		delete coef;
-		free_memory(nDiff);	/* XXX: also frees nRemez and f */
-		free_memory(w);
+		delete[] coef;
+		sollya_lib_clear_obj(errS);
+		sollya_lib_clear_obj(diffS);
+		sollya_lib_clear_obj(pS);
+		sollya_lib_clear_obj(qualityS);
+		sollya_lib_clear_obj(weightS);
+		sollya_lib_clear_obj(degreeS);
+		sollya_lib_clear_obj(rangeS);
 		mpfr_clear(ia);
 		mpfr_clear(ib);
-		mpfr_clear(prec);
-		freeChain(monoms, freeIntPtr);
 	}
 
 
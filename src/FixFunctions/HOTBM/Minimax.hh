@@ -1,7 +1,7 @@
 #ifndef _MINIMAX_HH_
 #define _MINIMAX_HH_
 
-#include "../Function.hpp"
+#include "../FixFunction.hpp"
 #include "MPPolynomial.hh"
 
 using namespace std;
@@ -11,7 +11,7 @@ namespace flopoco{
 
 	class Minimax {
 	public:
-		Minimax(Function &f, double ia, double ib, int d);
+		Minimax(FixFunction &f, double ia, double ib, int d);
 		~Minimax();
 
 		MPPolynomial &getMPP() const;
@@ -400,7 +400,7 @@ Component::Component (flopoco::Target* t, TermPowMult tpm, std::string name)
 		ostringstream buf;
 		buf << name << "_pow";
 		Operator* op = pow->toComponent(t, buf.str());
-		oplist.push_back (op);
+		addSubComponent(op);
 
 		outPortMap (op, "r", "s");
 		if (tp.beta >= 2)
@@ -422,7 +422,7 @@ Component::Component (flopoco::Target* t, TermPowMult tpm, std::string name)
 		{
 			TermPowMultTableInstance* op = new TermPowMultTableInstance
 				(t, d, tp.mM, tp.mT, tp.alphas[i], tp.sigmas[i], wTable[i], i, table[i], getName() + flopoco::join("_t",i+1));
-			oplist.push_back (op);
+			addSubComponent(op);
 
 			outPortMap (op, "r", join(i < tp.mM ? "k_" : "r0_",i+1));
 			if ((i >= tp.mM) && (tp.sigmas[i] > 1))
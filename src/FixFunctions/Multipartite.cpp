@@ -88,47 +88,71 @@ namespace flopoco
 
 	void Multipartite::computeTOiSize(int i)
 	{
-		double r1, r2, r;
-		double delta = deltai(i);
-		r1 = abs( delta * si(i,0) );
-		r2 = abs( delta * si(i, (int)(intpow2(gammai[i]) - 1)));
-		if (r1 > r2)
-			r = r1;
-		else
-			r = r2;
+		double r = mpt->oneTableSlopeRange(pi[i], betai[i], gammai[i]);
 		outputSizeTOi[i]= (int)ceil( outputSize + guardBits + log2(r));
 
 		sizeTOi[i] = (int)intpow2( gammai[i]+betai[i]-1 ) * (outputSizeTOi[i]-1);
 	}
 
 
+	double Multipartite::slopeRange(int pi_, int betai_, int gammai_)
+	{
+		double r1, r2;
+		double d = delta(pi_, betai_);
+		r1 = abs( d * s(pi_, betai_, gammai_, 0) );
+		r2 = abs( d * s(pi_, betai_, gammai_, (int)(intpow2(gammai_) - 1)));
+		if (r1 > r2)
+			return r1;
+		else
+			return r2;
+	}
+
+
 	/** Just as in the article */
 	double Multipartite::deltai(int i)
 	{
-		return mui(i, (int)(intpow2(betai[i]) - 1)) - mui(i, 0);
+		return delta(pi[i], betai[i]);
+	}
+
+
+	double Multipartite::delta(int pi_, int betai_)
+	{
+		return mu(pi_, (int)(intpow2(betai_) - 1)) - mu(pi_, 0);
 	}
 
 
 	/** Just as in the article  */
 	double Multipartite::mui(int i, int Bi)
+	{
+		return mu(pi[i], Bi);
+	}
+
+
+	double Multipartite::mu(int pi_, int Bi)
 	{
 		int wi = inputSize;
-		return  (f->signedIn ? -1 : 0) + (f->signedIn ? 2 : 1) *  intpow2(-wi+pi[i]) * Bi;
+		return  (f->signedIn ? -1 : 0) + (f->signedIn ? 2 : 1) *  intpow2(-wi+pi_) * Bi;
 	}
 
 
 	/** Just as in the article */
 	double Multipartite::si(int i, int Ai)
+	{
+		return s(pi[i], betai[i], gammai[i], Ai);
+	}
+
+
+	double Multipartite::s(int pi_, int betai_, int gammai_, int Ai)
 	{
 		int wi = inputSize;
 		double xleft = (f->signedIn ? -1 : 0)
-				+ (f->signedIn ? 2 : 1) * intpow2(-gammai[i])  * ((double)Ai);
-		double xright= (f->signedIn ? -1 : 0) + (f->signedIn ? 2 : 1) * ((intpow2(-gammai[i]) * ((double)Ai+1)) - intpow2(-wi+pi[i]+betai[i]));
-		double delta = deltai(i);
-		double si =  (f->eval(xleft + delta)
+				+ (f->signedIn ? 2 : 1) * intpow2(-gammai_)  * ((double)Ai);
+		double xright= (f->signedIn ? -1 : 0) + (f->signedIn ? 2 : 1) * ((intpow2(-gammai_) * ((double)Ai+1)) - intpow2(-wi+pi_+betai_));
+		double d = delta(pi_, betai_);
+		double si =  (f->eval(xleft + d)
 					  - f->eval(xleft)
-					  + f->eval(xright+delta)
-					  - f->eval(xright) )    / (2*delta);
+					  + f->eval(xright+d)
+					  - f->eval(xright) )    / (2*d);
 		return si;
 	}
 
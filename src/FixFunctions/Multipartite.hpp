@@ -81,6 +81,12 @@ namespace flopoco
 			 */
 			void mkTables(Target* target);
 
+			/**
+			 * @brief slopeRange : max |delta_i s_i| over the TO table defined by pi, betai and gammai, which determines its output size.
+			 * It only depends on these three values, hence is memoised by FixFunctionByMultipartiteTable::oneTableSlopeRange()
+			 */
+			double slopeRange(int pi_, int betai_, int gammai_);
+
 			//---------------------------------------------------------------------------------- Public attributes
 			FixFunction* f;
 
@@ -133,6 +139,11 @@ namespace flopoco
 			double mui(int i, int Bi);
 			double si(int i, int Ai);
 
+			/** The same, for explicit values of pi, betai and gammai */
+			double delta(int pi_, int betai_);
+			double mu(int pi_, int Bi);
+			double s(int pi_, int betai_, int gammai_, int Ai);
+
 			void compressAndUpdateTIV(int inputSize, int outputSize);
 
 	};
@@ -31,8 +31,8 @@
 
 namespace flopoco{
 
-	PiecewisePolyApprox::PiecewisePolyApprox(FixFunction *f_, double targetAccuracy_, int degree_):
-		degree(degree_), f(f_), targetAccuracy(targetAccuracy_)
+	PiecewisePolyApprox::PiecewisePolyApprox(FixFunction *f_, double targetAccuracy_, int degree_, int minAlpha_):
+		degree(degree_), f(f_), targetAccuracy(targetAccuracy_), minAlpha(minAlpha_)
 	{
 		needToFreeF = false;
 		srcFileName="PiecewisePolyApprox"; // should be somehow static but this is too much to ask me
@@ -40,8 +40,8 @@ namespace flopoco{
 	}
 
 
-	PiecewisePolyApprox::PiecewisePolyApprox(string sollyaString_, double targetAccuracy_, int degree_):
-		degree(degree_), targetAccuracy(targetAccuracy_)
+	PiecewisePolyApprox::PiecewisePolyApprox(string sollyaString_, double targetAccuracy_, int degree_, int minAlpha_):
+		degree(degree_), targetAccuracy(targetAccuracy_), minAlpha(minAlpha_)
 	{
 		//  parsing delegated to FixFunction
 		f = new FixFunction(sollyaString_, false /* on [0,1]*/);
@@ -93,7 +93,10 @@ namespace flopoco{
 		int nbIntervals;
 
 		ostringstream cacheFileName;
-		cacheFileName << "PiecewisePoly_"<<vhdlize(f->description) << "_" << degree << "_" << targetAccuracy << ".cache";
+		cacheFileName << "PiecewisePoly_"<<vhdlize(f->description) << "_" << degree << "_" << targetAccuracy;
+		if(minAlpha>0)
+			cacheFileName << "_alpha" << minAlpha;
+		cacheFileName << ".cache";
 
 		// cerr << cacheFileName.str() <<endl<<endl;
 		// Test existence of cache file
@@ -121,7 +124,7 @@ namespace flopoco{
 			// Limit alpha to 24, because alpha will be the number of bits input to a table
 			// it will take too long before that anyway
 			bool alphaOK;
-			for (alpha=0; alpha<24; alpha++) {
+			for (alpha=minAlpha; alpha<24; alpha++) {
 				nbIntervals=1<<alpha;
 				alphaOK=true;
 				REPORT(DETAILED, " Testing alpha=" << alpha );
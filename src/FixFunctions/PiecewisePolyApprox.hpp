@@ -24,11 +24,12 @@ namespace flopoco{
 	public:
 
 		/** A minimal constructor
+		 * minAlpha is the minimum number of address bits, used to give several approximations the same segments
 		 */
-		PiecewisePolyApprox(FixFunction* f, double targetAccuracy, int degree);
+		PiecewisePolyApprox(FixFunction* f, double targetAccuracy, int degree, int minAlpha=0);
 
 		/** A minimal constructor that parses a sollya string		 */
-		PiecewisePolyApprox(string sollyaString, double targetAccuracy, int degree);
+		PiecewisePolyApprox(string sollyaString, double targetAccuracy, int degree, int minAlpha=0);
 
 		virtual ~PiecewisePolyApprox();
 		
@@ -51,6 +52,7 @@ namespace flopoco{
 	private:
 		FixFunction *f;                   /**< The function to be approximated */
 		double targetAccuracy;            /**< please build an approximation at least as accurate as that */
+		int minAlpha;                     /**< alpha will be at least that */
 
 		string srcFileName; /**< useful only to enable same kind of reporting as for FloPoCo operators. */
 		string uniqueName_; /**< useful only to enable same kind of reporting as for FloPoCo operators. */
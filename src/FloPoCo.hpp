@@ -11,6 +11,7 @@
 
 #include "Operator.hpp"
 #include "UserInterface.hpp"
+#include "DesignSpaceExplorer.hpp"
 #include "FlopocoStream.hpp"
 
 /* operator pipeline work* ------------------------------------ */
@@ -26,6 +27,9 @@
 #include "Tools/ResourceEstimationHelper.hpp"
 /* floorplanning ---------------------------------------------- */
 
+/* profiling of the generator --------------------------------- */
+#include "Tools/Profiler.hpp"
+
 /* targets ---------------------------------------------------- */
 #include "Target.hpp"
 #include "TargetModel.hpp"
@@ -46,12 +50,15 @@
 #include "Targets/CycloneIV.hpp"
 #include "Targets/CycloneV.hpp"
 
+#include "Targets/GenericTarget.hpp"
+
 #include "TestBenches/TestBench.hpp"
 
 /* shifters + lzoc ------------------------------------------- */
 #include "ShiftersEtc/Shifters.hpp"
 #include "ShiftersEtc/LZOC.hpp"
 #include "ShiftersEtc/LZOCShifterSticky.hpp"
+#include "ShiftersEtc/LZA.hpp"
 
 
 /* FixFilters ------------------------------------------------ */
@@ -120,6 +127,7 @@
 #include "FPComposite/FPLargeAcc.hpp"
 #include "FPComposite/LargeAccToFP.hpp"
 #include "FPComposite/FPDotProduct.hpp"
+#include "FPComposite/FPSumOfProducts.hpp"
 
 
 /* Fixed-point function generators ---------------------*/
@@ -130,10 +138,12 @@
 #include "FixFunctions/FixFunctionByTable.hpp"
 #include "FixFunctions/FixFunctionBySimplePoly.hpp"
 #include "FixFunctions/FixFunctionByPiecewisePoly.hpp"
+#include "FixFunctions/FixMultiFunctionByPiecewisePoly.hpp"
 
 #include "FixFunctions/GenericTable.hpp"
 #include "FixFunctions/BipartiteTable.hpp"
 #include "FixFunctions/FixFunctionByMultipartiteTable.hpp"
+#include "FixFunctions/HOTBM.hpp"
 
 /*  Various elementary functions in fixed or floating point*/
 #include "Trigs/FixSinCos.hpp"
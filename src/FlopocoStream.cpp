@@ -25,6 +25,7 @@
 #include <gmpxx.h>
 #include "utils.hpp"
 #include "FlopocoStream.hpp"
+#include "UserInterface.hpp"
 
 
 using namespace std;
@@ -64,6 +65,7 @@ namespace flopoco{
 	}
 
 	void FlopocoStream::flush(int currentCycle){
+		/* with estimateOnly, the code is only lexed for the use table (the flip-flop estimate), and never stored */
 		if (! disabledParsing ){
 			ostringstream bufferCode;
 			if ( vhdlCodeBuffer.str() != string("") ){
@@ -73,10 +75,11 @@ namespace flopoco{
 				bufferCode << annotateIDs( currentCycle );
 
 				/* the newly processed code is appended to the existing one */
-				vhdlCode << bufferCode.str();
+				if (! UserInterface::estimateOnly)
+					vhdlCode << bufferCode.str();
 
 			}
-		}else{
+		}else if (! UserInterface::estimateOnly){
 			vhdlCode << vhdlCodeBuffer.str();				
 		}
 		/* reset buffer */
@@ -90,6 +90,7 @@ namespace flopoco {
 
 		cloneOperator(addImplementationList[selectedVersion]);
 		changeName ( name.str() );
+		addEstimatedCost(wIn_); // one LUT per bit on the carry chain
 
 		REPORT(DETAILED, "Selected implementation for IntAdder"<< wIn << " is "<<selectedVersion<<" with cost="<<currentCost);
 
@@ -282,6 +282,7 @@ namespace flopoco {
 			vhdl << tab << declareFixPoint("XX",signedIO,-1, -wXdecl) << " <= " << (signedIO?"signed":"unsigned") << "(" << xname <<");" << endl;
 			vhdl << tab << declareFixPoint("YY",signedIO,-1, -wYdecl) << " <= " << (signedIO?"signed":"unsigned") << "(" << yname <<");" << endl;
 			vhdl << tab << declareFixPoint("RR",signedIO,-1, -wXdecl-wYdecl) << " <= XX*YY;" << endl;
+			addEstimatedMultiplierCost(wXdecl, wYdecl);
 			vhdl << tab << "R <= std_logic_vector(RR" << range(wXdecl+wYdecl-1, wXdecl+wYdecl-wOut) << ");" << endl;
 		}
 		else{
@@ -464,6 +465,7 @@ namespace flopoco {
 			vhdl << tab << "-- How to obfuscate multiplication by 1 bit: first generate a trivial bit vector" << endl;
 
 			if (signedIO){
+				parentOp->addEstimatedAdderCost(wX+1);
 				manageCriticalPath(  parentOp->getTarget()->localWireDelay(wX) +  parentOp->getTarget()->adderDelay(wX+1) );
 
 				vhdl << tab << declare(addUID("RR"), bitHeap->getMaxWeight())  << " <= (" << zg(bitHeap->getMaxWeight())
@@ -660,6 +662,7 @@ namespace flopoco {
 
 			//manage the pipeline
 			manageCriticalPath(parentOp->getTarget()->DSPMultiplierDelay());
+			parentOp->addEstimatedCost(0, 1);
 			s << "DSP_Res_" <<  getuid();
 			string sou=(negate || signedIO ? "signed": "unsigned");
 			vhdl << tab << declare(s.str(), dspXSize+dspYSize+(signedIO ? 0 : 2))
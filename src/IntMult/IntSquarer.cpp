@@ -48,6 +48,7 @@ namespace flopoco{
 			vhdl << tab << declare( "sX", wIn) << " <= X;" << endl;
 			vhdl << tab << declare( "sY", wIn) << " <= X;" << endl;
 			
+			addEstimatedCost(0, 1); // one DSP block per product
 			manageCriticalPath( target->LogicToDSPWireDelay() + target->DSPMultiplierDelay() );
 			vhdl << tab << "R <= sX * sY;" << endl; 
 			outDelayMap["R"] = getCriticalPath();
@@ -59,6 +60,7 @@ namespace flopoco{
 			vhdl << tab << declare("x17_32_shr",18) << " <= \"0\" & " << zg(33-wIn,0) << " & X" << range(wIn-1,17) << " & \"0\"" << ";" << endl;
 			
 						
+			addEstimatedCost(0, 3); // one DSP block per product
 			manageCriticalPath( target->LogicToDSPWireDelay() + target->DSPMultiplierDelay() );
 			vhdl << tab << declare("p0",36) << " <= x0_16 * x0_16;" <<endl;
 			vhdl << tab << declare("p1_x2",36) << " <= x17_32_shr * x0_16;" <<endl;
@@ -82,6 +84,7 @@ namespace flopoco{
 			else
 				vhdl << tab << declare("x17_33",17) << " <= X" << range(33,17) << ";" << endl;
 						
+			addEstimatedCost(0, 3); // one DSP block per product
 			manageCriticalPath( target->LogicToDSPWireDelay() + target->DSPMultiplierDelay() );
 			vhdl << tab << declare("p0",34) << " <= x0_16 * x0_16;" <<endl;
 			vhdl << tab << declare("f0",18) << " <= p0" << range(17,0) << ";" << endl;
@@ -110,6 +113,7 @@ namespace flopoco{
 			else
 				vhdl << tab << declare("sigX",51) << "<= X;"<<endl;
 				
+			addEstimatedCost(0, 6); // one DSP block per product
 			manageCriticalPath( target->LogicToDSPWireDelay() + target->DSPMultiplierDelay() );	
 			vhdl << tab << declare("x0_16_sqr",34) << "<= sigX" << range(16,0) << " * sigX" << range(16,0)<<";"<<endl;
 			vhdl << tab << declare("x17_33_sqr",34) << "<= sigX" << range(33,17) << " * sigX" << range(33,17)<<";"<<endl;
@@ -150,6 +154,7 @@ namespace flopoco{
 				
 			setCriticalPath( getMaxInputDelays(inputDelays) );	
 
+			addEstimatedCost(0, 10); // one DSP block per product
 			manageCriticalPath( target->LogicToDSPWireDelay() + target->DSPMultiplierDelay() ); 
 			vhdl << tab << declare("x0_16_x17_33",34) << "<= sigX" << range(16,0) << " * sigX" << range(33,17)<<";"<<endl;
 			manageCriticalPath( target->DSPCascadingWireDelay() + target->DSPAdderDelay() );
@@ -232,6 +237,7 @@ namespace flopoco{
 
 			syncCycleFromSignal("out_Squarer_51",true);
 			
+			addEstimatedMultiplierCost(2, 2);
 			vhdl << tab << declare("x51_52_sqr",4) << " <= sigX" << range(52,51) << " * sigX" << range(52,51) <<";"<<endl;
 			
 			nextCycle(); ////////////////////////////////////////////////
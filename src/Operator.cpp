@@ -16,8 +16,14 @@ Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
 #include <string>
 #include <sstream>
 #include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <set>
+#include <algorithm>
+#include <functional>
 #include "Operator.hpp"  // Useful only for reporting. TODO split out the REPORT and THROWERROR #defines from Operator to another include.
 #include "utils.hpp"
+#include "PackedTable.hpp"
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/normal_distribution.hpp>
@@ -51,6 +57,15 @@ namespace flopoco{
 		architectureName_			= "arch";
 		indirectOperator_           = NULL;
 		hasDelay1Feedbacks_         = false;
+		profileStart_               = Profiler::now();
+		profileAllocations_         = Profiler::allocations();
+		profileBytes_               = Profiler::allocatedBytes();
+		profileDone_                = false;
+		estimatedLUTs_              = 0;
+		estimatedDSPs_              = 0;
+		estimatedBRAMs_             = 0;
+		estimatedInstanceFFs_       = 0;
+		estimatedFFs_               = -1;
 
 
 		// Currently we set the pipeline and clockenable from the global target.
@@ -90,12 +105,21 @@ namespace flopoco{
 
 
 	void Operator::addSubComponent(OperatorPtr op) {
+		op->endProfiling();
 		subComponents_.push_back(op);
 		// In newPipeline, we deprecate this function and replace it with the following message.
 		// REPORT(INFO, "addSubComponent() is deprecated, instance() does it automatically. Remove it from the source code to get rid of this annoying message.");
 	}
 
 
+	void Operator::endProfiling() {
+		if(profileDone_)
+			return;
+		profileDone_ = true;
+		Profiler::addEvent(srcFileName, uniqueName_, profileStart_, profileAllocations_, profileBytes_);
+	}
+
+
 	OperatorPtr Operator::getSubComponent(string name){
 		for (auto op: subComponents_) {
 			if (op->getName()==name)
@@ -608,6 +632,181 @@ namespace flopoco{
 	}
 
 
+	int Operator::getRegisteredBits() {
+		if (getIndirectOperator()!=NULL)
+			return getSubComponents()[0]->getRegisteredBits();
+		int bits=0;
+		for (auto s: signalList_)
+			bits += s->width() * s->getLifeSpan();
+		for (auto s: ioList_)
+			if(s->type()==Signal::in)
+				bits += s->width() * s->getLifeSpan();
+		// a component instantiated n times has n copies of its registers
+		set<OperatorPtr> instantiated;
+		for (auto i: instances_) {
+			bits += i.second.first->getRegisteredBits();
+			instantiated.insert(i.second.first);
+		}
+		// the sub-components instantiated without instance() are counted once
+		for (auto i: getSubComponents())
+			if(instantiated.find(i)==instantiated.end())
+				bits += i->getRegisteredBits();
+		return bits;
+	}
+
+
+	void Operator::addEstimatedCost(int luts, int dsps, int brams) {
+		estimatedLUTs_  += luts;
+		estimatedDSPs_  += dsps;
+		estimatedBRAMs_ += brams;
+	}
+
+	void Operator::addEstimatedAdderCost(int w) {
+		addEstimatedCost(w);
+	}
+
+	void Operator::addEstimatedMultiplierCost(int wX, int wY) {
+		if(target_->useHardMultipliers() && target_->worthUsingDSP(wX, wY)) {
+			int dspX, dspY;
+			target_->getDSPWidths(dspX, dspY);
+			// the best of the two orientations
+			int n1 = ((wX+dspX-1)/dspX) * ((wY+dspY-1)/dspY);
+			int n2 = ((wX+dspY-1)/dspY) * ((wY+dspX-1)/dspX);
+			addEstimatedCost(0, min(n1, n2));
+		}
+		else
+			addEstimatedCost(target_->getIntMultiplierCost(wX, wY));
+	}
+
+	int Operator::getEstimatedLUTs() {
+		if (getIndirectOperator()!=NULL)
+			return getSubComponents()[0]->getEstimatedLUTs();
+		return estimatedLUTs_;
+	}
+
+	int Operator::getEstimatedDSPs() {
+		if (getIndirectOperator()!=NULL)
+			return getSubComponents()[0]->getEstimatedDSPs();
+		return estimatedDSPs_;
+	}
+
+	int Operator::getEstimatedBRAMs() {
+		if (getIndirectOperator()!=NULL)
+			return getSubComponents()[0]->getEstimatedBRAMs();
+		return estimatedBRAMs_;
+	}
+
+	int Operator::getEstimatedFFs() {
+		if (getIndirectOperator()!=NULL)
+			return getSubComponents()[0]->getEstimatedFFs();
+		if(estimatedFFs_>=0)
+			return estimatedFFs_;
+		estimatedFFs_ = estimatedInstanceFFs_;
+		if(!isSequential())
+			return estimatedFFs_;
+		// The lifespans that parse2 would compute: the distance from the declaration to the last use
+		vhdl.flush();
+		map<string, int> lifeSpan;
+		for (auto u: vhdl.getUseTable()) {
+			if(declareTable.find(u.first)==declareTable.end())
+				continue;
+			int l = u.second - declareTable[u.first];
+			if(l > lifeSpan[u.first])
+				lifeSpan[u.first] = l;
+		}
+		for (auto s: signalMap_) {
+			if(s.second->type()==Signal::out)
+				continue;
+			int l = max(lifeSpan[s.first], s.second->getLifeSpan());
+			estimatedFFs_ += s.second->width() * l;
+		}
+		return estimatedFFs_;
+	}
+
+	void Operator::outputEstimateReport(ostream& o) {
+		o << "Estimate for " << uniqueName_ << ": latency " << getPipelineDepth() << " cycles at "
+			<< target_->frequencyMHz() << " MHz, "
+			<< getEstimatedLUTs() << " LUTs, " << getEstimatedFFs() << " FFs, "
+			<< getEstimatedDSPs() << " DSPs, " << getEstimatedBRAMs() << " memory blocks" << endl;
+	}
+
+
+	void Operator::outputJSONReport(ostream& o, int level) {
+		if (getIndirectOperator()!=NULL){ // interface operator: report the actual one
+			getSubComponents()[0]->outputJSONReport(o, level);
+			return;
+		}
+		string in(level, '\t');
+		double period = 1e9/target_->frequency(); // ns
+		vector<Signal*> signals;
+		for (auto s: ioList_)
+			signals.push_back(s);
+		for (auto s: signalList_)
+			signals.push_back(s);
+		// The delay of a signal from the previous register level: the critical path recorded when it was declared,
+		// the input delay of an input, and the output delay of an output
+		auto delayOf = [&](Signal* s) -> double {
+			if(s->type()==Signal::in)
+				return (inputDelayMap.find(s->getName())==inputDelayMap.end() ? 0 : inputDelayMap[s->getName()]);
+			if(s->type()==Signal::out && outDelayMap.find(s->getName())!=outDelayMap.end())
+				return outDelayMap[s->getName()];
+			return s->getCriticalPath();
+		};
+
+		o << in << "{" << endl;
+		o << in << "\t\"name\": \"" << uniqueName_ << "\"," << endl;
+		o << in << "\t\"target\": \"" << target_->getID() << "\"," << endl;
+		o << in << "\t\"frequencyMHz\": " << target_->frequency()/1e6 << "," << endl;
+		o << in << "\t\"pipelineDepth\": " << getPipelineDepth() << "," << endl;
+		o << in << "\t\"registeredBits\": " << getRegisteredBits() << "," << endl;
+
+		// signals
+		o << in << "\t\"signals\": [";
+		for (size_t k=0; k<signals.size(); k++) {
+			Signal* s = signals[k];
+			int regBits = (s->type()==Signal::out ? 0 : s->width() * s->getLifeSpan());
+			o << (k==0 ? "" : ",") << endl << in << "\t\t{\"name\": \"" << s->getName() << "\""
+			  << ", \"width\": " << s->width()
+			  << ", \"cycle\": " << s->getCycle()
+			  << ", \"delay\": " << 1e9*delayOf(s)
+			  << ", \"lifeSpan\": " << s->getLifeSpan()
+			  << ", \"registeredBits\": " << regBits << "}";
+		}
+		o << endl << in << "\t]," << endl;
+
+		// stages: worst path and registers at the end of each cycle
+		o << in << "\t\"stages\": [";
+		for (int c=0; c<=getPipelineDepth(); c++) {
+			Signal* worst = NULL;
+			int regBits = 0;
+			for (auto s: signals) {
+				if(s->getCycle()==c && (worst==NULL || delayOf(s) > delayOf(worst)))
+					worst = s;
+				// a signal with lifespan l is registered at the end of cycles cycle .. cycle+l-1
+				if(s->type()!=Signal::out && s->getCycle()<=c && c < s->getCycle()+s->getLifeSpan())
+					regBits += s->width();
+			}
+			double worstDelay = (worst==NULL ? 0 : 1e9*delayOf(worst));
+			o << (c==0 ? "" : ",") << endl << in << "\t\t{\"cycle\": " << c
+			  << ", \"worstDelay\": " << worstDelay
+			  << ", \"worstSignal\": \"" << (worst==NULL ? "" : worst->getName()) << "\""
+			  << ", \"slack\": " << period - worstDelay
+			  << ", \"registeredBits\": " << regBits << "}";
+		}
+		o << endl << in << "\t]," << endl;
+
+		// subcomponents
+		o << in << "\t\"subComponents\": [";
+		vector<OperatorPtr> subComponents = getSubComponents();
+		for (size_t k=0; k<subComponents.size(); k++) {
+			o << (k==0 ? "" : ",") << endl;
+			subComponents[k]->outputJSONReport(o, level+2);
+		}
+		o << (subComponents.empty() ? "" : "\n" + in + "\t") << "]" << endl;
+		o << in << "}";
+	}
+
+
 	void Operator::setCycle(int cycle, bool report) {
 		criticalPath_ = 0;
 		// lexing part
@@ -890,6 +1089,8 @@ namespace flopoco{
 		// define its cycle
 		if(isSequential())
 			s->setCycle(this->currentCycle_);
+		// and record the critical path, which includes the logic computing this signal (manageCriticalPath() comes first)
+		s->setCriticalPath(criticalPath_);
 
 		// add this signal to the declare table
 		declareTable[name] = s->getCycle();
@@ -922,6 +1123,8 @@ namespace flopoco{
 		// define its cycle
 		if(isSequential())
 			s->setCycle(this->currentCycle_);
+		// and record the critical path, which includes the logic computing this signal (manageCriticalPath() comes first)
+		s->setCriticalPath(criticalPath_);
 
 		// add this signal to the declare table
 		declareTable[name] = s->getCycle();
@@ -1185,6 +1388,10 @@ namespace flopoco{
 
 
 	string Operator::instance(Operator* op, string instanceName){
+		op->endProfiling();
+		addEstimatedCost(op->getEstimatedLUTs(), op->getEstimatedDSPs(), op->getEstimatedBRAMs());
+		estimatedInstanceFFs_ += op->getEstimatedFFs();
+		instances_.push_back(make_pair(instanceName, make_pair(op, currentCycle_)));
 		ostringstream o;
 		// TODO add checks here? Check that all the signals are covered for instance
 
@@ -1716,6 +1923,440 @@ namespace flopoco{
 
 
 
+	void Operator::retime(){
+		if(hasDelay1Feedbacks_ || isRecirculatory() || getIndirectOperator()!=NULL) {
+			REPORT(DETAILED, "Retiming skipped (feedbacks or indirect operator)");
+			return;
+		}
+
+		string code = vhdl.str();
+
+		// an annotation __name__cycle__ of the code, see FlopocoStream
+		struct Annotation {
+			size_t pos;
+			size_t length;
+			string name;
+			int cycle;
+		};
+		// a piece of code ending with a semicolon
+		struct Chunk {
+			size_t begin;
+			size_t end;
+			vector<Annotation> annotations;
+			string text;     // without comments nor annotations, in lower case
+			string lhs;      // the assigned signal, if the chunk is a simple assignment
+			bool movable;
+		};
+
+		// Split the code into chunks, ignoring the semicolons in the comments
+		vector<Chunk> chunks;
+		size_t begin=0;
+		bool inComment=false;
+		for(size_t i=0; i<code.size(); i++) {
+			if(inComment) {
+				if(code[i]=='\n')
+					inComment=false;
+			}
+			else if(code[i]=='-' && i+1<code.size() && code[i+1]=='-')
+				inComment=true;
+			else if(code[i]==';' || i==code.size()-1) {
+				Chunk c;
+				c.begin=begin;
+				c.end=i+1;
+				c.movable=false;
+				chunks.push_back(c);
+				begin=i+1;
+			}
+		}
+
+		for(auto& c: chunks) {
+			// the annotations
+			size_t pos=c.begin;
+			while((pos=code.find("__", pos)) != string::npos && pos+2 < c.end) {
+				size_t q = code.find("__", pos+2);
+				size_t r = (q==string::npos ? string::npos : code.find("__", q+2));
+				if(r==string::npos || r+2>c.end || !isalpha(code[pos+2])) {
+					pos+=2;
+					continue;
+				}
+				string cycleString = code.substr(q+2, r-q-2);
+				if(cycleString.empty() || cycleString.find_first_not_of("0123456789")!=string::npos) {
+					pos+=2;
+					continue;
+				}
+				Annotation a;
+				a.pos=pos;
+				a.length=r+2-pos;
+				a.name=code.substr(pos+2, q-pos-2);
+				a.cycle=atoi(cycleString.c_str());
+				c.annotations.push_back(a);
+				pos=r+2;
+			}
+			// the remaining text, and the assigned signal
+			unsigned int next=0;
+			inComment=false;
+			for(size_t i=c.begin; i<c.end; i++) {
+				if(next<c.annotations.size() && i==c.annotations[next].pos) {
+					c.text += " ";
+					i += c.annotations[next].length-1;
+					if(c.lhs=="") {
+						size_t j = code.find_first_not_of(" \t\n", i+1);
+						if(j!=string::npos && code.compare(j, 2, "<=")==0)
+							c.lhs = c.annotations[next].name;
+					}
+					next++;
+				}
+				else if(inComment) {
+					if(code[i]=='\n')
+						inComment=false;
+				}
+				else if(code[i]=='-' && i+1<c.end && code[i+1]=='-')
+					inComment=true;
+				else
+					c.text += tolower(code[i]);
+			}
+		}
+
+		// The declared signal referred to by an identifier, also when it is a delayed name
+		auto signalOf = [&](string name) -> string {
+			if(declareTable.find(name)!=declareTable.end())
+				return name;
+			size_t d = name.rfind("_d");
+			if(d!=string::npos && d+2<name.size() && name.find_first_not_of("0123456789", d+2)==string::npos
+				 && declareTable.find(name.substr(0,d))!=declareTable.end())
+				return name.substr(0,d);
+			return "";
+		};
+
+		// Classify the chunks. Signals involved in anything else than a simple assignment are fixed.
+		// A chunk is a concurrent statement only outside the bodies of processes, generates and blocks:
+		// the second statement of a process does not contain any keyword, but it is not movable
+		set<string> fixed;
+		map<string, int> nbDefinitions;
+		const char* keywords[] = {"process", "begin", "end", "port", "map", "generate", "if", "case", "component", "block"};
+		const char* bodies[] = {"process", "generate", "block"};
+		int depth=0; // the nesting level of bodies
+		for(auto& c: chunks) {
+			bool simple = (depth==0 && c.lhs!="" && declareTable.find(c.lhs)!=declareTable.end());
+			for(auto a: c.annotations) {
+				if(a.cycle != c.annotations[0].cycle || (signalOf(a.name)!="" && signalOf(a.name)!=a.name))
+					simple=false;
+			}
+			// the identifiers of the chunk
+			vector<string> words;
+			string word;
+			for(size_t i=0; i<=c.text.size(); i++) {
+				if(i<c.text.size() && (isalnum(c.text[i]) || c.text[i]=='_'))
+					word += c.text[i];
+				else if(word!="") {
+					words.push_back(word);
+					word="";
+				}
+			}
+			for(unsigned int i=0; i<words.size(); i++) {
+				for(auto k: keywords)
+					if(words[i]==k)
+						simple=false;
+				for(auto b: bodies)
+					if(words[i]==b)
+						depth += (i>0 && words[i-1]=="end" ? -1 : 1);
+			}
+			if(simple) {
+				c.movable=true;
+				nbDefinitions[c.lhs]++;
+			}
+			else {
+				for(auto a: c.annotations)
+					if(signalOf(a.name)!="")
+						fixed.insert(signalOf(a.name));
+			}
+		}
+		for(auto s: ioList_)
+			fixed.insert(s->getName());
+		for(auto it: declareTable) {
+			if(nbDefinitions[it.first]!=1 || getSignalByName(it.first)->getLifeSpan()>0)
+				fixed.insert(it.first);
+		}
+
+		// The graph
+		map<string, int> cycle(declareTable.begin(), declareTable.end()); // current cycle of each signal
+		map<string, int> initialCycle = cycle;
+		map<string, int> nodeChunk;                 // the chunk of each movable node
+		map<string, set<string> > preds;            // the signals used to compute a movable node
+		map<string, vector<pair<int,int> > > uses;  // chunk and (if the chunk is not movable) cycle of each use of a signal
+		vector<string> nodes;
+		for(unsigned int k=0; k<chunks.size(); k++) {
+			Chunk& c = chunks[k];
+			if(c.movable && fixed.find(c.lhs)!=fixed.end())
+				c.movable=false;
+			if(c.movable) {
+				nodeChunk[c.lhs]=k;
+				nodes.push_back(c.lhs);
+			}
+			for(auto a: c.annotations) {
+				if(a.name==c.lhs || declareTable.find(a.name)==declareTable.end())
+					continue;
+				if(c.movable)
+					preds[c.lhs].insert(a.name);
+				uses[a.name].push_back(make_pair(k, a.cycle));
+			}
+		}
+		if(nodes.empty())
+			return;
+
+		auto useCycle = [&](pair<int,int> use) -> int {
+			return (chunks[use.first].movable ? cycle[chunks[use.first].lhs] : use.second);
+		};
+		auto registeredBits = [&](string s) -> int {
+			int lifeSpan=0;
+			for(auto u: uses[s])
+				lifeSpan = max(lifeSpan, useCycle(u)-cycle[s]);
+			return getSignalByName(s)->width() * lifeSpan;
+		};
+
+		// The delay of each node, deduced from the critical paths at the end of its predecessors in the same cycle.
+		// Without timing information (an operator that does not manage its critical path), retiming could break the period
+		double maxCriticalPath=0;
+		for(auto v: nodes)
+			maxCriticalPath = max(maxCriticalPath, getSignalByName(v)->getCriticalPath());
+		if(maxCriticalPath==0) {
+			REPORT(DETAILED, "Retiming skipped (no critical path information)");
+			return;
+		}
+		map<string, double> nodeDelay;
+		for(auto v: nodes) {
+			double start=0;
+			for(auto u: preds[v])
+				if(cycle[u]==cycle[v])
+					start = max(start, getSignalByName(u)->getCriticalPath());
+			nodeDelay[v] = max(0.0, getSignalByName(v)->getCriticalPath() - start);
+		}
+
+		// Arrival times in the current schedule
+		map<string, double> arrival;
+		set<string> inProgress;
+		std::function<double(string)> arrivalOf = [&](string v) -> double {
+			if(arrival.find(v)!=arrival.end())
+				return arrival[v];
+			if(nodeChunk.find(v)==nodeChunk.end() || inProgress.find(v)!=inProgress.end())
+				return getSignalByName(v)->getCriticalPath();
+			inProgress.insert(v);
+			double start=0;
+			for(auto u: preds[v])
+				if(cycle[u]==cycle[v])
+					start = max(start, arrivalOf(u));
+			inProgress.erase(v);
+			arrival[v] = start + nodeDelay[v];
+			return arrival[v];
+		};
+
+		double limit = 1.0/target_->frequency();
+		for(auto v: nodes)
+			limit = max(limit, arrivalOf(v));
+		map<string, double> initialArrival = arrival;
+
+		// A schedule meets timing if no node exceeds the limit, and if the nodes used in the same cycle
+		// by code that is not a simple assignment are not later than they used to be
+		auto meetsTiming = [&]() -> bool {
+			arrival.clear();
+			for(auto v: nodes) {
+				double bound = limit;
+				for(auto u: uses[v]) {
+					if(!chunks[u.first].movable && u.second==cycle[v])
+						bound = (cycle[v]==initialCycle[v] ? min(bound, initialArrival[v]) : -1);
+				}
+				if(arrivalOf(v) > bound)
+					return false;
+			}
+			return true;
+		};
+
+		int bitsBefore=0;
+		for(auto it: declareTable)
+			bitsBefore += registeredBits(it.first);
+
+		// Local moves: push a node one cycle later (or earlier) if it saves registered bits.
+		// Moving a node earlier at equal cost is also accepted: it often enables a saving on its successor,
+		// and as the sum of the cycles decreases, this cannot loop
+		int nbMoves=0;
+		bool improved=true;
+		for(int iteration=0; improved && iteration<100; iteration++) {
+			improved=false;
+			for(auto v: nodes) {
+				for(int direction=1; direction>=-1; direction-=2) {
+					int oldCycle = cycle[v];
+					int newCycle = oldCycle+direction;
+					bool possible = (newCycle>=0);
+					for(auto u: preds[v])
+						if(cycle[u] > newCycle)
+							possible=false;
+					for(auto u: uses[v])
+						if(useCycle(u) < newCycle)
+							possible=false;
+					if(!possible)
+						continue;
+					int before = registeredBits(v);
+					for(auto u: preds[v])
+						before += registeredBits(u);
+					cycle[v] = newCycle;
+					int after = registeredBits(v);
+					for(auto u: preds[v])
+						after += registeredBits(u);
+					if((after < before || (after == before && direction < 0)) && meetsTiming()) {
+						nbMoves++;
+						improved=true;
+					}
+					else
+						cycle[v] = oldCycle;
+				}
+			}
+		}
+
+		int bitsAfter=0;
+		for(auto it: declareTable)
+			bitsAfter += registeredBits(it.first);
+		REPORT(DETAILED, "Retiming: " << nbMoves << " moves, registered bits " << bitsBefore << " -> " << bitsAfter);
+		if(nbMoves==0)
+			return;
+
+		// Re-annotate the code of the moved nodes, and update the declare and use tables accordingly
+		ostringstream newCode;
+		size_t done=0;
+		vhdl.useTable.clear();
+		for(auto& c: chunks) {
+			for(auto a: c.annotations) {
+				int newCycle = (c.movable ? cycle[c.lhs] : a.cycle);
+				newCode << code.substr(done, a.pos-done) << "__" << a.name << "__" << newCycle << "__";
+				done = a.pos + a.length;
+				vhdl.useTable.push_back(make_pair(a.name, newCycle));
+			}
+		}
+		newCode << code.substr(done);
+		vhdl.setSecondLevelCode(newCode.str());
+		for(auto v: nodes) {
+			declareTable[v] = cycle[v];
+			getSignalByName(v)->setCycle(cycle[v]);
+		}
+	}
+
+
+
+	void Operator::packTables(){
+		// The memory-block tables instantiated once, by this operator
+		vector<pair<string, pair<OperatorPtr, int> > > candidates;
+		for(auto i: instances_) {
+			Table* t = dynamic_cast<Table*>(i.second.first);
+			if(t==NULL || t->isLogicTable())
+				continue;
+			int n = count_if(instances_.begin(), instances_.end(),
+			                 [t](pair<string, pair<OperatorPtr, int> >& j){return j.second.first==t;});
+			if(n==1 && find(subComponents_.begin(), subComponents_.end(), t) != subComponents_.end())
+				candidates.push_back(i);
+		}
+		if(candidates.size() < 2)
+			return;
+
+		vhdl.flush();
+		string code = vhdl.str();
+		vector<bool> packed(candidates.size(), false);
+		int nbPacked = 0;
+		for(size_t a=0; a<candidates.size(); a++) {
+			if(packed[a])
+				continue;
+			Table* ta = (Table*) candidates[a].second.first;
+			// the partner that saves the most memory blocks
+			int best = -1;
+			int bestSaving = 0;
+			for(size_t b=a+1; b<candidates.size(); b++) {
+				Table* tb = (Table*) candidates[b].second.first;
+				if(packed[b] || candidates[b].second.second != candidates[a].second.second
+				   || tb->isSequential() != ta->isSequential() || tb->getPipelineDepth() != ta->getPipelineDepth())
+					continue;
+				int before = ta->getEstimatedBRAMs() + tb->getEstimatedBRAMs();
+				int after = (ta->wIn >= tb->wIn ? PackedTable::memoryBlocks(getTarget(), ta, tb) : PackedTable::memoryBlocks(getTarget(), tb, ta));
+				if(before - after > bestSaving) {
+					best = b;
+					bestSaving = before - after;
+				}
+			}
+			if(best < 0)
+				continue;
+
+			// the first table of the pack is the one with the larger input
+			size_t i1 = a, i2 = best;
+			if(((Table*)candidates[a].second.first)->wIn < ((Table*)candidates[best].second.first)->wIn)
+				swap(i1, i2);
+			Table* t1 = (Table*) candidates[i1].second.first;
+			Table* t2 = (Table*) candidates[i2].second.first;
+
+			// Locate the two instances in the code, see instance()
+			size_t begin1 = code.find(tab + candidates[i1].first + ": " + t1->getName());
+			size_t begin2 = code.find(tab + candidates[i2].first + ": " + t2->getName());
+			if(begin1==string::npos || begin2==string::npos) {
+				REPORT(DETAILED, "packTables: instances of " << t1->getName() << " or " << t2->getName() << " not found, not packed");
+				continue;
+			}
+			size_t end1 = code.find(");", begin1) + 2;
+			size_t end2 = code.find(");", begin2) + 2;
+			if(end2 < code.size() && code[end2]=='\n')
+				end2++;
+			string instance1 = code.substr(begin1, end1-begin1);
+			string instance2 = code.substr(begin2, end2-begin2);
+			// the actual signals of the second instance
+			string actualX2, actualY2;
+			size_t portMap = instance2.find("port map ( ");
+			istringstream ports(instance2.substr(portMap+11, instance2.rfind(");") - portMap - 11));
+			string port;
+			while(getline(ports, port, ',')) {
+				size_t arrow = port.find(" => ");
+				string formal = port.substr(0, arrow);
+				formal.erase(0, formal.find_first_not_of(" \t\n"));
+				if(formal=="X")
+					actualX2 = port.substr(arrow+4);
+				else if(formal=="Y")
+					actualY2 = port.substr(arrow+4);
+			}
+
+			PackedTable* pt = new PackedTable(getTarget(), t1, t2);
+			string packedInstance = instance1;
+			packedInstance.replace(0, tab.size() + candidates[i1].first.size() + 2 + t1->getName().size(),
+			                       tab + candidates[i1].first + ": " + pt->getName());
+			packedInstance.replace(packedInstance.find(" X => "), 6, " X1 => ");
+			packedInstance.replace(packedInstance.find(" Y => "), 6, " Y1 => ");
+			packedInstance.insert(packedInstance.size()-2, ",\n" + tab + tab + "           X2 => " + actualX2
+			                      + ",\n" + tab + tab + "           Y2 => " + actualY2);
+
+			// replace the later instance first, so that the position of the earlier one remains valid
+			if(begin1 > begin2) {
+				code.replace(begin1, end1-begin1, packedInstance);
+				code.erase(begin2, end2-begin2);
+			}
+			else {
+				code.erase(begin2, end2-begin2);
+				code.replace(begin1, end1-begin1, packedInstance);
+			}
+
+			subComponents_.erase(find(subComponents_.begin(), subComponents_.end(), t1));
+			subComponents_.erase(find(subComponents_.begin(), subComponents_.end(), t2));
+			subComponents_.push_back(pt);
+			for(auto& i: instances_)
+				if(i.first==candidates[i1].first)
+					i.second.first = pt;
+			string instanceName2 = candidates[i2].first;
+			instances_.erase(remove_if(instances_.begin(), instances_.end(),
+			                           [&](pair<string, pair<OperatorPtr, int> >& j){return j.first==instanceName2;}),
+			                 instances_.end());
+			packed[i1] = packed[i2] = true;
+			nbPacked++;
+			REPORT(DETAILED, "packTables: " << t1->getName() << " and " << t2->getName() << " packed in " << pt->getName()
+			       << ", saving " << bestSaving << " memory blocks");
+		}
+		if(nbPacked > 0)
+			vhdl.setSecondLevelCode(code);
+	}
+
+
+
 	void  Operator::setIndirectOperator(Operator* op){
 		indirectOperator_=op;
 		if(op!=NULL) 	{
@@ -2124,6 +2765,11 @@ namespace flopoco{
 		needRecirculationSignal_    = op->getNeedRecirculationSignal();
 		indirectOperator_           = op->getIndirectOperator();
 		hasDelay1Feedbacks_         = op->hasDelay1Feedbacks();
+		estimatedLUTs_              = op->estimatedLUTs_;
+		estimatedDSPs_              = op->estimatedDSPs_;
+		estimatedBRAMs_             = op->estimatedBRAMs_;
+		estimatedInstanceFFs_       = op->estimatedInstanceFFs_;
+		instances_                  = op->instances_;
 	}
 
 	/**
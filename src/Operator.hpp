@@ -19,6 +19,7 @@
 #include "utils.hpp"
 #include "Tools/ResourceEstimationHelper.hpp"
 #include "Tools/FloorplanningHelper.hpp"
+#include "Tools/Profiler.hpp"
 #include "TestState.hpp"
 
 using namespace std;
@@ -79,6 +80,10 @@ public:
 	/** add a sub-operator to this operator */
 	void addSubComponent(OperatorPtr op);
 
+	/** Ends the profiling of the construction of this operator, which started in Operator::Operator().
+	 * Called when the operator is instantiated or added to the operator lists: only the first call counts */
+	void endProfiling();
+
 	/** Retrieve a sub-operator by its name, NULL if not found */
 	OperatorPtr getSubComponent(string name);
 
@@ -776,6 +781,51 @@ public:
 	 * thing useful to tell to the end user
 	*/
 	virtual void outputFinalReport(ostream& s, int level);	
+
+	/** Timing report in JSON, for the build scripts (see the timingReport option).
+	 * Lists, for each signal, its cycle, critical path delay (see Signal::getCriticalPath()), lifespan and registered bits;
+	 * for each pipeline stage, its worst path and slack; then recurses on the subcomponents.
+	 * Only meaningful after the second parse, which computes the lifespans.
+	 * @param o the output stream
+	 * @param level the indentation level
+	*/
+	void outputJSONReport(ostream& o, int level=0);
+
+	/** The number of flip-flops of this operator, subcomponents included once per instance (after the second parse) */
+	int getRegisteredBits();
+
+	/** Analytical cost estimation, used by the estimateOnly option.
+	 * The building blocks (tables, bit heaps, adders) add their cost to the operator that builds them,
+	 * and instance() adds the cost of the instantiated operator to its parent.
+	 * @param luts the number of LUTs
+	 * @param dsps the number of DSP blocks
+	 * @param brams the number of memory blocks
+	*/
+	void addEstimatedCost(int luts, int dsps=0, int brams=0);
+
+	/** Adds to the cost estimate a carry-propagate adder (or comparator) of w bits written directly in VHDL: one LUT per bit.
+	 * Called next to the manageCriticalPath() of the addition */
+	void addEstimatedAdderCost(int w);
+
+	/** Adds to the cost estimate a wX x wY multiplier written directly in VHDL: DSP blocks if the target would use them,
+	 * the LUTs of Target::getIntMultiplierCost() otherwise */
+	void addEstimatedMultiplierCost(int wX, int wY);
+
+	/** The estimated LUTs of this operator, instances included */
+	int getEstimatedLUTs();
+
+	/** The estimated DSP blocks of this operator, instances included */
+	int getEstimatedDSPs();
+
+	/** The estimated memory blocks of this operator, instances included */
+	int getEstimatedBRAMs();
+
+	/** The estimated flip-flops of this operator, instances included.
+	 * Computed from the use table, without the second parse */
+	int getEstimatedFFs();
+
+	/** Prints the cost and latency estimates of this operator (estimateOnly option) */
+	void outputEstimateReport(ostream& o);
 	
 	
 	/** Gets the pipeline depth of this operator 
@@ -910,6 +960,27 @@ public:
 
 	void parse2();
 
+	/** Moves the register boundaries of a pipelined operator, after its construction and before parse2(),
+	 * so as to reduce the number of registered bits without exceeding the target period
+	 * (or the longest combinatorial delay of the constructed pipeline, if it is already larger).
+	 * The graph is built from the cycle-annotated VHDL: each simple concurrent assignment
+	 * to a declared signal is a node, whose delay is deduced from the critical paths recorded in the signals
+	 * when they are declared (Signal::getCriticalPath()). Operators without such timing information are not retimed.
+	 * Nodes are moved one cycle at a time (the classical retiming move across one node) as long as
+	 * this saves registered bits. Inputs, outputs, subcomponent ports, and all the signals involved
+	 * in statements that are not simple assignments (processes, instances, slices), or that are inside
+	 * the body of a process, generate or block, stay in place.
+	 */
+	void retime();
+
+	/** Packs pairs of memory-block tables instantiated in the same cycle into one dual-port PackedTable,
+	 * when this saves memory blocks (packTables option). The instance of the first table becomes that of
+	 * the PackedTable, the instance of the second one is removed, and so are the two tables from the sub-components.
+	 * Only the tables that are instantiated once, by this operator, are packed.
+	 * Called after construction, before the sub-components are output.
+	 */
+	void packTables();
+
 	
 	void setuid(int mm){
 		myuid = mm;
@@ -1412,6 +1483,16 @@ private:
 	bool                   hasClockEnable_;    	          /**< True if the operator has a clock enable signal  */
 	int					           hasDelay1Feedbacks_;		/**< True if this operator has feedbacks of one cyle, and no more than one cycle (i.e. an error if the distance is more). False gives warnings */
 	Operator*              indirectOperator_;              /**< NULL if this operator is just an interface operator to several possible implementations, otherwise points to the instance*/
+	double                 profileStart_;                  /**< Start time of the constructor, for the profiler */
+	long                   profileAllocations_;            /**< Number of allocations at the start of the constructor, for the profiler */
+	long                   profileBytes_;                  /**< Allocated bytes at the start of the constructor, for the profiler */
+	bool                   profileDone_;                   /**< True once the construction has been profiled */
+	int                    estimatedLUTs_;                 /**< Estimated LUTs, instances included, see addEstimatedCost() */
+	int                    estimatedDSPs_;                 /**< Estimated DSP blocks, instances included */
+	int                    estimatedBRAMs_;                /**< Estimated memory blocks, instances included */
+	int                    estimatedInstanceFFs_;          /**< Estimated flip-flops of the instances */
+	int                    estimatedFFs_;                  /**< Cache for getEstimatedFFs(), -1 if not computed yet */
+	vector<pair<string, pair<OperatorPtr, int> > > instances_;  /**< The instances built by instance(): name, operator and cycle, see packTables() */
 
 };
 
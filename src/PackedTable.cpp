@@ -0,0 +1,107 @@
+/*
+  Two tables sharing a dual-port memory
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  2008-2015.
+  All rights reserved.
+
+ */
+
+#include <iostream>
+#include <sstream>
+#include "utils.hpp"
+#include "PackedTable.hpp"
+
+using namespace std;
+
+
+namespace flopoco{
+
+	PackedTable::PackedTable(Target* target, Table* t1_, Table* t2_) :
+		Operator(target), t1(t1_), t2(t2_)
+	{
+		srcFileName = "PackedTable";
+		if(t1->wIn < t2->wIn)
+			THROWERROR("the first table should have the larger input");
+		ostringstream name;
+		name << "PackedTable_" << t1->wIn << "_" << t2->wIn << "_" << getNewUId();
+		setName(name.str());
+		setCopyrightString("FloPoCo developers (2026)");
+		addHeaderComment("-- Packs " + t1->getName() + " and " + t2->getName() + "\n");
+
+		addInput ("X1", t1->wIn, true);
+		addInput ("X2", t2->wIn, true);
+		addOutput ("Y1", t1->wOut, 1, true);
+		addOutput ("Y2", t2->wOut, 1, true);
+
+		wA = t1->wIn + 1;
+		w = max(t1->wOut, t2->wOut);
+		setPipelineDepth(t1->getPipelineDepth());
+		addEstimatedCost(0, 0, memoryBlocks(target, t1, t2));
+	}
+
+
+	int PackedTable::memoryBlocks(Target* target, Table* t1, Table* t2) {
+		double bits = (intpow2(t1->wIn) + intpow2(t2->wIn)) * max(t1->wOut, t2->wOut);
+		return (int) ceil(bits / target->sizeOfMemoryBlock());
+	}
+
+
+	void PackedTable::outputVHDL(std::ostream& o, std::string name)
+	{
+		licence(o);
+		o << "library ieee; " << endl;
+		o << "use ieee.std_logic_1164.all;" << endl;
+		o << "use ieee.numeric_std.all;" << endl;
+		o << "library work;" << endl;
+		outputVHDLEntity(o);
+		newArchitecture(o,name);
+
+		int offset = 1 << t1->wIn;
+		o << tab << "-- Build a 2-D array type for the RoM: " << t1->getName() << " at address 0, " << t2->getName() << " at address " << offset << endl;
+		o << tab << "subtype word_t is std_logic_vector("<< w-1 <<" downto 0);" << endl;
+		o << tab << "type memory_t is array(0 to " << offset + (1 << t2->wIn) - 1 << ") of word_t;" << endl;
+		o << tab << "function init_rom" << endl;
+		o << tab << tab << "return memory_t is " << endl;
+		o << tab << tab << "variable tmp : memory_t := (" << endl;
+		REPORT(FULL,"PackedTable.cpp: Filling the table");
+		for (int x = t1->minIn; x <= t1->maxIn; x++)
+			o << tab << x << " => \"" << unsignedBinary(t1->function(x), w) << "\"," << endl;
+		for (int x = t2->minIn; x <= t2->maxIn; x++)
+			o << tab << offset + x << " => \"" << unsignedBinary(t2->function(x), w) << "\"," << endl;
+		o << tab << tab << "others => (others => '0'));" << endl;
+		o << tab << tab << "	begin " << endl;
+		o << tab << tab << "return tmp;" << endl;
+		o << tab << tab << "end init_rom;" << endl;
+		o << "	signal rom : memory_t := init_rom;" << endl;
+		o << "	signal A1, A2 : std_logic_vector(" << wA-1 << " downto 0);" << endl;
+		o << "	signal R1, R2 : word_t;" << endl;
+		beginArchitecture(o);
+
+		o << tab << "A1 <= '0' & X1;" << endl;
+		o << tab << "A2 <= '1' & ";
+		if(t1->wIn > t2->wIn)
+			o << "\"" << string(t1->wIn - t2->wIn, '0') << "\" & ";
+		o << "X2;" << endl;
+		if(isSequential()){
+			o << "	process(clk)" << endl;
+			o << tab << "begin" << endl;
+			o << tab << "if(rising_edge(clk)) then" << endl;
+		}
+		o << tab << "	R1 <= rom(  TO_INTEGER(unsigned(A1))  );" << endl;
+		o << tab << "	R2 <= rom(  TO_INTEGER(unsigned(A2))  );" << endl;
+		if(isSequential()){
+			o << tab << "end if;" << endl;
+			o << tab << "end process;" << endl;
+		}
+		o << tab << " Y1 <= R1" << range(t1->wOut-1, 0) << ";" << endl;
+		o << tab << " Y2 <= R2" << range(t2->wOut-1, 0) << ";" << endl;
+		endArchitecture(o);
+	}
+
+}
@@ -0,0 +1,43 @@
+#ifndef PACKEDTABLE_HPP
+#define PACKEDTABLE_HPP
+#include <gmpxx.h>
+
+#include "Table.hpp"
+
+namespace flopoco{
+
+	/** Two memory-block tables sharing one dual-port memory (packTables option, see Operator::packTables()).
+		 The first table, which has the larger input, is stored at address 0, the second one just after it.
+		 Each table is read by one port: X1 -> Y1 for the first one, X2 -> Y2 for the second one.
+		 As in Table, the read is registered if the operator is sequential.
+	*/
+
+	class PackedTable : public Operator
+	{
+	public:
+
+		/**
+		 * The PackedTable constructor
+		 * @param[in] target the target device
+		 * @param[in] t1     the first table, such that t1->wIn >= t2->wIn
+		 * @param[in] t2     the second table
+		 **/
+		PackedTable(Target* target, Table* t1, Table* t2);
+
+		virtual ~PackedTable() {};
+
+		/** Overloading the method of Operator */
+		void outputVHDL(ostream& o, string name);
+
+		/** The number of memory blocks needed by the packed tables */
+		static int memoryBlocks(Target* target, Table* t1, Table* t2);
+
+	private:
+		Table* t1;
+		Table* t2;
+		int wA;      /**< the address width of the memory */
+		int w;       /**< the data width of the memory */
+	};
+
+}
+#endif
@@ -0,0 +1,145 @@
+/*
+  A leading zero anticipator for FloPoCo
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+  developed by the Arenaire team at Ecole Normale Superieure de Lyon
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  2008-2011.
+  All rights reserved.
+
+*/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <gmp.h>
+#include <mpfr.h>
+#include <gmpxx.h>
+#include "utils.hpp"
+#include "Operator.hpp"
+#include "LZA.hpp"
+
+using namespace std;
+
+
+namespace flopoco{
+
+	LZA::LZA(Target* target, int wIn, map<string, double> inputDelays) :
+		Operator(target, inputDelays), wIn_(wIn) {
+
+		srcFileName = "LZA";
+		setCopyrightString("FloPoCo developers (2026)");
+
+		ostringstream name;
+		name <<"LZA_"<<wIn;
+		setNameWithFreqAndUID(name.str());
+
+		if(wIn<2)
+			THROWERROR("wIn should be at least 2");
+
+		wOut_ = intlog2(wIn);
+
+		addInput ("A", wIn_);
+		addInput ("B", wIn_);
+		addOutput("O", wOut_);
+
+		setCriticalPath( getMaxInputDelays(inputDelays));
+
+		// The digits of A-B are +1 (gt), 0 (eq) or -1 (lt).
+		// In the leading part 0..0 (+1)(-1)..(-1) of a positive difference, the indicator marks the last digit,
+		// which is the position of the leading one or the next one. Same for a negative difference, exchanging +1 and -1.
+		manageCriticalPath(target->localWireDelay() + target->lutDelay());
+		vhdl << tab << declare("eq", wIn_) << " <= not (A xor B);" << endl;
+		vhdl << tab << declare("gt", wIn_) << " <= A and not B;" << endl;
+		vhdl << tab << declare("lt", wIn_) << " <= B and not A;" << endl;
+		// the digit on the left of the MSB is 0, the digit on the right of the LSB is 0
+		vhdl << tab << declare("eqLeft", wIn_) << " <= '1' & eq" << range(wIn_-1, 1) << ";" << endl;
+		vhdl << tab << declare("gtRight", wIn_) << " <= gt" << range(wIn_-2, 0) << " & '0';" << endl;
+		vhdl << tab << declare("ltRight", wIn_) << " <= lt" << range(wIn_-2, 0) << " & '0';" << endl;
+		manageCriticalPath(target->localWireDelay() + target->lutDelay());
+		vhdl << tab << declare("indicator", wIn_) << " <= (eqLeft and ((gt and not ltRight) or (lt and not gtRight)))" << endl
+				 << tab << tab << " or ((not eqLeft) and ((lt and not ltRight) or (gt and not gtRight)));" << endl;
+
+		lzoc = new LZOC(target, wIn_, inDelayMap("I", getCriticalPath()));
+		addSubComponent(lzoc);
+		inPortMap  (lzoc, "I", "indicator");
+		inPortMapCst(lzoc, "OZB", "'0'");
+		outPortMap (lzoc, "O", "count");
+		vhdl << instance(lzoc, "LZC_indicator");
+		syncCycleFromSignal("count");
+		setCriticalPath(lzoc->getOutputDelay("O"));
+
+		outDelayMap["O"] = getCriticalPath();
+		vhdl << tab << "O <= count;" << endl;
+	}
+
+	LZA::~LZA() {}
+
+
+
+	bool LZA::isFaster(Target* target, int wIn) {
+		int wCount = intlog2(wIn);
+		double level = target->lutDelay() + target->localWireDelay();
+		// LZOCShifterSticky: each stage is a zero detection followed by a multiplexer, and it shifts while it counts
+		double lzcDelay = 0;
+		for (int i=wCount; i>=1; i--)
+			lzcDelay += intlog(mpz_class(target->lutInputs()), intpow2(i-1)) * level + level;
+		// LZOC and Shifter process muxSelectBits() bits per stage
+		int stages = (wCount + target->muxSelectBits() - 1) / target->muxSelectBits();
+		double muxLevel = target->muxDelay(min(wCount, target->muxSelectBits())) + target->localWireDelay();
+		double lzaCountDelay = 0;
+		for (int i=wCount; i>=1; i-=target->muxSelectBits())
+			lzaCountDelay += intlog(mpz_class(target->lutInputs()), intpow2(max(0, i-target->muxSelectBits()))) * level + level + muxLevel;
+		double subDelay = target->adderDelay(wIn);
+		double lzcPathDelay = subDelay + lzcDelay;
+		// the indicator is computed in parallel with the subtraction, then a shift and the one-bit correction
+		double lzaPathDelay = max(subDelay, 2*level + lzaCountDelay) + stages*muxLevel + level;
+		return (lzaPathDelay < lzcPathDelay);
+	}
+
+
+
+	void LZA::emulate(TestCase* tc)
+	{
+		mpz_class sa = tc->getInputValue("A");
+		mpz_class sb = tc->getInputValue("B");
+		mpz_class d = sa - sb;
+		if(d < 0)
+			d = -d;
+
+		int count;
+		if(d == 0)
+			count = wIn_;
+		else
+			count = wIn_ - mpz_sizeinbase(d.get_mpz_t(), 2);
+
+		tc->addExpectedOutput("O", mpz_class(count));
+		if(count > 0)
+			tc->addExpectedOutput("O", mpz_class(count-1));
+	}
+
+
+	OperatorPtr LZA::parseArguments(Target *target, std::vector<std::string> &args) {
+		int wIn;
+		UserInterface::parseStrictlyPositiveInt(args, "wIn", &wIn);
+		return new LZA(target, wIn);
+	}
+
+
+
+	void LZA::registerFactory(){
+		UserInterface::add("LZA", // name
+											 "A leading zero anticipator: predicts the leading zero count of |A-B| up to one position.",
+											 "ShiftersLZOCs", // category
+											 "LZOC",
+											 "wIn(int): input size in bits", // This string will be parsed
+											 "The output is either the leading zero count of |A-B|, or this count minus one.",
+											 LZA::parseArguments
+											 ) ;
+
+	}
+}
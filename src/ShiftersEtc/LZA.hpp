@@ -0,0 +1,61 @@
+#ifndef LZA_HPP
+#define LZA_HPP
+#include <vector>
+#include <sstream>
+#include <gmp.h>
+#include <mpfr.h>
+#include <gmpxx.h>
+#include "Operator.hpp"
+#include "LZOC.hpp"
+
+
+namespace flopoco{
+
+	/** The leading zero anticipator class.
+	 * Predicts the number of leading zeroes of |A-B| from A and B, in parallel with the subtraction.
+	 * A leading one indicator string is computed from the signed digits of A-B (Schmookler and Nowka),
+	 * and its leading zeroes are counted by an LZOC.
+	 * The predicted count is either exact or one too small: the user has to perform the one-bit correction,
+	 * typically by looking at the MSB of the normalized significand.
+	 */
+	class LZA : public Operator{
+
+	public:
+		/** The LZA constructor
+		 * @param[in] target the target device for this operator
+		 * @param[in] wIn the width of the inputs
+		 */
+		LZA(Target* target, int wIn, map<string, double> inputDelays = emptyDelayMap);
+
+		/** The LZA destructor	*/
+		~LZA();
+
+		/** Estimates, using the delay model of the target, if a subtraction followed by an LZA-predicted shift and the one-bit correction
+		 * is faster than a subtraction followed by a leading zero count and shift.
+		 * @param[in] target the target device
+		 * @param[in] wIn the width of the subtraction
+		 */
+		static bool isFaster(Target* target, int wIn);
+
+		/**
+		 * Both the exact count and the count minus one are accepted.
+		 * @param tc a TestCase partially filled with input values
+		 */
+		void emulate(TestCase * tc);
+
+	protected:
+
+		int wIn_;    /**< The width of the inputs */
+		int wOut_;   /**< The width of the output */
+		LZOC* lzoc;  /**< The counter of the leading zeroes of the indicator */
+
+	public:
+		/** Factory method that parses arguments and calls the constructor */
+		static OperatorPtr parseArguments(Target *target , vector<string> &args);
+
+		/** Factory register method */
+		static void registerFactory();
+	};
+
+}
+#endif
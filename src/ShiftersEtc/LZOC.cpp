@@ -58,31 +58,76 @@ namespace flopoco{
 		//each operation is formed of a comparisson folloewd by a multiplexing
 		setCriticalPath( getMaxInputDelays(inputDelays));
 
-		for (int i=wOut_;i>=1;i--){
-			currDigit.str(""); currDigit << "digit" << i ;
+		// Each stage computes as many bits of the count as the multiplexers of the target allow in one logic level
+		int levelBits = target->muxSelectBits();
+		vector<string> counts; // the groups of bits of the output, MSB first
+		int i=wOut_;
+		while (i>=1){
+			int groupBits = min(levelBits, i);
 			currLevel.str(""); currLevel << "level" << i;
-			nextLevel.str(""); nextLevel << "level" << i-1;
-			manageCriticalPath( intlog(mpz_class(target->lutInputs()), intpow2(i-1)) * target->lutDelay() + intlog(mpz_class(target->lutInputs()), intpow2(i-1))* target->localWireDelay() ); 
-
-			vhdl << tab <<declare(currDigit.str()) << "<= '1' when " << currLevel.str() << "("<<intpow2(i)-1<<" downto "<<intpow2(i-1)<<") = "
-				  <<"("<<intpow2(i)-1<<" downto "<<intpow2(i-1)<<" => sozb)"
-				  << " else '0';"<<endl;
-
-			if (i>1){
-				manageCriticalPath( target->lutDelay() + (1 + (double(intpow2(i-1))/double(100)) )*target->localWireDelay());
-
-				vhdl << tab << declare(nextLevel.str(),intpow2(i-1)) << "<= "<<currLevel.str() << "("<<intpow2(i-1)-1<<" downto 0) when " << currDigit.str()<<"='1' "
-					  <<"else "<<currLevel.str()<<"("<<intpow2(i)-1<<" downto "<<intpow2(i-1)<<");"<<endl;
+			nextLevel.str(""); nextLevel << "level" << i-groupBits;
+			if (groupBits==1){
+				currDigit.str(""); currDigit << "digit" << i ;
+				manageCriticalPath( intlog(mpz_class(target->lutInputs()), intpow2(i-1)) * target->lutDelay() + intlog(mpz_class(target->lutInputs()), intpow2(i-1))* target->localWireDelay() ); 
+				// the comparison of 2^(i-1) bits to sozb is a tree of LUTs
+				addEstimatedCost(int(ceil(double(intpow2(i-1)) / (target->lutInputs()-1))));
+
+				vhdl << tab <<declare(currDigit.str()) << "<= '1' when " << currLevel.str() << "("<<intpow2(i)-1<<" downto "<<intpow2(i-1)<<") = "
+					  <<"("<<intpow2(i)-1<<" downto "<<intpow2(i-1)<<" => sozb)"
+					  << " else '0';"<<endl;
+
+				if (i>1){
+					manageCriticalPath( target->lutDelay() + (1 + (double(intpow2(i-1))/double(100)) )*target->localWireDelay());
+					addEstimatedCost(intpow2(i-1));
+
+					vhdl << tab << declare(nextLevel.str(),intpow2(i-1)) << "<= "<<currLevel.str() << "("<<intpow2(i-1)-1<<" downto 0) when " << currDigit.str()<<"='1' "
+						  <<"else "<<currLevel.str()<<"("<<intpow2(i)-1<<" downto "<<intpow2(i-1)<<");"<<endl;
+				}
+			}
+			else {
+				// The level is split in 2^groupBits parts, and the count of leading parts full of sozb selects the next level
+				int parts = intpow2(groupBits);
+				int partWidth = intpow2(i-groupBits);
+				manageCriticalPath( intlog(mpz_class(target->lutInputs()), partWidth) * target->lutDelay() + intlog(mpz_class(target->lutInputs()), partWidth)* target->localWireDelay() ); 
+				addEstimatedCost((parts-1) * int(ceil(double(partWidth) / (target->lutInputs()-1))));
+				for (int j=parts-1; j>=1; j--)
+					vhdl << tab << declare(join("part", i, "_", j, "_sozb")) << "<= '1' when " << currLevel.str() << range((j+1)*partWidth-1, j*partWidth) << " = "
+						  << "(" << partWidth-1 << " downto 0 => sozb) else '0';" << endl;
+
+				currDigit.str(""); currDigit << "digits" << i ;
+				manageCriticalPath( intlog(mpz_class(target->lutInputs()), parts-1) * (target->lutDelay() + target->localWireDelay()) );
+				addEstimatedCost(groupBits * int(ceil(double(parts-1) / target->lutInputs())));
+				vhdl << tab << declare(currDigit.str(), groupBits) << "<= ";
+				for (int c=0; c<parts-1; c++)
+					vhdl << "\"" << unsignedBinary(mpz_class(c), groupBits) << "\" when " << join("part", i, "_", parts-1-c, "_sozb") << "='0' else" << endl << tab << tab;
+				vhdl << "\"" << unsignedBinary(mpz_class(parts-1), groupBits) << "\";" << endl;
+
+				if (i>groupBits){
+					manageCriticalPath( target->muxDelay(groupBits) + (1 + (double(partWidth)/double(100)) )*target->localWireDelay());
+					// one multiplexer per bit, with 2^groupBits data inputs and groupBits select inputs
+					addEstimatedCost(partWidth * int(ceil(double(parts+groupBits) / target->lutInputs())));
+					vhdl << tab << "with " << currDigit.str() << " select" << endl;
+					vhdl << tab << declare(nextLevel.str(), partWidth) << "<= ";
+					for (int c=0; c<parts; c++) {
+						int j = parts-1-c;
+						vhdl << currLevel.str() << range((j+1)*partWidth-1, j*partWidth);
+						if (c==parts-1)
+							vhdl << " when others;" << endl;
+						else
+							vhdl << " when \"" << unsignedBinary(mpz_class(c), groupBits) << "\"," << endl << tab << tab;
+					}
+				}
 			}
+			counts.push_back(currDigit.str());
+			i -= groupBits;
 		}
 		//update output slack
 		outDelayMap["O"] = getCriticalPath();
 	
 		vhdl << tab << "O <= ";
-		for (int i=wOut_;i>=1;i--){
-			currDigit.str(""); currDigit << "digit" << i ;
-			vhdl << currDigit.str();
-			if (i==1)
+		for (unsigned int k=0; k<counts.size(); k++){
+			vhdl << counts[k];
+			if (k==counts.size()-1)
 				vhdl << ";"<<endl;
 			else
 				vhdl << " & ";
@@ -82,11 +82,13 @@ namespace flopoco{
 				manageCriticalPath( target->localWireDelay() + target->eqConstComparatorDelay( intpow2(i) ) ) ;
 			else
 				manageCriticalPath( target->localWireDelay() + target->eqComparatorDelay( intpow2(i) ) ) ;
+			addEstimatedCost(int(ceil(double(intpow2(i)) / (target->lutInputs()-1))));
 				
 			vhdl << tab << declare(join("count",i)) << "<= '1' when " <<join("level",i+1)<<range(prevLev-1,prevLev - intpow2(i))<<" = "
 				  <<"("<<prevLev-1<<" downto "<<prevLev - intpow2(i)<<"=>"<< (countType_==-1? "sozb": countType_==0?"'0'":"'1'")<<") else '0';"<<endl;
 
 			manageCriticalPath( target->localWireDelay() + target->lutDelay() );
+			addEstimatedCost(currLev);
 			vhdl << tab << declare(join("level",i),currLev) << "<= " << join("level",i+1)<<"("<<prevLev-1<<" downto "<< prevLev-currLev << ")"
 				  << " when " << join("count",i) << "='0' else ";
 			int l,r;
@@ -102,6 +104,10 @@ namespace flopoco{
 			if ((computeSticky_)&&(wOut_<wIn)) {
 				
 				manageCriticalPath( compDelay( max( prevLev-currLev, (currLev < prevLev - intpow2(i) ? (prevLev - int(intpow2(i)) ) - currLev : 0 ))  ) ); 
+				// the two OR-reductions, and the selection of the sticky
+				addEstimatedCost(int(ceil(double(prevLev-currLev) / (target->lutInputs()-1)))
+				                 + int(ceil(double(currLev < prevLev - intpow2(i) ? (prevLev - intpow2(i)) - currLev : 0) / (target->lutInputs()-1)))
+				                 + 1);
 
 				vhdl << tab << declare(join("sticky_high_",i)) << "<= '0'";
 				if (prevLev-currLev > 0)
@@ -89,15 +89,23 @@ namespace flopoco{
 				setCriticalPath(0.0);
 #endif
 
-			if(true || target->lutInputs()<6) { // levels are not grouped
-				for (int currentLevel=0; currentLevel<wShiftIn_; currentLevel++){
-					int stageWidth= wIn+intpow2(currentLevel+1)-1;
-					double delay = target->localWireDelay(stageWidth) // diffusion of the selection signal
-						+ target->lutDelay() ;   // the mux
-					manageCriticalPath(delay);
-					ostringstream currentLevelName, nextLevelName;
-					currentLevelName << "level"<<currentLevel;
-					nextLevelName << "level"<<currentLevel+1;
+			// Each stage processes as many bits of the shift amount as the multiplexers of the target allow in one logic level.
+			// The stages are named after the number of bits of S already processed.
+			int levelBits = target->muxSelectBits();
+			int currentLevel=0;
+			while (currentLevel<wShiftIn_) {
+				int nextLevel = min(currentLevel+levelBits, wShiftIn_);
+				int selectBits = nextLevel-currentLevel;
+				int stageWidth= wIn+intpow2(nextLevel)-1;
+				double delay = target->localWireDelay(stageWidth) // diffusion of the selection signal
+					+ target->muxDelay(selectBits) ;   // the mux
+				manageCriticalPath(delay);
+				// one multiplexer per bit, with 2^selectBits data inputs and selectBits select inputs
+				addEstimatedCost(stageWidth * int(ceil(double(intpow2(selectBits)+selectBits) / target->lutInputs())));
+				ostringstream currentLevelName, nextLevelName;
+				currentLevelName << "level"<<currentLevel;
+				nextLevelName << "level"<<nextLevel;
+				if (selectBits==1) {
 					if (direction==Right){
 						vhdl << tab << declare(nextLevelName.str(),  stageWidth ) 
 								 <<"<=  ("<<intpow2(currentLevel)-1 <<" downto 0 => '0') & "<<currentLevelName.str()<<" when ps";
@@ -114,8 +122,31 @@ namespace flopoco{
 								 << tab <<" ("<<intpow2(currentLevel)-1<<" downto 0 => '0') & "<< currentLevelName.str() <<";"<<endl;
 					}
 				}
-			
-		}
+				else {
+					// a 2^selectBits:1 multiplexer: the input is shifted by j.2^currentLevel, and padded to stageWidth
+					int padding = intpow2(nextLevel) - intpow2(currentLevel);
+					vhdl << tab << "with ps" << range(nextLevel-1, currentLevel) << " select" << endl;
+					vhdl << tab << declare(nextLevelName.str(),  stageWidth ) << " <= ";
+					for (int j=0; j<intpow2(selectBits); j++) {
+						int shift = j*intpow2(currentLevel);
+						int zerosBefore = (direction==Right ? shift : padding-shift);
+						int zerosAfter = padding - zerosBefore;
+						if (j>0)
+							vhdl << "," << endl << tab << tab;
+						if (zerosBefore>0)
+							vhdl << "(" << zerosBefore-1 << " downto 0 => '0') & ";
+						vhdl << currentLevelName.str();
+						if (zerosAfter>0)
+							vhdl << " & (" << zerosAfter-1 << " downto 0 => '0')";
+						if (j==intpow2(selectBits)-1)
+							vhdl << " when others;" << endl;
+						else
+							vhdl << " when \"" << unsignedBinary(mpz_class(j), selectBits) << "\"";
+					}
+				}
+				currentLevel = nextLevel;
+			}
+
 		//update the output slack
 		outDelayMap["R"] = getCriticalPath();
 		REPORT(DETAILED, "Delay at output " << getCriticalPath() );
@@ -179,6 +179,17 @@ namespace flopoco{
 		 */	
 		void setDelay(double delay);
 
+		/** obtain the critical path at the end of the computation of this signal, from the previous register level:
+		 * the critical path of the operator when the signal was declared, or the delay set by setDelay() if it is larger
+		 * @return the critical path, in seconds
+		 */
+		double getCriticalPath();
+
+		/** records the critical path at the end of the computation of this signal, see getCriticalPath()
+		 * @param[in] delay the critical path
+		 */
+		void setCriticalPath(double delay);
+
 
 		/** Set the number of possible output values. */
 		void  setNumberOfPossibleValues(int n);
@@ -228,6 +239,7 @@ namespace flopoco{
 		bool          isSigned_;    /**< true if this a signed fixed-point signals, false otherwise */
 		bool          isBus_;       /**< True is the signal is a bus (std_logic_vector)*/
 		double        delay_;       /**<  the delay of the signal, starting from a previous register level */
+		double        criticalPath_; /**< the critical path of the operator when the signal was declared */
 
 		
 	};
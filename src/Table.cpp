@@ -55,7 +55,7 @@ namespace flopoco{
 
 
 	Table::Table(Target* target_, int _wIn, int _wOut, int _minIn, int _maxIn, int _logicTable, map<string, double> inputDelays) :
-		Operator(target_),
+		Operator(target_, inputDelays),
 		wIn(_wIn), wOut(_wOut), minIn(_minIn), maxIn(_maxIn)
 	{
 		srcFileName = "Table";
@@ -97,6 +97,10 @@ namespace flopoco{
 			if(!logicTable)
 				REPORT(DETAILED, "This table will be implemented in memory blocks");
 		}
+		if(logicTable)
+			addEstimatedCost(wIn <= getTarget()->lutInputs() ? wOut : size_in_LUTs());
+		else
+			addEstimatedCost(0, 0, ceil(wOut * intpow2(wIn) / getTarget()->sizeOfMemoryBlock()));
 
 
 		// Pipelining is managed as follows:
@@ -118,6 +122,10 @@ namespace flopoco{
 				// The following is enough for practical sizes, but it is an overestimation.
 				addToCriticalPath(getTarget()->localWireDelay(wOut*lutsPerBit) + getTarget()->lutDelay() + getTarget()->localWireDelay() + getTarget()->lutDelay());
 			}
+			// outputVHDL() may compress the table, which adds an adder after the tables:
+			// its delay is accounted for now, since the user of the table is scheduled with outDelayMap
+			if(getTarget()->tableCompression() && wIn > getTarget()->lutInputs())
+				addToCriticalPath(getTarget()->adderDelay(wOut));
 		}
 		else{
 			manageCriticalPath(getTarget()->LogicToRAMWireDelay() + getTarget()->RAMToLogicWireDelay() + getTarget()->RAMDelay()); // will hopefully insert the extra register when needed
@@ -184,6 +192,14 @@ namespace flopoco{
 	//old version -- just for testing
 	void Table::outputVHDL(std::ostream& o, std::string name)
 	{
+		if(getTarget()->tableCompression() && wIn > getTarget()->lutInputs()) {
+			int s, wCorr;
+			vector<mpz_class> base, correction;
+			if(findCompression(s, wCorr, base, correction)) {
+				outputCompressedVHDL(o, name, s, wCorr, base, correction);
+				return;
+			}
+		}
 		licence(o);
 		o << "library ieee; " << endl;
 		o << "use ieee.std_logic_1164.all;" << endl;
@@ -310,4 +326,140 @@ namespace flopoco{
 		return wOut*int(intpow2(wIn-getTarget()->lutInputs()));
 	}
 
+
+	bool Table::isLogicTable() {
+		return logicTable || wIn <= getTarget()->lutInputs();
+	}
+
+
+	double Table::cost(Target* target, int wIn, int wOut) {
+		// same choice between logic and memory blocks as the constructor
+		if(wIn <= target->lutInputs())
+			return wOut;
+		double bits = wOut * intpow2(wIn);
+		if(bits < 0.5*target->sizeOfMemoryBlock())
+			return wOut * intpow2(wIn-target->lutInputs());
+		return ceil(bits / target->sizeOfMemoryBlock()) * target->sizeOfMemoryBlock() / intpow2(target->lutInputs());
+	}
+
+
+	bool Table::findCompression(int& s, int& wCorr, vector<mpz_class>& base, vector<mpz_class>& correction) {
+		vector<mpz_class> values(maxIn+1);
+		for (int x = minIn; x <= maxIn; x++)
+			values[x] = function(x);
+
+		double bestCost = cost(getTarget(), wIn, wOut);
+		double plainCost = bestCost;
+		s = -1;
+		for (int t = 1; t < wIn; t++) {
+			// the largest correction over all the slices of 2^t values
+			mpz_class maxCorr = 0;
+			for (int h = 0; h < (1<<(wIn-t)); h++) {
+				int first = max(h<<t, minIn);
+				int last = min(((h+1)<<t) - 1, maxIn);
+				if(first > last)
+					continue;
+				mpz_class minVal = values[first], maxVal = values[first];
+				for (int x = first+1; x <= last; x++) {
+					if(values[x] < minVal)	minVal = values[x];
+					if(values[x] > maxVal)	maxVal = values[x];
+				}
+				if(maxVal - minVal > maxCorr)
+					maxCorr = maxVal - minVal;
+			}
+			int w = max(1, intlog2(maxCorr));
+			double c = cost(getTarget(), wIn-t, wOut) + cost(getTarget(), wIn, w) + wOut; // the adder is one LUT per bit
+			REPORT(DEBUG, "Table compression with s=" << t << ": correction on " << w << " bits, cost " << c << " LUTs");
+			if(c < bestCost) {
+				bestCost = c;
+				s = t;
+				wCorr = w;
+			}
+		}
+		if(s < 0)
+			return false;
+
+		// A memory-block table is replaced by logic tables and an adder before its output register: they must fit in a cycle
+		if(!logicTable && isSequential()) {
+			int lutsPerBit = 1<<(wIn-getTarget()->lutInputs());
+			double delay = getMaxInputDelays(inputDelayMap)
+				+ getTarget()->localWireDelay(wCorr*lutsPerBit) + getTarget()->lutDelay() + getTarget()->localWireDelay() + getTarget()->lutDelay()
+				+ getTarget()->adderDelay(wOut);
+			if(delay > 1.0/getTarget()->frequency()) {
+				REPORT(DETAILED, "Not compressing table " << getName() << ": the compressed table and its adder would not fit in a cycle");
+				return false;
+			}
+		}
+
+		base = vector<mpz_class>(1<<(wIn-s), mpz_class(0));
+		correction = vector<mpz_class>(1<<wIn, mpz_class(0)); // don't care outside minIn..maxIn
+		for (int h = 0; h < (1<<(wIn-s)); h++) {
+			int first = max(h<<s, minIn);
+			int last = min(((h+1)<<s) - 1, maxIn);
+			if(first > last)
+				continue;
+			base[h] = values[first];
+			for (int x = first+1; x <= last; x++)
+				if(values[x] < base[h])
+					base[h] = values[x];
+			for (int x = first; x <= last; x++)
+				correction[x] = values[x] - base[h];
+		}
+
+		// Exhaustive check of the decomposition, modulo 2^wOut as the adder
+		mpz_class mask = (mpz_class(1) << wOut) - 1;
+		for (int x = minIn; x <= maxIn; x++) {
+			if(correction[x] >= (mpz_class(1) << wCorr)  ||  ((base[x>>s] + correction[x]) & mask) != (values[x] & mask)) {
+				REPORT(INFO, "WARNING: compression of table " << getName() << " failed its check at x=" << x << ", keeping the plain table");
+				return false;
+			}
+		}
+		REPORT(DETAILED, "Compressing table " << getName() << " as a " << wIn-s << "-input base table and a " << wCorr
+					 << "-bit correction table: estimated cost " << bestCost << " LUTs instead of " << plainCost);
+		return true;
+	}
+
+
+	void Table::outputCompressedVHDL(ostream& o, string name, int s, int wCorr, vector<mpz_class>& base, vector<mpz_class>& correction) {
+		licence(o);
+		o << "library ieee; " << endl;
+		o << "use ieee.std_logic_1164.all;" << endl;
+		o << "use ieee.numeric_std.all;" << endl;
+		o << "library work;" << endl;
+		outputVHDLEntity(o);
+		newArchitecture(o,name);
+		o << "signal XBase : std_logic_vector(" << wIn-s-1 << " downto 0);" << endl;
+		o << "signal TableBase : std_logic_vector(" << wOut-1 << " downto 0);" << endl;
+		o << "signal TableCorr : std_logic_vector(" << wCorr-1 << " downto 0);" << endl;
+		bool registered = !logicTable && isSequential(); // as the memory-block table above
+		if(registered)
+			o << "signal Y0 : std_logic_vector(" << wOut-1 << " downto 0);" << endl;
+		beginArchitecture(o);
+
+		o << tab << "XBase <= X" << range(wIn-1, s) << ";" << endl;
+		o << tab << "with XBase select  TableBase <= " << endl;
+		for (int h = (minIn>>s); h <= (maxIn>>s); h++)
+			o << tab << "\"" << unsignedBinary(base[h], wOut) << "\" when \"" << unsignedBinary(h, wIn-s) << "\"," << endl;
+		o << tab << "\"" << string(wOut, '-') << "\" when others;" << endl;
+
+		o << tab << "with X select  TableCorr <= " << endl;
+		for (int x = minIn; x <= maxIn; x++)
+			o << tab << "\"" << unsignedBinary(correction[x], wCorr) << "\" when \"" << unsignedBinary(x, wIn) << "\"," << endl;
+		o << tab << "\"" << string(wCorr, '-') << "\" when others;" << endl;
+
+		string sum = "std_logic_vector(unsigned(TableBase) + unsigned(TableCorr))";
+		if(registered) {
+			o << "	process(clk)" << endl;
+			o << tab << "begin" << endl;
+			o << tab << "if(rising_edge(clk)) then" << endl;
+			o << tab << "	Y0 <= " << sum << ";" << endl;
+			o << tab << "end if;" << endl;
+			o << tab << "end process;" << endl;
+			o << tab << " Y <= Y0;" << endl;
+		}
+		else
+			o << tab << " Y <= " << sum << ";" << endl;
+		endArchitecture(o);
+	}
+
 }
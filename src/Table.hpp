@@ -120,7 +120,24 @@ namespace flopoco{
 
 		/** A function that returns an estimation of the size of the table in LUTs. Your mileage may vary thanks to boolean optimization */
 		int size_in_LUTs();
+
+		/** The cost of a wIn-input, wOut-output table on the target, in LUTs.
+		 * A table that would go to memory blocks is counted as the LUTs that hold as many bits as these blocks. */
+		static double cost(Target* target, int wIn, int wOut);
+
+		/** true if the table is implemented as logic, false if it goes to memory blocks */
+		bool isLogicTable();
+
 	private:
+		/** Looks for the cheapest decomposition of the table as Y = base(X>>s) + correction(X), where base holds the minimum
+		 *  of each slice of 2^s values (difference-based compression, as Multipartite::compressedTIV does for the TIV).
+		 *  The decomposition is checked exhaustively against function().
+		 * @return true if a decomposition is cheaper than the plain table, then s, wCorr, base and correction describe it */
+		bool findCompression(int& s, int& wCorr, vector<mpz_class>& base, vector<mpz_class>& correction);
+
+		/** Outputs the architecture of the table compressed by findCompression() */
+		void outputCompressedVHDL(ostream& o, string name, int s, int wCorr, vector<mpz_class>& base, vector<mpz_class>& correction);
+
 		bool full; /**< true if there is no "don't care" inputs, i.e. minIn=0 and maxIn=2^wIn-1 */
 		bool logicTable; /**<  true: LUT-based table; false: BRAM-based */
 	};
@@ -26,6 +26,9 @@ namespace flopoco{
 
 	Target::Target()   {
 			generateFigures_=false;
+			retiming_=false;
+			tableCompression_=false;
+			tablePacking_=false;
 			lutInputs_         = 4;
 			hasHardMultipliers_= true;
 			hasFastLogicTernaryAdders_ = false;
@@ -77,6 +80,31 @@ namespace flopoco{
 		return lutInputs_;
 	}
 
+	int Target::muxSelectBits() {
+		int k=1;
+		while ((1<<(k+1)) + (k+1) <= lutInputs_)
+			k++;
+		int dedicated = (vendor_=="Xilinx" && lutInputs_>=6 ? 2 : 0); // F7 and F8
+		// a dedicated multiplexer level is only used if it selects faster than another stage of LUTs and its wires
+		int best=k;
+		for (int b=k+1; b<=k+dedicated; b++)
+			if ((muxDelay(b)+localWireDelay()) / b < (muxDelay(best)+localWireDelay()) / best)
+				best=b;
+		return best;
+	}
+
+	double Target::muxDelay(int selectBits) {
+		int lutSelectBits=1;
+		while ((1<<(lutSelectBits+1)) + (lutSelectBits+1) <= lutInputs_)
+			lutSelectBits++;
+		// beyond the select bits of a LUT, one level of dedicated multiplexers per bit
+		return lutDelay() + max(0, selectBits-lutSelectBits) * dedicatedMuxDelay();
+	}
+
+	double Target::dedicatedMuxDelay() {
+		return lutDelay();
+	}
+
 	double Target::frequency(){
 		return frequency_;
 	}
@@ -114,6 +142,30 @@ namespace flopoco{
 	  generateFigures_ = b;
 	}
 
+	bool  Target::retiming(){
+		return retiming_;
+	}
+
+	void  Target::setRetiming(bool v){
+		retiming_ = v;
+	}
+
+	bool  Target::tableCompression(){
+		return tableCompression_;
+	}
+
+	void  Target::setTableCompression(bool v){
+		tableCompression_ = v;
+	}
+
+	bool  Target::tablePacking(){
+		return tablePacking_;
+	}
+
+	void  Target::setTablePacking(bool v){
+		tablePacking_ = v;
+	}
+
 	bool Target::hasHardMultipliers(){
 		return hasHardMultipliers_ ;
 	}
@@ -122,6 +122,24 @@ namespace flopoco{
 		/** should flopoco generate SVG figures */
 		bool generateFigures();
 
+		/** should flopoco retime the pipelined operators after their construction */
+		bool retiming();
+
+		/** defines if flopoco should retime the pipelined operators after their construction */
+		void setRetiming(bool v);
+
+		/** should flopoco try to compress the large tables, see Table::findCompression() */
+		bool tableCompression();
+
+		/** defines if flopoco should try to compress the large tables */
+		void setTableCompression(bool v);
+
+		/** should flopoco pack the memory-block tables of an operator into shared memories, see Operator::packTables() */
+		bool tablePacking();
+
+		/** defines if flopoco should pack the memory-block tables of an operator into shared memories */
+		void setTablePacking(bool v);
+
 		/** should flopoco generate SVG figures */
 		void setGenerateFigures(bool b);
 
@@ -130,6 +148,25 @@ namespace flopoco{
 		 * @return the number of inputs for the look-up tables (LUTs) of the device
 		 */
 		int lutInputs();
+
+		/** Returns the number of select bits of the multiplexer to use in one logic level:
+		 * a 2^k:1 multiplexer fits in a LUT with 2^k+k inputs, and the F7 and F8 multiplexers of Xilinx 6-LUT slices may add two bits,
+		 * when they select faster than a second stage of LUTs (see dedicatedMuxDelay())
+		 * @return the number of select bits, at least 1
+		 */
+		int muxSelectBits();
+
+		/** Function which returns the delay of a multiplexer that fits in one logic level
+		 * @param[in] selectBits the number of select bits, at most muxSelectBits()
+		 * @return the delay of the multiplexer, without the wire delays
+		 */
+		double muxDelay(int selectBits);
+
+		/** Function which returns the delay of one level of the dedicated multiplexers that combine LUT outputs
+		 * (F7 and F8 on Xilinx 6-LUT slices). By default such a level is counted as a LUT
+		 * @return the delay of a dedicated multiplexer, without the wire delays
+		 */
+		virtual double dedicatedMuxDelay();
 	
 		/** Function for determining the submultiplication sizes so that the design is able 
 		 * to function at a desired frequency ( multiplicatio is considerd X * Y )
@@ -670,6 +707,9 @@ namespace flopoco{
 																		1 means: any sub-multiplier, even very small ones, go to DSP*/  
 		bool   plainVHDL_;     /**< True if we want the VHDL code to be concise and readable, with + and * instead of optimized FloPoCo operators. */
 		bool   generateFigures_;  /**< If true, some operators may generate some figures in SVG format */
+		bool   retiming_;         /**< If true, the register boundaries of pipelined operators are moved after construction to save registers, see Operator::retime() */
+		bool   tableCompression_; /**< If true, the large tables are implemented as a base table plus a correction table when it is cheaper */
+		bool   tablePacking_;     /**< If true, pairs of memory-block tables of an operator may share a dual-port memory */
 
 	};
 
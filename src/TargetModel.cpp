@@ -17,7 +17,7 @@ namespace flopoco {
 
 
 
-	TargetModel::TargetModel(Target* target, int type_) : Operator(target), type(type_) {
+	TargetModel::TargetModel(Target* target, int type_, int param_) : Operator(target), type(type_), param(param_) {
 		/* constructor of the TargetModel
 		   Target is the targeted FPGA : Stratix, Virtex ... (see Target.hpp for more informations)
 		*/
@@ -25,9 +25,21 @@ namespace flopoco {
 		// definition of the source file name, used for info and error reporting using REPORT 
 		srcFileName="TargetModel";
 
-		// definition of the name of the operator
+		if(param<1) {
+			THROWERROR("param should be strictly positive, got " << param);
+		}
+
+		// definition of the name of the operator: it is parsed back by tools/target-calibration.py
+		const char* typeNames[] = {"adder", "lutchain", "fanout", "eqcomparator", "dspchain", "ramread"};
+		if(type<0 || type>RAMRead) {
+			THROWERROR("unknown type " << type);
+		}
+		// The ROM content is enumerated in the VHDL: 2^20 words is already more than any block RAM
+		if(type==RAMRead && param>20) {
+			THROWERROR("for the block RAM read model, param is the address width and should be at most 20, got " << param);
+		}
 		ostringstream name;
-		name << "TargetModel";
+		name << "TargetModel_" << typeNames[type] << "_" << param;
 		setName(name.str());
 		// Copyright 
 		setCopyrightString("Florent de Dinechin");
@@ -38,14 +50,95 @@ namespace flopoco {
 		   n is an integer (int)   that stands for the length of the corresponding 
 		   input/output */
 
-		addInput ("X" , 32);
-		addInput ("Y" , 32);
-		addOutput("S" , 32);
-		if(type==0) {
-			// we first put the most significant bit of the result into R
-			REPORT(INFO, "Delay should be adderDelay(32) = " << target->adderDelay(32));
+		// The intermediate signals of the chains are marked keep, so that synthesis does not restructure the chain
+		if(type==Adder) {
+			addInput ("X" , param);
+			addInput ("Y" , param);
+			addOutput("S" , param);
+			REPORT(INFO, "Delay should be adderDelay(" << param << ") = " << target->adderDelay(param));
 			vhdl << tab << "S <= X+Y;" << endl;
 		}
+
+		else if(type==LUTChain) {
+			// each level is a LUT with one input from the previous level and lutInputs-1 fresh inputs
+			int k = target->lutInputs()-1;
+			addInput ("X" , param*k+1);
+			addOutput("R");
+			vhdl << tab << declare("L0") << " <= X" << of(param*k) << ";" << endl;
+			for(int i=1; i<=param; i++) {
+				vhdl << tab << declare(join("L",i)) << " <= " << join("L",i-1);
+				for(int j=0; j<k; j++)
+					vhdl << " xor X" << of((i-1)*k+j);
+				vhdl << ";" << endl;
+				addAttribute("keep", "string", join("L",i)+": signal", "true");
+			}
+			vhdl << tab << "R <= " << join("L",param) << ";" << endl;
+			REPORT(INFO, "Delay should be " << param << "*(lutDelay()+localWireDelay()) = " << param*(target->lutDelay()+target->localWireDelay()));
+		}
+
+		else if(type==Fanout) {
+			// one signal drives param LUTs
+			addInput ("A");
+			addInput ("B" , param);
+			addOutput("R" , param);
+			vhdl << tab << "R <= B xor " << rangeAssign(param-1, 0, "A") << ";" << endl;
+			REPORT(INFO, "Delay should be localWireDelay(" << param << ")+lutDelay() = " << target->localWireDelay(param)+target->lutDelay());
+		}
+
+		else if(type==EqComparator) {
+			addInput ("X" , param);
+			addInput ("Y" , param);
+			addOutput("R");
+			vhdl << tab << "R <= '1' when X=Y else '0';" << endl;
+			REPORT(INFO, "Delay should be eqComparatorDelay(" << param << ") = " << target->eqComparatorDelay(param));
+		}
+
+		else if(type==DSPChain) {
+			// param multiplications in sequence, each product being truncated to feed the next DSP
+			int wX, wY;
+			target->getDSPWidths(wX, wY);
+			addInput ("X" , wX);
+			for(int i=1; i<=param; i++)
+				addInput (join("Y",i), wY);
+			addOutput("R" , wX);
+			vhdl << tab << declare("P0", wX) << " <= X;" << endl;
+			for(int i=1; i<=param; i++) {
+				vhdl << tab << declare(join("Prod",i), wX+wY) << " <= " << join("P",i-1) << " * " << join("Y",i) << ";" << endl;
+				vhdl << tab << declare(join("P",i), wX) << " <= " << join("Prod",i) << range(wX+wY-1, wY) << ";" << endl;
+				addAttribute("keep", "string", join("P",i)+": signal", "true");
+			}
+			vhdl << tab << "R <= " << join("P",param) << ";" << endl;
+			REPORT(INFO, "Delay should be " << param << "*(LogicToDSPWireDelay()+DSPMultiplierDelay()+DSPToLogicWireDelay()) = " 
+						 << param*(target->LogicToDSPWireDelay()+target->DSPMultiplierDelay()+target->DSPToLogicWireDelay()));
+		}
+
+		else if(type==RAMRead) {
+			// a ROM of 2^param words with synchronous read, so that it is mapped to block RAM
+			setSequential();
+			useNumericStd_Unsigned();
+			int wOut = 16;
+			addInput ("X" , param);
+			addOutput("R" , wOut);
+			ostringstream content;
+			content << "array(0 to " << (1<<param)-1 << ") of std_logic_vector(" << wOut-1 << " downto 0)";
+			addType("ROMType", content.str());
+			ostringstream values;
+			values << "(";
+			for(int i=0; i<(1<<param); i++)
+				values << (i>0?", ":"") << "\"" << unsignedBinary(mpz_class((i*0x9E37+0x7F4A)&0xFFFF), wOut) << "\"";
+			values << ")";
+			addConstant("rom", "ROMType", values.str());
+			vhdl << tab << declare("Y", wOut) << " <= rom(TO_INTEGER(unsigned(X)));" << endl;
+			vhdl << tab << "process(clk)" << endl;
+			vhdl << tab << "begin" << endl;
+			vhdl << tab << tab << "if(rising_edge(clk)) then" << endl;
+			vhdl << tab << tab << tab << "R <= Y;" << endl;
+			vhdl << tab << tab << "end if;" << endl;
+			vhdl << tab << "end process;" << endl;
+			useHardRAM(this);
+			REPORT(INFO, "Delay should be LogicToRAMWireDelay()+RAMDelay()+RAMToLogicWireDelay() = " 
+						 << target->LogicToRAMWireDelay()+target->RAMDelay()+target->RAMToLogicWireDelay());
+		}
 	};
 
 
@@ -53,9 +146,10 @@ namespace flopoco {
 
 
 	OperatorPtr TargetModel::parseArguments(Target *target, vector<string> &args) {
-		 int type;
+		 int type, param;
 		 UserInterface::parseInt(args, "type", &type); // param0 has a default value, this method will recover it if it doesnt't find it in args, 
-		 return new TargetModel(target, type);
+		 UserInterface::parseStrictlyPositiveInt(args, "param", &param);
+		 return new TargetModel(target, type, param);
 	}
 	
 	void TargetModel::registerFactory(){
@@ -67,9 +161,10 @@ namespace flopoco {
 											 // Respect its syntax because it will be used to generate the parser and the docs
 											 // Syntax is: a semicolon-separated list of parameterDescription;
 											 // where parameterDescription is parameterName (parameterType)[=defaultValue]: parameterDescriptionString 
-											 "type(int)=0: when 0, build an adder of size 32",
+											 "type(int)=0: 0: adder, 1: chain of LUTs, 2: fanout, 3: equality comparator, 4: chain of DSPs, 5: block RAM read;\
+                        param(int)=32: size of the model: adder or comparator width, length of the chain, fanout, or RAM address width (at most 20)",
 											 // More documentation for the HTML pages. If you want to link to your blog, it is here.
-											 "This operator is for FloPoCo developers only. <br> Synthesize this operator, then look at its critical path. <br> Also see Target.hpp.",
+											 "This operator is for FloPoCo developers only. <br> Synthesize this operator, then look at its critical path. <br> Also see Target.hpp. <br> tools/target-calibration.py generates a family of such micro-benchmarks, and fits the parameters of a calibration file for target=Generic to their timing reports.",
 											 TargetModel::parseArguments
 											 ) ;
 	}
@@ -1,5 +1,8 @@
 /* This is a dummy operator that should be used to build a new Target.
 	 Syntesize it, then look at the critical path and transfer the obtained information in YourTarget.hpp and YourTarget.cpp  
+	 Its various types are micro-benchmarks, each isolating a few parameters of the delay model of Target.
+	 tools/target-calibration.py generates the whole family (wrapped between registers),
+	 then fits the parameters of a GenericTarget calibration file to the timing reports of their synthesis.
 */
 #include "Operator.hpp"
 
@@ -14,7 +17,14 @@ namespace flopoco {
 
 
 	public:
-		TargetModel(Target* target, int type);
+		/** The micro-benchmark types */
+		typedef enum {Adder=0, LUTChain=1, Fanout=2, EqComparator=3, DSPChain=4, RAMRead=5} ModelType;
+
+		/**
+		 * @param type  the type of micro-benchmark
+		 * @param param its size parameter: adder or comparator width, length of the LUT or DSP chain, fanout, RAM address width
+		 */
+		TargetModel(Target* target, int type, int param=32);
 
 		~TargetModel() {};
 
@@ -27,6 +37,7 @@ namespace flopoco {
 
 	private:
 		int type; /**< The type of feature we want to model. See the operator docstring for options */
+		int param; /**< The size parameter of the model */
 
 	};
 
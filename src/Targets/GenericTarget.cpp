@@ -0,0 +1,358 @@
+/*
+  A target whose delay and area parameters are read from a calibration file
+
+  This file is part of the FloPoCo project
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  All rights reserved.
+*/
+
+#include "GenericTarget.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "../utils.hpp"
+
+
+namespace flopoco{
+
+	GenericTarget::GenericTarget(string calibrationFile) : Target()	{
+		// Default values: these are those of the Virtex6 model
+		id_                     = "Generic";
+		vendor_                 = "Xilinx";
+		sizeOfBlock_            = 18432;
+		maxFrequencyMHz_        = 500;
+		lutInputs_              = 6;
+		hasHardMultipliers_     = true;
+		hasFastLogicTernaryAdders_ = false;
+		hasMemoryBlock_         = true;
+		multXInputs_            = 25;
+		multYInputs_            = 18;
+		nrDSPs_                 = 160;
+		dspFixedShift_          = 17;
+
+		lutDelay_               = 0.053e-9;
+		ffDelay_                = 0.268e-9;
+		carryPropagateDelay_    = 0.015e-9;
+		adderBaseDelay_         = 0.452e-9;
+		adder3BaseDelay_        = 0.452e-9;
+		eqComparatorBaseDelay_  = 0.272e-9;
+		elemWireDelay_          = 0.313e-9;
+		fanoutScale_            = 50;
+
+		DSPMultiplierDelay_     = 1.638e-9;
+		DSPAdderDelay_          = 1.769e-9;
+		DSPCascadingWireDelay_  = 0.365e-9;
+		DSPToLogicWireDelay_    = 0.436e-9;
+		LogicToDSPWireDelay_    = 0.436e-9;
+
+		RAMDelay_               = 1.591e-9;
+		RAMToLogicWireDelay_    = 0.235e-9;
+		LogicToRAMWireDelay_    = 0.235e-9;
+
+		topSliceX               = 169;
+		topSliceY               = 359;
+		lutPerSlice             = 4;
+		ffPerSlice              = 8;
+		dspHeightInLUT          = 3;
+		ramHeightInLUT          = 5;
+		dspPerColumn            = 143;
+		ramPerColumn            = 71;
+
+		buildKeyTables();
+		readCalibrationFile(calibrationFile);
+	}
+
+
+	void GenericTarget::buildKeyTables() {
+		stringKeys_["id"]                     = &id_;
+		stringKeys_["vendor"]                 = &vendor_;
+
+		boolKeys_["hasHardMultipliers"]       = &hasHardMultipliers_;
+		boolKeys_["hasFastLogicTernaryAdders"] = &hasFastLogicTernaryAdders_;
+		boolKeys_["hasMemoryBlock"]           = &hasMemoryBlock_;
+
+		intKeys_["lutInputs"]                 = &lutInputs_;
+		intKeys_["multXInputs"]               = &multXInputs_;
+		intKeys_["multYInputs"]               = &multYInputs_;
+		intKeys_["nrDSPs"]                    = &nrDSPs_;
+		intKeys_["dspFixedShift"]             = &dspFixedShift_;
+		intKeys_["topSliceX"]                 = &topSliceX;
+		intKeys_["topSliceY"]                 = &topSliceY;
+		intKeys_["lutPerSlice"]               = &lutPerSlice;
+		intKeys_["ffPerSlice"]                = &ffPerSlice;
+		intKeys_["dspHeightInLUT"]            = &dspHeightInLUT;
+		intKeys_["ramHeightInLUT"]            = &ramHeightInLUT;
+		intKeys_["dspPerColumn"]              = &dspPerColumn;
+		intKeys_["ramPerColumn"]              = &ramPerColumn;
+
+		longKeys_["sizeOfBlock"]              = &sizeOfBlock_;
+
+		realKeys_["maxFrequencyMHz"]          = &maxFrequencyMHz_;
+		realKeys_["fanoutScale"]              = &fanoutScale_;
+
+		delayKeys_["lutDelay"]                = &lutDelay_;
+		delayKeys_["ffDelay"]                 = &ffDelay_;
+		delayKeys_["carryPropagateDelay"]     = &carryPropagateDelay_;
+		delayKeys_["adderBaseDelay"]          = &adderBaseDelay_;
+		delayKeys_["adder3BaseDelay"]         = &adder3BaseDelay_;
+		delayKeys_["eqComparatorBaseDelay"]   = &eqComparatorBaseDelay_;
+		delayKeys_["elemWireDelay"]           = &elemWireDelay_;
+		delayKeys_["DSPMultiplierDelay"]      = &DSPMultiplierDelay_;
+		delayKeys_["DSPAdderDelay"]           = &DSPAdderDelay_;
+		delayKeys_["DSPCascadingWireDelay"]   = &DSPCascadingWireDelay_;
+		delayKeys_["DSPToLogicWireDelay"]     = &DSPToLogicWireDelay_;
+		delayKeys_["LogicToDSPWireDelay"]     = &LogicToDSPWireDelay_;
+		delayKeys_["RAMDelay"]                = &RAMDelay_;
+		delayKeys_["RAMToLogicWireDelay"]     = &RAMToLogicWireDelay_;
+		delayKeys_["LogicToRAMWireDelay"]     = &LogicToRAMWireDelay_;
+	}
+
+
+	void GenericTarget::readCalibrationFile(string calibrationFile) {
+		ifstream file(calibrationFile.c_str());
+		if(!file.is_open())
+			throw("ERROR in GenericTarget: cannot open calibration file " + calibrationFile);
+
+		string line;
+		int lineNumber=0;
+		bool versionSeen=false;
+		while(getline(file, line)) {
+			lineNumber++;
+			ostringstream where;
+			where << calibrationFile << ":" << lineNumber << ": ";
+			// remove the comments and the surrounding blanks
+			size_t pos = line.find('#');
+			if(pos != string::npos)
+				line = line.substr(0, pos);
+			size_t first = line.find_first_not_of(" \t\r");
+			if(first == string::npos)
+				continue;
+			line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+
+			if(!versionSeen) {
+				istringstream header(line);
+				string magic;
+				int version;
+				if(!(header >> magic >> version) || magic != "FloPoCoTarget")
+					throw("ERROR in GenericTarget: " + where.str() + "expecting FloPoCoTarget <version>");
+				if(version > calibrationFileVersion) {
+					ostringstream e;
+					e << "ERROR in GenericTarget: " << where.str() << "calibration file version " << version
+					  << " is newer than the supported version " << calibrationFileVersion;
+					throw(e.str());
+				}
+				versionSeen=true;
+				continue;
+			}
+
+			pos = line.find('=');
+			if(pos == string::npos)
+				throw("ERROR in GenericTarget: " + where.str() + "expecting key = value");
+			string key = line.substr(0, pos);
+			key = key.substr(0, key.find_last_not_of(" \t") + 1);
+			istringstream value(line.substr(pos+1));
+			bool ok;
+			if(delayKeys_.find(key) != delayKeys_.end()) {
+				double d;
+				ok = bool(value >> d);
+				*delayKeys_[key] = d*1e-9;
+			}
+			else if(realKeys_.find(key) != realKeys_.end())
+				ok = bool(value >> *realKeys_[key]);
+			else if(intKeys_.find(key) != intKeys_.end())
+				ok = bool(value >> *intKeys_[key]);
+			else if(longKeys_.find(key) != longKeys_.end())
+				ok = bool(value >> *longKeys_[key]);
+			else if(boolKeys_.find(key) != boolKeys_.end())
+				ok = bool(value >> *boolKeys_[key]);
+			else if(stringKeys_.find(key) != stringKeys_.end())
+				ok = bool(value >> *stringKeys_[key]);
+			else
+				throw("ERROR in GenericTarget: " + where.str() + "unknown key " + key);
+			if(!ok)
+				throw("ERROR in GenericTarget: " + where.str() + "could not read the value of " + key);
+		}
+		if(!versionSeen)
+			throw("ERROR in GenericTarget: calibration file " + calibrationFile + " is empty");
+	}
+
+
+	void GenericTarget::writeCalibrationFile(ostream& o) {
+		o << "FloPoCoTarget " << calibrationFileVersion << endl;
+		o << "# Delays are in ns" << endl;
+		for(auto it: stringKeys_)
+			o << it.first << " = " << *it.second << endl;
+		for(auto it: boolKeys_)
+			o << it.first << " = " << *it.second << endl;
+		for(auto it: intKeys_)
+			o << it.first << " = " << *it.second << endl;
+		for(auto it: longKeys_)
+			o << it.first << " = " << *it.second << endl;
+		for(auto it: realKeys_)
+			o << it.first << " = " << *it.second << endl;
+		for(auto it: delayKeys_)
+			o << it.first << " = " << *it.second*1e9 << endl;
+	}
+
+
+	double GenericTarget::adderDelay(int size) {
+		return adderBaseDelay_ + double(size-1)*carryPropagateDelay_;
+	};
+
+	double GenericTarget::adder3Delay(int size) {
+		return adder3BaseDelay_ + double(size-1)*carryPropagateDelay_;
+	};
+
+	void GenericTarget::getAdderParameters(double &k1, double &k2, int size){
+		k1 = adderBaseDelay_;
+		k2 = carryPropagateDelay_;
+	}
+
+	double GenericTarget::eqComparatorDelay(int size){
+		return eqComparatorBaseDelay_ + double((size-1)/(lutInputs_/2)+1)*carryPropagateDelay_;
+	}
+
+	double GenericTarget::eqConstComparatorDelay(int size){
+		return eqComparatorBaseDelay_ + double((size-1)/lutInputs_+1)*carryPropagateDelay_;
+	}
+
+	double GenericTarget::ffDelay() {
+		return ffDelay_;
+	};
+
+	double GenericTarget::carryPropagateDelay() {
+		return carryPropagateDelay_;
+	};
+
+	double GenericTarget::localWireDelay(int fanout){
+		return elemWireDelay_*(1+double(fanout)/fanoutScale_);
+	};
+
+	double GenericTarget::distantWireDelay(int n){
+		return n*elemWireDelay_;
+	};
+
+	double GenericTarget::lutDelay(){
+		return lutDelay_;
+	};
+
+	long GenericTarget::sizeOfMemoryBlock()
+	{
+		return sizeOfBlock_;
+	};
+
+
+	DSP* GenericTarget::createDSP()
+	{
+		int x, y;
+		getDSPWidths(x, y);
+		return new DSP(dspFixedShift_, x, y);
+	};
+
+	bool GenericTarget::suggestSubmultSize(int &x, int &y, int wInX, int wInY){
+		getDSPWidths(x, y);
+		if (wInX <= x)
+			x = wInX;
+		if (wInY <= y)
+			y = wInY;
+		return true;
+	}
+
+	bool GenericTarget::suggestSubaddSize(int &x, int wIn){
+		return suggestSlackSubaddSize(x, wIn, ffDelay() + localWireDelay());
+	};
+
+	bool GenericTarget::suggestSlackSubaddSize(int &x, int wIn, double slack){
+		int chunkSize = 1 + (int)floor( (1./frequency() - slack - adderBaseDelay_) / carryPropagateDelay_ );
+		x = min(chunkSize, wIn);
+		if (x > 0)
+			return true;
+		else {
+			x = min(2,wIn);
+			return false;
+		}
+	};
+
+	bool GenericTarget::suggestSubadd3Size(int &x, int wIn){
+		return suggestSlackSubadd3Size(x, wIn, ffDelay() + localWireDelay());
+	};
+
+	bool GenericTarget::suggestSlackSubadd3Size(int &x, int wIn, double slack){
+		if(!hasFastLogicTernaryAdders_)
+			return false;
+		int chunkSize = 1 + (int)floor( (1./frequency() - slack - adder3BaseDelay_) / carryPropagateDelay_ );
+		x = min(chunkSize, wIn);
+		if (x > 0)
+			return true;
+		else {
+			x = min(2,wIn);
+			return false;
+		}
+	};
+
+	bool GenericTarget::suggestSlackSubcomparatorSize(int& x, int wIn, double slack, bool constant)
+	{
+		bool succes = true;
+		int bitsPerCarry = (constant ? lutInputs_ : lutInputs_/2);
+		x = bitsPerCarry*(((1./frequency() - slack) - eqComparatorBaseDelay_)/carryPropagateDelay_ - 1)+1;
+		if (x<lutInputs_){ //capture possible negative values
+			x = lutInputs_;
+			succes = false;
+		}
+		if (x> wIn)//saturation
+			x = wIn;
+		return succes;
+	}
+
+	int GenericTarget::getIntMultiplierCost(int wInX, int wInY){
+		// sub-products of (lutInputs/2)x(lutInputs/2) bits, each costing lutInputs LUTs,
+		// summed by an adder tree of about one LUT per bit per operand
+		int halfLut = lutInputs_/2;
+		int cx = int(ceil((double) wInX/halfLut));
+		int cy = int(ceil((double) wInY/halfLut));
+		return cx*cy*lutInputs_ + (cx*cy-1)*(wInX+wInY)/2;
+	};
+
+	void GenericTarget::getDSPWidths(int &x, int &y, bool sign){
+		if (sign){
+			x = multXInputs_;
+			y = multYInputs_;
+		}else{ // the DSP inputs are signed
+			x = multXInputs_-1;
+			y = multYInputs_-1;
+		}
+	}
+
+	int GenericTarget::getEquivalenceSliceDSP(){
+		int x, y;
+		getDSPWidths(x,y);
+		return getIntMultiplierCost(x, y);
+	}
+
+	int GenericTarget::getNumberOfDSPs()
+	{
+		return nrDSPs_;
+	};
+
+	int GenericTarget::getIntNAdderCost(int wIn, int n)
+	{
+		// n-1 adders of one LUT per bit, plus the registers of the chunked pipelined additions
+		int chunkSize;
+		suggestSubaddSize(chunkSize, wIn);
+		int nr = ceil((double) wIn/chunkSize);
+		return (n-1)*wIn + (n-1)*(nr-1)*wIn/2;
+	}
+
+	void GenericTarget::delayForDSP(MultiplierBlock* multBlock, double currentCp, int& cycleDelay, double& cpDelay)
+	{
+		double targetPeriod, totalPeriod;
+
+		targetPeriod = 1.0/frequency();
+		totalPeriod = currentCp + DSPMultiplierDelay_;
+
+		cycleDelay = floor(totalPeriod/targetPeriod);
+		cpDelay = totalPeriod-targetPeriod*cycleDelay;
+	}
+}
@@ -0,0 +1,123 @@
+#ifndef GenericTarget_HPP
+#define GenericTarget_HPP
+#include "../Target.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <math.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <gmpxx.h>
+
+
+namespace flopoco{
+
+	/** Class for representing a target whose parameters are read from a calibration file.
+	 * The delay model is that of a carry-chain FPGA: an adder of size n has delay
+	 * adderBaseDelay + (n-1)*carryPropagateDelay, a local wire has delay
+	 * elemWireDelay*(1+fanout/fanoutScale), etc.
+	 * This allows to calibrate a device and speed grade without recompiling FloPoCo.
+	 *
+	 * The calibration file is a text file. Its first non-comment line must be
+	 *    FloPoCoTarget <version>
+	 * and the following lines are of the form
+	 *    key = value
+	 * Everything after a # is a comment. Delays are given in ns.
+	 * Keys that are not present keep their default value (roughly a Virtex-6).
+	 * An unknown key is an error, to catch typos.
+	 */
+	class GenericTarget : public Target
+	{
+	public:
+		/** The constructor.
+		 * @param calibrationFile the name of the calibration file */
+		GenericTarget(string calibrationFile);
+
+		/** The destructor */
+		virtual ~GenericTarget() {}
+
+		/** The version of the calibration file format that this class reads */
+		static const int calibrationFileVersion = 1;
+
+		/** Writes the current parameters in the calibration file format (useful to start a new calibration) */
+		void writeCalibrationFile(ostream& o);
+
+		/** overloading the virtual functions of Target
+		 * @see the target class for more details
+		 */
+		double carryPropagateDelay();
+		double adderDelay(int size);
+		double adder3Delay(int size);
+		double eqComparatorDelay(int size);
+		double eqConstComparatorDelay(int size);
+
+		double DSPMultiplierDelay(){ return DSPMultiplierDelay_;}
+		double DSPAdderDelay(){ return DSPAdderDelay_;}
+		double DSPCascadingWireDelay(){ return DSPCascadingWireDelay_;}
+		double DSPToLogicWireDelay(){ return DSPToLogicWireDelay_;}
+		double LogicToDSPWireDelay(){ return LogicToDSPWireDelay_;}
+		void   delayForDSP(MultiplierBlock* multBlock, double currentCp, int& cycleDelay, double& cpDelay);
+
+		double RAMDelay() { return RAMDelay_; }
+		double RAMToLogicWireDelay() { return RAMToLogicWireDelay_; }
+		double LogicToRAMWireDelay() { return LogicToRAMWireDelay_; }
+
+		void   getAdderParameters(double &k1, double &k2, int size);
+		double localWireDelay(int fanout = 1);
+		double lutDelay();
+		double ffDelay();
+		double distantWireDelay(int n);
+		bool   suggestSubmultSize(int &x, int &y, int wInX, int wInY);
+		bool   suggestSubaddSize(int &x, int wIn);
+		bool   suggestSubadd3Size(int &x, int wIn);
+		bool   suggestSlackSubaddSize(int &x, int wIn, double slack);
+		bool   suggestSlackSubadd3Size(int &x, int wIn, double slack);
+		bool   suggestSlackSubcomparatorSize(int &x, int wIn, double slack, bool constant);
+
+		int    getIntMultiplierCost(int wInX, int wInY);
+		long   sizeOfMemoryBlock();
+		DSP*   createDSP();
+		int    getEquivalenceSliceDSP();
+		int    getNumberOfDSPs();
+		void   getDSPWidths(int &x, int &y, bool sign = false);
+		int    getIntNAdderCost(int wIn, int n);
+
+	private:
+		/** Builds the tables that associate the keys of the calibration file to the attributes */
+		void buildKeyTables();
+
+		/** Reads the calibration file, overwriting the default values */
+		void readCalibrationFile(string calibrationFile);
+
+		map<string, double*> delayKeys_;  /**< keys of the delays (given in ns in the file, stored in s) */
+		map<string, double*> realKeys_;   /**< keys of the other real-valued parameters */
+		map<string, int*>    intKeys_;    /**< keys of the integer parameters */
+		map<string, long*>   longKeys_;   /**< keys of the long integer parameters */
+		map<string, bool*>   boolKeys_;   /**< keys of the boolean parameters */
+		map<string, string*> stringKeys_; /**< keys of the string parameters */
+
+		double lutDelay_;              /**< The delay of a LUT */
+		double ffDelay_;               /**< The clock-to-output delay plus the setup delay of a flip-flop */
+		double carryPropagateDelay_;   /**< The delay of one bit of the fast carry chain */
+		double adderBaseDelay_;        /**< The delay of an adder, excluding the carry propagation */
+		double adder3BaseDelay_;       /**< The delay of a ternary adder, excluding the carry propagation (when hasFastLogicTernaryAdders) */
+		double eqComparatorBaseDelay_; /**< The delay of an equality comparator, excluding the carry propagation */
+		double elemWireDelay_;         /**< The elementary wire delay (for computing the distant wire delay) */
+		double fanoutScale_;           /**< The fanout that doubles the local wire delay */
+		int nrDSPs_;                   /**< Number of available DSPs on this target */
+		int dspFixedShift_;            /**< The amount by which the DSP block can shift an input to the ALU */
+
+		double DSPMultiplierDelay_;
+		double DSPAdderDelay_;
+		double DSPCascadingWireDelay_;
+		double DSPToLogicWireDelay_;
+		double LogicToDSPWireDelay_;
+
+		double RAMDelay_;
+		double RAMToLogicWireDelay_;
+		double LogicToRAMWireDelay_;
+	};
+
+}
+#endif
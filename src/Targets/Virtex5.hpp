@@ -110,6 +110,7 @@ namespace flopoco{
 		double localWireDelay(int fanout = 1);
 		double lutDelay();
 		double ffDelay();
+		double dedicatedMuxDelay() { return muxf5_; } // F7 and F8
 		double distantWireDelay(int n);
 		bool   suggestSubmultSize(int &x, int &y, int wInX, int wInY);
 		bool   suggestSubaddSize(int &x, int wIn);
@@ -48,10 +48,13 @@ namespace flopoco{
 		//        maybe best to be placed in main.cpp ?
                 FloPoCoRandomState::init(n);
 		// Generate the standard and random test cases for this operator
-		op-> buildStandardTestCases(&tcl_);
-                // initialization of randomstate generator with the seed base on the number of
-                // randomtestcase to be generated
-		if (!fromFile) op-> buildRandomTestCaseList(&tcl_, n);
+		{
+			Profiler::Scope p("test case generation", op->getName());
+			op-> buildStandardTestCases(&tcl_);
+			// initialization of randomstate generator with the seed base on the number of
+			// randomtestcase to be generated
+			if (!fromFile) op-> buildRandomTestCaseList(&tcl_, n);
+		}
 
 
 		// The instance
@@ -90,6 +93,7 @@ namespace flopoco{
 		vhdl << tab << "end process;" <<endl;
 		vhdl << endl;
 
+		Profiler::Scope p("test bench generation", op->getName());
 		if (fromFile) generateTestFromFile();
 		else generateTestInVhdl();
 	}
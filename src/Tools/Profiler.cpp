@@ -0,0 +1,228 @@
+/*
+  Profiling of the generator itself (not of the generated hardware)
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  2008-2015.
+  All rights reserved.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <sys/resource.h>
+
+#include "Profiler.hpp"
+
+
+// Counting the allocations: the global operator new is replaced by a counting one.
+// It only counts when the profiling is enabled, so that the other runs only pay a test.
+// Profiler::enabled is set while parsing the options, before any thread is started.
+// The counters are atomic since a few searches are multi-threaded: the allocations of the worker threads
+// are counted in the event that encloses them.
+static std::atomic<long> nbAllocations(0);
+static std::atomic<long> nbAllocatedBytes(0);
+
+void* operator new(size_t size) {
+	if(flopoco::Profiler::enabled) {
+		nbAllocations.fetch_add(1, std::memory_order_relaxed);
+		nbAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+	void* p = malloc(size==0 ? 1 : size);
+	if(p==NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+
+namespace flopoco{
+
+	bool Profiler::enabled = false;
+	vector<Profiler::Event> Profiler::events;
+
+	static const std::chrono::steady_clock::time_point startOfTime = std::chrono::steady_clock::now();
+
+	// The events may be added by several threads
+	static std::mutex eventsMutex;
+	// the threads, numbered in the order of their first event; the main thread is 0
+	static const std::thread::id mainThread = std::this_thread::get_id();
+	static map<std::thread::id, int> threadNumbers;
+	static int nbWorkerThreads = 0;
+
+
+	double Profiler::now() {
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startOfTime).count();
+	}
+
+	long Profiler::allocations() {
+		return nbAllocations;
+	}
+
+	long Profiler::allocatedBytes() {
+		return nbAllocatedBytes;
+	}
+
+
+	void Profiler::addEvent(string name, string detail, double start, long allocations, long bytes) {
+		if(!enabled)
+			return;
+		Event e;
+		e.name = name;
+		e.detail = detail;
+		e.start = start;
+		e.duration = now() - start;
+		e.allocations = nbAllocations - allocations;
+		e.bytes = nbAllocatedBytes - bytes;
+		std::lock_guard<std::mutex> lock(eventsMutex);
+		std::thread::id id = std::this_thread::get_id();
+		if(threadNumbers.find(id)==threadNumbers.end())
+			threadNumbers[id] = (id==mainThread ? 0 : ++nbWorkerThreads);
+		e.thread = threadNumbers[id];
+		events.push_back(e);
+	}
+
+
+	Profiler::Scope::Scope(string name, string detail) {
+		if(!enabled)
+			return;
+		name_ = name;
+		detail_ = detail;
+		allocations_ = nbAllocations;
+		bytes_ = nbAllocatedBytes;
+		start_ = now();
+	}
+
+	Profiler::Scope::~Scope() {
+		if(!enabled)
+			return;
+		addEvent(name_, detail_, start_, allocations_, bytes_);
+	}
+
+
+
+	// A node of the hierarchical profile: all the events of the same name under the same parent
+	typedef struct ProfileNode {
+		string name;
+		int calls;
+		double total;
+		long allocations;
+		long bytes;
+		vector<ProfileNode*> children;
+	} ProfileNode;
+
+	static void printProfileNode(ostream& o, ProfileNode* n, int level, double wallTime) {
+		double childrenTotal = 0;
+		for (auto c: n->children)
+			childrenTotal += c->total;
+		o << setw(10) << n->total/1000 << " ms" << setw(10) << (n->total-childrenTotal)/1000 << " ms"
+			<< setw(6) << 100*n->total/wallTime << "%"
+			<< setw(9) << n->calls
+			<< setw(11) << n->allocations
+			<< setw(10) << n->bytes/1048576.0 << " MB   "
+			<< string(2*level, ' ') << n->name << endl;
+		// most expensive first
+		sort(n->children.begin(), n->children.end(), [](ProfileNode* a, ProfileNode* b) {return a->total > b->total;});
+		for (auto c: n->children)
+			printProfileNode(o, c, level+1, wallTime);
+	}
+
+	static void deleteProfileNode(ProfileNode* n) {
+		for (auto c: n->children)
+			deleteProfileNode(c);
+		delete n;
+	}
+
+
+	void Profiler::outputTextReport(ostream& o) {
+		double wallTime = now();
+		vector<Event> sorted = events;
+		// parents before children
+		sort(sorted.begin(), sorted.end(), [](const Event& a, const Event& b) {
+				return (a.start < b.start) || (a.start == b.start && a.duration > b.duration);});
+
+		ProfileNode* root = new ProfileNode{"total", 1, wallTime, nbAllocations, nbAllocatedBytes, {}};
+		// Events nest in time within a thread. The outermost events of a worker thread are children
+		// of the innermost event of the main thread that encloses them, typically the search that started the thread
+		map<int, vector<pair<double, ProfileNode*>>> stacks; // per thread, (end time, node) of the enclosing events
+		for (auto e: sorted) {
+			double end = e.start + e.duration;
+			vector<pair<double, ProfileNode*>>& stack = stacks[e.thread];
+			while(!stack.empty() && end > stack.back().first)
+				stack.pop_back();
+			ProfileNode* parent = (stack.empty() ? root : stack.back().second);
+			if(stack.empty() && e.thread!=0) {
+				vector<pair<double, ProfileNode*>>& mainStack = stacks[0];
+				for (auto i=mainStack.rbegin(); i!=mainStack.rend(); i++)
+					if(end <= i->first) {
+						parent = i->second;
+						break;
+					}
+			}
+			ProfileNode* node = NULL;
+			for (auto c: parent->children)
+				if(c->name == e.name)
+					node = c;
+			if(node==NULL) {
+				node = new ProfileNode{e.name, 0, 0, 0, 0, {}};
+				parent->children.push_back(node);
+			}
+			node->calls++;
+			node->total += e.duration;
+			node->allocations += e.allocations;
+			node->bytes += e.bytes;
+			stack.push_back(make_pair(end, node));
+		}
+
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		o << "Generator profile (" << events.size() << " events, peak resident memory " << usage.ru_maxrss/1024 << " MB)" << endl;
+		o << "     total          self         calls  allocations     allocated   phase" << endl;
+		o << fixed << setprecision(2);
+		printProfileNode(o, root, 0, wallTime);
+		o << defaultfloat;
+		deleteProfileNode(root);
+	}
+
+
+	static string jsonEscape(string s) {
+		ostringstream o;
+		for (char c: s) {
+			if(c=='"' || c=='\\')
+				o << '\\' << c;
+			else if(c=='\n')
+				o << "\\n";
+			else
+				o << c;
+		}
+		return o.str();
+	}
+
+	void Profiler::outputChromeTrace(ostream& o) {
+		o << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+		for (size_t i=0; i<events.size(); i++) {
+			Event& e = events[i];
+			o << (i==0 ? "" : ",") << endl
+				<< "{\"name\": \"" << jsonEscape(e.name) << "\", \"cat\": \"flopoco\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << e.thread+1
+				<< ", \"ts\": " << fixed << setprecision(3) << e.start << ", \"dur\": " << e.duration << defaultfloat
+				<< ", \"args\": {\"detail\": \"" << jsonEscape(e.detail) << "\", \"allocations\": " << e.allocations
+				<< ", \"bytes\": " << e.bytes << "}}";
+		}
+		o << endl << "]}" << endl;
+	}
+
+}
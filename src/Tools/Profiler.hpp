@@ -0,0 +1,90 @@
+/*
+  Profiling of the generator itself (not of the generated hardware)
+
+  Author: FloPoCo developers (2026)
+
+  This file is part of the FloPoCo project
+
+  Initial software.
+  Copyright © ENS-Lyon, INRIA, CNRS, UCBL,
+  2008-2015.
+  All rights reserved.
+*/
+
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace flopoco{
+
+	/** The Profiler records where the generator spends its time and memory (option profile=1).
+	 * Each measured phase is an event with a start time, a duration, and the number and size
+	 * of the C++ allocations (operator new) performed during it.
+	 * Events may be recorded by a Profiler::Scope object (from its construction to its destruction)
+	 * or explicitely by addEvent(): this is how the operator constructors are measured,
+	 * from Operator::Operator() to the instance() of the operator in its parent.
+	 * The events nest in time within each thread: the text report is the tree of the events, with the events of the same
+	 * name merged under a given parent; the Chrome trace (chrome://tracing, Perfetto) shows each event.
+	 * The allocations of the C libraries (sollya, mpfr) are not counted, the peak resident memory is reported instead.
+	 */
+	class Profiler
+	{
+	public:
+		/** An event: a measured phase of the generation */
+		typedef struct {
+			string name;       /**< the name of the phase, e.g. parse2, or the class of an operator */
+			string detail;     /**< more information, e.g. the name of the operator (only in the Chrome trace) */
+			double start;      /**< in microseconds since the start of the program */
+			double duration;   /**< in microseconds */
+			long allocations;  /**< number of calls to operator new */
+			long bytes;        /**< bytes allocated by operator new */
+			int thread;        /**< the thread that recorded the event, 0 for the main thread */
+		} Event;
+
+		/** A scoped timer: measures the phase from its construction to its destruction.
+		 * Costs nothing but a test when the profiling is disabled */
+		class Scope
+		{
+		public:
+			Scope(string name, string detail="");
+			~Scope();
+		private:
+			string name_;
+			string detail_;
+			double start_;
+			long allocations_;
+			long bytes_;
+		};
+
+		/** The current time, in microseconds since the start of the program */
+		static double now();
+
+		/** The number of calls to operator new since the start of the program */
+		static long allocations();
+
+		/** The number of bytes allocated by operator new since the start of the program */
+		static long allocatedBytes();
+
+		/** Records an event (does nothing if the profiling is disabled). May be called by several threads */
+		static void addEvent(string name, string detail, double start, long allocations, long bytes);
+
+		/** Outputs the hierarchical profile as text */
+		static void outputTextReport(ostream& o);
+
+		/** Outputs the events in the Chrome trace event format (JSON) */
+		static void outputChromeTrace(ostream& o);
+
+		static bool enabled;   /**< set by the profile option */
+
+	private:
+		static vector<Event> events;
+	};
+
+}
+#endif
@@ -17,8 +17,8 @@ namespace flopoco{
 	//The wIn+1 below is for consistency with FixSinCos and FixSinOrCos interfaces.
 	// TODO possibly fix all the code instead... This would enable sharing emulate() etc.
  
-	CordicSinCos::CordicSinCos(Target* target, int wIn_, int wOut_, int reducedIterations_, map<string, double> inputDelays) 
-		: Operator(target), wIn(wIn_+1), wOut(wOut_+1), reducedIterations(reducedIterations_)
+	CordicSinCos::CordicSinCos(Target* target, int wIn_, int wOut_, int reducedIterations_, int radix_, map<string, double> inputDelays) 
+		: Operator(target), wIn(wIn_+1), wOut(wOut_+1), reducedIterations(reducedIterations_), radix(radix_)
 	{
 
 		int stage;
@@ -26,7 +26,7 @@ namespace flopoco{
 		setCopyrightString ( "Matei Istoan, Florent de Dinechin (2012-...)" );
 
 		ostringstream name;
-		name << "CordicSinCos_" << (reducedIterations==1?"reducedIterations":"") << wIn_ << "_" << wOut_;
+		name << "CordicSinCos_" << (reducedIterations==1?"reducedIterations":"") << (radix==4?"radix4_":"") << wIn_ << "_" << wOut_;
 		if(target->isPipelined())
 			name  <<"_f" << target->frequencyMHz();
 		else 
@@ -38,8 +38,20 @@ namespace flopoco{
 			REPORT(INFO, "wIn is small, are you sure you don't want to tabulate this operator in a ROM?");
 		}
 
+		if(radix!=2 && radix!=4) {
+			THROWERROR("radix should be 2 or 4, got " << radix);
+		}
+		if(radix==4 && reducedIterations==1) {
+			THROWERROR("radix=4 and reducedIterations=1 are two alternative ways of finishing the rotation, choose one");
+		}
+		if(radix==4 && wOut<8) {
+			THROWERROR("radix=4 only makes sense for wOut>=8");
+		}
+
 		if (reducedIterations == 1)
 			maxIterations=(wOut>>1)+1;
+		else if (radix == 4)
+			maxIterations=(wOut+3)>>1; // so that the remaining angle theta satisfies theta^2 < 2^-(wOut+2)
 		else
 			maxIterations = wOut+1;
 		
@@ -49,28 +61,54 @@ namespace flopoco{
 		REPORT(DEBUG, "Using rounded rotation trick");
 #endif
 
+		// Method error, when the rotation by the remaining angle theta is approximated:
+		// cos(theta) replaced with 1 and sin(theta) with theta, where theta < atan(2^-maxIterations).
+		// In radix 4, the rotations by the digits of theta are applied one after the other, which adds second-order terms.
+		double methodError=0;
+		if(reducedIterations==1 || radix==4) {
+			double theta = atan(pow(2.0, -maxIterations));
+			methodError = theta*theta/2 + theta*theta*theta/6;
+			if(radix==4)
+				methodError += theta*theta/2;
+		}
+
 		//error analysis
 		double eps;  //error in ulp
-		eps=0.5; //initial rounding of kfactor
-		double shift=0.5;
-		for(stage=1; stage<=maxIterations; stage++){
+		// The rounding errors, in ulps of weight 2^-w, and the method error should fit in half an ulp of the output,
+		// the other half being for the final rounding.
+		// In radix 4, the number of rotations depends on w, hence on g: look for the smallest g that works.
+		for(g=1; ; g++) {
+			w = wOut-1 + g;
+			eps=0.5; //initial rounding of kfactor
+			double shift=0.5;
+			for(stage=1; stage<=maxIterations; stage++){
 #if ROUNDED_ROTATION
-			eps = eps + eps*shift + 0.5; // 0.5 assume rounding in the rotation.
+				eps = eps + eps*shift + 0.5; // 0.5 assume rounding in the rotation.
 #else
-			eps = eps + eps*shift + 1.0; // 1.0 assume truncation in the rotation.
+				eps = eps + eps*shift + 1.0; // 1.0 assume truncation in the rotation.
 #endif
-			shift *=0.5;
-		}
+				shift *=0.5;
+			}
 
-		if (reducedIterations == 1) {
-			eps+=2; // two multiplications in sequence, each truncated
-		}
+			if (reducedIterations == 1) {
+				// two multiplications in sequence: the truncated product (1 ulp), the faithful Pi*Z multiplied by |cos|<=1 (0.5 ulp),
+				// and the truncation of Cos and Sin to the size of Z multiplied by Pi*Z (0.25 ulp)
+				eps+=1.75;
+			}
 
-		eps+=1; // the final neg-by-not
-		REPORT(DEBUG, "Error analysis computes eps=" << eps << " ulps (before final rounding)");
+			if (radix == 4) {
+				eps += 0.5; // the faithful Pi*Z multiplied by |cos|<=1
+				eps += 1;   // the lowest radix-4 digit, of weight 2^(-w-1), is dropped
+				int nbDigits = (w-maxIterations+3 +1)/2; // Pi*Z has w-maxIterations+3 bits
+				for(int k=nbDigits-1; k>=1; k--)
+					eps = eps*(1+pow(2.0, 2*k-w)) + 1; // the rotation by digit k in [-2,2] of weight 2^(2k-w-1), truncated
+			}
 
-		// guard bits depend only on the number of iterations
-		g = 1+(int) ceil(log2(eps)); // +1 for the final rounding 
+			eps+=1; // the final neg-by-not
+			if(eps*pow(2.0, -w) + methodError <= pow(2.0, -wOut))
+				break;
+		}
+		REPORT(DEBUG, "Error analysis computes eps=" << eps << " ulps (before final rounding), method error=" << methodError);
 
 		
 		// *********    internal precision and fixed-point alignment **************
@@ -85,7 +123,7 @@ namespace flopoco{
 		// while the Z datapath starts on w-1 bits (sign bit at weight  -2,
 		//  and decreasing, so the invariant is: sign bit at weight -stage-1)
 
-		w = wOut-1 + g; // -1 because of sign
+		w = wOut-1 + g; // -1 because of sign (already set by the error analysis)
 
 		REPORT(DEBUG, "wIn=" << wIn << " wOut=" << wOut 
 		       << "   MaxIterations: " << maxIterations 
@@ -192,6 +230,7 @@ namespace flopoco{
 			// The data dependency is from one Z to the next 
 			// We may assume that the rotations themselves overlap once the DI are known
 			//manageCriticalPath(target->localWireDelay(w) + target->adderDelay(w) + target->lutDelay()));
+ 			addEstimatedAdderCost(sizeZ);
  			manageCriticalPath(target->localWireDelay(sizeZ) + target->adderDelay(sizeZ));
 			
 #if ROUNDED_ROTATION  // rounding of the shifted operand, should save 1 bit in each addition
@@ -234,7 +273,7 @@ namespace flopoco{
 									
 			REPORT(DEBUG, "  sizeZ=" << sizeZ << "   zMSB="<<zMSB );
 
-			if(stage<maxIterations || reducedIterations == 1) {
+			if(stage<maxIterations || reducedIterations == 1 || radix == 4) {
 				// LSB is always -w 
 				vhdl << tab << declare(join("atan2PowStage", stage), sizeZ) << " <= " << unsignedFixPointNumber(zatan, zMSB, zLSB) << ";" <<endl;
 				
@@ -250,11 +289,12 @@ namespace flopoco{
 		}
 		
 		// Give the time to finish the last rotation
+		addEstimatedAdderCost(w+1);
 		manageCriticalPath( target->localWireDelay(w+1) + target->adderDelay(w+1) // actual CP delay
 		                    - (target->localWireDelay(sizeZ+1) + target->adderDelay(sizeZ+1))); // CP delay that was already added
 
 			
-		if(reducedIterations == 0){ //regular struture; all that remains is to assign the outputs correctly
+		if(reducedIterations == 0 && radix == 2){ //regular struture; all that remains is to assign the outputs correctly
 			
 			//assign output
 			
@@ -262,6 +302,63 @@ namespace flopoco{
 			vhdl << tab << declare("redSin", w+1) << "<= " << join("Sin", stage) << ";" << endl;
 			
 
+		}
+		else if(radix == 4){ // rotate by the remaining angle, using its radix-4 (Booth) digits
+			
+			vhdl << tab << "-- Radix 4: finish the computation by rotations by the radix-4 digits of Pi Z" << stage << endl; 
+
+			FixRealKCM* piMultiplier = new FixRealKCM(target, true, zMSB+1, zLSB, zLSB, "pi", 1.0, inDelayMap("X",getCriticalPath()) ); 
+			addSubComponent(piMultiplier);
+			
+			vhdl << tab << declare("FinalZ", sizeZ+1) << " <= " << join("D", stage)<< " & " << join("Z", stage) << ";" << endl;
+			inPortMap(piMultiplier, "X", "FinalZ");
+			outPortMap(piMultiplier, "R", "PiZ");
+			vhdl << instance(piMultiplier, "piMultiplier") << endl;
+			syncCycleFromSignal("PiZ");
+			setCriticalPath(piMultiplier->getOutputDelay("R"));
+
+			// PiZ has LSB weight zLSB=-w-1; digit k has weight 2^(2k-w-1).
+			// Digit 0 would shift by more than w: it is dropped (accounted for in the error analysis)
+			int sizePiZ = sizeZ+3;
+			int nbDigits = (sizePiZ+1)/2;
+			string cosName = join("Cos", stage);
+			string sinName = join("Sin", stage);
+			for(int k=nbDigits-1; k>=1; k--) {
+				addEstimatedAdderCost(w+1);
+				manageCriticalPath(target->localWireDelay(w+1) + target->adderDelay(w+1));
+				int shift = w+1-2*k; // the shift for a digit of absolute value 1
+				vhdl << tab << declare(join("Digit", k), 3) << " <= ";
+				for(int j=2*k+1; j>=2*k-1; j--) {
+					vhdl << "PiZ" << of(min(j, sizePiZ-1)); // sign extension for the top digit
+					if(j>2*k-1)
+						vhdl << " & ";
+				}
+				vhdl << ";" << endl;
+
+				vhdl << tab << "with " << join("Digit", k) << " select" << endl;
+				vhdl << tab << tab << declare(join("SinTermR4_", k), w+1) << " <= " << endl;
+				vhdl << tab << tab << tab << rangeAssign(w, w+1-shift, sinName+of(w)) << " & " << sinName << range(w, shift) << " when \"001\" | \"010\" | \"101\" | \"110\"," << endl;
+				vhdl << tab << tab << tab << rangeAssign(w, w+2-shift, sinName+of(w)) << " & " << sinName << range(w, shift-1) << " when \"011\" | \"100\"," << endl;
+				vhdl << tab << tab << tab << zg(w+1) << " when others;" << endl;
+				vhdl << tab << "with " << join("Digit", k) << " select" << endl;
+				vhdl << tab << tab << declare(join("CosTermR4_", k), w+1) << " <= " << endl;
+				vhdl << tab << tab << tab << rangeAssign(w, w+1-shift, cosName+of(w)) << " & " << cosName << range(w, shift) << " when \"001\" | \"010\" | \"101\" | \"110\"," << endl;
+				vhdl << tab << tab << tab << rangeAssign(w, w+2-shift, cosName+of(w)) << " & " << cosName << range(w, shift-1) << " when \"011\" | \"100\"," << endl;
+				vhdl << tab << tab << tab << zg(w+1) << " when others;" << endl;
+
+				// positive digit: Cos - d.Sin, Sin + d.Cos
+				vhdl << tab << declare(join("CosR4_", k), w+1) << " <= " 
+						 << cosName << " - " << join("SinTermR4_", k) << " when " << join("Digit", k) << of(2) << "=\'0\' else "
+						 << cosName << " + " << join("SinTermR4_", k) << " ;" << endl;
+				vhdl << tab << declare(join("SinR4_", k), w+1) << " <= " 
+						 << sinName << " + " << join("CosTermR4_", k) << " when " << join("Digit", k) << of(2) << "=\'0\' else "
+						 << sinName << " - " << join("CosTermR4_", k) << " ;" << endl;
+				cosName = join("CosR4_", k);
+				sinName = join("SinR4_", k);
+			}
+
+			vhdl << tab << declare("redCos", w+1) << "<= " << cosName << ";" << endl;
+			vhdl << tab << declare("redSin", w+1) << "<= " << sinName << ";" << endl;
 		}
 		else{	//reduced iterations structure; rotate by the remaining angle and then assign the angles
 			
@@ -270,7 +367,7 @@ namespace flopoco{
 		
 			nextCycle();
 			//multiply X by Pi
-			FixRealKCM* piMultiplier = new FixRealKCM(target, zLSB, zMSB, 1, zLSB, "pi", 1.0, inDelayMap("X",getCriticalPath()) ); 
+			FixRealKCM* piMultiplier = new FixRealKCM(target, true, zMSB+1, zLSB, zLSB, "pi", 1.0, inDelayMap("X",getCriticalPath()) ); 
 			addSubComponent(piMultiplier);
 			
 			vhdl << tab << declare("FinalZ", sizeZ+1) << " <= " << join("D", stage)<< " & " << join("Z", stage) << ";" << endl;
@@ -306,6 +403,7 @@ namespace flopoco{
 			
 			syncCycleFromSignal("CosTimesZ");
 			
+			addEstimatedAdderCost(w);
 			manageCriticalPath(target->localWireDelay(w) + target->adderDelay(w));
 			
 			vhdl << tab << declare("CosTimesZTrunc", sizeZ) << "<= CosTimesZ" << range(2*sizeZ-1, sizeZ) << ";" << endl;
@@ -345,6 +443,7 @@ namespace flopoco{
 		vhdl << tab << tab << tab << " redCosNeg when others;" << endl;
 		
 		
+		addEstimatedAdderCost(1+wOut+1);
 		manageCriticalPath( target->adderDelay(1+wOut+1));
 
 		vhdl << tab << declare("roundedCosX", wOut+1) << " <= CosX0" << range(w, w-wOut) << " + " << " (" << zg(wOut) << " & \'1\');" << endl;
@@ -484,10 +583,12 @@ namespace flopoco{
 		int lsb;
 		//int lsbOut;
 		bool reducedIterations;
+		int radix;
 		UserInterface::parseBoolean(args, "reducedIterations", &reducedIterations); 
 		// 		UserInterface::parseInt(args, "lsbOut", &lsbOut);
 		UserInterface::parseInt(args, "lsb", &lsb);
-		return new CordicSinCos(target, -lsb, -lsb, reducedIterations);  // TODO we want to expose the constructor parameters in the new  interface, so these "-" are a bug
+		UserInterface::parsePositiveInt(args, "radix", &radix);
+		return new CordicSinCos(target, -lsb, -lsb, reducedIterations, radix);  // TODO we want to expose the constructor parameters in the new  interface, so these "-" are a bug
 	}
 
 	void CordicSinCos::registerFactory(){
@@ -496,7 +597,8 @@ namespace flopoco{
 											 "ElementaryFunctions",
 											 "", // seeAlso
 											 "lsb(int): weight of the LSB of the input and outputs; \
-                        reducedIterations(int)=0: If 1, number of iterations will be reduced at the cost of two multiplications. ",
+                        reducedIterations(int)=0: If 1, number of iterations will be reduced at the cost of two multiplications; \
+                        radix(int)=2: If 4, the second half of the iterations is replaced with about half as many radix-4 rotations, without multiplier ",
 											 "This is a classical CORDIC, implemented the FloPoCo way: it is last-bit accurate, hopefully at the minimum cost. <br>For more details, see <a href=\"bib/flopoco.html#DinIstSer2013-HEART-SinCos\">this article</a>.",
 											 CordicSinCos::parseArguments
 											 ) ;
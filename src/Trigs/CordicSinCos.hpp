@@ -17,7 +17,9 @@ namespace flopoco{
 	  public:
 	  
 		// constructor, defined there with two parameters (default value 0 for each)
-		CordicSinCos(Target* target, int wIn, int wOut, int reducedIterations = 0, map<string, double> inputDelays = emptyDelayMap);
+		// reducedIterations=1 replaces the second half of the iterations with two multiplications,
+		// radix=4 replaces it with radix-4 rotations, the digits being those of the remaining angle.
+		CordicSinCos(Target* target, int wIn, int wOut, int reducedIterations = 0, int radix = 2, map<string, double> inputDelays = emptyDelayMap);
 
 		// destructor
 		~CordicSinCos();
@@ -44,6 +46,7 @@ namespace flopoco{
 		int wIn;                   /**< input precision, input being in [-1,1) (includes a sign bit of weight 2^0) */
 		int wOut;                  /**< output precisions; output being in (-1,1) (includes a sign bit of weight 2^0) */
 		int reducedIterations;     /**< 0 = normal CORDIC, 1=halved number of iterations */
+		int radix;                 /**< 2 = normal CORDIC, 4=halved number of radix-2 iterations, followed by radix-4 rotations */
 		int w;                     /**< internal precision */
 		int	maxIterations;         /**< index at which iterations stop */
 		int g;                     /**< number of guard bits*/
@@ -81,6 +81,7 @@ namespace flopoco {
 			vhdl << tab << declare("mX", wIn) << " <= (not Xsat);	 -- negation by not, implies one ulp error." << endl;
 			vhdl << tab << declare("mY", wIn) << " <= (not Ysat);	 -- negation by not, implies one ulp error. " << endl;
 		}else {
+			addEstimatedAdderCost(wIn);
 			manageCriticalPath( getTarget()->adderDelay(wIn));
 			vhdl << tab << declare("pX", wIn) << " <= Xsat;" << endl;
 			vhdl << tab << declare("pY", wIn) << " <= Ysat;" << endl;
@@ -131,6 +132,7 @@ namespace flopoco {
 	}
 
 	void FixAtan2::buildQuadrantReconstruction(){
+		addEstimatedAdderCost(wOut);
 		manageCriticalPath(getTarget()->lutDelay() + getTarget()->adderDelay(wOut));
 		vhdl << tab << declare("qangle", wOut) << " <= (quadrant & " << zg(wOut-2) << ");" << endl;
 		vhdl << tab << "A <= "
@@ -329,6 +331,9 @@ namespace flopoco {
 		else if(method<10) {
 			return new FixAtan2ByCORDIC(target, -lsb,-lsb);
 		}
+		else if(method==13) {
+			return new FixAtan2ByCORDIC(target, -lsb,-lsb, 4);
+		}
 		else {
 			return new FixAtan2ByBivariateApprox(target, -lsb, -lsb, method-10);
 		}
@@ -341,7 +346,7 @@ namespace flopoco {
 											 "ElementaryFunctions",
 											 "", // seeAlso
 											 "lsb(int): weight of the LSB of both inputs and outputs; \
-                        method(int): parameter select between: InvMultAtan with approximations of the corresponding degree (0..7), plain CORDIC (8), CORDIC with scaling (9), a method using surface approximation (10), Taylor approximation of order 1 (11) and 2 (12)",
+                        method(int): parameter select between: InvMultAtan with approximations of the corresponding degree (0..7), plain CORDIC (8), CORDIC with scaling (9), a method using surface approximation (10), Taylor approximation of order 1 (11) and 2 (12), radix-4 CORDIC (13)",
 											 "For more details, see <a href=\"bib/flopoco.html#DinIsto2015\">this article</a>.",
 											 FixAtan2::parseArguments
 											 ) ;
@@ -165,6 +165,7 @@ namespace flopoco {
 				resizeFixPoint("BYLow_sgnExtended", "BYLow", maxMSB-1, -wOut+1-g);
 
 				//manage the pipeline
+				addEstimatedAdderCost(maxMSB+wOut+g+1);
 				manageCriticalPath(getTarget()->adderDelay(maxMSB+wOut+g+1));
 
 				//add everything up
@@ -172,11 +173,13 @@ namespace flopoco {
 						<< " <= (AXLow_sgnExtended(AXLow_sgnExtended'HIGH) & AXLow_sgnExtended) + (BYLow_sgnExtended(BYLow_sgnExtended'HIGH) & BYLow_sgnExtended);" << endl;
 
 				//manage the pipeline
+				addEstimatedAdderCost(maxMSB+wOut+g+2);
 				manageCriticalPath(getTarget()->adderDelay(maxMSB+wOut+g+2));
 
 				vhdl << tab << declareFixPoint("AXLowAddBYLowAddC", true, maxMSB+1, -wOut+1-g) << " <= (AXLowAddBYLow(AXLowAddBYLow'HIGH) & AXLowAddBYLow) + C_sgnExtended;" << endl;
 
 				//manage the pipeline
+				addEstimatedAdderCost(wOut+1);
 				manageCriticalPath(getTarget()->adderDelay(wOut+1));
 
 				//extract the final result
@@ -558,6 +561,7 @@ namespace flopoco {
 				setCycleFromSignal("A_DeltaX_sgnExt");
 				syncCycleFromSignal("B_DeltaY_sgnExt");
 				setCriticalPath(criticalPathA_DeltaX);
+				addEstimatedAdderCost(wOut+g+1);
 				manageCriticalPath(getTarget()->adderDelay(wOut+g+1));
 
 				//add everything up
@@ -570,6 +574,7 @@ namespace flopoco {
 				//manage the pipeline
 				setCycleFromSignal("D_DeltaX2_sgnExt");
 				setCriticalPath(criticalPathD_DeltaX2);
+				addEstimatedAdderCost(wOut+g+1);
 				manageCriticalPath(getTarget()->adderDelay(wOut+g+1));
 
 				vhdl << tab << declareFixPoint("Sum2", true, maxMSB, -wOut+1-g)
@@ -585,6 +590,7 @@ namespace flopoco {
 					setCriticalPath(criticalPathE_DeltaY2);
 				else
 					setCriticalPath(criticalPathF_DeltaX_DeltaY);
+				addEstimatedAdderCost(wOut+g+1);
 				manageCriticalPath(getTarget()->adderDelay(wOut+g+1));
 
 				vhdl << tab << declareFixPoint("Sum3", true, maxMSB, -wOut+1-g)
@@ -600,6 +606,7 @@ namespace flopoco {
 					setCriticalPath(criticalPathSum1);
 				else
 					setCriticalPath(criticalPathSum2);
+				addEstimatedAdderCost(wOut+g+1);
 				manageCriticalPath(getTarget()->adderDelay(wOut+g+1));
 
 				vhdl << tab << declareFixPoint("Sum4", true, maxMSB+1, -wOut+1-g)
@@ -615,6 +622,7 @@ namespace flopoco {
 					setCriticalPath(criticalPathSum3);
 				else
 					setCriticalPath(criticalPathSum4);
+				addEstimatedAdderCost(wOut+g+1);
 				manageCriticalPath(getTarget()->adderDelay(wOut+g+1));
 
 				vhdl << tab << declareFixPoint("Sum5", true, maxMSB+2, -wOut+1-g)
@@ -622,6 +630,7 @@ namespace flopoco {
 				vhdl << endl;
 
 				//manage the pipeline
+				addEstimatedAdderCost(wOut+2);
 				manageCriticalPath(getTarget()->adderDelay(wOut+2));
 
 				//extract the final result
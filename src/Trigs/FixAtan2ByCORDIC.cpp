@@ -35,8 +35,8 @@ namespace flopoco{
 	// an option for outputting the norm of the vector as well (scaled or not)
 
 
-	FixAtan2ByCORDIC::FixAtan2ByCORDIC(Target* target_, int wIn_, int wOut_, map<string, double> inputDelays_) :
- 		FixAtan2(target_, wIn_, wOut_, inputDelays_)
+	FixAtan2ByCORDIC::FixAtan2ByCORDIC(Target* target_, int wIn_, int wOut_, int radix_, map<string, double> inputDelays_) :
+ 		FixAtan2(target_, wIn_, wOut_, inputDelays_), radix(radix_)
 	{
 		int stage;
 		srcFileName="FixAtan2ByCORDIC";
@@ -44,8 +44,12 @@ namespace flopoco{
 		useNumericStd_Unsigned();
 
 		ostringstream name;
-		name << "FixAtan2ByCORDIC_" << wIn_ << "_" << wOut_ << "_uid" << getNewUId();
+		name << "FixAtan2ByCORDIC_" << (radix==4?"radix4_":"") << wIn_ << "_" << wOut_ << "_uid" << getNewUId();
 		setNameWithFreq( name.str() );
+
+		if(radix!=2 && radix!=4) {
+			THROWERROR("radix should be 2 or 4, got " << radix);
+		}
 	
 		mpfr_t  zatan; 
 		mpfr_init2(zatan, 10*wOut);
@@ -91,6 +95,7 @@ namespace flopoco{
 		vhdl << tab << declare("Y1", sizeY) << " <= '0' & YRS & " << zg(sizeY-(wIn-1)-1) << ";" <<endl;			
 		stage=1; 
  
+		addEstimatedAdderCost(sizeX);
 		manageCriticalPath( getTarget()->adderDelay(sizeX));
 		vhdl << tab << "--- Iteration " << stage << " : sign is known positive ---" << endl;
 		vhdl << tab << declare(join("YShift", stage), sizeX) << " <= " << rangeAssign(sizeX-1, sizeX-stage, "'0'") << " & Y" << stage << range(sizeX-1, stage) << ";" << endl;
@@ -122,9 +127,67 @@ namespace flopoco{
 			// Invariant: sizeX-sizeY = stage-2
 			vhdl << tab << "--- Iteration " << stage << " ---" << endl;
 			
+			addEstimatedAdderCost(max(sizeX,sizeZ));
 			manageCriticalPath( getTarget()->localWireDelay(sizeX+1) + getTarget()->adderDelay(max(sizeX,sizeZ)) );
 			vhdl << tab << declare(join("sgnY", stage))  << " <= " <<  join("Y", stage)  <<  of(sizeY-1) << ";" << endl;
 			
+			if(radix==4 && -2*stage+1 < -wIn+1-gXY && stage+1<=maxIterations) {
+				// X is constant from now on: iterations stage and stage+1 are overlapped in a radix-4 step.
+				// The four possible values of Y(stage+2) are computed in parallel with sgnY(stage+1),
+				// which then selects one of them: the result is identical to two radix-2 iterations.
+				vhdl << tab << "--- Iterations " << stage << " and " << stage+1 << " (radix 4) ---" << endl;
+				vhdl << tab << declare(join("X", stage+2), sizeX) << " <= " << join("X", stage) << " ;" << endl;
+				vhdl << tab << declare(join("XShift", stage), sizeY) << " <= " << zg(2) << " & X" << stage << range(sizeX-1, sizeX - sizeY + 2) << ";" <<endl;			
+				vhdl << tab << declare(join("XShift", stage+1), sizeY-1) << " <= " << zg(2) << " & X" << stage << range(sizeX-1, sizeX - sizeY + 3) << ";" <<endl;			
+				vhdl << tab << declare(join("XShiftP", stage), sizeY-1) << " <= " 
+						 << join("XShift", stage) << range(sizeY-2, 0) << " + " << join("XShift", stage+1) << " ;" << endl;
+				vhdl << tab << declare(join("XShiftM", stage), sizeY-1) << " <= " 
+						 << join("XShift", stage) << range(sizeY-2, 0) << " - " << join("XShift", stage+1) << " ;" << endl;
+				// first iteration, only for the sign
+				vhdl << tab << declare(join("YY", stage+1), sizeY) << " <= " 
+						 << join("Y", stage) << " + " << join("XShift", stage) << " when " << join("sgnY", stage) << "=\'1\'     else "
+						 << join("Y", stage) << " - " << join("XShift", stage) << " ;" << endl;
+				vhdl << tab << declare(join("sgnY", stage+1))  << " <= " <<  join("YY", stage+1)  <<  of(sizeY-2) << ";" << endl;
+				// both iterations, speculatively
+				vhdl << tab << declare(join("YR4pp", stage+2), sizeY-1) << " <= " << join("Y", stage) << range(sizeY-2, 0) << " + " << join("XShiftP", stage) << ";" << endl;
+				vhdl << tab << declare(join("YR4pm", stage+2), sizeY-1) << " <= " << join("Y", stage) << range(sizeY-2, 0) << " + " << join("XShiftM", stage) << ";" << endl;
+				vhdl << tab << declare(join("YR4mp", stage+2), sizeY-1) << " <= " << join("Y", stage) << range(sizeY-2, 0) << " - " << join("XShiftM", stage) << ";" << endl;
+				vhdl << tab << declare(join("YR4mm", stage+2), sizeY-1) << " <= " << join("Y", stage) << range(sizeY-2, 0) << " - " << join("XShiftP", stage) << ";" << endl;
+
+				//create the constant signals for the arctans
+				for(int i=stage; i<=stage+1; i++) {
+					mpfr_set_d(zatan, 1.0, GMP_RNDN);
+					mpfr_div_2si(zatan, zatan, i, GMP_RNDN);
+					mpfr_atan(zatan, zatan, GMP_RNDN);
+					mpfr_div(zatan, zatan, constPi, GMP_RNDN);
+					REPORT(DEBUG, "stage=" << i << "  atancst=" << printMPFR(zatan));		
+					vhdl << tab << declare(join("atan2PowStage", i), sizeZ) << " <= " << unsignedFixPointNumber(zatan, zMSB, zLSB) << ";" <<endl;
+				}
+				// sums of constants, folded by synthesis
+				vhdl << tab << declare(join("ZR4pp", stage+2), sizeZ) << " <= " << join("Z", stage) << " + (" << join("atan2PowStage", stage) << " + " << join("atan2PowStage", stage+1) << ");" << endl;
+				vhdl << tab << declare(join("ZR4pm", stage+2), sizeZ) << " <= " << join("Z", stage) << " + (" << join("atan2PowStage", stage) << " - " << join("atan2PowStage", stage+1) << ");" << endl;
+				vhdl << tab << declare(join("ZR4mp", stage+2), sizeZ) << " <= " << join("Z", stage) << " - (" << join("atan2PowStage", stage) << " - " << join("atan2PowStage", stage+1) << ");" << endl;
+				vhdl << tab << declare(join("ZR4mm", stage+2), sizeZ) << " <= " << join("Z", stage) << " - (" << join("atan2PowStage", stage) << " + " << join("atan2PowStage", stage+1) << ");" << endl;
+
+				manageCriticalPath( getTarget()->localWireDelay(sizeY) + getTarget()->lutDelay() );
+				vhdl << tab << declare(join("sgnYR4", stage), 2)  << " <= " <<  join("sgnY", stage) << " & " << join("sgnY", stage+1) << ";" << endl;
+				vhdl << tab << "with " << join("sgnYR4", stage) << " select" << endl;
+				vhdl << tab << tab << declare(join("Y", stage+2), sizeY-2) << " <= " 
+						 << join("YR4pp", stage+2) << range(sizeY-3, 0) << " when \"11\", " 
+						 << join("YR4pm", stage+2) << range(sizeY-3, 0) << " when \"10\", " 
+						 << join("YR4mp", stage+2) << range(sizeY-3, 0) << " when \"01\", " 
+						 << join("YR4mm", stage+2) << range(sizeY-3, 0) << " when others;" << endl;
+				vhdl << tab << "with " << join("sgnYR4", stage) << " select" << endl;
+				vhdl << tab << tab << declare(join("Z", stage+2), sizeZ) << " <= " 
+						 << join("ZR4pp", stage+2) << " when \"00\", " 
+						 << join("ZR4pm", stage+2) << " when \"01\", " 
+						 << join("ZR4mp", stage+2) << " when \"10\", " 
+						 << join("ZR4mm", stage+2) << " when others;" << endl;
+				stage++;
+				sizeY--;
+				continue;
+			}
+
 			if(-2*stage+1 >= -wIn+1-gXY) { 
 				vhdl << tab << declare(join("YShift", stage), sizeX) 
 						 << " <= " << rangeAssign(sizeX-1, sizeX -(sizeX-sizeY+stage), join("sgnY", stage))   
@@ -163,6 +226,7 @@ namespace flopoco{
 			// manageCriticalPath( getTarget()->localWireDelay(w+1) + getTarget()->adderDelay(w+1) // actual CP delay
 			//                     - (getTarget()->localWireDelay(sizeZ+1) + getTarget()->adderDelay(sizeZ+1))); // CP delay that was already added
 		
+		addEstimatedAdderCost(2);
 		manageCriticalPath( getTarget()->localWireDelay(wOut+1) + getTarget()->adderDelay(2) );
 
 		vhdl << tab << declare("finalZ", wOut) << " <= Z" << stage << of(sizeZ-1) << " & Z" << stage << range(sizeZ-1, sizeZ-wOut+1) << "; -- sign-extended and rounded" << endl;
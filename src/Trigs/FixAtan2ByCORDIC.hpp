@@ -20,9 +20,10 @@ namespace flopoco{
 		 Angle is output as a signed number between 00...00 and 11...1111, for 2pi(1-2^-w)
 		      pi is 0100..00, etc.
 		Actual position of the fixed point in the inputs doesn't matter as long as it is the same for x and y
+		radix=4 performs two iterations per stage wherever X no longer changes; the result is the same as in radix 2
 
 		*/
-		FixAtan2ByCORDIC(Target* target, int wIn, int wOut, map<string, double> inputDelays = emptyDelayMap);
+		FixAtan2ByCORDIC(Target* target, int wIn, int wOut, int radix=2, map<string, double> inputDelays = emptyDelayMap);
 
 		// destructor
 		~FixAtan2ByCORDIC();
@@ -33,6 +34,7 @@ namespace flopoco{
 		int	maxIterations;         /**< index at which iterations stop */
 		int gXY;                   /**< number of guard bits on the (X,Y) datapath */
 		int gA;                    /**< number of guard bits on the Angle datapath */
+		int radix;                 /**< 2: one iteration per stage; 4: two iterations per stage when X is constant */
 		vector<mpfr_t> atani;      /**< */
 
 		void computeGuardBits();
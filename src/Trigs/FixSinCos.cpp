@@ -540,6 +540,7 @@ FixSinCos::FixSinCos(Target * target, int w_):Operator(target), w(w_){
 				vhdl << instance (z3o6Table, "z3o6Table");
 				syncCycleFromSignal("Z3o6");
 
+				addEstimatedAdderCost(wZ);
 				manageCriticalPath(target->adderDelay(wZ));
 				vhdl << tab << declare ("SinZ", wZ) << " <= Z - Z3o6;" << endl;
 				setSignalDelay("SinZ", getCriticalPath());
@@ -637,6 +638,7 @@ FixSinCos::FixSinCos(Target * target, int w_):Operator(target), w(w_){
 			nextCycle();
 
 			// TODO: critical path supposed suboptimal (but don't know how to fix)
+			addEstimatedAdderCost(w+g);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(w+g));
 			vhdl << tab << declare ("CosZCosPiA_plus_rnd", w+g)
 					 << " <= CosPiA - Z2o2CosPiA;" << endl;
@@ -644,6 +646,7 @@ FixSinCos::FixSinCos(Target * target, int w_):Operator(target), w(w_){
 			syncCycleFromSignal ("SinZSinPiA");
 			nextCycle();
 
+			addEstimatedAdderCost(w+g);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(w+g));
 			vhdl << tab << declare ("C_out_rnd_aux", w+g)
 			<< " <= CosZCosPiA_plus_rnd - SinZSinPiA;" << endl;
@@ -792,6 +795,7 @@ FixSinCos::FixSinCos(Target * target, int w_):Operator(target), w(w_){
 			setCycleFromSignal ("Z2o2SinPiA");
 			nextCycle();
 			
+			addEstimatedAdderCost(w+g);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(w+g));
 			vhdl << tab << declare ("CosZSinPiA_plus_rnd", w+g)
 					 << " <= SinPiA - Z2o2SinPiA;" << endl;
@@ -799,6 +803,7 @@ FixSinCos::FixSinCos(Target * target, int w_):Operator(target), w(w_){
 			syncCycleFromSignal ("SinZCosPiA");
 			nextCycle();
 			
+			addEstimatedAdderCost(w+g);
 			manageCriticalPath(target->localWireDelay() + target->adderDelay(w+g));
 			vhdl << tab << declare ("S_out_rnd_aux", w+g)
 					 << " <= CosZSinPiA_plus_rnd + SinZCosPiA;" << endl;
@@ -854,8 +859,7 @@ FixSinCos::FixSinCos(Target * target, int w_):Operator(target), w(w_){
 
 
 FixSinCos::~FixSinCos(){
-	if(scT) free(scT);
-	if(pi_mult) free(pi_mult);
+	// scT and pi_mult are sub-components: they are deleted with the operator tree, not here
 	mpfr_clears (scale, constPi, NULL);		
 };
 
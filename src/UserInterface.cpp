@@ -3,6 +3,15 @@
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <ctime>
+#include <set>
+#include <functional>
+#ifdef HAVE_FLOPOCO_VERSION_HPP
+#include "FloPoCoVersion.hpp" // generated at each build, defines FLOPOCO_GIT_VERSION
+#endif
 
 // TODO check the hard mult threshold
 
@@ -22,15 +31,26 @@ namespace flopoco
 
 	// Allocation of the global objects
 	string UserInterface::outputFileName;
+	string UserInterface::timingReportFileName;
 	string UserInterface::entityName=""; // used for the -name option
 	int    UserInterface::verbose;
 	string UserInterface::targetFPGA;
+	string UserInterface::targetFile;
 	double UserInterface::targetFrequencyMHz;
+	int    UserInterface::targetLatency;
 	bool   UserInterface::pipeline;
 	bool   UserInterface::clockEnable;
 	bool   UserInterface::useHardMult;
 	bool   UserInterface::plainVHDL;
 	bool   UserInterface::generateFigures;
+	bool   UserInterface::retime;
+	bool   UserInterface::compressTables;
+	bool   UserInterface::packTables;
+	bool   UserInterface::estimateOnly;
+	bool   UserInterface::incremental;
+	double UserInterface::incrementalCheck;
+	string UserInterface::generationHash;
+	bool   UserInterface::checkingIncremental;
 	double UserInterface::unusedHardMultThreshold;
 	int    UserInterface::resourceEstimation;
 	bool   UserInterface::floorplanning;
@@ -73,6 +93,7 @@ namespace flopoco
 				v.push_back("cyclone3");
 				v.push_back("cyclone4");
 				v.push_back("cyclone5");
+				v.push_back("generic");
 				return v;
 			}();
 
@@ -94,14 +115,24 @@ namespace flopoco
 				v.push_back(option_t("pipeline", values));
 				v.push_back(option_t("plainVHDL", values));
 				v.push_back(option_t("generateFigures", values));
+				v.push_back(option_t("retime", values));
+				v.push_back(option_t("compressTables", values));
+				v.push_back(option_t("packTables", values));
+				v.push_back(option_t("profile", values));
+				v.push_back(option_t("estimateOnly", values));
+				v.push_back(option_t("incremental", values));
 				v.push_back(option_t("useHardMults", values));
 
 				//free options, using an empty vector of values 
 				values.clear();
 				v.push_back(option_t("name", values));
 				v.push_back(option_t("outputFile", values));
+				v.push_back(option_t("timingReport", values));
+				v.push_back(option_t("incrementalCheck", values));
 				v.push_back(option_t("hardMultThreshold", values));
 				v.push_back(option_t("frequency", values));
+				v.push_back(option_t("latency", values));
+				v.push_back(option_t("targetFile", values));
 				
 				//verbosity level
 				values.clear();
@@ -119,9 +150,23 @@ namespace flopoco
 		try {
 			sollya_lib_init();
 			initialize();
+			if(isUpToDate(argc, argv)) {
+				cerr << "Output file " << outputFileName << " is up to date (incremental=1), nothing to do" << endl;
+				sollya_lib_close();
+				return;
+			}
 			buildAll(argc, argv);
-			outputVHDL();
-			finalReport(cerr); 
+			if(estimateOnly) {
+				// no second parse, no VHDL output (which is also where the tables are filled)
+				for(auto i: globalOpList)
+					i->outputEstimateReport(cerr);
+			}
+			else {
+				outputVHDL();
+				finalReport(cerr); 
+			}
+			if(Profiler::enabled)
+				outputProfile();
 			sollya_lib_close();
 		}
 		catch (string e) {
@@ -137,13 +182,23 @@ namespace flopoco
 	void UserInterface::parseGenericOptions(vector<string> &args) {
 		parseString(args, "name", &entityName, true); // not sticky: will be used, and reset, after the operator parser
 		parseString(args, "outputFile", &outputFileName, true); // not sticky: will be used, and reset, after the operator parser
+		parseString(args, "timingReport", &timingReportFileName, true); // global: one report for all the operators
 		parseString(args, "target", &targetFPGA, true); // not sticky: will be used, and reset, after the operator parser
 		parsePositiveInt(args, "verbose", &verbose, true); // sticky option
 		parseFloat(args, "frequency", &targetFrequencyMHz, true); // sticky option
+		parseInt(args, "latency", &targetLatency, true); // not sticky: will be used, and reset, after the operator parser
+		parseString(args, "targetFile", &targetFile, true); // sticky option
 		parseFloat(args, "hardMultThreshold", &unusedHardMultThreshold, true); // sticky option
 		parseBoolean(args, "useHardMult", &useHardMult, true);
 		parseBoolean(args, "plainVHDL", &plainVHDL, true);
 		parseBoolean(args, "generateFigures", &generateFigures, true);
+		parseBoolean(args, "retime", &retime, true);
+		parseBoolean(args, "compressTables", &compressTables, true);
+		parseBoolean(args, "packTables", &packTables, true);
+		parseBoolean(args, "profile", &Profiler::enabled, true);
+		parseBoolean(args, "estimateOnly", &estimateOnly, true);
+		parseBoolean(args, "incremental", &incremental, true);
+		parseFloat(args, "incrementalCheck", &incrementalCheck, true);
 		parseBoolean(args, "floorplanning", &floorplanning, true);
 		parseBoolean(args, "reDebug", &reDebug, true );
 		parseBoolean(args, "pipeline", &pipeline, true );
@@ -166,6 +221,7 @@ namespace flopoco
 
 
 	void UserInterface::addToGlobalOpList(OperatorPtr op) {
+		op->endProfiling();
 		bool alreadyPresent=false;
 		// We assume all the operators added to GlobalOpList are unpipelined.
 		for (auto i: globalOpList){
@@ -193,6 +249,11 @@ namespace flopoco
 				REPORT(FULL, "  DECLARE LIST" << printMapContent(i->getDeclareTable()));
 				REPORT(FULL, "  USE LIST" << printVectorContent(  (i->getFlopocoVHDLStream())->getUseTable()) );
 
+				if(i->getTarget()->tablePacking()) {
+					Profiler::Scope p("packTables", i->getName());
+					i->packTables();
+				}
+
 				// check for subcomponents
 				if (! i->getSubComponents().empty() ){
 					//recursively call to print subcomponent
@@ -202,9 +263,16 @@ namespace flopoco
 
 				/* second parse is only for sequential operators */
 				if (i->isSequential()){
+					if(i->getTarget()->retiming()) {
+						REPORT (FULL, "  RETIMING");
+						Profiler::Scope p("retime", i->getName());
+						i->retime();
+					}
 					REPORT (FULL, "  2nd PASS");
+					Profiler::Scope p("parse2", i->getName());
 					i->parse2();
 				}
+				Profiler::Scope p("outputVHDL", i->getName());
 				i->outputVHDL(file);
 
 			} catch (std::string s) {
@@ -270,11 +338,22 @@ namespace flopoco
 		// Initialize all the command-line options
 		verbose=1;
 		outputFileName="flopoco.vhdl";
+		timingReportFileName="";
 		targetFPGA=defaultFPGA;
+		targetFile="";
 		targetFrequencyMHz=400;
+		targetLatency=-1;
 		pipeline=true;
 		useHardMult=true;
 		unusedHardMultThreshold=0.7;
+		retime=false;
+		compressTables=false;
+		packTables=false;
+		estimateOnly=false;
+		incremental=false;
+		incrementalCheck=0;
+		checkingIncremental=false;
+		generationHash="";
 		
 	}
 
@@ -293,6 +372,10 @@ namespace flopoco
 			buildAutocomplete();
 			exit(EXIT_SUCCESS);
 		}
+		if(string(argv[1])=="explore") {
+			DesignSpaceExplorer::main(argc, argv);
+			exit(EXIT_SUCCESS);
+		}
 
 		// First convert for convenience the input arg list into
 		// 1/ a (possibly empty) vector of global args / initial options,
@@ -363,6 +446,11 @@ namespace flopoco
 				else if (targetFPGA=="cycloneiii" || targetFPGA=="cyclone3") target=new CycloneIII();
 				else if (targetFPGA=="cycloneiv" || targetFPGA=="cyclone4") target=new CycloneIV();
 				else if (targetFPGA=="cyclonev" || targetFPGA=="cyclone5") target=new CycloneV();
+				else if (targetFPGA=="generic") {
+					if(targetFile=="")
+						throw(string("ERROR: target=Generic needs a calibration file, given by targetFile=<file>"));
+					target=new GenericTarget(targetFile);
+				}
 				else {
 					throw("ERROR: unknown target: " + targetFPGA);
 					}
@@ -371,13 +459,24 @@ namespace flopoco
 				target->setUseHardMultipliers(useHardMult);
 				target->setPlainVHDL(plainVHDL);
 				target->setGenerateFigures(generateFigures);
+				target->setRetiming(retime);
+				target->setTableCompression(compressTables);
+				target->setTablePacking(packTables);
 				// Now build the operator
 				OperatorFactoryPtr fp = getFactoryByName(opName);
 				if (fp==NULL){
 					throw( "Can't find the operator factory for " + opName) ;
 				}
-				OperatorPtr op = fp->parseArguments(target, opParams);
+				OperatorPtr op;
+				Profiler::Scope p("build " + opName);
+				if(targetLatency>=0) {
+					op = buildForLatency(fp, target, opParams, targetLatency);
+					targetLatency=-1;
+				}
+				else
+					op = fp->parseArguments(target, opParams);
 				if(op!=NULL)	{// Some factories don't actually create an operator
+					op->endProfiling();
 					if(entityName!="") {
 						op->changeName(entityName);
 						entityName="";
@@ -399,14 +498,228 @@ namespace flopoco
 	}
 
 
+	OperatorPtr UserInterface::buildForLatency(OperatorFactoryPtr fp, Target* target, vector<string>& opParams, int latency) {
+		string srcFileName = "UserInterface"; // for REPORT
+		if(!target->isPipelined() && latency>0)
+			throw(string("ERROR: latency=") + to_string(latency) + " needs pipeline=yes");
+		Profiler::Scope p("latency search");
+		// A trial builds the operator at frequency f (in MHz).
+		// parseArguments consumes its arguments, hence the copy.
+		struct Trial {
+			OperatorPtr op;
+			vector<OperatorPtr> globalOps; // the operators added to the globalOpList by this trial
+			vector<string> args;           // the arguments left by parseArguments
+			double f;
+			int depth;
+		};
+		// The operators of a trial are the operator, its sub-components, and the operators it added to the globalOpList.
+		// Operators never delete their sub-components, so those of a rejected trial are deleted here,
+		// except those that were already reachable from the globalOpList before the search
+		std::function<void(OperatorPtr, set<OperatorPtr>&)> reach = [&](OperatorPtr op, set<OperatorPtr>& ops) {
+			if(ops.insert(op).second)
+				for(auto sub: op->getSubComponents())
+					reach(sub, ops);
+		};
+		size_t globalOpListSize = globalOpList.size();
+		set<OperatorPtr> previousOps;
+		for(size_t i=0; i<globalOpListSize; i++)
+			reach(globalOpList[i], previousOps);
+		auto discard = [&](Trial& t) {
+			set<OperatorPtr> ops;
+			reach(t.op, ops);
+			for(auto g: t.globalOps)
+				reach(g, ops);
+			for(auto op: ops)
+				if(previousOps.find(op)==previousOps.end())
+					delete op;
+		};
+
+		// The best trial so far: the deepest pipeline that does not exceed the latency, then the highest frequency.
+		// Keeping it makes the result independent of the monotonicity of the depth as a function of the frequency
+		Trial best;
+		best.op=NULL;
+		auto depthAt = [&](double f) -> int {
+			target->setFrequency(1e6*f);
+			Trial t;
+			t.f = f;
+			t.args = opParams;
+			t.op = fp->parseArguments(target, t.args);
+			t.globalOps.assign(globalOpList.begin()+globalOpListSize, globalOpList.end());
+			globalOpList.resize(globalOpListSize);
+			if(t.op==NULL)
+				throw(string("ERROR: latency= is not supported by ") + opParams[0]);
+			t.op->endProfiling();
+			t.depth = t.op->getPipelineDepth();
+			REPORT(DETAILED, "latency search: frequency " << f << " MHz gives pipeline depth " << t.depth);
+			if(t.depth<=latency && (best.op==NULL || t.depth>best.depth || (t.depth==best.depth && t.f>best.f))) {
+				if(best.op!=NULL)
+					discard(best);
+				best=t;
+			}
+			else
+				discard(t);
+			return t.depth;
+		};
+
+		// The pipeline depth is (mostly) an increasing function of the frequency:
+		// bisect on a log scale, keeping depth(fLow)<=latency<depth(fHigh)
+		double fLow=1, fHigh=4000;
+		if(depthAt(fLow) > latency)
+			throw(string("ERROR: ") + opParams[0] + " needs more than " + to_string(latency) + " cycles even at " + to_string(fLow) + " MHz");
+		if(depthAt(fHigh) > latency) {
+			while(fHigh/fLow > 1.01) {
+				double f = sqrt(fLow*fHigh);
+				if(depthAt(f) <= latency)
+					fLow=f;
+				else
+					fHigh=f;
+			}
+		}
+
+		// Keep the best trial, for good
+		target->setFrequency(1e6*best.f);
+		globalOpList.insert(globalOpList.end(), best.globalOps.begin(), best.globalOps.end());
+		opParams = best.args;
+		OperatorPtr op = best.op;
+		if(op->getPipelineDepth() != latency)
+			REPORT(INFO, "WARNING: no frequency gives a pipeline depth of exactly " << latency << " cycles for " << op->getName() << ", using " << op->getPipelineDepth() << " cycles");
+		REPORT(INFO, "latency=" << latency << ": " << op->getName() << " built for " << best.f << " MHz");
+		return op;
+	}
+
+
+
 	void UserInterface::outputVHDL() {
+		string previousContent;
+		if(checkingIncremental) {
+			ifstream previous(outputFileName.c_str());
+			stringstream s;
+			s << previous.rdbuf();
+			previousContent = s.str();
+		}
 		ofstream file; 
 		file.open(outputFileName.c_str(), ios::out);
+		if(!generationHash.empty())
+			file << "-- FloPoCo generation hash: " << generationHash << endl;
 		outputVHDLToFile(file);
 		file.close();
+		if(checkingIncremental) {
+			ifstream current(outputFileName.c_str());
+			stringstream s;
+			s << current.rdbuf();
+			if(s.str() != previousContent)
+				throw(string("ERROR: incrementalCheck: the regenerated ") + outputFileName
+							+ " differs from the previous one, although the generation hash is the same");
+			cerr << "incrementalCheck: the regenerated " << outputFileName << " is identical to the previous one" << endl;
+		}
+
+		// The timing report needs the lifespans, hence comes after the VHDL generation
+		if(timingReportFileName!="") {
+			ofstream report;
+			report.open(timingReportFileName.c_str(), ios::out);
+			report << "{" << endl;
+			report << "\t\"vhdlFile\": \"" << outputFileName << "\"," << endl;
+			report << "\t\"operators\": [" << endl;
+			for(size_t k=0; k<globalOpList.size(); k++) {
+				globalOpList[k]->outputJSONReport(report, 2);
+				report << (k+1<globalOpList.size() ? "," : "") << endl;
+			}
+			report << "\t]" << endl;
+			report << "}" << endl;
+			report.close();
+		}
+	}
+
+
+
+
+
+	void UserInterface::outputProfile() {
+		Profiler::outputTextReport(cerr);
+		string traceFileName = outputFileName;
+		size_t dot = traceFileName.rfind(".vhd");
+		if(dot!=string::npos)
+			traceFileName = traceFileName.substr(0, dot);
+		traceFileName += ".trace.json";
+		ofstream trace;
+		trace.open(traceFileName.c_str(), ios::out);
+		Profiler::outputChromeTrace(trace);
+		trace.close();
+		cerr << "Profile trace (for chrome://tracing or ui.perfetto.dev): " << traceFileName << endl;
+	}
+
+
+
+	string UserInterface::computeGenerationHash(int argc, char* argv[]) {
+		ostringstream description;
+#ifdef FLOPOCO_GIT_VERSION
+		// the commit, followed by a hash of the uncommitted changes if any
+		description << FLOPOCO_GIT_VERSION;
+#else
+		// not built from a git repository: the generator is identified by the content of its executable
+		ifstream executable("/proc/self/exe", ios::binary);
+		if(!executable)
+			return "";
+		description << executable.rdbuf();
+#endif
+		description << endl;
+		for (int i=1; i<argc; i++) {
+			string arg = argv[i];
+			string key = arg.substr(0, arg.find('='));
+			std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+			if(key=="incremental" || key=="incrementalcheck")
+				continue;
+			description << arg << endl;
+			// The calibration file is a parameter of the target
+			if(key=="targetfile") {
+				ifstream calibration(arg.substr(arg.find('=')+1).c_str());
+				description << calibration.rdbuf() << endl;
+			}
+		}
+		// FNV-1a, 64 bits
+		uint64_t h = 14695981039346656037ULL;
+		for (unsigned char c: description.str()) {
+			h ^= c;
+			h *= 1099511628211ULL;
+		}
+		ostringstream s;
+		s << hex << setw(16) << setfill('0') << h;
+		return s.str();
 	}
 
 
+	bool UserInterface::isUpToDate(int argc, char* argv[]) {
+		// The options that matter here are needed before the operators are built: look for them directly
+		for (int i=1; i<argc; i++) {
+			vector<string> args;
+			args.push_back("$$incremental$$");
+			args.push_back(argv[i]);
+			if(args[1].find('=') == string::npos)
+				continue;
+			parseBoolean(args, "incremental", &incremental, true);
+			parseFloat(args, "incrementalCheck", &incrementalCheck, true);
+			parseString(args, "outputFile", &outputFileName, true);
+		}
+		if(!incremental)
+			return false;
+		generationHash = computeGenerationHash(argc, argv);
+		if(generationHash.empty()) {
+			cerr << "WARNING: the version of this flopoco cannot be determined, ignoring incremental=1" << endl;
+			return false;
+		}
+		ifstream previous(outputFileName.c_str());
+		string firstLine;
+		if(!previous || !getline(previous, firstLine))
+			return false;
+		if(firstLine != "-- FloPoCo generation hash: " + generationHash)
+			return false;
+		if(incrementalCheck > 0) {
+			srand(time(NULL));
+			checkingIncremental = (double)rand()/RAND_MAX < incrementalCheck;
+			return !checkingIncremental;
+		}
+		return true;
+	}
 
 
 
@@ -600,15 +913,28 @@ namespace flopoco
 		s << "Generic options include:" << endl;
 		s << "  " << COLOR_BOLD << "name" << COLOR_NORMAL << "=<string>:        override the the default entity name "<<endl;
 		s << "  " << COLOR_BOLD << "outputFile" << COLOR_NORMAL << "=<string>:  override the the default output file name " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL <<endl;
+		s << "  " << COLOR_BOLD << "timingReport" << COLOR_NORMAL << "=<string>: also write a JSON timing and pipeline report of all the operators in this file" <<endl;
 		s << "  " << COLOR_BOLD << "pipeline" << COLOR_NORMAL << "=<0|1>:       pipelined operator, or not " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
 		s << "  " << COLOR_BOLD << "target" << COLOR_NORMAL << "=<string>:      target FPGA (default " << defaultFPGA << ") " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
-		s << "     Supported targets: Stratix2...5, Virtex2...6, Cyclone2...5,Spartan3"<<endl;
+		s << "     Supported targets: Stratix2...5, Virtex2...6, Cyclone2...5,Spartan3, Generic"<<endl;
+		s << "  " << COLOR_BOLD << "targetFile" << COLOR_NORMAL << "=<string>:  calibration file for target=Generic " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "frequency" << COLOR_NORMAL << "=<float>:    target frequency in MHz (default 400) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
+		s << "  " << COLOR_BOLD << "latency" << COLOR_NORMAL << "=<int>:        build the fastest operator that has this pipeline depth (overrides frequency)"<<endl;
 		s << "  " << COLOR_BOLD << "plainVHDL" << COLOR_NORMAL << "=<0|1>:      use plain VHDL (default), or not " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
 		s << "  " << COLOR_BOLD << "hardMultThreshold" << COLOR_NORMAL << "=<float>: unused hard mult threshold (O..1, default 0.7) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "generateFigures" << COLOR_NORMAL << "=<0|1>:generate SVG graphics (default off) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
+		s << "  " << COLOR_BOLD << "retime" << COLOR_NORMAL << "=<0|1>:         move the pipeline registers after construction to save flip-flops (default off) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
+		s << "  " << COLOR_BOLD << "compressTables" << COLOR_NORMAL << "=<0|1>: implement large tables as base table + correction table + adder when cheaper (default off) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
+		s << "  " << COLOR_BOLD << "packTables" << COLOR_NORMAL << "=<0|1>:     let pairs of memory-block tables read in the same cycle share a dual-port memory (default off) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
+		s << "  " << COLOR_BOLD << "incremental" << COLOR_NORMAL << "=<0|1>:    do nothing if the output file was generated by the same command and flopoco version (default off)" << endl;
+		s << "  " << COLOR_BOLD << "incrementalCheck" << COLOR_NORMAL << "=<float>: with incremental=1, probability to regenerate anyway and check that the output is identical (default 0)" << endl;
+		s << "  " << COLOR_BOLD << "estimateOnly" << COLOR_NORMAL << "=<0|1>:   only print latency and LUT/FF/DSP/memory estimates, without generating the VHDL (default off)" << endl;
+		s << "  " << COLOR_BOLD << "profile" << COLOR_NORMAL << "=<0|1>:        profile the generator itself: time and allocations per operator and phase (default off)" << endl;
 		s << "  " << COLOR_BOLD << "verbose" << COLOR_NORMAL << "=<int>:        verbosity level (0-4, default=1)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "Sticky options apply to the rest of the command line, unless changed again" <<endl;
+		s << COLOR_BLUE_NORMAL<< "Design-space exploration: " << COLOR_NORMAL << "flopoco explore [jobs=<n>] [exploreOutput=<prefix>] [options] OperatorName parameters" << endl;
+		s << "  where values may be lists (frequency=200,300,400) or ranges (wF=20:30 or frequency=100:500:50);" << endl;
+		s << "  the Pareto front of the estimates (see estimateOnly) is written to <prefix>.csv (default explore.csv)" << endl;
 		s <<endl;
 		s <<  COLOR_BOLD << "List of operators with command-line interface"<< COLOR_NORMAL << " (a few more are hidden inside FloPoCo)" <<endl;
 		// The following is an inefficient double loop to avoid duplicating the data structure: nobody needs efficiency here
@@ -1065,6 +1391,12 @@ namespace flopoco
 		return  m_paramDefault[key];
 	}
 
+	string OperatorFactory::getParamType(const string& key){
+		if(m_paramType.find(key)==m_paramType.end())
+			return "";
+		return m_paramType[key];
+	}
+
 	OperatorFactory::OperatorFactory(
 						 string name,
 						 string description, /* for the HTML doc and the detailed help */ 
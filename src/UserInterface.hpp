@@ -51,6 +51,21 @@ namespace flopoco
 
 		/** generates a report for operators in globalOpList, and all their subcomponents */
 		static void finalReport(ostream & s);
+
+		/** Outputs the profile of the generator (profile option): text on cerr, Chrome trace in a file */
+		static void outputProfile();
+
+		/** Computes the hash of a generation (incremental option): a hash of the flopoco version
+		 * (the commit and uncommitted changes, or the executable itself outside a git repository),
+		 * of the command line, and of the calibration files it refers to.
+		 * Returns an empty string if the version cannot be determined */
+		static string computeGenerationHash(int argc, char* argv[]);
+
+		/** true if incremental=1 and the output file was generated by the same command line and flopoco version.
+		 * Also sets generationHash, which stays empty when incremental mode is off or the version is unknown.
+		 * With incrementalCheck=p, returns false with probability p, and outputVHDL() then checks that the
+		 * regenerated file is identical */
+		static bool isUpToDate(int argc, char* argv[]);
 		
 
 		/**a helper factory function. For the parameter documentation, see the OperatorFactory constructor */ 
@@ -106,6 +121,11 @@ namespace flopoco
 		/** parse all the generic options such as name, target, verbose, etc. */
 		static void parseGenericOptions(vector<string>& args);
 
+		/** Build the operator with the highest frequency whose pipeline depth is the given latency,
+		 * by a binary search on the period (for latency=).
+		 * The best operator built during the search is returned, the other ones are deleted. */
+		static OperatorPtr buildForLatency(OperatorFactoryPtr fp, Target* target, vector<string>& opParams, int latency);
+
 		/** Build operators.html directly into the doc directory. */
 		static void buildHTMLDoc();
 
@@ -115,16 +135,27 @@ namespace flopoco
 	public:
 		static vector<OperatorPtr>  globalOpList;  /**< Level-0 operators. Each of these can have sub-operators */
 		static int    verbose;
+		static bool   estimateOnly; /**< only estimates are printed: the VHDL code is never stored (see FlopocoStream::flush()) */
 	private:
 		static string outputFileName;
+		static string timingReportFileName;
 		static string entityName;
 		static string targetFPGA;
+		static string targetFile;
 		static double targetFrequencyMHz;
+		static int    targetLatency;
 		static bool   pipeline;
 		static bool   clockEnable;
 		static bool   useHardMult;
 		static bool   plainVHDL;
 		static bool   generateFigures;
+		static bool   retime;
+		static bool   compressTables;
+		static bool   packTables;
+		static bool   incremental;
+		static double incrementalCheck;
+		static string generationHash;
+		static bool   checkingIncremental;
 		static double unusedHardMultThreshold;
 		static int    resourceEstimation;
 		static bool   floorplanning;
@@ -191,6 +222,9 @@ namespace flopoco
 		/** get the default value associated to a parameter (empty string if there is no default)*/
 		string getDefaultParamVal(const string& key);
 
+		/** get the type of a parameter (int, real, bool, string), or an empty string if there is no such parameter */
+		string getParamType(const string& key);
+
 		/*! Consumes zero or more string arguments, and creates an operator
 			\param args The offered arguments start at index 0 of the vector, and it is up to the
 			factory to check the types and whether there are enough.
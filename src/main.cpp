@@ -43,6 +43,7 @@ int main(int argc, char* argv[] )
 		Shifter::registerFactory();
 		LZOC::registerFactory();
 		LZOCShifterSticky::registerFactory();
+		LZA::registerFactory();
 
 		IntAdder::registerFactory();
 #if 0 // Plug them for debug purpose only
@@ -71,7 +72,9 @@ int main(int argc, char* argv[] )
 		FixFunctionByTable::registerFactory();
 		FixFunctionBySimplePoly::registerFactory();
 		FixFunctionByPiecewisePoly::registerFactory();
+		FixMultiFunctionByPiecewisePoly::registerFactory();
 		FixFunctionByMultipartiteTable::registerFactory();
+		HOTBM::registerFactory();
 		BasicPolyApprox::registerFactory();
 		PiecewisePolyApprox::registerFactory();
 		FixRealKCM::registerFactory();
@@ -92,6 +95,7 @@ int main(int argc, char* argv[] )
 		FPLargeAcc::registerFactory();
 		LargeAccToFP::registerFactory();
 		FPDotProduct::registerFactory();
+		FPSumOfProducts::registerFactory();
 		
 		FPExp::registerFactory();
 		IterativeLog::registerFactory();
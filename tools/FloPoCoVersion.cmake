@@ -0,0 +1,47 @@
+# Writes FloPoCoVersion.hpp, which defines FLOPOCO_GIT_VERSION, the version of the generator
+# that is part of the hash used by incremental=1.
+# Run at each build by the flopoco_version target of CMakeLists.txt:
+#   cmake -DSOURCE_DIR=<FloPoCo sources> -DOUTPUT=<header> -P FloPoCoVersion.cmake
+# With uncommitted changes, the version is followed by a hash of the changes to src/ (untracked files included),
+# so that editing a source file changes the version without a commit.
+# The header is only rewritten when the version changes, to avoid useless recompilations.
+
+EXECUTE_PROCESS(COMMAND git describe --always --dirty
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE VERSION
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET)
+
+IF (VERSION MATCHES "dirty")
+  EXECUTE_PROCESS(COMMAND git diff HEAD -- src
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE CHANGES
+    ERROR_QUIET)
+  EXECUTE_PROCESS(COMMAND git ls-files --others --exclude-standard -- src
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE UNTRACKED
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET)
+  IF (UNTRACKED)
+    STRING(REPLACE "\n" ";" UNTRACKED "${UNTRACKED}")
+    FOREACH (F ${UNTRACKED})
+      FILE(SHA1 ${SOURCE_DIR}/${F} H)
+      SET(CHANGES "${CHANGES}${F} ${H}\n")
+    ENDFOREACH (F)
+  ENDIF (UNTRACKED)
+  STRING(SHA1 CHANGES_HASH "${CHANGES}")
+  SET(VERSION "${VERSION}-${CHANGES_HASH}")
+ENDIF (VERSION MATCHES "dirty")
+
+IF (VERSION)
+  SET(CONTENT "#define FLOPOCO_GIT_VERSION \"${VERSION}\"\n")
+ELSE (VERSION)
+  SET(CONTENT "// not built from a git repository\n")
+ENDIF (VERSION)
+
+IF (EXISTS ${OUTPUT})
+  FILE(READ ${OUTPUT} PREVIOUS)
+ENDIF (EXISTS ${OUTPUT})
+IF (NOT "${CONTENT}" STREQUAL "${PREVIOUS}")
+  FILE(WRITE ${OUTPUT} "${CONTENT}")
+ENDIF (NOT "${CONTENT}" STREQUAL "${PREVIOUS}")
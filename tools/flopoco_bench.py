@@ -0,0 +1,153 @@
+##
+################################################################################
+##             Generation-speed benchmark for FloPoCo
+## This tool is part of  FloPoCo
+## All rights reserved
+################################################################################
+##
+## Measures the performance of flopoco itself (not of the generated hardware) on a fixed corpus
+## of representative operators (tools/bench/corpus-<version>.txt).
+## This is the flopoco_bench target of the CMake build.
+##
+## flopoco_bench.py run flopoco result.json [corpus.txt]
+##     runs each item of the corpus in a fresh directory, and saves in result.json, for each item,
+##     the exit status, the wall and CPU times, the peak resident memory and the size of the output files
+## flopoco_bench.py compare old.json new.json [tolerance]
+##     compares two results of the same corpus version, and lists the items whose time, memory or output
+##     size grew by more than tolerance (default 0.1, i.e. 10%). Exits with status 1 if there is a regression.
+
+import os
+import sys
+import json
+import time
+import shlex
+import shutil
+import platform
+import tempfile
+import subprocess
+
+default_corpus = os.path.join(os.path.dirname(os.path.abspath(__file__)), "bench", "corpus-1.txt")
+
+# metrics compared by the compare command
+metrics = ["wallTime", "cpuTime", "peakRSSKB", "outputBytes"]
+# below these, differences are noise
+noise = {"wallTime": 0.5, "cpuTime": 0.5, "peakRSSKB": 4096, "outputBytes": 1024}
+
+
+def usage():
+    print("Usage: \nflopoco_bench.py run flopoco result.json [corpus.txt]\nflopoco_bench.py compare old.json new.json [tolerance]")
+    sys.exit(2)
+
+
+def read_corpus(filename):
+    """Returns (version, list of (name, args))"""
+    version = None
+    items = []
+    for line in open(filename):
+        line = line.strip()
+        if line == "" or line.startswith("#"):
+            continue
+        if version is None:
+            fields = line.split()
+            if len(fields) != 2 or fields[0] != "FloPoCoBenchCorpus":
+                sys.stderr.write(filename + ": first line should be FloPoCoBenchCorpus <version>\n")
+                sys.exit(2)
+            version = int(fields[1])
+            continue
+        name, args = line.split(":", 1)
+        items.append((name.strip(), shlex.split(args)))
+    return (version, items)
+
+
+def directory_size(directory):
+    size = 0
+    for (root, dirs, files) in os.walk(directory):
+        for f in files:
+            size += os.path.getsize(os.path.join(root, f))
+    return size
+
+
+def run_item(flopoco, name, args):
+    workdir = tempfile.mkdtemp(prefix="flopoco_bench_")
+    log = open(os.path.join(workdir, "flopoco.log"), "w")
+    start = time.time()
+    p = subprocess.Popen([flopoco] + args, cwd=workdir, stdout=log, stderr=subprocess.STDOUT)
+    # wait4 gives the resource usage of this child only
+    (pid, status, usage) = os.wait4(p.pid, 0)
+    wall = time.time() - start
+    log.close()
+    os.remove(os.path.join(workdir, "flopoco.log"))
+    result = {
+        "name": name,
+        "command": "flopoco " + " ".join(shlex.quote(a) for a in args),
+        "status": os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1,
+        "wallTime": round(wall, 3),
+        "cpuTime": round(usage.ru_utime + usage.ru_stime, 3),
+        "peakRSSKB": usage.ru_maxrss,  # in KB on Linux
+        "outputBytes": directory_size(workdir),
+    }
+    shutil.rmtree(workdir)
+    return result
+
+
+def run(flopoco, result_file, corpus_file):
+    flopoco = os.path.abspath(flopoco)
+    (version, items) = read_corpus(corpus_file)
+    results = []
+    for (name, args) in items:
+        r = run_item(flopoco, name, args)
+        sys.stderr.write("%-40s %8.2f s %8d KB %10d bytes%s\n"
+                         % (name, r["wallTime"], r["peakRSSKB"], r["outputBytes"],
+                            "" if r["status"] == 0 else "   FAILED (status %d)" % r["status"]))
+        results.append(r)
+    report = {
+        "corpus": os.path.basename(corpus_file),
+        "corpusVersion": version,
+        "flopoco": flopoco,
+        "date": time.strftime("%Y-%m-%d %H:%M:%S"),
+        "host": platform.node(),
+        "machine": platform.machine(),
+        "items": results,
+    }
+    f = open(result_file, "w")
+    json.dump(report, f, indent=1)
+    f.write("\n")
+    f.close()
+    sys.stderr.write("Results written to " + result_file + "\n")
+
+
+def compare(old_file, new_file, tolerance):
+    old = json.load(open(old_file))
+    new = json.load(open(new_file))
+    if old["corpusVersion"] != new["corpusVersion"]:
+        sys.stderr.write("Different corpus versions (%s and %s): not comparable\n" % (old["corpusVersion"], new["corpusVersion"]))
+        sys.exit(2)
+    old_items = dict((i["name"], i) for i in old["items"])
+    regressions = 0
+    for n in new["items"]:
+        o = old_items.get(n["name"])
+        if o is None:
+            continue
+        if n["status"] != 0 and o["status"] == 0:
+            print("%-40s now FAILS (status %d)" % (n["name"], n["status"]))
+            regressions += 1
+            continue
+        for m in metrics:
+            if n[m] > o[m] * (1 + tolerance) and n[m] - o[m] > noise[m]:
+                print("%-40s %-12s %12s -> %12s  (+%.0f%%)" % (n["name"], m, o[m], n[m], 100.0 * (n[m] - o[m]) / max(o[m], 1e-9)))
+                regressions += 1
+    if regressions == 0:
+        print("No regression")
+    sys.exit(1 if regressions > 0 else 0)
+
+
+#/* main */
+if __name__ == '__main__':
+    if len(sys.argv) < 4:
+        usage()
+    if sys.argv[1] == "run":
+        run(sys.argv[2], sys.argv[3], sys.argv[4] if len(sys.argv) > 4 else default_corpus)
+    elif sys.argv[1] == "compare":
+        compare(sys.argv[2], sys.argv[3], float(sys.argv[4]) if len(sys.argv) > 4 else 0.1)
+    else:
+        usage()
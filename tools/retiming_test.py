@@ -0,0 +1,94 @@
+##
+################################################################################
+##             Retiming regression test for FloPoCo
+## This tool is part of  FloPoCo
+## All rights reserved
+################################################################################
+##
+## Checks the retime=1 option against the original pipeline, on a list of pipelined operators.
+## This is the flopoco_retiming_test target of the CMake build.
+##
+## retiming_test.py flopoco [n]
+##     generates each operator with retime=0 and retime=1, each with a TestBench of n random tests (default 1000),
+##     and simulates both with ghdl. Both pipelines must pass their test bench (which compares them to the emulate()
+##     of the operator), and the retimed one must have the same pipeline depth as the original one.
+##     Exits with status 1 if a check fails.
+
+import os
+import re
+import sys
+import shlex
+import shutil
+import tempfile
+import subprocess
+
+# pipelined operators whose constructors produce simple assignments that the retiming can move
+operators = [
+    "frequency=400 IntAdder wIn=64",
+    "frequency=300 FPAdd wE=8 wF=23",
+    "frequency=300 FPMult wE=8 wF=23",
+    "frequency=300 FPDiv wE=8 wF=23",
+    "frequency=300 FPSqrt wE=8 wF=23",
+    "frequency=300 FPExp wE=8 wF=23",
+    "frequency=300 FPLog wE=8 wF=23",
+    "frequency=400 LZOCShifterSticky wIn=32 wOut=32 wCount=5 computeSticky=true",
+]
+
+
+def usage():
+    print("Usage: \nretiming_test.py flopoco [n]")
+    sys.exit(2)
+
+
+def run(flopoco, args, retime, n):
+    """Returns (pipeline depth, number of errors, log), the number of errors being None if the simulation failed"""
+    workdir = tempfile.mkdtemp(prefix="flopoco_retiming_")
+    cmd = [flopoco, "retime=" + str(retime)] + shlex.split(args) + ["TestBench", "n=" + str(n)]
+    p = subprocess.run(cmd, cwd=workdir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    log = p.stdout
+    depth = None
+    m = re.search(r"Pipeline depth = (\d+)", log)
+    if m:
+        depth = int(m.group(1))
+    errors = None
+    if p.returncode == 0:
+        # the ghdl commands printed by flopoco, without the waveform dump
+        ghdl = [l.strip() for l in log.splitlines() if l.strip().startswith("ghdl ")]
+        ok = len(ghdl) == 3
+        for c in ghdl:
+            c = re.sub(r" --vcd=\S+", "", c)
+            q = subprocess.run(c, shell=True, cwd=workdir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                               universal_newlines=True)
+            log += q.stdout
+            ok = ok and (q.returncode == 0 or c.startswith("ghdl -r"))
+        m = re.search(r"(\d+) error\(s\) encoutered", log)
+        if ok and m:
+            errors = int(m.group(1))
+    shutil.rmtree(workdir)
+    return (depth, errors, log)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2 or len(sys.argv) > 3:
+        usage()
+    flopoco = os.path.abspath(sys.argv[1])
+    n = int(sys.argv[2]) if len(sys.argv) == 3 else 1000
+    failures = 0
+    for args in operators:
+        (depth0, errors0, log0) = run(flopoco, args, 0, n)
+        (depth1, errors1, log1) = run(flopoco, args, 1, n)
+        problems = []
+        if errors0 != 0:
+            problems.append("original pipeline: " + ("simulation failed" if errors0 is None else str(errors0) + " errors"))
+        if errors1 != 0:
+            problems.append("retimed pipeline: " + ("simulation failed" if errors1 is None else str(errors1) + " errors"))
+        if depth0 != depth1:
+            problems.append("pipeline depth " + str(depth0) + " -> " + str(depth1))
+        if problems:
+            failures += 1
+            print("FAIL  " + args + ": " + "; ".join(problems))
+            sys.stdout.write(log1)
+        else:
+            print("OK    " + args + " (pipeline depth " + str(depth1) + ")")
+    print(str(len(operators) - failures) + "/" + str(len(operators)) + " operators pass")
+    sys.exit(1 if failures > 0 else 0)
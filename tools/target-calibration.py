@@ -0,0 +1,286 @@
+##
+################################################################################
+##             Target calibration for FloPoCo
+## This tool is part of  FloPoCo
+## All rights reserved
+################################################################################
+##
+## Builds a calibration file for target=Generic (see src/Targets/GenericTarget.hpp)
+## from the timing reports of a family of micro-benchmarks (see src/TargetModel.cpp).
+##
+## target-calibration.py generate dir [flopoco options]
+##     generates in dir the VHDL of all the micro-benchmarks, each wrapped between registers.
+##     The flopoco options (e.g. target=Generic targetFile=prior.txt) select the LUT and DSP sizes.
+## target-calibration.py synth dir
+##     synthesizes them with vivado-runsyn.py, and saves each timing report as dir/<entity>.rpt
+## target-calibration.py fit dir [prior.txt]
+##     parses the timing reports found in dir (Vivado timing reports or nextpnr logs, saved locally,
+##     one per benchmark, with the benchmark name in the file name or the report), fits the delay
+##     parameters by least squares, and prints the calibration file on the standard output.
+##     The parameters that the benchmarks cannot separate keep the values of the prior calibration
+##     file (by default, those of the built-in GenericTarget).
+##
+## There is no benchmark for distantWireDelay(n) = n*elemWireDelay: portable VHDL cannot place two
+## registers n slices apart without vendor placement constraints (RLOC, LOC), so such a measure would
+## depend on the placer. No operator uses distantWireDelay in its delay estimate, and elemWireDelay
+## is fitted on the local wires of the other benchmarks.
+
+import os
+import sys
+import re
+import shutil
+import subprocess
+
+flopoco = "./flopoco"
+
+# (TargetModel type, name, list of values of param)
+benchmarks = [
+    (0, "adder",        [4, 8, 16, 24, 32, 48, 64]),
+    (1, "lutchain",     [1, 2, 3, 4, 6, 8]),
+    (2, "fanout",       [1, 2, 4, 8, 16, 32, 64]),
+    (3, "eqcomparator", [8, 16, 32, 64]),
+    (4, "dspchain",     [1, 2, 3]),
+    (5, "ramread",      [9, 10, 11]),
+]
+
+# The fitted parameters, in ns. The local wire delay for fanout f is elemWireDelay + fanoutSlope*f,
+# i.e. fanoutSlope = elemWireDelay/fanoutScale
+parameters = ["ffDelay", "lutDelay", "elemWireDelay", "fanoutSlope",
+              "adderBaseDelay", "carryPropagateDelay", "eqComparatorBaseDelay",
+              "DSPMultiplierDelay", "DSPToLogicWireDelay", "RAMDelay", "RAMToLogicWireDelay"]
+
+# The defaults of GenericTarget
+default_prior = {
+    "lutInputs": "6", "fanoutScale": "50",
+    "ffDelay": "0.268", "lutDelay": "0.053", "elemWireDelay": "0.313",
+    "adderBaseDelay": "0.452", "carryPropagateDelay": "0.015", "eqComparatorBaseDelay": "0.272",
+    "DSPMultiplierDelay": "1.638", "DSPToLogicWireDelay": "0.436", "LogicToDSPWireDelay": "0.436",
+    "RAMDelay": "1.591", "RAMToLogicWireDelay": "0.235", "LogicToRAMWireDelay": "0.235",
+}
+
+# regularization weight pulling the parameters towards the prior: small, so that it only matters
+# for the combinations of parameters that the measures do not determine
+ridge = 1e-4
+
+
+def usage():
+    print("Usage: \ntarget-calibration.py generate dir [flopoco options]\ntarget-calibration.py synth dir\ntarget-calibration.py fit dir [prior.txt]")
+    sys.exit()
+
+
+def benchmark_name(name, param):
+    return "TargetModel_" + name + "_" + str(param)
+
+
+def generate(directory, options):
+    if not os.path.isdir(directory):
+        os.mkdir(directory)
+    for (t, name, params) in benchmarks:
+        for p in params:
+            entity = benchmark_name(name, p)
+            cmd = (flopoco + " pipeline=no " + " ".join(options)
+                   + " outputFile=" + os.path.join(directory, entity + ".vhdl")
+                   + " TargetModel type=" + str(t) + " param=" + str(p) + " Wrapper")
+            print(cmd)
+            os.system(cmd)
+
+
+def synth(directory):
+    runsyn = os.path.join(os.path.dirname(os.path.abspath(__file__)), "vivado-runsyn.py")
+    for f in sorted(os.listdir(directory)):
+        if not f.endswith(".vhdl"):
+            continue
+        entity = f[:-len(".vhdl")] + "_Wrapper"
+        subprocess.call(["python", runsyn, os.path.join(directory, f), entity])
+        report = os.path.join("/tmp/vivado_runsyn_files", "test_" + entity + "_timing_report.txt")
+        if os.path.exists(report):
+            shutil.copy(report, os.path.join(directory, f[:-len(".vhdl")] + ".rpt"))
+        else:
+            sys.stderr.write("No timing report for " + entity + "\n")
+
+
+def parse_report(text):
+    """Returns the register-to-register critical path delay in ns, or None"""
+    # nextpnr log
+    freqs = [float(f) for f in re.findall(r"Max frequency for clock '[^']*': ([\d.]+) MHz", text)]
+    if freqs:
+        return 1000.0 / min(freqs)
+    # Vivado timing report: worst data path between two sequential cells (ignore the IO paths)
+    worst = None
+    for block in text.split("Slack")[1:]:
+        source = re.search(r"Source:.*\n(.*)", block)
+        destination = re.search(r"Destination:.*\n(.*)", block)
+        delay = re.search(r"Data Path Delay:\s+([\d.]+)ns", block)
+        if not (source and destination and delay):
+            continue
+        if "edge-triggered cell" in source.group(0) and "edge-triggered cell" in destination.group(0):
+            d = float(delay.group(1))
+            if worst is None or d > worst:
+                worst = d
+    return worst
+
+
+def read_measures(directory):
+    """Returns a list of (name, param, delay)"""
+    measures = []
+    for f in sorted(os.listdir(directory)):
+        if f.endswith(".vhdl"):
+            continue
+        text = open(os.path.join(directory, f)).read()
+        m = re.search(r"TargetModel_([a-z]+)_(\d+)", f) or re.search(r"TargetModel_([a-z]+)_(\d+)", text)
+        if not m:
+            continue
+        delay = parse_report(text)
+        if delay is None:
+            sys.stderr.write("No timing information found in " + f + "\n")
+            continue
+        measures.append((m.group(1), int(m.group(2)), delay))
+    return measures
+
+
+def model_row(name, p, lut_inputs):
+    """Coefficients of the parameters in the delay of a benchmark"""
+    row = dict((k, 0.0) for k in parameters)
+    row["ffDelay"] = 1
+    if name == "adder":
+        row["elemWireDelay"] = 1
+        row["fanoutSlope"] = 1
+        row["adderBaseDelay"] = 1
+        row["carryPropagateDelay"] = p - 1
+    elif name == "lutchain":
+        row["elemWireDelay"] = p
+        row["fanoutSlope"] = p
+        row["lutDelay"] = p
+    elif name == "fanout":
+        row["elemWireDelay"] = 1
+        row["fanoutSlope"] = p
+        row["lutDelay"] = 1
+    elif name == "eqcomparator":
+        row["elemWireDelay"] = 1
+        row["fanoutSlope"] = 1
+        row["eqComparatorBaseDelay"] = 1
+        row["carryPropagateDelay"] = (p - 1) // (lut_inputs // 2) + 1
+    elif name == "dspchain":
+        # LogicToDSPWireDelay is assumed equal to DSPToLogicWireDelay
+        row["DSPMultiplierDelay"] = p
+        row["DSPToLogicWireDelay"] = 2 * p
+    elif name == "ramread":
+        # LogicToRAMWireDelay is assumed equal to RAMToLogicWireDelay
+        row["ffDelay"] = 0
+        row["RAMDelay"] = 1
+        row["RAMToLogicWireDelay"] = 1
+    else:
+        return None
+    return [row[k] for k in parameters]
+
+
+def solve(a, b):
+    """Gaussian elimination with partial pivoting"""
+    n = len(b)
+    m = [a[i][:] + [b[i]] for i in range(n)]
+    for c in range(n):
+        pivot = max(range(c, n), key=lambda r: abs(m[r][c]))
+        m[c], m[pivot] = m[pivot], m[c]
+        for r in range(c + 1, n):
+            f = m[r][c] / m[c][c]
+            for k in range(c, n + 1):
+                m[r][k] -= f * m[c][k]
+    x = [0.0] * n
+    for r in range(n - 1, -1, -1):
+        x[r] = (m[r][n] - sum(m[r][k] * x[k] for k in range(r + 1, n))) / m[r][r]
+    return x
+
+
+def read_calibration_file(filename):
+    """Returns the list of (key, value) of a calibration file, in order"""
+    entries = []
+    for line in open(filename):
+        line = line.split("#")[0].strip()
+        if line == "" or line.startswith("FloPoCoTarget"):
+            continue
+        key, value = line.split("=", 1)
+        entries.append((key.strip(), value.strip()))
+    return entries
+
+
+def fit(directory, prior_file):
+    if prior_file:
+        entries = read_calibration_file(prior_file)
+    else:
+        entries = sorted(default_prior.items())
+    prior = dict(default_prior)
+    prior.update(dict(entries))
+    lut_inputs = int(prior["lutInputs"])
+    p0 = [float(prior[k]) for k in parameters if k != "fanoutSlope"]
+    p0.insert(parameters.index("fanoutSlope"), float(prior["elemWireDelay"]) / float(prior["fanoutScale"]))
+
+    measures = read_measures(directory)
+    if not measures:
+        sys.stderr.write("No timing report found in " + directory + "\n")
+        sys.exit(1)
+    rows = []
+    delays = []
+    kept = []
+    for (name, p, d) in measures:
+        row = model_row(name, p, lut_inputs)
+        if row is None:
+            sys.stderr.write("Ignoring unknown benchmark " + name + "\n")
+            continue
+        rows.append(row)
+        delays.append(d)
+        kept.append((name, p, d))
+    if not rows:
+        sys.stderr.write("No known benchmark in " + directory + "\n")
+        sys.exit(1)
+
+    # normal equations of the least squares problem, regularized towards the prior
+    n = len(parameters)
+    ata = [[sum(r[i] * r[j] for r in rows) + (ridge if i == j else 0) for j in range(n)] for i in range(n)]
+    atb = [sum(r[i] * d for (r, d) in zip(rows, delays)) + ridge * p0[i] for i in range(n)]
+    x = solve(ata, atb)
+
+    fitted = dict(zip(parameters, x))
+    rms = 0
+    for ((name, p, d), r) in zip(kept, rows):
+        e = sum(c * v for (c, v) in zip(r, x))
+        rms += (e - d) ** 2
+        sys.stderr.write("%-30s measured %7.3f ns, model %7.3f ns\n" % (benchmark_name(name, p), d, e))
+    sys.stderr.write("RMS error: %.3f ns on %d benchmarks\n" % ((rms / len(rows)) ** 0.5, len(rows)))
+    for k in parameters:
+        if fitted[k] < 0:
+            sys.stderr.write("Warning: fitted " + k + " is negative, keeping the prior value\n")
+            fitted[k] = p0[parameters.index(k)]
+
+    result = dict(fitted)
+    del result["fanoutSlope"]
+    if fitted["fanoutSlope"] > 0:
+        result["fanoutScale"] = fitted["elemWireDelay"] / fitted["fanoutSlope"]
+    result["LogicToDSPWireDelay"] = fitted["DSPToLogicWireDelay"]
+    result["LogicToRAMWireDelay"] = fitted["RAMToLogicWireDelay"]
+
+    print("FloPoCoTarget 1")
+    print("# Fitted by target-calibration.py on %d timing reports of %s" % (len(rows), directory))
+    print("# Delays are in ns")
+    for (key, value) in entries:
+        if key in result:
+            print("%s = %.4f" % (key, result.pop(key)))
+        else:
+            print("%s = %s" % (key, value))
+    for key in sorted(result):
+        print("%s = %.4f" % (key, result[key]))
+
+
+#/* main */
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        usage()
+    command = sys.argv[1]
+    directory = sys.argv[2]
+    if command == "generate":
+        generate(directory, sys.argv[3:])
+    elif command == "synth":
+        synth(directory)
+    elif command == "fit":
+        fit(directory, sys.argv[3] if len(sys.argv) > 3 else None)
+    else:
+        usage()